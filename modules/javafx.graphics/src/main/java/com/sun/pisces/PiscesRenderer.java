@@ -358,6 +358,30 @@ public final class PiscesRenderer {
     private native void emitAndClearAlphaRowImpl(byte[] alphaMap, int[] alphaDeltas, int pix_y, int pix_x_from, int pix_x_to,
         int pix_x_off, int rowNum);
 
+    /**
+     * Emits numRows rows at once, as emitAndClearAlphaRow would emit them one by one.
+     * Row i is described by rows[3*i] (y), rows[3*i+1] (x_from) and rows[3*i+2] (x_to),
+     * and its alpha deltas start at alphaDeltas[i*alphaStride].
+     */
+    public void emitAndClearAlphaRows(byte[] alphaMap, int[] alphaDeltas, int alphaStride,
+        int[] rows, int numRows, int rowNum)
+    {
+        if (numRows <= 0) {
+            return;
+        }
+        if (alphaStride <= 0 || numRows * 3 > rows.length || numRows * alphaStride > alphaDeltas.length) {
+            throw new IllegalArgumentException("rendering range exceeds length of data");
+        }
+        for (int i = 0; i < numRows; i++) {
+            if (rows[i * 3 + 2] - rows[i * 3 + 1] >= alphaStride) {
+                throw new IllegalArgumentException("rendering range exceeds length of data");
+            }
+        }
+        this.emitAndClearAlphaRowsImpl(alphaMap, alphaDeltas, alphaStride, rows, numRows, rowNum);
+    }
+    private native void emitAndClearAlphaRowsImpl(byte[] alphaMap, int[] alphaDeltas, int alphaStride,
+        int[] rows, int numRows, int rowNum);
+
     public void fillAlphaMask(byte[] mask, int x, int y, int width, int height, int offset, int stride) {
         if (mask == null) {
             throw new NullPointerException("Mask is NULL");
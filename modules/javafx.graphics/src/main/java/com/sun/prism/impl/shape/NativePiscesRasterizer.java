@@ -32,6 +32,7 @@ import com.sun.javafx.geom.RectBounds;
 import com.sun.javafx.geom.Shape;
 import com.sun.javafx.geom.transform.BaseTransform;
 import com.sun.prism.BasicStroke;
+import com.sun.prism.impl.Disposer;
 import com.sun.prism.impl.PrismSettings;
 import java.nio.ByteBuffer;
 import java.security.AccessController;
@@ -46,26 +47,86 @@ public class NativePiscesRasterizer implements ShapeRasterizer {
     private static final byte SEG_CUBICTO = PathIterator.SEG_CUBICTO;
     private static final byte SEG_CLOSE   = PathIterator.SEG_CLOSE;
 
+    // Checked against AlphaConsumer.h through the generated header
+    private static final int TILE_LG_SIZE   = TiledMaskData.TILE_LG_SIZE;
+    private static final int TILE_SIZE_MASK = TiledMaskData.TILE_SIZE - 1;
+    private static final int TILE_EMPTY     = TiledMaskData.TILE_EMPTY;
+    private static final int TILE_PARTIAL   = TiledMaskData.TILE_PARTIAL;
+    private static final int TILE_FULL      = TiledMaskData.TILE_FULL;
+
+    private static TiledMaskData emptyTiledData = new TiledMaskData();
+    static {
+        emptyTiledData.update(ByteBuffer.wrap(new byte[1]), 0, 0, 1, 1,
+                              new int[2], new byte[] { TILE_EMPTY });
+    }
+
     private byte cachedMask[];
     private ByteBuffer cachedBuffer;
     private MaskData cachedData;
+    private int cachedSpans[];
+    private byte cachedTiles[];
+    private TiledMaskData cachedTiledData;
     private int bounds[] = new int[4];
     private boolean lastAntialiasedShape;
     private boolean firstTimeAASetting = true;
 
+    // The native buffers used to rasterize the shapes of this rasterizer,
+    // which is only used by one thread.  They are kept from one shape to
+    // the next, and freed when the rasterizer is collected.
+    private long context;
+
     native static void init(int subpixelLgPositionsX, int subpixelLgPositionsY);
 
-    native static void produceFillAlphas(float coords[], byte commands[], int nsegs, boolean nonzero,
+    native static long createContext();
+    native static void disposeContext(long context);
+
+    // A context of 0 rasterizes the shape with temporary buffers.
+    native static void produceFillAlphas(long context,
+                                         float coords[], byte commands[], int nsegs, boolean nonzero,
                                          double mxx, double mxy, double mxt,
                                          double myx, double myy, double myt,
                                          int bounds[], byte mask[]);
-    native static void produceStrokeAlphas(float coords[], byte commands[], int nsegs,
+    native static void produceStrokeAlphas(long context,
+                                           float coords[], byte commands[], int nsegs,
                                            float lw, int cap, int join, float mlimit,
                                            float dashes[], float dashoff,
                                            double mxx, double mxy, double mxt,
                                            double myx, double myy, double myt,
                                            int bounds[], byte mask[]);
 
+    // Variants which also fill the row spans and tile flags of the mask,
+    // and only the parts of the mask these flags need, see TiledMaskData.
+    native static void produceFillTiles(long context,
+                                        float coords[], byte commands[], int nsegs, boolean nonzero,
+                                        double mxx, double mxy, double mxt,
+                                        double myx, double myy, double myt,
+                                        int bounds[], byte mask[],
+                                        int spans[], byte tiles[]);
+    native static void produceStrokeTiles(long context,
+                                          float coords[], byte commands[], int nsegs,
+                                          float lw, int cap, int join, float mlimit,
+                                          float dashes[], float dashoff,
+                                          double mxx, double mxy, double mxt,
+                                          double myx, double myy, double myt,
+                                          int bounds[], byte mask[],
+                                          int spans[], byte tiles[]);
+
+    private static class ContextDisposerRecord implements Disposer.Record {
+        private long context;
+
+        ContextDisposerRecord(long context) {
+            this.context = context;
+        }
+
+        @Override
+        public void dispose() {
+            if (context != 0L) {
+                disposeContext(context);
+                context = 0L;
+            }
+        }
+    }
+
     static {
         AccessController.doPrivileged((PrivilegedAction<Void>) () -> {
             String libName = "prism_common";
@@ -86,13 +147,58 @@ public class NativePiscesRasterizer implements ShapeRasterizer {
                                 RectBounds xformBounds, BaseTransform xform,
                                 boolean close, boolean antialiasedShape)
     {
+        return rasterize(shape, stroke, xformBounds, xform, antialiasedShape, false);
+    }
+
+    /**
+     * Same as {@link #getMaskData}, but also returns the coverage of the
+     * rows and tiles of the mask, which is only filled where that coverage
+     * is partial.
+     */
+    public TiledMaskData getTiledMaskData(Shape shape, BasicStroke stroke,
+                                          RectBounds xformBounds, BaseTransform xform,
+                                          boolean antialiasedShape)
+    {
+        return (TiledMaskData) rasterize(shape, stroke, xformBounds, xform, antialiasedShape, true);
+    }
 
+    private void ensureMaskCapacity(int size) {
+        if (cachedMask == null || size > cachedMask.length) {
+            cachedMask = null;
+            cachedBuffer = null;
+            cachedData = new MaskData();
+            int csize = (size + 0xfff) & (~0xfff);
+            cachedMask = new byte[csize];
+            cachedBuffer = ByteBuffer.wrap(cachedMask);
+        }
+    }
+
+    private long getContext() {
+        if (context == 0L) {
+            context = createContext();
+            if (context != 0L) {
+                Disposer.addRecord(this, new ContextDisposerRecord(context));
+            }
+        }
+        return context;
+    }
+
+    private void validateAA(boolean antialiasedShape) {
         if (firstTimeAASetting || (lastAntialiasedShape != antialiasedShape)) {
             int subpixelLgPositions = antialiasedShape ? 3 : 0;
             NativePiscesRasterizer.init(subpixelLgPositions, subpixelLgPositions);
             firstTimeAASetting = false;
             lastAntialiasedShape = antialiasedShape;
         }
+    }
+
+    private MaskData rasterize(Shape shape, BasicStroke stroke,
+                               RectBounds xformBounds, BaseTransform xform,
+                               boolean antialiasedShape, boolean tiled)
+    {
+        MaskData empty = tiled ? emptyTiledData : emptyData;
+
+        validateAA(antialiasedShape);
 
         if (stroke != null && stroke.getType() != BasicStroke.TYPE_CENTERED) {
             // RT-27427
@@ -122,7 +228,7 @@ public class NativePiscesRasterizer implements ShapeRasterizer {
         bounds[2] = (int) Math.ceil(xformBounds.getMaxX());
         bounds[3] = (int) Math.ceil(xformBounds.getMaxY());
         if (bounds[2] <= bounds[0] || bounds[3] <= bounds[1]) {
-            return emptyData;
+            return empty;
         }
         Path2D p2d = (shape instanceof Path2D) ? (Path2D) shape : new Path2D(shape);
         double mxx, mxy, mxt, myx, myy, myt;
@@ -143,18 +249,40 @@ public class NativePiscesRasterizer implements ShapeRasterizer {
         int w = bounds[2] - x;
         int h = bounds[3] - y;
         if (w <= 0 || h <= 0) {
-            return emptyData;
+            return empty;
         }
-        if (cachedMask == null || w * h > cachedMask.length) {
-            cachedMask = null;
-            cachedBuffer = null;
-            cachedData = new MaskData();
-            int csize = (w * h + 0xfff) & (~0xfff);
-            cachedMask = new byte[csize];
-            cachedBuffer = ByteBuffer.wrap(cachedMask);
+        ensureMaskCapacity(w * h);
+        if (tiled) {
+            int tiles = ((w + TILE_SIZE_MASK) >> TILE_LG_SIZE) * ((h + TILE_SIZE_MASK) >> TILE_LG_SIZE);
+            if (cachedSpans == null || cachedSpans.length < h * 2) {
+                cachedSpans = new int[(h * 2 + 0xff) & (~0xff)];
+            }
+            if (cachedTiles == null || cachedTiles.length < tiles) {
+                cachedTiles = new byte[(tiles + 0xff) & (~0xff)];
+            }
+            if (cachedTiledData == null) {
+                cachedTiledData = new TiledMaskData();
+            }
         }
-        if (stroke != null) {
-            produceStrokeAlphas(p2d.getFloatCoordsNoClone(),
+        if (tiled) {
+            if (stroke != null) {
+                produceStrokeTiles(getContext(), p2d.getFloatCoordsNoClone(),
+                                   p2d.getCommandsNoClone(),
+                                   p2d.getNumCommands(),
+                                   stroke.getLineWidth(), stroke.getEndCap(),
+                                   stroke.getLineJoin(), stroke.getMiterLimit(),
+                                   stroke.getDashArray(), stroke.getDashPhase(),
+                                   mxx, mxy, mxt, myx, myy, myt,
+                                   bounds, cachedMask, cachedSpans, cachedTiles);
+            } else {
+                produceFillTiles(getContext(), p2d.getFloatCoordsNoClone(),
+                                 p2d.getCommandsNoClone(),
+                                 p2d.getNumCommands(), p2d.getWindingRule() == Path2D.WIND_NON_ZERO,
+                                 mxx, mxy, mxt, myx, myy, myt,
+                                 bounds, cachedMask, cachedSpans, cachedTiles);
+            }
+        } else if (stroke != null) {
+            produceStrokeAlphas(getContext(), p2d.getFloatCoordsNoClone(),
                                 p2d.getCommandsNoClone(),
                                 p2d.getNumCommands(),
                                 stroke.getLineWidth(), stroke.getEndCap(),
@@ -163,7 +291,7 @@ public class NativePiscesRasterizer implements ShapeRasterizer {
                                 mxx, mxy, mxt, myx, myy, myt,
                                 bounds, cachedMask);
         } else {
-            produceFillAlphas(p2d.getFloatCoordsNoClone(),
+            produceFillAlphas(getContext(), p2d.getFloatCoordsNoClone(),
                               p2d.getCommandsNoClone(),
                               p2d.getNumCommands(), p2d.getWindingRule() == Path2D.WIND_NON_ZERO,
                               mxx, mxy, mxt, myx, myy, myt,
@@ -174,7 +302,11 @@ public class NativePiscesRasterizer implements ShapeRasterizer {
         w = bounds[2] - x;
         h = bounds[3] - y;
         if (w <= 0 || h <= 0) {
-            return emptyData;
+            return empty;
+        }
+        if (tiled) {
+            cachedTiledData.update(cachedBuffer, x, y, w, h, cachedSpans, cachedTiles);
+            return cachedTiledData;
         }
         cachedData.update(cachedBuffer, x, y, w, h);
         return cachedData;
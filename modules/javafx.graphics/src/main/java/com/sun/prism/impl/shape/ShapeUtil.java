@@ -64,6 +64,23 @@ public class ShapeUtil {
         return shapeRasterizer.getMaskData(shape, stroke, xformBounds, xform, close, antialiasedShape);
     }
 
+    /**
+     * Rasterizes the shape along with the coverage of the rows and tiles of
+     * its mask, or returns null when the rasterizer can not produce them.
+     */
+    public static TiledMaskData rasterizeShapeTiled(Shape shape,
+                                                    BasicStroke stroke,
+                                                    RectBounds xformBounds,
+                                                    BaseTransform xform,
+                                                    boolean antialiasedShape)
+    {
+        if (shapeRasterizer instanceof NativePiscesRasterizer) {
+            return ((NativePiscesRasterizer) shapeRasterizer)
+                    .getTiledMaskData(shape, stroke, xformBounds, xform, antialiasedShape);
+        }
+        return null;
+    }
+
     public static Shape createCenteredStrokedShape(Shape s, BasicStroke stroke)
     {
         if (PrismSettings.rasterizerSpec == RasterizerType.DoubleMarlin) {
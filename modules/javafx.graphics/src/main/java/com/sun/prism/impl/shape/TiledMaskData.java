@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package com.sun.prism.impl.shape;
+
+import java.nio.ByteBuffer;
+
+/**
+ * A mask which also describes where its coverage is.  Each row has a span
+ * of pixels, outside of which the row is empty, and the mask is split in
+ * {@code TILE_SIZE} square tiles which are empty, partially covered or fully
+ * covered.  Only the spans and the partial tiles of the mask buffer are
+ * defined, so callers skip empty tiles and fill full tiles without reading
+ * the mask.
+ */
+public class TiledMaskData extends MaskData {
+
+    public static final int TILE_LG_SIZE = 5;
+    public static final int TILE_SIZE = 1 << TILE_LG_SIZE;
+
+    public static final byte TILE_EMPTY = 0;
+    public static final byte TILE_PARTIAL = 1;
+    public static final byte TILE_FULL = 2;
+
+    private int rowSpans[];
+    private byte tileFlags[];
+
+    public TiledMaskData() {
+    }
+
+    /**
+     * Returns the first and the last plus one pixel of each row which
+     * may be covered, relative to the origin.
+     */
+    public int[] getRowSpans() {
+        return rowSpans;
+    }
+
+    /**
+     * Returns the flag of each tile, row by row.
+     */
+    public byte[] getTileFlags() {
+        return tileFlags;
+    }
+
+    public int getTilesX() {
+        return (getWidth() + TILE_SIZE - 1) >> TILE_LG_SIZE;
+    }
+
+    public int getTilesY() {
+        return (getHeight() + TILE_SIZE - 1) >> TILE_LG_SIZE;
+    }
+
+    public void update(ByteBuffer maskBuffer,
+                       int originX, int originY, int width, int height,
+                       int rowSpans[], byte tileFlags[])
+    {
+        update(maskBuffer, originX, originY, width, height);
+        this.rowSpans = rowSpans;
+        this.tileFlags = tileFlags;
+    }
+}
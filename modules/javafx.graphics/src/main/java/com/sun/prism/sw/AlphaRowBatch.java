@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.prism.sw;
+
+import com.sun.pisces.PiscesRenderer;
+import java.util.Arrays;
+
+/**
+ * Collects the alpha rows produced for a shape and emits them to the
+ * PiscesRenderer in batches of up to MAX_ROWS rows, so that the surface is
+ * acquired once per batch rather than once per row.
+ */
+final class AlphaRowBatch {
+    static final int MAX_ROWS = 32;
+
+    private int deltas[];
+    private final int rows[] = new int[MAX_ROWS * 3];
+    private int stride;
+    private int numRows;
+    private int firstRowNum;
+
+    void init(int width) {
+        // Room for the last delta of a row, as in the alpha deltas of the
+        // rasterizers
+        stride = width + 2;
+        if (deltas == null || deltas.length < stride * MAX_ROWS) {
+            deltas = new int[stride * MAX_ROWS];
+        }
+        numRows = 0;
+        firstRowNum = 0;
+    }
+
+    /**
+     * Copies and clears the deltas of the row from alphaDeltas[x_off], which
+     * would have been emitted by
+     * emitAndClearAlphaRow(alphaMap, alphaDeltas, y, x_from, x_to, x_off, rowNum).
+     */
+    void add(PiscesRenderer pr, byte alphaMap[], int alphaDeltas[],
+             int y, int x_from, int x_to, int x_off, int rowNum)
+    {
+        if (numRows == 0) {
+            firstRowNum = rowNum;
+        }
+        int len = Math.min(Math.min(x_to - x_from + 1, stride), alphaDeltas.length - x_off);
+        if (len > 0) {
+            System.arraycopy(alphaDeltas, x_off, deltas, numRows * stride, len);
+            Arrays.fill(alphaDeltas, x_off, x_off + len, 0);
+        }
+        rows[numRows * 3] = y;
+        rows[numRows * 3 + 1] = x_from;
+        rows[numRows * 3 + 2] = x_from + len - 1;
+        if (++numRows == MAX_ROWS) {
+            flush(pr, alphaMap);
+        }
+    }
+
+    void flush(PiscesRenderer pr, byte alphaMap[]) {
+        if (numRows > 0) {
+            pr.emitAndClearAlphaRows(alphaMap, deltas, stride, rows, numRows, firstRowNum);
+            numRows = 0;
+        }
+    }
+}
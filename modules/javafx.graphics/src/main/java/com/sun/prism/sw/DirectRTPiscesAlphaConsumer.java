@@ -39,6 +39,7 @@ final class DirectRTPiscesAlphaConsumer implements AlphaConsumer {
     private int rowNum;
 
     private PiscesRenderer pr;
+    private final AlphaRowBatch batch = new AlphaRowBatch();
 
     void initConsumer(Renderer renderer, PiscesRenderer pr) {
         outpix_xmin = renderer.getOutpixMinX();
@@ -49,6 +50,11 @@ final class DirectRTPiscesAlphaConsumer implements AlphaConsumer {
         if (h < 0) { h = 0; }
         rowNum = 0;
         this.pr = pr;
+        batch.init(w);
+    }
+
+    void flush() {
+        batch.flush(pr, alpha_map);
     }
 
     @Override
@@ -83,7 +89,7 @@ final class DirectRTPiscesAlphaConsumer implements AlphaConsumer {
 
     @Override
     public void setAndClearRelativeAlphas(int[] alphaDeltas, int pix_y, int firstdelta, int lastdelta) {
-        pr.emitAndClearAlphaRow(alpha_map, alphaDeltas, pix_y, firstdelta, lastdelta, rowNum);
+        batch.add(pr, alpha_map, alphaDeltas, pix_y, firstdelta, lastdelta, 0, rowNum);
         rowNum++;
     }
 }
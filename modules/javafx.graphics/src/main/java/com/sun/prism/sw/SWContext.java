@@ -50,6 +50,7 @@ import com.sun.prism.impl.shape.MarlinPrismUtils;
 import com.sun.prism.impl.shape.MaskData;
 import com.sun.prism.impl.shape.OpenPiscesPrismUtils;
 import com.sun.prism.impl.shape.ShapeUtil;
+import com.sun.prism.impl.shape.TiledMaskData;
 
 import java.lang.ref.SoftReference;
 
@@ -69,6 +70,11 @@ final class SWContext {
         private SoftReference<SWMaskTexture> maskTextureRef;
 
         public void renderShape(PiscesRenderer pr, Shape shape, BasicStroke stroke, BaseTransform tr, Rectangle clip, boolean antialiasedShape) {
+            final TiledMaskData tiles = ShapeUtil.rasterizeShapeTiled(shape, stroke, clip.toRectBounds(), tr, antialiasedShape);
+            if (tiles != null) {
+                this.renderTiles(pr, tiles);
+                return;
+            }
             final MaskData mask = ShapeUtil.rasterizeShape(shape, stroke, clip.toRectBounds(), tr, true, antialiasedShape);
             final SWMaskTexture tex = this.validateMaskTexture(mask.getWidth(), mask.getHeight());
             mask.uploadToTexture(tex, 0, 0, false);
@@ -76,6 +82,39 @@ final class SWContext {
                              mask.getWidth(), mask.getHeight(), 0, tex.getPhysicalWidth());
         }
 
+        // Skips the empty tiles, fills the full ones and blends the mask of
+        // the partial ones, merging runs of tiles with the same flag.
+        private void renderTiles(PiscesRenderer pr, TiledMaskData mask) {
+            final byte[] alphas = mask.getMaskBuffer().array();
+            final byte[] flags = mask.getTileFlags();
+            final int x = mask.getOriginX();
+            final int y = mask.getOriginY();
+            final int w = mask.getWidth();
+            final int h = mask.getHeight();
+            final int tilesX = mask.getTilesX();
+            final int tilesY = mask.getTilesY();
+            for (int ty = 0; ty < tilesY; ty++) {
+                final int y0 = ty * TiledMaskData.TILE_SIZE;
+                final int th = Math.min(TiledMaskData.TILE_SIZE, h - y0);
+                int tx = 0;
+                while (tx < tilesX) {
+                    final byte flag = flags[ty * tilesX + tx];
+                    int end = tx + 1;
+                    while (end < tilesX && flags[ty * tilesX + end] == flag) {
+                        end++;
+                    }
+                    final int x0 = tx * TiledMaskData.TILE_SIZE;
+                    final int tw = Math.min(end * TiledMaskData.TILE_SIZE, w) - x0;
+                    if (flag == TiledMaskData.TILE_FULL) {
+                        pr.fillRect((x + x0) << 16, (y + y0) << 16, tw << 16, th << 16);
+                    } else if (flag == TiledMaskData.TILE_PARTIAL) {
+                        pr.fillAlphaMask(alphas, x + x0, y + y0, tw, th, y0 * w + x0, w);
+                    }
+                    tx = end;
+                }
+            }
+        }
+
         private SWMaskTexture initMaskTexture(int width, int height) {
             final SWMaskTexture tex = (SWMaskTexture)factory.createMaskTexture(width, height, Texture.WrapMode.CLAMP_NOT_NEEDED);
             maskTextureRef = new SoftReference<SWMaskTexture>(tex);
@@ -128,6 +167,7 @@ final class SWContext {
             final Renderer r = OpenPiscesPrismUtils.setupRenderer(shape, stroke, tr, clip, antialiasedShape);
             alphaConsumer.initConsumer(r, pr);
             r.produceAlphas(alphaConsumer);
+            alphaConsumer.flush();
         }
 
         public void dispose() { }
@@ -170,6 +210,7 @@ final class SWContext {
                 }
                 alphaConsumer.initConsumer(outpix_xmin, outpix_ymin, w, h, pr);
                 renderer.produceAlphas(alphaConsumer);
+                alphaConsumer.flush();
             } finally {
                 if (renderer != null) {
                     renderer.dispose();
@@ -192,6 +233,7 @@ final class SWContext {
         private int rowNum;
 
         private PiscesRenderer pr;
+        private final AlphaRowBatch batch = new AlphaRowBatch();
 
         public void initConsumer(int x, int y, int w, int h, PiscesRenderer pr) {
             this.x = x;
@@ -200,6 +242,11 @@ final class SWContext {
             this.h = h;
             rowNum = 0;
             this.pr = pr;
+            batch.init(w);
+        }
+
+        void flush() {
+            batch.flush(pr, alpha_map);
         }
 
         @Override
@@ -247,7 +294,7 @@ final class SWContext {
                                               final int pix_from, final int pix_to)
         {
             // pix_from indicates the first alpha coverage != 0 within [x; pix_to[
-            pr.emitAndClearAlphaRow(alpha_map, alphaDeltas, pix_y, pix_from, pix_to, (pix_from - x), rowNum);
+            batch.add(pr, alpha_map, alphaDeltas, pix_y, pix_from, pix_to, (pix_from - x), rowNum);
             rowNum++;
 
             // clear properly the end of the alphaDeltas:
@@ -308,6 +355,7 @@ final class SWContext {
                 }
                 alphaConsumer.initConsumer(outpix_xmin, outpix_ymin, w, h, pr);
                 renderer.produceAlphas(alphaConsumer);
+                alphaConsumer.flush();
             } finally {
                 if (renderer != null) {
                     renderer.dispose();
@@ -113,11 +113,11 @@ public class SSEBoxBlurPeer extends SSEEffectPeer<BoxRenderState> {
         return new ImageData(getFilterContext(), cur, dstBounds);
     }
 
-    private static native void
+    static native void
         filterHorizontal(int dstPixels[], int dstw, int dsth, int dstscan,
                          int srcPixels[], int srcw, int srch, int srcscan);
 
-    private static native void
+    static native void
         filterVertical(int dstPixels[], int dstw, int dsth, int dstscan,
                        int srcPixels[], int srcw, int srch, int srcscan);
 }
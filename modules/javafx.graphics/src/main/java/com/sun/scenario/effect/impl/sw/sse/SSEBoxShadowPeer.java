@@ -141,17 +141,17 @@ public class SSEBoxShadowPeer extends SSEEffectPeer<BoxRenderState> {
         return new ImageData(getFilterContext(), cur, dstBounds, inputs[0].getTransform());
     }
 
-    private static native void
+    static native void
         filterHorizontalBlack(int dstPixels[], int dstw, int dsth, int dstscan,
                               int srcPixels[], int srcw, int srch, int srcscan,
                               float spread);
 
-    private static native void
+    static native void
         filterVerticalBlack(int dstPixels[], int dstw, int dsth, int dstscan,
                             int srcPixels[], int srcw, int srch, int srcscan,
                             float spread);
 
-    private static native void
+    static native void
         filterVertical(int dstPixels[], int dstw, int dsth, int dstscan,
                        int srcPixels[], int srcw, int srch, int srcscan,
                        float spread, float shadowColor[]);
@@ -42,7 +42,7 @@ public class SSELinearConvolveShadowPeer extends SSELinearConvolvePeer {
         return getRenderState().getPassShadowColorComponents();
     }
 
-    private static native void
+    static native void
         filterVector(int dstPixels[], int dstw, int dsth, int dstscan,
                      int srcPixels[], int srcw, int srch, int srcscan,
                      float weights[], int count,
@@ -79,7 +79,7 @@ public class SSELinearConvolveShadowPeer extends SSELinearConvolvePeer {
      * Rows are horizontal in the first pass and vertical in the second pass.
      * Cols are vice versa.
      */
-    private static native void
+    static native void
         filterHV(int dstPixels[], int dstcols, int dstrows, int dcolinc, int drowinc,
                  int srcPixels[], int srccols, int srcrows, int scolinc, int srowinc,
                  float weights[], float shadowColor[]);
@@ -34,11 +34,79 @@ import com.sun.scenario.effect.impl.sw.RendererDelegate;
 
 public class SSERendererDelegate implements RendererDelegate {
 
+    /**
+     * Kernel levels used by the native peers, see {@link #getSIMDLevel()}.
+     */
+    public static final int SIMD_SCALAR = 0;
+    public static final int SIMD_SSE2 = 1;
+    public static final int SIMD_AVX2 = 2;
+
     public static native boolean isSupported();
 
+    /**
+     * Returns the level of the kernels used by the native peers: the
+     * scalar loops, or the vectorized SSE2 or AVX2 kernels when the
+     * processor supports them.  All levels produce identical pixels.
+     */
+    public static native int getSIMDLevel();
+
+    /**
+     * Limits the native peers to the kernels of the given level and
+     * returns the level actually used, which is lower if the processor
+     * does not support the requested one.
+     */
+    public static native int setSIMDLevel(int level);
+
+    /**
+     * Lets the native blur and convolve peers split a filter pass into
+     * bands of rows or columns that are filtered by up to {@code threads}
+     * native threads.  Passes covering fewer than {@code threshold} pixels
+     * are always filtered on the calling thread, as are all passes when
+     * {@code threads} is 1.  The result does not depend on the settings.
+     */
+    public static synchronized void setParallelism(int threads, int threshold) {
+        parallelThreads = Math.max(threads, 1);
+        parallelThreshold = threshold;
+        nSetParallelism(parallelThreads, parallelThreshold);
+    }
+
+    public static synchronized int getParallelThreads() {
+        return parallelThreads;
+    }
+
+    public static synchronized int getParallelThreshold() {
+        return parallelThreshold;
+    }
+
+    private static int parallelThreads = 1;
+    private static int parallelThreshold = 0;
+
+    private static native void nSetParallelism(int threads, int threshold);
+
+    private static int getIntProperty(String name, int defaultValue) {
+        String value = System.getProperty(name);
+        if (value != null) {
+            try {
+                return Integer.parseInt(value.trim());
+            } catch (NumberFormatException e) {
+            }
+        }
+        return defaultValue;
+    }
+
     static {
         AccessController.doPrivileged((PrivilegedAction) () -> {
             NativeLibLoader.loadLibrary("decora_sse");
+            String level = System.getProperty("decora.simd.level");
+            if ("scalar".equals(level)) {
+                setSIMDLevel(SIMD_SCALAR);
+            } else if ("sse2".equals(level)) {
+                setSIMDLevel(SIMD_SSE2);
+            }
+            int threads = getIntProperty("decora.simd.threads",
+                Math.min(Runtime.getRuntime().availableProcessors(), 4));
+            int threshold = getIntProperty("decora.simd.threshold", 256 * 256);
+            setParallelism(threads, threshold);
             return null;
         });
     }
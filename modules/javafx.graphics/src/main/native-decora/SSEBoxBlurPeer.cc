@@ -29,9 +29,118 @@
  */
 
 #include <jni.h>
-#include "SSEUtils.h"
+#include "SSEKernels.h"
+#include "SSEWorkers.h"
 #include "com_sun_scenario_effect_impl_sw_sse_SSEBoxBlurPeer.h"
 
+struct BoxBlurPass {
+    jint *dstPixels;
+    jint dstw, dsth, dstscan;
+    jint *srcPixels;
+    jint srcw, srch, srcscan;
+};
+
+// Filters the rows [begin, end) of a horizontal pass.
+static void filterHorizontalBand(void *data, jint begin, jint end)
+{
+    BoxBlurPass *pass = (BoxBlurPass *) data;
+    jint *dstPixels = pass->dstPixels + begin * pass->dstscan;
+    jint dstw = pass->dstw;
+    jint dsth = end - begin;
+    jint dstscan = pass->dstscan;
+    jint *srcPixels = pass->srcPixels + begin * pass->srcscan;
+    jint srcw = pass->srcw;
+    jint srch = end - begin;
+    jint srcscan = pass->srcscan;
+
+    jint hsize = dstw - srcw + 1;
+    jint kscale = 0x7fffffff / (hsize * 255);
+    if (!boxBlurHorizontalSIMD(dstPixels, dstw, dsth, dstscan,
+                               srcPixels, srcw, srch, srcscan, kscale)) {
+        jint srcoff = 0;
+        jint dstoff = 0;
+        for (jint y = 0; y < dsth; y++) {
+            jint suma = 0;
+            jint sumr = 0;
+            jint sumg = 0;
+            jint sumb = 0;
+            for (jint x = 0; x < dstw; x++) {
+                jint rgb;
+                // Un-accumulate the data for col-hsize location into the sums.
+                rgb = (x >= hsize) ? srcPixels[srcoff + x - hsize] : 0;
+                suma -= (rgb >> 24) & 0xff;
+                sumr -= (rgb >> 16) & 0xff;
+                sumg -= (rgb >>  8) & 0xff;
+                sumb -= (rgb      ) & 0xff;
+                // Accumulate the data for this col location into the sums.
+                rgb = (x < srcw) ? srcPixels[srcoff + x] : 0;
+                suma += (rgb >> 24) & 0xff;
+                sumr += (rgb >> 16) & 0xff;
+                sumg += (rgb >>  8) & 0xff;
+                sumb += (rgb      ) & 0xff;
+                dstPixels[dstoff + x] =
+                    (((suma * kscale) >> 23) << 24) +
+                    (((sumr * kscale) >> 23) << 16) +
+                    (((sumg * kscale) >> 23) <<  8) +
+                    (((sumb * kscale) >> 23)      );
+            }
+            srcoff += srcscan;
+            dstoff += dstscan;
+        }
+    }
+}
+
+// Filters the columns [begin, end) of a vertical pass.
+static void filterVerticalBand(void *data, jint begin, jint end)
+{
+    BoxBlurPass *pass = (BoxBlurPass *) data;
+    jint *dstPixels = pass->dstPixels + begin;
+    jint dstw = end - begin;
+    jint dsth = pass->dsth;
+    jint dstscan = pass->dstscan;
+    jint *srcPixels = pass->srcPixels + begin;
+    jint srcw = end - begin;
+    jint srch = pass->srch;
+    jint srcscan = pass->srcscan;
+
+    jint vsize = dsth - srch + 1;
+    jint kscale = 0x7fffffff / (vsize * 255);
+    if (!boxBlurVerticalSIMD(dstPixels, dstw, dsth, dstscan,
+                             srcPixels, srcw, srch, srcscan, kscale)) {
+        jint voff = vsize * srcscan;
+        for (jint x = 0; x < dstw; x++) {
+            jint suma = 0;
+            jint sumr = 0;
+            jint sumg = 0;
+            jint sumb = 0;
+            jint srcoff = x;
+            jint dstoff = x;
+            for (jint y = 0; y < dsth; y++) {
+                jint rgb;
+                // Un-accumulate the data for row-vsize location into the sums.
+                rgb = (srcoff >= voff) ? srcPixels[srcoff - voff] : 0;
+                suma -= (rgb >> 24) & 0xff;
+                sumr -= (rgb >> 16) & 0xff;
+                sumg -= (rgb >>  8) & 0xff;
+                sumb -= (rgb      ) & 0xff;
+                // Accumulate the data for this col location into the sums.
+                rgb = (y < srch) ? srcPixels[srcoff] : 0;
+                suma += (rgb >> 24) & 0xff;
+                sumr += (rgb >> 16) & 0xff;
+                sumg += (rgb >>  8) & 0xff;
+                sumb += (rgb      ) & 0xff;
+                dstPixels[dstoff] =
+                    (((suma * kscale) >> 23) << 24) +
+                    (((sumr * kscale) >> 23) << 16) +
+                    (((sumg * kscale) >> 23) <<  8) +
+                    (((sumb * kscale) >> 23)      );
+                srcoff += srcscan;
+                dstoff += dstscan;
+            }
+        }
+    }
+}
+
 JNIEXPORT void JNICALL
 Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxBlurPeer_filterHorizontal
     (JNIEnv *env, jclass klass,
@@ -46,38 +155,11 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxBlurPeer_filterHorizontal
         return;
     }
 
-    jint hsize = dstw - srcw + 1;
-    jint kscale = 0x7fffffff / (hsize * 255);
-    jint srcoff = 0;
-    jint dstoff = 0;
-    for (jint y = 0; y < dsth; y++) {
-        jint suma = 0;
-        jint sumr = 0;
-        jint sumg = 0;
-        jint sumb = 0;
-        for (jint x = 0; x < dstw; x++) {
-            jint rgb;
-            // Un-accumulate the data for col-hsize location into the sums.
-            rgb = (x >= hsize) ? srcPixels[srcoff + x - hsize] : 0;
-            suma -= (rgb >> 24) & 0xff;
-            sumr -= (rgb >> 16) & 0xff;
-            sumg -= (rgb >>  8) & 0xff;
-            sumb -= (rgb      ) & 0xff;
-            // Accumulate the data for this col location into the sums.
-            rgb = (x < srcw) ? srcPixels[srcoff + x] : 0;
-            suma += (rgb >> 24) & 0xff;
-            sumr += (rgb >> 16) & 0xff;
-            sumg += (rgb >>  8) & 0xff;
-            sumb += (rgb      ) & 0xff;
-            dstPixels[dstoff + x] =
-                (((suma * kscale) >> 23) << 24) +
-                (((sumr * kscale) >> 23) << 16) +
-                (((sumg * kscale) >> 23) <<  8) +
-                (((sumb * kscale) >> 23)      );
-        }
-        srcoff += srcscan;
-        dstoff += dstscan;
-    }
+    BoxBlurPass pass = {
+        dstPixels, dstw, dsth, dstscan,
+        srcPixels, srcw, srch, srcscan
+    };
+    decoraRunBands(filterHorizontalBand, &pass, dsth, 1, dstw * dsth);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -97,39 +179,12 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxBlurPeer_filterVertical
         return;
     }
 
-    jint vsize = dsth - srch + 1;
-    jint kscale = 0x7fffffff / (vsize * 255);
-    jint voff = vsize * srcscan;
-    for (jint x = 0; x < dstw; x++) {
-        jint suma = 0;
-        jint sumr = 0;
-        jint sumg = 0;
-        jint sumb = 0;
-        jint srcoff = x;
-        jint dstoff = x;
-        for (jint y = 0; y < dsth; y++) {
-            jint rgb;
-            // Un-accumulate the data for row-vsize location into the sums.
-            rgb = (srcoff >= voff) ? srcPixels[srcoff - voff] : 0;
-            suma -= (rgb >> 24) & 0xff;
-            sumr -= (rgb >> 16) & 0xff;
-            sumg -= (rgb >>  8) & 0xff;
-            sumb -= (rgb      ) & 0xff;
-            // Accumulate the data for this col location into the sums.
-            rgb = (y < srch) ? srcPixels[srcoff] : 0;
-            suma += (rgb >> 24) & 0xff;
-            sumr += (rgb >> 16) & 0xff;
-            sumg += (rgb >>  8) & 0xff;
-            sumb += (rgb      ) & 0xff;
-            dstPixels[dstoff] =
-                (((suma * kscale) >> 23) << 24) +
-                (((sumr * kscale) >> 23) << 16) +
-                (((sumg * kscale) >> 23) <<  8) +
-                (((sumb * kscale) >> 23)      );
-            srcoff += srcscan;
-            dstoff += dstscan;
-        }
-    }
+    BoxBlurPass pass = {
+        dstPixels, dstw, dsth, dstscan,
+        srcPixels, srcw, srch, srcscan
+    };
+    // Column bands are kept a multiple of the widest vector kernel
+    decoraRunBands(filterVerticalBand, &pass, dstw, 8, dstw * dsth);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -29,9 +29,176 @@
  */
 
 #include <jni.h>
-#include "SSEUtils.h"
+#include "SSEKernels.h"
+#include "SSEWorkers.h"
 #include "com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer.h"
 
+struct BoxShadowPass {
+    jint *dstPixels;
+    jint dstw, dsth, dstscan;
+    jint *srcPixels;
+    jint srcw, srch, srcscan;
+    jfloat spread;
+    jfloat *shadowColor;
+};
+
+// Filters the rows [begin, end) of a horizontal pass.
+static void filterHorizontalBlackBand(void *data, jint begin, jint end)
+{
+    BoxShadowPass *pass = (BoxShadowPass *) data;
+    jint *dstPixels = pass->dstPixels + begin * pass->dstscan;
+    jint dstw = pass->dstw;
+    jint dsth = end - begin;
+    jint dstscan = pass->dstscan;
+    jint *srcPixels = pass->srcPixels + begin * pass->srcscan;
+    jint srcw = pass->srcw;
+    jint srch = end - begin;
+    jint srcscan = pass->srcscan;
+    jfloat spread = pass->spread;
+
+    jint hsize = dstw - srcw + 1;
+    // amax goes from hsize*255 to 255 as spread goes from 0 to 1
+    jint amax = hsize * 255;
+    amax += (jint) ((255 - amax) * spread);
+    jint kscale = 0x7fffffff / amax;
+    jint amin = (amax / 255);
+    if (!boxShadowHorizontalBlackSIMD(dstPixels, dstw, dsth, dstscan,
+                                      srcPixels, srcw, srch, srcscan,
+                                      kscale, amin, amax)) {
+        jint srcoff = 0;
+        jint dstoff = 0;
+        for (jint y = 0; y < dsth; y++) {
+            jint suma = 0;
+            for (jint x = 0; x < dstw; x++) {
+                jint rgb;
+                // Un-accumulate the data for col-hsize location into the sums.
+                rgb = (x >= hsize) ? srcPixels[srcoff + x - hsize] : 0;
+                suma -= (rgb >> 24) & 0xff;
+                // Accumulate the data for this col location into the sums.
+                rgb = (x < srcw) ? srcPixels[srcoff + x] : 0;
+                suma += (rgb >> 24) & 0xff;
+                // Clamp, scale and convert the sum into a color.
+                dstPixels[dstoff + x] =
+                    ((suma < amin) ? 0
+                     : ((suma >= amax) ? 0xff000000
+                        : (((suma * kscale) >> 23) << 24)));
+            }
+            srcoff += srcscan;
+            dstoff += dstscan;
+        }
+    }
+}
+
+// Filters the columns [begin, end) of a vertical pass.
+static void filterVerticalBlackBand(void *data, jint begin, jint end)
+{
+    BoxShadowPass *pass = (BoxShadowPass *) data;
+    jint *dstPixels = pass->dstPixels + begin;
+    jint dstw = end - begin;
+    jint dsth = pass->dsth;
+    jint dstscan = pass->dstscan;
+    jint *srcPixels = pass->srcPixels + begin;
+    jint srcw = end - begin;
+    jint srch = pass->srch;
+    jint srcscan = pass->srcscan;
+    jfloat spread = pass->spread;
+
+    jint vsize = dsth - srch + 1;
+    // amax goes from hsize*255 to 255 as spread goes from 0 to 1
+    jint amax = vsize * 255;
+    amax += (jint) ((255 - amax) * spread);
+    jint kscale = 0x7fffffff / amax;
+    jint amin = (amax / 255);
+    if (!boxShadowVerticalBlackSIMD(dstPixels, dstw, dsth, dstscan,
+                                    srcPixels, srcw, srch, srcscan,
+                                    kscale, amin, amax)) {
+        jint voff = vsize * srcscan;
+        for (jint x = 0; x < dstw; x++) {
+            jint suma = 0;
+            jint srcoff = x;
+            jint dstoff = x;
+            for (jint y = 0; y < dsth; y++) {
+                jint rgb;
+                // Un-accumulate the data for row-vsize location into the sums.
+                rgb = (srcoff >= voff) ? srcPixels[srcoff - voff] : 0;
+                suma -= (rgb >> 24) & 0xff;
+                // Accumulate the data for this row location into the sums.
+                rgb = (y < srch) ? srcPixels[srcoff] : 0;
+                suma += (rgb >> 24) & 0xff;
+                // Clamp, scale and convert the sum into a color.
+                dstPixels[dstoff] =
+                    ((suma < amin) ? 0
+                     : ((suma >= amax) ? 0xff000000
+                        : (((suma * kscale) >> 23) << 24)));
+                srcoff += srcscan;
+                dstoff += dstscan;
+            }
+        }
+    }
+}
+
+// Filters the columns [begin, end) of a vertical pass.
+static void filterVerticalBand(void *data, jint begin, jint end)
+{
+    BoxShadowPass *pass = (BoxShadowPass *) data;
+    jint *dstPixels = pass->dstPixels + begin;
+    jint dstw = end - begin;
+    jint dsth = pass->dsth;
+    jint dstscan = pass->dstscan;
+    jint *srcPixels = pass->srcPixels + begin;
+    jint srcw = end - begin;
+    jint srch = pass->srch;
+    jint srcscan = pass->srcscan;
+    jfloat spread = pass->spread;
+    jfloat *shadowColor = pass->shadowColor;
+
+    jint vsize = dsth - srch + 1;
+    // amax goes from hsize*255 to 255 as spread goes from 0 to 1
+    jint amax = vsize * 255;
+    amax += (jint) ((255 - amax) * spread);
+    jint kscalea = 0x7fffffff / amax;
+    jint kscaler = (jint) (kscalea * shadowColor[0]);
+    jint kscaleg = (jint) (kscalea * shadowColor[1]);
+    jint kscaleb = (jint) (kscalea * shadowColor[2]);
+    kscalea = (jint) (kscalea * shadowColor[3]);
+    jint amin = (amax / 255);
+    jint voff = vsize * srcscan;
+    jint shadowRGB =
+        (((jint) (shadowColor[0] * 255)) << 16) |
+        (((jint) (shadowColor[1] * 255)) <<  8) |
+        (((jint) (shadowColor[2] * 255))      ) |
+        (((jint) (shadowColor[3] * 255)) << 24);
+    jint kscales[4] = { kscalea, kscaler, kscaleg, kscaleb };
+    if (!boxShadowVerticalSIMD(dstPixels, dstw, dsth, dstscan,
+                               srcPixels, srcw, srch, srcscan,
+                               kscales, amin, amax, shadowRGB)) {
+        for (jint x = 0; x < dstw; x++) {
+            jint suma = 0;
+            jint srcoff = x;
+            jint dstoff = x;
+            for (jint y = 0; y < dsth; y++) {
+                jint rgb;
+                // Un-accumulate the data for row-vsize location into the sums.
+                rgb = (srcoff >= voff) ? srcPixels[srcoff - voff] : 0;
+                suma -= (rgb >> 24) & 0xff;
+                // Accumulate the data for this row location into the sums.
+                rgb = (y < srch) ? srcPixels[srcoff] : 0;
+                suma += (rgb >> 24) & 0xff;
+                // Clamp, scale and convert the sum into a color.
+                dstPixels[dstoff] =
+                    ((suma < amin) ? 0
+                     : ((suma >= amax) ? shadowRGB
+                        : ((((suma * kscalea) >> 23) << 24) |
+                           (((suma * kscaler) >> 23) << 16) |
+                           (((suma * kscaleg) >> 23) <<  8) |
+                           (((suma * kscaleb) >> 23)      ))));
+                srcoff += srcscan;
+                dstoff += dstscan;
+            }
+        }
+    }
+}
+
 JNIEXPORT void JNICALL
 Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer_filterHorizontalBlack
     (JNIEnv *env, jclass klass,
@@ -47,33 +214,12 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer_filterHorizontalBlack
         return;
     }
 
-    jint hsize = dstw - srcw + 1;
-    // amax goes from hsize*255 to 255 as spread goes from 0 to 1
-    jint amax = hsize * 255;
-    amax += (jint) ((255 - amax) * spread);
-    jint kscale = 0x7fffffff / amax;
-    jint amin = (amax / 255);
-    jint srcoff = 0;
-    jint dstoff = 0;
-    for (jint y = 0; y < dsth; y++) {
-        jint suma = 0;
-        for (jint x = 0; x < dstw; x++) {
-            jint rgb;
-            // Un-accumulate the data for col-hsize location into the sums.
-            rgb = (x >= hsize) ? srcPixels[srcoff + x - hsize] : 0;
-            suma -= (rgb >> 24) & 0xff;
-            // Accumulate the data for this col location into the sums.
-            rgb = (x < srcw) ? srcPixels[srcoff + x] : 0;
-            suma += (rgb >> 24) & 0xff;
-            // Clamp, scale and convert the sum into a color.
-            dstPixels[dstoff + x] =
-                ((suma < amin) ? 0
-                 : ((suma >= amax) ? 0xff000000
-                    : (((suma * kscale) >> 23) << 24)));
-        }
-        srcoff += srcscan;
-        dstoff += dstscan;
-    }
+    BoxShadowPass pass = {
+        dstPixels, dstw, dsth, dstscan,
+        srcPixels, srcw, srch, srcscan,
+        spread, NULL
+    };
+    decoraRunBands(filterHorizontalBlackBand, &pass, dsth, 1, dstw * dsth);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -94,34 +240,13 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer_filterVerticalBlack
         return;
     }
 
-    jint vsize = dsth - srch + 1;
-    // amax goes from hsize*255 to 255 as spread goes from 0 to 1
-    jint amax = vsize * 255;
-    amax += (jint) ((255 - amax) * spread);
-    jint kscale = 0x7fffffff / amax;
-    jint amin = (amax / 255);
-    jint voff = vsize * srcscan;
-    for (jint x = 0; x < dstw; x++) {
-        jint suma = 0;
-        jint srcoff = x;
-        jint dstoff = x;
-        for (jint y = 0; y < dsth; y++) {
-            jint rgb;
-            // Un-accumulate the data for row-vsize location into the sums.
-            rgb = (srcoff >= voff) ? srcPixels[srcoff - voff] : 0;
-            suma -= (rgb >> 24) & 0xff;
-            // Accumulate the data for this row location into the sums.
-            rgb = (y < srch) ? srcPixels[srcoff] : 0;
-            suma += (rgb >> 24) & 0xff;
-            // Clamp, scale and convert the sum into a color.
-            dstPixels[dstoff] =
-                ((suma < amin) ? 0
-                 : ((suma >= amax) ? 0xff000000
-                    : (((suma * kscale) >> 23) << 24)));
-            srcoff += srcscan;
-            dstoff += dstscan;
-        }
-    }
+    BoxShadowPass pass = {
+        dstPixels, dstw, dsth, dstscan,
+        srcPixels, srcw, srch, srcscan,
+        spread, NULL
+    };
+    // Column bands are kept a multiple of the widest vector kernel
+    decoraRunBands(filterVerticalBlackBand, &pass, dstw, 8, dstw * dsth);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -145,46 +270,13 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer_filterVertical
         return;
     }
 
-    jint vsize = dsth - srch + 1;
-    // amax goes from hsize*255 to 255 as spread goes from 0 to 1
-    jint amax = vsize * 255;
-    amax += (jint) ((255 - amax) * spread);
-    jint kscalea = 0x7fffffff / amax;
-    jint kscaler = (jint) (kscalea * shadowColor[0]);
-    jint kscaleg = (jint) (kscalea * shadowColor[1]);
-    jint kscaleb = (jint) (kscalea * shadowColor[2]);
-    kscalea = (jint) (kscalea * shadowColor[3]);
-    jint amin = (amax / 255);
-    jint voff = vsize * srcscan;
-    jint shadowRGB =
-        (((jint) (shadowColor[0] * 255)) << 16) |
-        (((jint) (shadowColor[1] * 255)) <<  8) |
-        (((jint) (shadowColor[2] * 255))      ) |
-        (((jint) (shadowColor[3] * 255)) << 24);
-    for (jint x = 0; x < dstw; x++) {
-        jint suma = 0;
-        jint srcoff = x;
-        jint dstoff = x;
-        for (jint y = 0; y < dsth; y++) {
-            jint rgb;
-            // Un-accumulate the data for row-vsize location into the sums.
-            rgb = (srcoff >= voff) ? srcPixels[srcoff - voff] : 0;
-            suma -= (rgb >> 24) & 0xff;
-            // Accumulate the data for this row location into the sums.
-            rgb = (y < srch) ? srcPixels[srcoff] : 0;
-            suma += (rgb >> 24) & 0xff;
-            // Clamp, scale and convert the sum into a color.
-            dstPixels[dstoff] =
-                ((suma < amin) ? 0
-                 : ((suma >= amax) ? shadowRGB
-                    : ((((suma * kscalea) >> 23) << 24) |
-                       (((suma * kscaler) >> 23) << 16) |
-                       (((suma * kscaleg) >> 23) <<  8) |
-                       (((suma * kscaleb) >> 23)      ))));
-            srcoff += srcscan;
-            dstoff += dstscan;
-        }
-    }
+    BoxShadowPass pass = {
+        dstPixels, dstw, dsth, dstscan,
+        srcPixels, srcw, srch, srcscan,
+        spread, shadowColor
+    };
+    // Column bands are kept a multiple of the widest vector kernel
+    decoraRunBands(filterVerticalBand, &pass, dstw, 8, dstw * dsth);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -0,0 +1,440 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "SSEKernels.h"
+
+#ifdef DECORA_SSE2
+#include <emmintrin.h>
+
+#define cmin 1.0f
+#define cmax (255.0f - 1.0f/32.0f)
+
+// Unpacks an ARGB pixel into four 32-bit lanes holding b, g, r, a.
+static inline __m128i unpackPixel(jint rgb)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(rgb), zero);
+    return _mm_unpacklo_epi16(v, zero);
+}
+
+// Packs four b, g, r, a lanes in the range 0-255 back into an ARGB pixel.
+static inline jint packPixel(__m128i v)
+{
+    v = _mm_packs_epi32(v, v);
+    v = _mm_packus_epi16(v, v);
+    return _mm_cvtsi128_si32(v);
+}
+
+// SSE2 has no 32-bit multiply keeping the low halves of the products, so
+// multiply the even and odd lanes separately and interleave the results.
+static inline __m128i mullo32(__m128i a, __m128i b)
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// (sum * kscale) >> 23 for each lane, as the scalar loops compute it.
+static inline __m128i scale(__m128i sum, __m128i kscale)
+{
+    return _mm_srai_epi32(mullo32(sum, kscale), 23);
+}
+
+// Clamps and scales alpha sums into black shadow pixels.
+static inline __m128i shadowBlack(__m128i suma, __m128i kscale,
+                                  __m128i amin, __m128i amax)
+{
+    __m128i v = _mm_slli_epi32(scale(suma, kscale), 24);
+    __m128i inrange = _mm_cmplt_epi32(suma, amax);
+    v = _mm_or_si128(_mm_and_si128(inrange, v),
+                     _mm_andnot_si128(inrange, _mm_set1_epi32(0xff000000)));
+    return _mm_andnot_si128(_mm_cmplt_epi32(suma, amin), v);
+}
+
+// Clamps and scales alpha sums into pixels of the shadow color.
+static inline __m128i shadowColor(__m128i suma, const __m128i *kscales,
+                                  __m128i amin, __m128i amax, __m128i shadowRGB)
+{
+    __m128i v = _mm_or_si128(
+        _mm_or_si128(_mm_slli_epi32(scale(suma, kscales[0]), 24),
+                     _mm_slli_epi32(scale(suma, kscales[1]), 16)),
+        _mm_or_si128(_mm_slli_epi32(scale(suma, kscales[2]),  8),
+                     scale(suma, kscales[3])));
+    __m128i inrange = _mm_cmplt_epi32(suma, amax);
+    v = _mm_or_si128(_mm_and_si128(inrange, v),
+                     _mm_andnot_si128(inrange, shadowRGB));
+    return _mm_andnot_si128(_mm_cmplt_epi32(suma, amin), v);
+}
+
+// Converts channel sums into bytes with the cmin/cmax clamping of the
+// LinearConvolve peers.
+static inline __m128i clampSums(__m128 sum)
+{
+    __m128i v = _mm_cvttps_epi32(sum);
+    __m128i over = _mm_castps_si128(_mm_cmpgt_ps(sum, _mm_set1_ps(cmax)));
+    v = _mm_or_si128(_mm_andnot_si128(over, v),
+                     _mm_and_si128(over, _mm_set1_epi32(255)));
+    return _mm_andnot_si128(_mm_castps_si128(_mm_cmplt_ps(sum, _mm_set1_ps(cmin))), v);
+}
+
+jboolean boxBlurHorizontalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                           jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                           jint kscale)
+{
+    // The running sums of a row depend on each other, so the four color
+    // channels of one pixel are processed together instead.
+    jint hsize = dstw - srcw + 1;
+    __m128i vkscale = _mm_set1_epi32(kscale);
+    for (jint y = 0; y < dsth; y++) {
+        jint *src = srcPixels + y * srcscan;
+        jint *dst = dstPixels + y * dstscan;
+        __m128i sum = _mm_setzero_si128();
+        for (jint x = 0; x < dstw; x++) {
+            if (x >= hsize) {
+                sum = _mm_sub_epi32(sum, unpackPixel(src[x - hsize]));
+            }
+            if (x < srcw) {
+                sum = _mm_add_epi32(sum, unpackPixel(src[x]));
+            }
+            dst[x] = packPixel(scale(sum, vkscale));
+        }
+    }
+    return JNI_TRUE;
+}
+
+jboolean boxBlurVerticalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                             jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                             jint kscale)
+{
+    // Walking down the columns one at a time touches a new cache line for
+    // every pixel, so the rows are swept instead while keeping the channel
+    // sums of every column in a buffer.  Groups of 4 columns are unpacked
+    // into 4 registers; the last dstw % 4 columns are done one at a time.
+    __m128i *sums = (__m128i *) _mm_malloc(dstw * sizeof(__m128i), 16);
+    if (sums == NULL) return JNI_FALSE;
+    __m128i zero = _mm_setzero_si128();
+    for (jint x = 0; x < dstw; x++) {
+        sums[x] = zero;
+    }
+    jint vsize = dsth - srch + 1;
+    jint w4 = dstw & ~3;
+    __m128i vkscale = _mm_set1_epi32(kscale);
+    for (jint y = 0; y < dsth; y++) {
+        jint *sub = (y >= vsize) ? srcPixels + (y - vsize) * srcscan : NULL;
+        jint *add = (y < srch) ? srcPixels + y * srcscan : NULL;
+        jint *dst = dstPixels + y * dstscan;
+        jint x = 0;
+        for (; x < w4; x += 4) {
+            __m128i sum0 = sums[x + 0];
+            __m128i sum1 = sums[x + 1];
+            __m128i sum2 = sums[x + 2];
+            __m128i sum3 = sums[x + 3];
+            __m128i p, lo, hi;
+            if (sub != NULL) {
+                p = _mm_loadu_si128((__m128i *) (sub + x));
+                lo = _mm_unpacklo_epi8(p, zero);
+                hi = _mm_unpackhi_epi8(p, zero);
+                sum0 = _mm_sub_epi32(sum0, _mm_unpacklo_epi16(lo, zero));
+                sum1 = _mm_sub_epi32(sum1, _mm_unpackhi_epi16(lo, zero));
+                sum2 = _mm_sub_epi32(sum2, _mm_unpacklo_epi16(hi, zero));
+                sum3 = _mm_sub_epi32(sum3, _mm_unpackhi_epi16(hi, zero));
+            }
+            if (add != NULL) {
+                p = _mm_loadu_si128((__m128i *) (add + x));
+                lo = _mm_unpacklo_epi8(p, zero);
+                hi = _mm_unpackhi_epi8(p, zero);
+                sum0 = _mm_add_epi32(sum0, _mm_unpacklo_epi16(lo, zero));
+                sum1 = _mm_add_epi32(sum1, _mm_unpackhi_epi16(lo, zero));
+                sum2 = _mm_add_epi32(sum2, _mm_unpacklo_epi16(hi, zero));
+                sum3 = _mm_add_epi32(sum3, _mm_unpackhi_epi16(hi, zero));
+            }
+            sums[x + 0] = sum0;
+            sums[x + 1] = sum1;
+            sums[x + 2] = sum2;
+            sums[x + 3] = sum3;
+            lo = _mm_packs_epi32(scale(sum0, vkscale), scale(sum1, vkscale));
+            hi = _mm_packs_epi32(scale(sum2, vkscale), scale(sum3, vkscale));
+            _mm_storeu_si128((__m128i *) (dst + x), _mm_packus_epi16(lo, hi));
+        }
+        for (; x < dstw; x++) {
+            __m128i sum = sums[x];
+            if (sub != NULL) {
+                sum = _mm_sub_epi32(sum, unpackPixel(sub[x]));
+            }
+            if (add != NULL) {
+                sum = _mm_add_epi32(sum, unpackPixel(add[x]));
+            }
+            sums[x] = sum;
+            dst[x] = packPixel(scale(sum, vkscale));
+        }
+    }
+    _mm_free(sums);
+    return JNI_TRUE;
+}
+
+jboolean boxShadowHorizontalBlackSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                  jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                                  jint kscale, jint amin, jint amax)
+{
+    // Only alpha is summed, so run 4 rows side by side instead.  A last
+    // group of fewer than 4 rows repeats the bottom row, which just stores
+    // the same pixels twice.
+    jint hsize = dstw - srcw + 1;
+    __m128i vkscale = _mm_set1_epi32(kscale);
+    __m128i vamin = _mm_set1_epi32(amin);
+    __m128i vamax = _mm_set1_epi32(amax);
+    for (jint y = 0; y < dsth; y += 4) {
+        jint *src[4];
+        jint *dst[4];
+        for (jint i = 0; i < 4; i++) {
+            jint row = (y + i < dsth) ? y + i : dsth - 1;
+            src[i] = srcPixels + row * srcscan;
+            dst[i] = dstPixels + row * dstscan;
+        }
+        __m128i suma = _mm_setzero_si128();
+        for (jint x = 0; x < dstw; x++) {
+            if (x >= hsize) {
+                jint i = x - hsize;
+                suma = _mm_sub_epi32(suma, _mm_srli_epi32(
+                    _mm_setr_epi32(src[0][i], src[1][i], src[2][i], src[3][i]), 24));
+            }
+            if (x < srcw) {
+                suma = _mm_add_epi32(suma, _mm_srli_epi32(
+                    _mm_setr_epi32(src[0][x], src[1][x], src[2][x], src[3][x]), 24));
+            }
+            __m128i v = shadowBlack(suma, vkscale, vamin, vamax);
+            dst[0][x] = _mm_cvtsi128_si32(v);
+            dst[1][x] = _mm_cvtsi128_si32(_mm_srli_si128(v, 4));
+            dst[2][x] = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+            dst[3][x] = _mm_cvtsi128_si32(_mm_srli_si128(v, 12));
+        }
+    }
+    return JNI_TRUE;
+}
+
+/*
+ * Shared by the two vertical shadow passes, which only differ in the color
+ * of the output: kscales is NULL for black.  As in boxBlurVerticalSSE2 the
+ * rows are swept with the alpha sums of every column kept in a buffer, 4
+ * columns per register and one per register for the last dstw % 4.
+ */
+static jboolean shadowVerticalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                   jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                                   jint kscale, jint *kscales,
+                                   jint amin, jint amax, jint shadowRGB)
+{
+    jint w4 = dstw & ~3;
+    jint count = w4 / 4 + (dstw - w4);
+    __m128i *sums = (__m128i *) _mm_malloc(count * sizeof(__m128i), 16);
+    if (sums == NULL) return JNI_FALSE;
+    for (jint i = 0; i < count; i++) {
+        sums[i] = _mm_setzero_si128();
+    }
+    jint vsize = dsth - srch + 1;
+    __m128i vkscales[4];
+    if (kscales != NULL) {
+        for (jint i = 0; i < 4; i++) {
+            vkscales[i] = _mm_set1_epi32(kscales[i]);
+        }
+    }
+    __m128i vkscale = _mm_set1_epi32(kscale);
+    __m128i vamin = _mm_set1_epi32(amin);
+    __m128i vamax = _mm_set1_epi32(amax);
+    __m128i vshadowRGB = _mm_set1_epi32(shadowRGB);
+    for (jint y = 0; y < dsth; y++) {
+        jint *sub = (y >= vsize) ? srcPixels + (y - vsize) * srcscan : NULL;
+        jint *add = (y < srch) ? srcPixels + y * srcscan : NULL;
+        jint *dst = dstPixels + y * dstscan;
+        jint x = 0;
+        for (; x < w4; x += 4) {
+            __m128i *suma = sums + x / 4;
+            __m128i sum = *suma;
+            if (sub != NULL) {
+                sum = _mm_sub_epi32(sum, _mm_srli_epi32(
+                    _mm_loadu_si128((__m128i *) (sub + x)), 24));
+            }
+            if (add != NULL) {
+                sum = _mm_add_epi32(sum, _mm_srli_epi32(
+                    _mm_loadu_si128((__m128i *) (add + x)), 24));
+            }
+            *suma = sum;
+            _mm_storeu_si128((__m128i *) (dst + x), (kscales == NULL)
+                ? shadowBlack(sum, vkscale, vamin, vamax)
+                : shadowColor(sum, vkscales, vamin, vamax, vshadowRGB));
+        }
+        for (; x < dstw; x++) {
+            __m128i *suma = sums + w4 / 4 + (x - w4);
+            __m128i sum = *suma;
+            if (sub != NULL) {
+                sum = _mm_sub_epi32(sum, _mm_srli_epi32(_mm_cvtsi32_si128(sub[x]), 24));
+            }
+            if (add != NULL) {
+                sum = _mm_add_epi32(sum, _mm_srli_epi32(_mm_cvtsi32_si128(add[x]), 24));
+            }
+            *suma = sum;
+            dst[x] = _mm_cvtsi128_si32((kscales == NULL)
+                ? shadowBlack(sum, vkscale, vamin, vamax)
+                : shadowColor(sum, vkscales, vamin, vamax, vshadowRGB));
+        }
+    }
+    _mm_free(sums);
+    return JNI_TRUE;
+}
+
+jboolean boxShadowVerticalBlackSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                    jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                                    jint kscale, jint amin, jint amax)
+{
+    return shadowVerticalSSE2(dstPixels, dstw, dsth, dstscan,
+                              srcPixels, srcw, srch, srcscan,
+                              kscale, NULL, amin, amax, 0);
+}
+
+jboolean boxShadowVerticalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                               jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                               jint *kscales, jint amin, jint amax, jint shadowRGB)
+{
+    return shadowVerticalSSE2(dstPixels, dstw, dsth, dstscan,
+                              srcPixels, srcw, srch, srcscan,
+                              0, kscales, amin, amax, shadowRGB);
+}
+
+jboolean linearConvolveHVSSE2(jint *dstPixels, jint dstcols, jint dstrows, jint dcolinc, jint drowinc,
+                          jint *srcPixels, jint srccols, jint srcrows, jint scolinc, jint srowinc,
+                          jfloat *kvals, jint kernelSize)
+{
+    // One register per kernel tap holding the 4 components of the pixel,
+    // so each lane adds up its products in the order the scalar loop does.
+    __m128 cvals[128];
+    jint dstrow = 0;
+    jint srcrow = 0;
+    for (jint r = 0; r < dstrows; r++) {
+        jint dstoff = dstrow;
+        jint srcoff = srcrow;
+        for (jint i = 0; i < kernelSize; i++) {
+            cvals[i] = _mm_setzero_ps();
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            jint rgb = (c < srccols) ? srcPixels[srcoff] : 0;
+            cvals[kernelSize - koff] = _mm_cvtepi32_ps(unpackPixel(rgb));
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            jfloat *factors = kvals + koff;
+            __m128 sum = _mm_setzero_ps();
+            for (jint i = 0; i < kernelSize; i++) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(cvals[i], _mm_set1_ps(factors[i])));
+            }
+            dstPixels[dstoff] = packPixel(clampSums(sum));
+            dstoff += dcolinc;
+            srcoff += scolinc;
+        }
+        dstrow += drowinc;
+        srcrow += srowinc;
+    }
+    return JNI_TRUE;
+}
+
+#endif /* DECORA_SSE2 */
+
+#if defined(DECORA_SSE2) && defined(DECORA_AVX2)
+#define DISPATCH_AVX2(name, args) \
+    if (decoraSIMDLevel() >= DECORA_SIMD_AVX2) { \
+        return name##AVX2 args; \
+    }
+#else
+#define DISPATCH_AVX2(name, args)
+#endif
+
+#ifdef DECORA_SSE2
+#define DISPATCH_SSE2(name, args) \
+    if (decoraSIMDLevel() >= DECORA_SIMD_SSE2) { \
+        return name##SSE2 args; \
+    }
+#else
+#define DISPATCH_SSE2(name, args)
+#endif
+
+#define DISPATCH(name, args) \
+    DISPATCH_AVX2(name, args) \
+    DISPATCH_SSE2(name, args) \
+    return JNI_FALSE
+
+jboolean boxBlurHorizontalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                               jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                               jint kscale)
+{
+    DISPATCH(boxBlurHorizontal, (dstPixels, dstw, dsth, dstscan,
+                                 srcPixels, srcw, srch, srcscan, kscale));
+}
+
+jboolean boxBlurVerticalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                             jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                             jint kscale)
+{
+    DISPATCH(boxBlurVertical, (dstPixels, dstw, dsth, dstscan,
+                               srcPixels, srcw, srch, srcscan, kscale));
+}
+
+jboolean boxShadowHorizontalBlackSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                      jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                                      jint kscale, jint amin, jint amax)
+{
+    // There is no AVX2 kernel for this pass, gathering the alpha of 8 rows
+    // costs more than the wider arithmetic saves.
+    DISPATCH_SSE2(boxShadowHorizontalBlack, (dstPixels, dstw, dsth, dstscan,
+                                             srcPixels, srcw, srch, srcscan,
+                                             kscale, amin, amax))
+    return JNI_FALSE;
+}
+
+jboolean boxShadowVerticalBlackSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                    jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                                    jint kscale, jint amin, jint amax)
+{
+    DISPATCH(boxShadowVerticalBlack, (dstPixels, dstw, dsth, dstscan,
+                                      srcPixels, srcw, srch, srcscan,
+                                      kscale, amin, amax));
+}
+
+jboolean boxShadowVerticalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                               jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                               jint *kscales, jint amin, jint amax, jint shadowRGB)
+{
+    DISPATCH(boxShadowVertical, (dstPixels, dstw, dsth, dstscan,
+                                 srcPixels, srcw, srch, srcscan,
+                                 kscales, amin, amax, shadowRGB));
+}
+
+jboolean linearConvolveHVSIMD(jint *dstPixels, jint dstcols, jint dstrows, jint dcolinc, jint drowinc,
+                              jint *srcPixels, jint srccols, jint srcrows, jint scolinc, jint srowinc,
+                              jfloat *kvals, jint kernelSize)
+{
+    DISPATCH(linearConvolveHV, (dstPixels, dstcols, dstrows, dcolinc, drowinc,
+                                srcPixels, srccols, srcrows, scolinc, srowinc,
+                                kvals, kernelSize));
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef _Included_SSEKernels
+#define _Included_SSEKernels
+
+#include <jni.h>
+#include "SSEUtils.h"
+
+/*
+ * Vectorized versions of the SSE peer filter loops.
+ *
+ * Each of the functions below runs the filter with the best kernel for
+ * the current decoraSIMDLevel() and returns JNI_TRUE, or returns JNI_FALSE
+ * without touching dstPixels if only the scalar loop in the peer is
+ * available.  The kernels produce exactly the same pixels as the scalar
+ * loops: integer kernels use the same 32-bit arithmetic and the float
+ * kernels keep one color channel per lane and add the taps in the same
+ * order.
+ */
+
+jboolean boxBlurHorizontalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                               jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                               jint kscale);
+
+jboolean boxBlurVerticalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                             jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                             jint kscale);
+
+jboolean boxShadowHorizontalBlackSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                      jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                                      jint kscale, jint amin, jint amax);
+
+jboolean boxShadowVerticalBlackSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                    jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                                    jint kscale, jint amin, jint amax);
+
+// kscales holds the a, r, g, b scale factors, in that order.
+jboolean boxShadowVerticalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                               jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                               jint *kscales, jint amin, jint amax, jint shadowRGB);
+
+jboolean linearConvolveHVSIMD(jint *dstPixels, jint dstcols, jint dstrows, jint dcolinc, jint drowinc,
+                              jint *srcPixels, jint srccols, jint srcrows, jint scolinc, jint srowinc,
+                              jfloat *kvals, jint kernelSize);
+
+#ifdef DECORA_SSE2
+
+/*
+ * The individual kernels, only used by the functions above.  The *AVX2
+ * variants are compiled for AVX2 on their own and must only be called
+ * once the processor has been checked.  The vertical passes need a row of
+ * column sums and return JNI_FALSE if it cannot be allocated.
+ */
+
+jboolean boxBlurHorizontalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                           jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                           jint kscale);
+jboolean boxBlurVerticalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                         jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                         jint kscale);
+jboolean boxShadowHorizontalBlackSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                  jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                                  jint kscale, jint amin, jint amax);
+jboolean boxShadowVerticalBlackSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                                jint kscale, jint amin, jint amax);
+jboolean boxShadowVerticalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                           jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                           jint *kscales, jint amin, jint amax, jint shadowRGB);
+jboolean linearConvolveHVSSE2(jint *dstPixels, jint dstcols, jint dstrows, jint dcolinc, jint drowinc,
+                          jint *srcPixels, jint srccols, jint srcrows, jint scolinc, jint srowinc,
+                          jfloat *kvals, jint kernelSize);
+
+#ifdef DECORA_AVX2
+jboolean boxBlurHorizontalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                           jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                           jint kscale);
+jboolean boxBlurVerticalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                         jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                         jint kscale);
+jboolean boxShadowVerticalBlackAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                                jint kscale, jint amin, jint amax);
+jboolean boxShadowVerticalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                           jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                           jint *kscales, jint amin, jint amax, jint shadowRGB);
+jboolean linearConvolveHVAVX2(jint *dstPixels, jint dstcols, jint dstrows, jint dcolinc, jint drowinc,
+                          jint *srcPixels, jint srccols, jint srcrows, jint scolinc, jint srowinc,
+                          jfloat *kvals, jint kernelSize);
+#endif /* DECORA_AVX2 */
+
+#endif /* DECORA_SSE2 */
+
+#endif /* _Included_SSEKernels */
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * AVX2 kernels.  This file is compiled with the same flags as the rest of
+ * the library, so on gcc and clang every function here is compiled for
+ * AVX2 with a target attribute, and they are only called once
+ * decoraSIMDLevel() has reported AVX2 support.
+ */
+
+#include "SSEKernels.h"
+
+#if defined(DECORA_SSE2) && defined(DECORA_AVX2)
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+#define cmin 1.0f
+#define cmax (255.0f - 1.0f/32.0f)
+
+// Unpacks a pixel from each of two rows into the b, g, r, a lanes of the
+// low and high halves.
+AVX2_TARGET
+static inline __m256i unpackPixels(jint rgb0, jint rgb1)
+{
+    return _mm256_cvtepu8_epi32(_mm_unpacklo_epi32(_mm_cvtsi32_si128(rgb0),
+                                                    _mm_cvtsi32_si128(rgb1)));
+}
+
+// Packs the low and high halves of v back into two ARGB pixels.
+AVX2_TARGET
+static inline void packPixels(__m256i v, jint *rgb0, jint *rgb1)
+{
+    __m128i p = _mm_packs_epi32(_mm256_castsi256_si128(v),
+                                _mm256_extracti128_si256(v, 1));
+    p = _mm_packus_epi16(p, p);
+    *rgb0 = _mm_cvtsi128_si32(p);
+    *rgb1 = _mm_cvtsi128_si32(_mm_srli_si128(p, 4));
+}
+
+AVX2_TARGET
+static inline __m256i scale(__m256i sum, __m256i kscale)
+{
+    return _mm256_srai_epi32(_mm256_mullo_epi32(sum, kscale), 23);
+}
+
+AVX2_TARGET
+static inline __m256i shadowBlack(__m256i suma, __m256i kscale,
+                                  __m256i amin, __m256i amax)
+{
+    __m256i v = _mm256_slli_epi32(scale(suma, kscale), 24);
+    v = _mm256_blendv_epi8(_mm256_set1_epi32(0xff000000), v,
+                           _mm256_cmpgt_epi32(amax, suma));
+    return _mm256_andnot_si256(_mm256_cmpgt_epi32(amin, suma), v);
+}
+
+AVX2_TARGET
+static inline __m256i shadowColor(__m256i suma, const __m256i *kscales,
+                                  __m256i amin, __m256i amax, __m256i shadowRGB)
+{
+    __m256i v = _mm256_or_si256(
+        _mm256_or_si256(_mm256_slli_epi32(scale(suma, kscales[0]), 24),
+                        _mm256_slli_epi32(scale(suma, kscales[1]), 16)),
+        _mm256_or_si256(_mm256_slli_epi32(scale(suma, kscales[2]),  8),
+                        scale(suma, kscales[3])));
+    v = _mm256_blendv_epi8(shadowRGB, v, _mm256_cmpgt_epi32(amax, suma));
+    return _mm256_andnot_si256(_mm256_cmpgt_epi32(amin, suma), v);
+}
+
+AVX2_TARGET
+static inline __m256i loadAlpha(const jint *pixels)
+{
+    return _mm256_srli_epi32(_mm256_loadu_si256((const __m256i *) pixels), 24);
+}
+
+AVX2_TARGET
+jboolean boxBlurHorizontalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                           jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                           jint kscale)
+{
+    // Two rows at a time, one in each half of the register.
+    jint hsize = dstw - srcw + 1;
+    __m256i vkscale = _mm256_set1_epi32(kscale);
+    jint y = 0;
+    for (; y + 2 <= dsth; y += 2) {
+        jint *src0 = srcPixels + y * srcscan;
+        jint *src1 = src0 + srcscan;
+        jint *dst0 = dstPixels + y * dstscan;
+        jint *dst1 = dst0 + dstscan;
+        __m256i sum = _mm256_setzero_si256();
+        for (jint x = 0; x < dstw; x++) {
+            if (x >= hsize) {
+                sum = _mm256_sub_epi32(sum, unpackPixels(src0[x - hsize], src1[x - hsize]));
+            }
+            if (x < srcw) {
+                sum = _mm256_add_epi32(sum, unpackPixels(src0[x], src1[x]));
+            }
+            packPixels(scale(sum, vkscale), dst0 + x, dst1 + x);
+        }
+    }
+    if (y < dsth) {
+        return boxBlurHorizontalSSE2(dstPixels + y * dstscan, dstw, dsth - y, dstscan,
+                                     srcPixels + y * srcscan, srcw, srch - y, srcscan,
+                                     kscale);
+    }
+    return JNI_TRUE;
+}
+
+AVX2_TARGET
+jboolean boxBlurVerticalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                             jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                             jint kscale)
+{
+    // Rows are swept with the channel sums of every column kept in a
+    // buffer, as in boxBlurVerticalSSE2, 8 columns at a time and two pixels
+    // per register.  The packs work within 128-bit halves, which leaves the
+    // pixels in the order 0 2 4 6 1 3 5 7 before the final permute.  The
+    // last dstw % 8 columns are left to the SSE2 kernel.
+    jint w8 = dstw & ~7;
+    if (w8 > 0) {
+        __m256i *sums = (__m256i *) _mm_malloc(w8 / 2 * sizeof(__m256i), 32);
+        if (sums == NULL) return JNI_FALSE;
+        __m256i zero = _mm256_setzero_si256();
+        for (jint i = 0; i < w8 / 2; i++) {
+            sums[i] = zero;
+        }
+        jint vsize = dsth - srch + 1;
+        __m256i vkscale = _mm256_set1_epi32(kscale);
+        __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        for (jint y = 0; y < dsth; y++) {
+            jint *sub = (y >= vsize) ? srcPixels + (y - vsize) * srcscan : NULL;
+            jint *add = (y < srch) ? srcPixels + y * srcscan : NULL;
+            jint *dst = dstPixels + y * dstscan;
+            for (jint x = 0; x < w8; x += 8) {
+                __m256i *sum = sums + x / 2;
+                __m256i sum0 = sum[0];
+                __m256i sum1 = sum[1];
+                __m256i sum2 = sum[2];
+                __m256i sum3 = sum[3];
+                __m128i lo, hi;
+                if (sub != NULL) {
+                    lo = _mm_loadu_si128((__m128i *) (sub + x));
+                    hi = _mm_loadu_si128((__m128i *) (sub + x + 4));
+                    sum0 = _mm256_sub_epi32(sum0, _mm256_cvtepu8_epi32(lo));
+                    sum1 = _mm256_sub_epi32(sum1, _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+                    sum2 = _mm256_sub_epi32(sum2, _mm256_cvtepu8_epi32(hi));
+                    sum3 = _mm256_sub_epi32(sum3, _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+                }
+                if (add != NULL) {
+                    lo = _mm_loadu_si128((__m128i *) (add + x));
+                    hi = _mm_loadu_si128((__m128i *) (add + x + 4));
+                    sum0 = _mm256_add_epi32(sum0, _mm256_cvtepu8_epi32(lo));
+                    sum1 = _mm256_add_epi32(sum1, _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+                    sum2 = _mm256_add_epi32(sum2, _mm256_cvtepu8_epi32(hi));
+                    sum3 = _mm256_add_epi32(sum3, _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+                }
+                sum[0] = sum0;
+                sum[1] = sum1;
+                sum[2] = sum2;
+                sum[3] = sum3;
+                __m256i p01 = _mm256_packs_epi32(scale(sum0, vkscale), scale(sum1, vkscale));
+                __m256i p23 = _mm256_packs_epi32(scale(sum2, vkscale), scale(sum3, vkscale));
+                __m256i p = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(p01, p23), order);
+                _mm256_storeu_si256((__m256i *) (dst + x), p);
+            }
+        }
+        _mm_free(sums);
+    }
+    if (w8 < dstw) {
+        return boxBlurVerticalSSE2(dstPixels + w8, dstw - w8, dsth, dstscan,
+                                   srcPixels + w8, srcw - w8, srch, srcscan,
+                                   kscale);
+    }
+    return JNI_TRUE;
+}
+
+/*
+ * The vertical shadow passes, see shadowVerticalSSE2.  Only the first
+ * dstw & ~7 columns are done here, the caller passes the rest to the SSE2
+ * kernel.
+ */
+AVX2_TARGET
+static jboolean shadowVerticalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                   jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                                   jint kscale, jint *kscales,
+                                   jint amin, jint amax, jint shadowRGB)
+{
+    jint w8 = dstw & ~7;
+    if (w8 == 0) return JNI_TRUE;
+    __m256i *sums = (__m256i *) _mm_malloc(w8 / 8 * sizeof(__m256i), 32);
+    if (sums == NULL) return JNI_FALSE;
+    for (jint i = 0; i < w8 / 8; i++) {
+        sums[i] = _mm256_setzero_si256();
+    }
+    jint vsize = dsth - srch + 1;
+    __m256i vkscales[4];
+    if (kscales != NULL) {
+        for (jint i = 0; i < 4; i++) {
+            vkscales[i] = _mm256_set1_epi32(kscales[i]);
+        }
+    }
+    __m256i vkscale = _mm256_set1_epi32(kscale);
+    __m256i vamin = _mm256_set1_epi32(amin);
+    __m256i vamax = _mm256_set1_epi32(amax);
+    __m256i vshadowRGB = _mm256_set1_epi32(shadowRGB);
+    for (jint y = 0; y < dsth; y++) {
+        jint *sub = (y >= vsize) ? srcPixels + (y - vsize) * srcscan : NULL;
+        jint *add = (y < srch) ? srcPixels + y * srcscan : NULL;
+        jint *dst = dstPixels + y * dstscan;
+        for (jint x = 0; x < w8; x += 8) {
+            __m256i *suma = sums + x / 8;
+            __m256i sum = *suma;
+            if (sub != NULL) {
+                sum = _mm256_sub_epi32(sum, loadAlpha(sub + x));
+            }
+            if (add != NULL) {
+                sum = _mm256_add_epi32(sum, loadAlpha(add + x));
+            }
+            *suma = sum;
+            _mm256_storeu_si256((__m256i *) (dst + x), (kscales == NULL)
+                ? shadowBlack(sum, vkscale, vamin, vamax)
+                : shadowColor(sum, vkscales, vamin, vamax, vshadowRGB));
+        }
+    }
+    _mm_free(sums);
+    return JNI_TRUE;
+}
+
+AVX2_TARGET
+jboolean boxShadowVerticalBlackAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                    jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                                    jint kscale, jint amin, jint amax)
+{
+    jint w8 = dstw & ~7;
+    if (!shadowVerticalAVX2(dstPixels, dstw, dsth, dstscan,
+                            srcPixels, srcw, srch, srcscan,
+                            kscale, NULL, amin, amax, 0)) {
+        return JNI_FALSE;
+    }
+    if (w8 < dstw) {
+        return boxShadowVerticalBlackSSE2(dstPixels + w8, dstw - w8, dsth, dstscan,
+                                          srcPixels + w8, srcw - w8, srch, srcscan,
+                                          kscale, amin, amax);
+    }
+    return JNI_TRUE;
+}
+
+AVX2_TARGET
+jboolean boxShadowVerticalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                               jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                               jint *kscales, jint amin, jint amax, jint shadowRGB)
+{
+    jint w8 = dstw & ~7;
+    if (!shadowVerticalAVX2(dstPixels, dstw, dsth, dstscan,
+                            srcPixels, srcw, srch, srcscan,
+                            0, kscales, amin, amax, shadowRGB)) {
+        return JNI_FALSE;
+    }
+    if (w8 < dstw) {
+        return boxShadowVerticalSSE2(dstPixels + w8, dstw - w8, dsth, dstscan,
+                                     srcPixels + w8, srcw - w8, srch, srcscan,
+                                     kscales, amin, amax, shadowRGB);
+    }
+    return JNI_TRUE;
+}
+
+AVX2_TARGET
+jboolean linearConvolveHVAVX2(jint *dstPixels, jint dstcols, jint dstrows, jint dcolinc, jint drowinc,
+                          jint *srcPixels, jint srccols, jint srcrows, jint scolinc, jint srowinc,
+                          jfloat *kvals, jint kernelSize)
+{
+    // Two rows at a time, one in each half of the register.  Every lane
+    // still holds a single component, so the sums are not reordered and
+    // no fused multiply-add is used.
+    __m256 cvals[128];
+    __m256 vcmin = _mm256_set1_ps(cmin);
+    __m256 vcmax = _mm256_set1_ps(cmax);
+    __m256i v255 = _mm256_set1_epi32(255);
+    jint r = 0;
+    for (; r + 2 <= dstrows; r += 2) {
+        jint dstoff = r * drowinc;
+        jint srcoff = r * srowinc;
+        for (jint i = 0; i < kernelSize; i++) {
+            cvals[i] = _mm256_setzero_ps();
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            jint rgb0 = 0;
+            jint rgb1 = 0;
+            if (c < srccols) {
+                rgb0 = srcPixels[srcoff];
+                rgb1 = srcPixels[srcoff + srowinc];
+            }
+            cvals[kernelSize - koff] = _mm256_cvtepi32_ps(unpackPixels(rgb0, rgb1));
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            jfloat *factors = kvals + koff;
+            __m256 sum = _mm256_setzero_ps();
+            for (jint i = 0; i < kernelSize; i++) {
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(cvals[i], _mm256_set1_ps(factors[i])));
+            }
+            __m256i v = _mm256_cvttps_epi32(sum);
+            v = _mm256_blendv_epi8(v, v255,
+                                   _mm256_castps_si256(_mm256_cmp_ps(sum, vcmax, _CMP_GT_OQ)));
+            v = _mm256_andnot_si256(
+                _mm256_castps_si256(_mm256_cmp_ps(sum, vcmin, _CMP_LT_OQ)), v);
+            packPixels(v, dstPixels + dstoff, dstPixels + dstoff + drowinc);
+            dstoff += dcolinc;
+            srcoff += scolinc;
+        }
+    }
+    if (r < dstrows) {
+        return linearConvolveHVSSE2(dstPixels + r * drowinc, dstcols, dstrows - r, dcolinc, drowinc,
+                                    srcPixels + r * srowinc, srccols, srcrows - r, scolinc, srowinc,
+                                    kvals, kernelSize);
+    }
+    return JNI_TRUE;
+}
+
+#endif /* DECORA_SSE2 && DECORA_AVX2 */
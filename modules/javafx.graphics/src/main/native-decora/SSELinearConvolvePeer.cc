@@ -30,7 +30,8 @@
 
 #include <jni.h>
 #include <math.h>
-#include "SSEUtils.h"
+#include "SSEKernels.h"
+#include "SSEWorkers.h"
 #include "com_sun_scenario_effect_impl_sw_sse_SSELinearConvolvePeer.h"
 
 #define cmin 1.0f
@@ -38,33 +39,54 @@
 
 #define fvaltobyte(f) (((f) < cmin) ? 0 : (((f) > cmax) ? 255 : ((jint) (f))))
 
-JNIEXPORT void JNICALL
-Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolvePeer_filterVector
-    (JNIEnv *env, jobject lcpthis,
-     jintArray dstPixels_arr, jint dstw, jint dsth, jint dstscan,
-     jintArray srcPixels_arr, jint srcw, jint srch, jint srcscan,
-     jfloatArray weights_arr, jint count,
-     jfloat srcx0, jfloat srcy0,
-     jfloat offsetx, jfloat offsety,
-     jfloat deltax, jfloat deltay,
-     jfloat dxcol, jfloat dycol, jfloat dxrow, jfloat dyrow)
-{
-    if (count > 128) return;
-    jfloat weights[128];
-    env->GetFloatArrayRegion(weights_arr, 0, count, weights);
+struct VectorPass {
+    jint *dstPixels;
+    jint dstw, dsth, dstscan;
+    jint *srcPixels;
+    jint srcw, srch, srcscan;
+    jfloat *weights;
+    jint count;
+    jfloat srcx0, srcy0;
+    jfloat offsetx, offsety;
+    jfloat deltax, deltay;
+    jfloat dxcol, dycol, dxrow, dyrow;
+};
 
-    jint *srcPixels = (jint *)env->GetPrimitiveArrayCritical(srcPixels_arr, 0);
-    if (srcPixels == NULL) return;
-    jint *dstPixels = (jint *)env->GetPrimitiveArrayCritical(dstPixels_arr, 0);
-    if (dstPixels == NULL) {
-        env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
-        return;
-    }
+// Filters the rows [begin, end) of the destination.
+static void filterVectorBand(void *data, jint begin, jint end)
+{
+    VectorPass *pass = (VectorPass *) data;
+    jint *dstPixels = pass->dstPixels + begin * pass->dstscan;
+    jint dstw = pass->dstw;
+    jint dsth = end - begin;
+    jint dstscan = pass->dstscan;
+    jint *srcPixels = pass->srcPixels;
+    jint srcw = pass->srcw;
+    jint srch = pass->srch;
+    jint srcscan = pass->srcscan;
+    jfloat *weights = pass->weights;
+    jint count = pass->count;
+    jfloat srcx0 = pass->srcx0;
+    jfloat srcy0 = pass->srcy0;
+    jfloat offsetx = pass->offsetx;
+    jfloat offsety = pass->offsety;
+    jfloat deltax = pass->deltax;
+    jfloat deltay = pass->deltay;
+    jfloat dxcol = pass->dxcol;
+    jfloat dycol = pass->dycol;
+    jfloat dxrow = pass->dxrow;
+    jfloat dyrow = pass->dyrow;
 
     jint dstrow = 0;
     // srcxy0 point at UL corner, shift them to center of 1st dest pixel:
     srcx0 += (dxrow + dxcol) * 0.5f;
     srcy0 += (dyrow + dycol) * 0.5f;
+    // Step to the first row of the band the same way the loop below steps
+    // from row to row, so the sample positions do not depend on the bands.
+    for (jint dy = 0; dy < begin; dy++) {
+        srcx0 += dxrow;
+        srcy0 += dyrow;
+    }
     for (jint dy = 0; dy < dsth; dy++) {
         jfloat srcx = srcx0;
         jfloat srcy = srcy0;
@@ -90,11 +112,127 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolvePeer_filterVector
         srcy0 += dyrow;
         dstrow += dstscan;
     }
+}
+
+JNIEXPORT void JNICALL
+Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolvePeer_filterVector
+    (JNIEnv *env, jobject lcpthis,
+     jintArray dstPixels_arr, jint dstw, jint dsth, jint dstscan,
+     jintArray srcPixels_arr, jint srcw, jint srch, jint srcscan,
+     jfloatArray weights_arr, jint count,
+     jfloat srcx0, jfloat srcy0,
+     jfloat offsetx, jfloat offsety,
+     jfloat deltax, jfloat deltay,
+     jfloat dxcol, jfloat dycol, jfloat dxrow, jfloat dyrow)
+{
+    if (count > 128) return;
+    jfloat weights[128];
+    env->GetFloatArrayRegion(weights_arr, 0, count, weights);
+
+    jint *srcPixels = (jint *)env->GetPrimitiveArrayCritical(srcPixels_arr, 0);
+    if (srcPixels == NULL) return;
+    jint *dstPixels = (jint *)env->GetPrimitiveArrayCritical(dstPixels_arr, 0);
+    if (dstPixels == NULL) {
+        env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
+        return;
+    }
+
+    VectorPass pass = {
+        dstPixels, dstw, dsth, dstscan,
+        srcPixels, srcw, srch, srcscan,
+        weights, count,
+        srcx0, srcy0,
+        offsetx, offsety,
+        deltax, deltay,
+        dxcol, dycol, dxrow, dyrow
+    };
+    decoraRunBands(filterVectorBand, &pass, dsth, 1, dstw * dsth);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
 }
 
+struct HVPass {
+    jint *dstPixels;
+    jint dstcols, dstrows, dcolinc, drowinc;
+    jint *srcPixels;
+    jint srccols, srcrows, scolinc, srowinc;
+    jfloat *kvals;
+    jint kernelSize;
+};
+
+// Filters the rows [begin, end) of a pass, see filterHV below.
+static void filterHVBand(void *data, jint begin, jint end)
+{
+    HVPass *pass = (HVPass *) data;
+    jint *dstPixels = pass->dstPixels + begin * pass->drowinc;
+    jint dstcols = pass->dstcols;
+    jint dstrows = end - begin;
+    jint dcolinc = pass->dcolinc;
+    jint drowinc = pass->drowinc;
+    jint *srcPixels = pass->srcPixels + begin * pass->srowinc;
+    jint srccols = pass->srccols;
+    jint srcrows = pass->srcrows - begin;
+    jint scolinc = pass->scolinc;
+    jint srowinc = pass->srowinc;
+    jfloat *kvals = pass->kvals;
+    jint kernelSize = pass->kernelSize;
+
+    if (!linearConvolveHVSIMD(dstPixels, dstcols, dstrows, dcolinc, drowinc,
+                              srcPixels, srccols, srcrows, scolinc, srowinc,
+                              kvals, kernelSize)) {
+        // cvals stores the component values from the surrounding K pixels
+        // from x-r to x+r
+        jfloat cvals[128*4];
+        jint dstrow = 0;
+        jint srcrow = 0;
+        for (jint r = 0; r < dstrows; r++) {
+            jint dstoff = dstrow;
+            jint srcoff = srcrow;
+            // Must clear out the array at the start of every line
+            // Might be able to rely on the fact that the previous line must
+            // have run out of data towards the end of the scan line, though.
+            for (jint i = 0; i < kernelSize*4; i++) {
+                cvals[i] = 0.0f;
+            }
+            jint koff = kernelSize;
+            for (jint c = 0; c < dstcols; c++) {
+                // Load the data for this x location into the array.
+                jint i = (kernelSize - koff) * 4;
+                jint rgb = (c < srccols) ? srcPixels[srcoff] : 0;
+                cvals[i+0] = (jfloat) ((rgb >> 24) & 0xff);
+                cvals[i+1] = (jfloat) ((rgb >> 16) & 0xff);
+                cvals[i+2] = (jfloat) ((rgb >>  8) & 0xff);
+                cvals[i+3] = (jfloat) ((rgb      ) & 0xff);
+                // Bump the koff to the next spot to align the coefficients.
+                if (--koff <= 0) {
+                    koff += kernelSize;
+                }
+                jfloat suma = 0.0f;
+                jfloat sumr = 0.0f;
+                jfloat sumg = 0.0f;
+                jfloat sumb = 0.0f;
+                for (i = 0; i < kernelSize*4; i += 4) {
+                    jfloat factor = kvals[koff + (i>>2)];
+                    suma += cvals[i+0] * factor;
+                    sumr += cvals[i+1] * factor;
+                    sumg += cvals[i+2] * factor;
+                    sumb += cvals[i+3] * factor;
+                }
+                dstPixels[dstoff] =
+                    (((suma < cmin) ? 0 : ((suma > cmax) ? 255 : ((jint) suma))) << 24) +
+                    (((sumr < cmin) ? 0 : ((sumr > cmax) ? 255 : ((jint) sumr))) << 16) +
+                    (((sumg < cmin) ? 0 : ((sumg > cmax) ? 255 : ((jint) sumg))) <<  8) +
+                    (((sumb < cmin) ? 0 : ((sumb > cmax) ? 255 : ((jint) sumb)))      );
+                dstoff += dcolinc;
+                srcoff += scolinc;
+            }
+            dstrow += drowinc;
+            srcrow += srowinc;
+        }
+    }
+}
+
 /*
  * In the nomenclature of the argument list for this method, "row" refers
  * to the coordinate which increments once for each new stream of single
@@ -123,55 +261,12 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolvePeer_filterHV
         return;
     }
 
-    // cvals stores the component values from the surrounding K pixels
-    // from x-r to x+r
-    jfloat cvals[128*4];
-    jint dstrow = 0;
-    jint srcrow = 0;
-    for (jint r = 0; r < dstrows; r++) {
-        jint dstoff = dstrow;
-        jint srcoff = srcrow;
-        // Must clear out the array at the start of every line
-        // Might be able to rely on the fact that the previous line must
-        // have run out of data towards the end of the scan line, though.
-        for (jint i = 0; i < kernelSize*4; i++) {
-            cvals[i] = 0.0f;
-        }
-        jint koff = kernelSize;
-        for (jint c = 0; c < dstcols; c++) {
-            // Load the data for this x location into the array.
-            jint i = (kernelSize - koff) * 4;
-            jint rgb = (c < srccols) ? srcPixels[srcoff] : 0;
-            cvals[i+0] = (jfloat) ((rgb >> 24) & 0xff);
-            cvals[i+1] = (jfloat) ((rgb >> 16) & 0xff);
-            cvals[i+2] = (jfloat) ((rgb >>  8) & 0xff);
-            cvals[i+3] = (jfloat) ((rgb      ) & 0xff);
-            // Bump the koff to the next spot to align the coefficients.
-            if (--koff <= 0) {
-                koff += kernelSize;
-            }
-            jfloat suma = 0.0f;
-            jfloat sumr = 0.0f;
-            jfloat sumg = 0.0f;
-            jfloat sumb = 0.0f;
-            for (i = 0; i < kernelSize*4; i += 4) {
-                jfloat factor = kvals[koff + (i>>2)];
-                suma += cvals[i+0] * factor;
-                sumr += cvals[i+1] * factor;
-                sumg += cvals[i+2] * factor;
-                sumb += cvals[i+3] * factor;
-            }
-            dstPixels[dstoff] =
-                (((suma < cmin) ? 0 : ((suma > cmax) ? 255 : ((jint) suma))) << 24) +
-                (((sumr < cmin) ? 0 : ((sumr > cmax) ? 255 : ((jint) sumr))) << 16) +
-                (((sumg < cmin) ? 0 : ((sumg > cmax) ? 255 : ((jint) sumg))) <<  8) +
-                (((sumb < cmin) ? 0 : ((sumb > cmax) ? 255 : ((jint) sumb)))      );
-            dstoff += dcolinc;
-            srcoff += scolinc;
-        }
-        dstrow += drowinc;
-        srcrow += srowinc;
-    }
+    HVPass pass = {
+        dstPixels, dstcols, dstrows, dcolinc, drowinc,
+        srcPixels, srccols, srcrows, scolinc, srowinc,
+        kvals, kernelSize
+    };
+    decoraRunBands(filterHVBand, &pass, dstrows, 1, dstcols * dstrows);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -31,41 +31,62 @@
 #include <jni.h>
 #include <math.h>
 #include "SSEUtils.h"
+#include "SSEWorkers.h"
 #include "com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer.h"
 
 #define cmin 1.0f
 #define cmax (255.0f - 1.0f/32.0f)
 
-JNIEXPORT void JNICALL
-Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer_filterVector
-    (JNIEnv *env, jclass klass,
-     jintArray dstPixels_arr, jint dstw, jint dsth, jint dstscan,
-     jintArray srcPixels_arr, jint srcw, jint srch, jint srcscan,
-     jfloatArray weights_arr, jint count,
-     jfloat srcx0, jfloat srcy0,
-     jfloat offsetx, jfloat offsety,
-     jfloat deltax, jfloat deltay,
-     jfloatArray shadowColor_arr,
-     jfloat dxcol, jfloat dycol, jfloat dxrow, jfloat dyrow)
-{
-    if (count > 128) return;
-    jfloat weights[128];
-    env->GetFloatArrayRegion(weights_arr, 0, count, weights);
-    jfloat shadowColor[4];
-    env->GetFloatArrayRegion(shadowColor_arr, 0, 4, shadowColor);
+struct VectorPass {
+    jint *dstPixels;
+    jint dstw, dsth, dstscan;
+    jint *srcPixels;
+    jint srcw, srch, srcscan;
+    jfloat *weights;
+    jint count;
+    jfloat srcx0, srcy0;
+    jfloat offsetx, offsety;
+    jfloat deltax, deltay;
+    jfloat *shadowColor;
+    jfloat dxcol, dycol, dxrow, dyrow;
+};
 
-    jint *srcPixels = (jint *)env->GetPrimitiveArrayCritical(srcPixels_arr, 0);
-    if (srcPixels == NULL) return;
-    jint *dstPixels = (jint *)env->GetPrimitiveArrayCritical(dstPixels_arr, 0);
-    if (dstPixels == NULL) {
-        env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
-        return;
-    }
+// Filters the rows [begin, end) of the destination.
+static void filterVectorBand(void *data, jint begin, jint end)
+{
+    VectorPass *pass = (VectorPass *) data;
+    jint *dstPixels = pass->dstPixels + begin * pass->dstscan;
+    jint dstw = pass->dstw;
+    jint dsth = end - begin;
+    jint dstscan = pass->dstscan;
+    jint *srcPixels = pass->srcPixels;
+    jint srcw = pass->srcw;
+    jint srch = pass->srch;
+    jint srcscan = pass->srcscan;
+    jfloat *weights = pass->weights;
+    jint count = pass->count;
+    jfloat srcx0 = pass->srcx0;
+    jfloat srcy0 = pass->srcy0;
+    jfloat offsetx = pass->offsetx;
+    jfloat offsety = pass->offsety;
+    jfloat deltax = pass->deltax;
+    jfloat deltay = pass->deltay;
+    jfloat *shadowColor = pass->shadowColor;
+    jfloat dxcol = pass->dxcol;
+    jfloat dycol = pass->dycol;
+    jfloat dxrow = pass->dxrow;
+    jfloat dyrow = pass->dyrow;
 
     jint dstrow = 0;
     // srcxy0 point at UL corner, shift them to center of 1st dest pixel:
     srcx0 += (dxrow + dxcol) * 0.5f;
     srcy0 += (dyrow + dycol) * 0.5f;
+    // Step to the first row of the band the same way the loop below steps
+    // from row to row, so the sample positions do not depend on the bands.
+    for (jint dy = 0; dy < begin; dy++) {
+        srcx0 += dxrow;
+        srcy0 += dyrow;
+    }
     for (jint dy = 0; dy < dsth; dy++) {
         jfloat srcx = srcx0;
         jfloat srcy = srcy0;
@@ -98,39 +119,25 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer_filterVecto
         srcy0 += dyrow;
         dstrow += dstscan;
     }
-
-    env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
-    env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
 }
 
-/*
- * In the nomenclature of the argument list for this method, "row" refers
- * to the coordinate which increments once for each new stream of single
- * axis data that we are blurring in a single pass.  And "col" refers to
- * the other coordinate that increments along the row.
- * Rows are horizontal in the first pass and vertical in the second pass.
- * Cols are vice versa.
- */
 JNIEXPORT void JNICALL
-Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer_filterHV
+Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer_filterVector
     (JNIEnv *env, jclass klass,
-     jintArray dstPixels_arr, jint dstcols, jint dstrows, jint dcolinc, jint drowinc,
-     jintArray srcPixels_arr, jint srccols, jint srcrows, jint scolinc, jint srowinc,
-     jfloatArray kvals_arr, jfloatArray shadowColor_arr)
+     jintArray dstPixels_arr, jint dstw, jint dsth, jint dstscan,
+     jintArray srcPixels_arr, jint srcw, jint srch, jint srcscan,
+     jfloatArray weights_arr, jint count,
+     jfloat srcx0, jfloat srcy0,
+     jfloat offsetx, jfloat offsety,
+     jfloat deltax, jfloat deltay,
+     jfloatArray shadowColor_arr,
+     jfloat dxcol, jfloat dycol, jfloat dxrow, jfloat dyrow)
 {
-    jint kernelSize = env->GetArrayLength(kvals_arr) / 2;
-    if (kernelSize > 128) return;
-    jfloat kvals[256];
-    env->GetFloatArrayRegion(kvals_arr, 0, kernelSize * 2, kvals);
+    if (count > 128) return;
+    jfloat weights[128];
+    env->GetFloatArrayRegion(weights_arr, 0, count, weights);
     jfloat shadowColor[4];
     env->GetFloatArrayRegion(shadowColor_arr, 0, 4, shadowColor);
-    jint shadowRGBs[256];
-    for (jint i = 0; i < 256; i++) {
-        shadowRGBs[i] = ((int) (shadowColor[0] * i) << 16) |
-                        ((int) (shadowColor[1] * i) <<  8) |
-                        ((int) (shadowColor[2] * i) <<  0) |
-                        ((int) (shadowColor[3] * i) << 24);
-    }
 
     jint *srcPixels = (jint *)env->GetPrimitiveArrayCritical(srcPixels_arr, 0);
     if (srcPixels == NULL) return;
@@ -140,6 +147,49 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer_filterHV
         return;
     }
 
+    VectorPass pass = {
+        dstPixels, dstw, dsth, dstscan,
+        srcPixels, srcw, srch, srcscan,
+        weights, count,
+        srcx0, srcy0,
+        offsetx, offsety,
+        deltax, deltay,
+        shadowColor,
+        dxcol, dycol, dxrow, dyrow
+    };
+    decoraRunBands(filterVectorBand, &pass, dsth, 1, dstw * dsth);
+
+    env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
+    env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
+}
+
+struct HVPass {
+    jint *dstPixels;
+    jint dstcols, dstrows, dcolinc, drowinc;
+    jint *srcPixels;
+    jint srccols, srcrows, scolinc, srowinc;
+    jfloat *kvals;
+    jint kernelSize;
+    jint *shadowRGBs;
+};
+
+// Filters the rows [begin, end) of a pass, see filterHV below.
+static void filterHVBand(void *data, jint begin, jint end)
+{
+    HVPass *pass = (HVPass *) data;
+    jint *dstPixels = pass->dstPixels + begin * pass->drowinc;
+    jint dstcols = pass->dstcols;
+    jint dstrows = end - begin;
+    jint dcolinc = pass->dcolinc;
+    jint drowinc = pass->drowinc;
+    jint *srcPixels = pass->srcPixels + begin * pass->srowinc;
+    jint srccols = pass->srccols;
+    jint scolinc = pass->scolinc;
+    jint srowinc = pass->srowinc;
+    jfloat *kvals = pass->kvals;
+    jint kernelSize = pass->kernelSize;
+    jint *shadowRGBs = pass->shadowRGBs;
+
     // avals stores the alpha values from the surrounding K pixels
     // from x-r to x+r
     jfloat avals[128];
@@ -177,6 +227,52 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer_filterHV
         dstrow += drowinc;
         srcrow += srowinc;
     }
+}
+
+/*
+ * In the nomenclature of the argument list for this method, "row" refers
+ * to the coordinate which increments once for each new stream of single
+ * axis data that we are blurring in a single pass.  And "col" refers to
+ * the other coordinate that increments along the row.
+ * Rows are horizontal in the first pass and vertical in the second pass.
+ * Cols are vice versa.
+ */
+JNIEXPORT void JNICALL
+Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer_filterHV
+    (JNIEnv *env, jclass klass,
+     jintArray dstPixels_arr, jint dstcols, jint dstrows, jint dcolinc, jint drowinc,
+     jintArray srcPixels_arr, jint srccols, jint srcrows, jint scolinc, jint srowinc,
+     jfloatArray kvals_arr, jfloatArray shadowColor_arr)
+{
+    jint kernelSize = env->GetArrayLength(kvals_arr) / 2;
+    if (kernelSize > 128) return;
+    jfloat kvals[256];
+    env->GetFloatArrayRegion(kvals_arr, 0, kernelSize * 2, kvals);
+    jfloat shadowColor[4];
+    env->GetFloatArrayRegion(shadowColor_arr, 0, 4, shadowColor);
+    jint shadowRGBs[256];
+    for (jint i = 0; i < 256; i++) {
+        shadowRGBs[i] = ((int) (shadowColor[0] * i) << 16) |
+                        ((int) (shadowColor[1] * i) <<  8) |
+                        ((int) (shadowColor[2] * i) <<  0) |
+                        ((int) (shadowColor[3] * i) << 24);
+    }
+
+    jint *srcPixels = (jint *)env->GetPrimitiveArrayCritical(srcPixels_arr, 0);
+    if (srcPixels == NULL) return;
+    jint *dstPixels = (jint *)env->GetPrimitiveArrayCritical(dstPixels_arr, 0);
+    if (dstPixels == NULL) {
+        env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
+        return;
+    }
+
+    HVPass pass = {
+        dstPixels, dstcols, dstrows, dcolinc, drowinc,
+        srcPixels, srccols, srcrows, scolinc, srowinc,
+        kvals, kernelSize,
+        shadowRGBs
+    };
+    decoraRunBands(filterHVBand, &pass, dstrows, 1, dstcols * dstrows);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -30,6 +30,15 @@
 #include <windows.h>
 #endif
 
+#ifdef DECORA_AVX2
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
 JNIEXPORT jboolean JNICALL
 Java_com_sun_scenario_effect_impl_sw_sse_SSERendererDelegate_isSupported
     (JNIEnv *env, jclass klass)
@@ -43,6 +52,82 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSERendererDelegate_isSupported
 #endif
 }
 
+#ifdef DECORA_AVX2
+static bool hasAVX2()
+{
+    // AVX2 needs both the instructions (CPUID.7.0:EBX bit 5) and an OS
+    // that saves the YMM registers (OSXSAVE with XCR0 bits 1 and 2 set).
+    const unsigned int osxsave_avx = (1 << 27) | (1 << 28);
+    unsigned int xcr0;
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    if ((info[2] & osxsave_avx) != osxsave_avx) return false;
+    xcr0 = (unsigned int) _xgetbv(0);
+    if ((xcr0 & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0, NULL) < 7) return false;
+    __cpuid(1, eax, ebx, ecx, edx);
+    if ((ecx & osxsave_avx) != osxsave_avx) return false;
+    __asm__ __volatile__ ("xgetbv" : "=a" (xcr0), "=d" (edx) : "c" (0));
+    if ((xcr0 & 0x6) != 0x6) return false;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx & (1 << 5)) != 0;
+#endif
+}
+#endif
+
+static jint supportedSIMDLevel()
+{
+#ifdef DECORA_SSE2
+#ifdef DECORA_AVX2
+    if (hasAVX2()) {
+        return DECORA_SIMD_AVX2;
+    }
+#endif
+    return DECORA_SIMD_SSE2;
+#else
+    return DECORA_SIMD_SCALAR;
+#endif
+}
+
+// -1 until the processor has been queried.  Racing initializations all
+// store the same value so no locking is needed.
+static volatile jint simdLevel = -1;
+
+jint decoraSIMDLevel()
+{
+    jint level = simdLevel;
+    if (level < 0) {
+        level = supportedSIMDLevel();
+        simdLevel = level;
+    }
+    return level;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_sun_scenario_effect_impl_sw_sse_SSERendererDelegate_getSIMDLevel
+    (JNIEnv *env, jclass klass)
+{
+    return decoraSIMDLevel();
+}
+
+JNIEXPORT jint JNICALL
+Java_com_sun_scenario_effect_impl_sw_sse_SSERendererDelegate_setSIMDLevel
+    (JNIEnv *env, jclass klass, jint level)
+{
+    jint supported = supportedSIMDLevel();
+    if (level > supported) level = supported;
+    if (level < DECORA_SIMD_SCALAR) level = DECORA_SIMD_SCALAR;
+    simdLevel = level;
+    return level;
+}
+
 static void laccum(jint pixel, jfloat mul, jfloat *fvals) {
     mul /= 255.f;
     fvals[FVAL_R] += ((pixel >> 16) & 0xff) * mul;
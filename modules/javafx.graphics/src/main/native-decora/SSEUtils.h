@@ -38,6 +38,31 @@ extern "C" {
 #define FVAL_G   1
 #define FVAL_B   2
 
+/*
+ * The SSE* peers run on plain x86/x64 code by default and switch to the
+ * hand vectorized kernels in SSEKernels.cc when the processor supports
+ * them.  The levels below must match the SSERendererDelegate.SIMD_*
+ * constants.
+ */
+#define DECORA_SIMD_SCALAR  0
+#define DECORA_SIMD_SSE2    1
+#define DECORA_SIMD_AVX2    2
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DECORA_SSE2
+#if defined(_MSC_VER) || defined(__GNUC__)
+#define DECORA_AVX2
+#endif
+#endif
+
+/*
+ * Returns the kernel level currently used by the peers, which is the
+ * highest level supported by the processor unless it has been lowered
+ * with setSIMDLevel().
+ */
+jint decoraSIMDLevel();
+
 void lsample(jint *img,
              jfloat floc_x, jfloat floc_y,
              jint w, jint h, jint scan,
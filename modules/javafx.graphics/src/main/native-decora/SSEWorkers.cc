@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "SSEWorkers.h"
+#include "com_sun_scenario_effect_impl_sw_sse_SSERendererDelegate.h"
+
+#ifdef WIN32 /* WIN32 */
+#include <windows.h>
+#include <process.h>
+
+typedef CRITICAL_SECTION Mutex;
+typedef CONDITION_VARIABLE Condition;
+
+static void initLock(Mutex *m)          { InitializeCriticalSection(m); }
+static void lock(Mutex *m)              { EnterCriticalSection(m); }
+static void unlock(Mutex *m)            { LeaveCriticalSection(m); }
+static void initCondition(Condition *c) { InitializeConditionVariable(c); }
+static void waitOn(Condition *c, Mutex *m){ SleepConditionVariableCS(c, m, INFINITE); }
+static void notifyAll(Condition *c)     { WakeAllConditionVariable(c); }
+#else
+#include <pthread.h>
+
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t Condition;
+
+static void initLock(Mutex *m)          { pthread_mutex_init(m, NULL); }
+static void lock(Mutex *m)              { pthread_mutex_lock(m); }
+static void unlock(Mutex *m)            { pthread_mutex_unlock(m); }
+static void initCondition(Condition *c) { pthread_cond_init(c, NULL); }
+static void waitOn(Condition *c, Mutex *m){ pthread_cond_wait(c, m); }
+static void notifyAll(Condition *c)     { pthread_cond_broadcast(c); }
+#endif
+
+// Configuration, see SSERendererDelegate.setParallelism().  The calling
+// thread works on a band too, so at most maxThreads - 1 workers are started.
+static volatile jint maxThreads = 1;
+static volatile jint minPixels = 0;
+
+static Mutex poolLock;
+static Condition workAvailable;
+static Condition workDone;
+static bool poolInitialized = false;
+static jint workerCount = 0;
+
+// The pass currently run by the pool, all guarded by poolLock.
+static bool busy = false;
+static unsigned int generation = 0;
+static DecoraBandFunction jobFunction;
+static void *jobData;
+static jint jobCount;
+static jint jobAlign;
+static jint jobBands;
+static jint nextBand;
+static jint pendingBands;
+
+static void runBands()
+{
+    lock(&poolLock);
+    while (nextBand < jobBands) {
+        jint band = nextBand++;
+        DecoraBandFunction fn = jobFunction;
+        void *data = jobData;
+        jint units = jobCount / jobAlign;
+        jint begin = (jint) ((jlong) units * band / jobBands) * jobAlign;
+        jint end = (band == jobBands - 1) ? jobCount
+            : (jint) ((jlong) units * (band + 1) / jobBands) * jobAlign;
+        unlock(&poolLock);
+
+        fn(data, begin, end);
+
+        lock(&poolLock);
+        if (--pendingBands == 0) {
+            notifyAll(&workDone);
+        }
+    }
+    unlock(&poolLock);
+}
+
+#ifdef WIN32 /* WIN32 */
+static unsigned __stdcall workerMain(void *arg)
+#else
+static void *workerMain(void *arg)
+#endif
+{
+    lock(&poolLock);
+    unsigned int seen = generation;
+    for (;;) {
+        while (generation == seen) {
+            waitOn(&workAvailable, &poolLock);
+        }
+        seen = generation;
+        unlock(&poolLock);
+        runBands();
+        lock(&poolLock);
+    }
+    return 0;
+}
+
+// Must be called with poolLock held.
+static void startWorkers(jint count)
+{
+    while (workerCount < count) {
+#ifdef WIN32 /* WIN32 */
+        HANDLE thread = (HANDLE) _beginthreadex(NULL, 0, workerMain, NULL, 0, NULL);
+        if (thread == 0) return;
+        CloseHandle(thread);
+#else
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, workerMain, NULL) != 0) return;
+        pthread_detach(thread);
+#endif
+        workerCount++;
+    }
+}
+
+void decoraRunBands(DecoraBandFunction fn, void *data,
+                    jint count, jint align, jint pixels)
+{
+    jint bands = maxThreads;
+    if (bands > count / align) {
+        bands = count / align;
+    }
+    if (bands < 2 || pixels < minPixels || !poolInitialized) {
+        fn(data, 0, count);
+        return;
+    }
+
+    lock(&poolLock);
+    startWorkers(bands - 1);
+    if (busy || workerCount == 0) {
+        // Another thread is filtering, or no worker could be started
+        unlock(&poolLock);
+        fn(data, 0, count);
+        return;
+    }
+    busy = true;
+    jobFunction = fn;
+    jobData = data;
+    jobCount = count;
+    jobAlign = align;
+    jobBands = bands;
+    nextBand = 0;
+    pendingBands = bands;
+    generation++;
+    notifyAll(&workAvailable);
+    unlock(&poolLock);
+
+    runBands();
+
+    lock(&poolLock);
+    while (pendingBands > 0) {
+        waitOn(&workDone, &poolLock);
+    }
+    busy = false;
+    unlock(&poolLock);
+}
+
+JNIEXPORT void JNICALL
+Java_com_sun_scenario_effect_impl_sw_sse_SSERendererDelegate_nSetParallelism
+    (JNIEnv *env, jclass klass, jint threads, jint threshold)
+{
+    // Called from the static initializer of SSERendererDelegate, before
+    // any filter can run.
+    if (!poolInitialized) {
+        initLock(&poolLock);
+        initCondition(&workAvailable);
+        initCondition(&workDone);
+        poolInitialized = true;
+    }
+    maxThreads = (threads < 1) ? 1 : threads;
+    minPixels = threshold;
+}
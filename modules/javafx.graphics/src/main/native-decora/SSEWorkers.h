@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef _Included_SSEWorkers
+#define _Included_SSEWorkers
+
+#include <jni.h>
+
+/*
+ * A small pool of native worker threads used to split the filter passes
+ * of the SSE peers into bands.
+ *
+ * A band function processes the rows (or columns) [begin, end) of a pass
+ * and must not call back into the JVM: it runs on threads that are not
+ * attached to it, while the calling thread holds the pixel arrays with
+ * GetPrimitiveArrayCritical.
+ */
+typedef void (*DecoraBandFunction)(void *data, jint begin, jint end);
+
+/*
+ * Runs fn over [0, count) and returns once every band is done.
+ *
+ * The range is split into up to one band per thread when the pass covers
+ * at least the configured threshold of pixels, and runs on the calling
+ * thread otherwise, or when another pass is already using the pool.  All
+ * band boundaries but the end of the range are multiples of align.
+ */
+void decoraRunBands(DecoraBandFunction fn, void *data,
+                    jint count, jint align, jint pixels);
+
+#endif /* _Included_SSEWorkers */
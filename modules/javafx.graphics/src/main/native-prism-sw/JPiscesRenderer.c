@@ -649,6 +649,94 @@ JNIEXPORT void JNICALL Java_com_sun_pisces_PiscesRenderer_emitAndClearAlphaRowIm
     }
 }
 
+/*
+ * Class:     com_sun_pisces_PiscesRenderer
+ * Method:    emitAndClearAlphaRowsImpl
+ * Signature: ([B[II[III)V
+ * Same as emitAndClearAlphaRowImpl for numRows rows, whose y, x_from and
+ * x_to are in rows and whose alpha deltas start every alphaStride deltas.
+ * The surface is acquired and the arrays pinned only once for all rows.
+ */
+JNIEXPORT void JNICALL Java_com_sun_pisces_PiscesRenderer_emitAndClearAlphaRowsImpl
+  (JNIEnv *env, jobject this, jbyteArray jAlphaMap, jintArray jAlphaDeltas, jint alphaStride,
+   jintArray jRows, jint numRows, jint rowNum)
+{
+    Renderer* rdr;
+    Surface* surface;
+    jobject surfaceHandle;
+    jbyte* alphaMap;
+    jint* alphaRows;
+    jint* rows;
+    jint i;
+
+    rdr = (Renderer*)JLongToPointer((*env)->GetLongField(env, this, fieldIds[RENDERER_NATIVE_PTR]));
+
+    SURFACE_FROM_RENDERER(surface, env, surfaceHandle, this);
+    ACQUIRE_SURFACE(surface, env, surfaceHandle);
+    INVALIDATE_RENDERER_SURFACE(rdr);
+    VALIDATE_BLITTING(rdr);
+
+    alphaMap = (jbyte*)(*env)->GetPrimitiveArrayCritical(env, jAlphaMap, NULL);
+    alphaRows = (alphaMap == NULL) ? NULL
+        : (jint*)(*env)->GetPrimitiveArrayCritical(env, jAlphaDeltas, NULL);
+    rows = (alphaRows == NULL) ? NULL
+        : (jint*)(*env)->GetPrimitiveArrayCritical(env, jRows, NULL);
+    if (rows != NULL) {
+        rdr->alphaMap = alphaMap;
+        rdr->_imageScanlineStride = surface->width;
+        rdr->_imagePixelStride = 1;
+
+        for (i = 0; i < numRows; i++) {
+            jint y = rows[i * 3];
+            jint x_from = MAX(rows[i * 3 + 1], rdr->_clip_bbMinX);
+            jint x_to = MIN(rows[i * 3 + 2], rdr->_clip_bbMaxX);
+
+            if (x_to >= x_from &&
+                y >= rdr->_clip_bbMinY &&
+                y <= rdr->_clip_bbMaxY)
+            {
+                rdr->_minTouched = x_from;
+                rdr->_maxTouched = x_to;
+                rdr->_currX = x_from;
+                rdr->_currY = y;
+
+                rdr->_rowNum = rowNum + i;
+
+                rdr->_rowAAInt = alphaRows + i * alphaStride;
+                rdr->_alphaWidth = x_to - x_from + 1;
+
+                rdr->_currImageOffset = y * surface->width;
+
+                if (rdr->_genPaint) {
+                    size_t l = (x_to - x_from + 1);
+                    ALLOC3(rdr->_paint, jint, l);
+                    rdr->_genPaint(rdr, 1);
+                }
+                rdr->_emitRows(rdr, 1);
+            }
+        }
+        rdr->_rowAAInt = NULL;
+    } else {
+        setMemErrorFlag();
+    }
+    if (rows != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, jRows, rows, JNI_ABORT);
+    }
+    if (alphaRows != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, jAlphaDeltas, alphaRows, 0);
+    }
+    if (alphaMap != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, jAlphaMap, alphaMap, 0);
+    }
+
+    RELEASE_SURFACE(surface, env, surfaceHandle);
+
+    if (JNI_TRUE == readAndClearMemErrorFlag()) {
+        JNI_ThrowNew(env, "java/lang/OutOfMemoryError",
+            "Allocation of internal renderer buffer failed.");
+    }
+}
+
 /*
  * Class:     com_sun_pisces_PiscesRenderer
  * Method:    drawImageImpl
@@ -75,6 +75,469 @@ static INLINE jint B(jint x) {
     return x & 0xFF;
 }
 
+// The SSE2 blitters are built wherever SSE2 is part of the target, the AVX2
+// ones into every x86 library with a compiler that can target them, and are
+// only used when the processor supports them, see setMaxBlitKernel().
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENABLE_SIMD_SSE2 1
+#else
+#define ENABLE_SIMD_SSE2 0
+#endif
+
+#if ENABLE_SIMD_SSE2 && (defined(_MSC_VER) || defined(__GNUC__))
+#define ENABLE_SIMD_AVX2 1
+#else
+#define ENABLE_SIMD_AVX2 0
+#endif
+
+// Coverage of the alpha deltas, converted by chunks for the SIMD blitters
+#define COVERAGE_CHUNK 256
+
+static jint blitKernel = -1;
+
+static INLINE jint currentBlitKernel() {
+    if (blitKernel < 0) {
+        setMaxBlitKernel(BLIT_KERNEL_AVX2);
+    }
+    return blitKernel;
+}
+
+// Same as the pixels of blitSrcOverMask8888_pre
+static INLINE void srcOverPixel(jint *intData, jint acoverage,
+                                jint calpha, jint cred, jint cgreen, jint cblue) {
+    if (acoverage) {
+        jint aval = ((acoverage+1) * calpha) >> 8;
+        if (aval == MAX_ALPHA) {
+            *intData = 0xff000000 | (cred << 16) | (cgreen << 8) | cblue;
+        } else if (aval > 0) {
+            blendSrcOver8888_pre(intData, aval, cred, cgreen, cblue);
+        }
+    }
+}
+
+// Same as the pixels of blitSrcMask8888_pre
+static INLINE void srcPixel(jint *intData, jint acoverage,
+                            jint calpha, jint cred, jint cgreen, jint cblue) {
+    if (acoverage == MAX_ALPHA) {
+        *intData = (calpha << 24) | (cred << 16) | (cgreen << 8) | cblue;
+    } else if (acoverage > 0) {
+        jint aval = ((acoverage+1) * calpha) >> 8;
+        blendSrc8888_pre(intData, aval, 255 - acoverage, cred, cgreen, cblue);
+    }
+}
+
+// Same as the pixels of blitPTSrcOverMask8888_pre
+static INLINE void srcOverPTPixel(jint *intData, jint malpha, jint cval) {
+    if (malpha) {
+        jint palpha = A(cval);
+        jint aval = ((malpha+1) * palpha) >> 8;
+        if (aval == MAX_ALPHA) {
+            *intData = cval;
+        } else if (aval > 0) {
+            blendSrcOver8888_pre_pre(intData, malpha+1, palpha, R(cval), G(cval), B(cval));
+        }
+    }
+}
+
+#if ENABLE_SIMD_SSE2
+// --- Begin SSE2 blitters
+#include <emmintrin.h>
+
+/*
+ * The blitters work on 16 bit channels, div255(x) is then
+ * ((x + 1) * 257) >> 16 for all of the x <= 255 * 255 they compute.
+ */
+static INLINE __m128i sse2_div255(__m128i x) {
+    return _mm_mulhi_epu16(_mm_add_epi16(x, _mm_set1_epi16(1)),
+                           _mm_set1_epi16(257));
+}
+
+// Spreads the coverage of 4 pixels over the channels of pixels 0, 1 (lo)
+// and 2, 3 (hi)
+static INLINE void sse2_spread(const jbyte *coverage, __m128i *lo, __m128i *hi) {
+    jint c4;
+    __m128i c;
+
+    memcpy(&c4, coverage, sizeof(c4));
+    c = _mm_unpacklo_epi8(_mm_cvtsi32_si128(c4), _mm_setzero_si128());
+    c = _mm_unpacklo_epi16(c, c);
+    *lo = _mm_unpacklo_epi32(c, c);
+    *hi = _mm_unpackhi_epi32(c, c);
+}
+
+static INLINE __m128i sse2_srcOver(__m128i d, __m128i cov, __m128i calpha, __m128i color) {
+    __m128i aval = _mm_srli_epi16(_mm_mullo_epi16(_mm_add_epi16(cov, _mm_set1_epi16(1)), calpha), 8);
+    __m128i raval = _mm_sub_epi16(_mm_set1_epi16(255), aval);
+    return sse2_div255(_mm_add_epi16(_mm_mullo_epi16(color, aval),
+                                     _mm_mullo_epi16(d, raval)));
+}
+
+static INLINE __m128i sse2_select(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// Broadcasts the alpha channel of each pixel over its other channels
+static INLINE __m128i sse2_alphas(__m128i c) {
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 3, 3)),
+                               _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+static INLINE __m128i sse2_src(__m128i d, __m128i cov, __m128i calpha,
+                               __m128i color, __m128i solid) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i aval = _mm_srli_epi16(_mm_mullo_epi16(_mm_add_epi16(cov, _mm_set1_epi16(1)), calpha), 8);
+    __m128i raaval = _mm_sub_epi16(_mm_set1_epi16(255), cov);
+    // The alpha channels of color are 255, so those of sum are the denominators
+    __m128i sum = _mm_add_epi16(_mm_mullo_epi16(color, aval), _mm_mullo_epi16(d, raaval));
+    __m128i o = _mm_andnot_si128(sse2_alphas(_mm_cmpeq_epi16(sum, zero)), sse2_div255(sum));
+    o = sse2_select(_mm_cmpeq_epi16(cov, zero), d, o);
+    return sse2_select(_mm_cmpeq_epi16(cov, _mm_set1_epi16(255)), solid, o);
+}
+
+static INLINE __m128i sse2_srcOverPT(__m128i d, __m128i cov, __m128i p) {
+    __m128i frac = _mm_add_epi16(cov, _mm_set1_epi16(1));
+    __m128i aval = _mm_srli_epi16(_mm_mullo_epi16(sse2_alphas(p), frac), 8);
+    __m128i raval = _mm_sub_epi16(_mm_set1_epi16(255), aval);
+    __m128i o = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(p, frac), 8),
+                              sse2_div255(_mm_mullo_epi16(d, raval)));
+    return sse2_select(_mm_cmpeq_epi16(aval, _mm_setzero_si128()), d, o);
+}
+
+// The row functions return the number of pixels they blitted, a multiple of 4
+static jint sse2_srcOverRow(jint *intData, const jbyte *coverage, jint w,
+                            jint calpha, jint cred, jint cgreen, jint cblue) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i vcalpha = _mm_set1_epi16((short)calpha);
+    const __m128i color = _mm_setr_epi16((short)cblue, (short)cgreen, (short)cred, 255,
+                                         (short)cblue, (short)cgreen, (short)cred, 255);
+    jint i, c4;
+
+    for (i = 0; i + 4 <= w; i += 4) {
+        __m128i d, lo, hi;
+
+        memcpy(&c4, coverage + i, sizeof(c4));
+        if (c4 == 0) {
+            continue;
+        }
+        d = _mm_loadu_si128((const __m128i *)(intData + i));
+        sse2_spread(coverage + i, &lo, &hi);
+        lo = sse2_srcOver(_mm_unpacklo_epi8(d, zero), lo, vcalpha, color);
+        hi = sse2_srcOver(_mm_unpackhi_epi8(d, zero), hi, vcalpha, color);
+        _mm_storeu_si128((__m128i *)(intData + i), _mm_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+static jint sse2_srcRow(jint *intData, const jbyte *coverage, jint w,
+                        jint calpha, jint cred, jint cgreen, jint cblue) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i vcalpha = _mm_set1_epi16((short)calpha);
+    const __m128i color = _mm_setr_epi16((short)cblue, (short)cgreen, (short)cred, 255,
+                                         (short)cblue, (short)cgreen, (short)cred, 255);
+    const __m128i solid = _mm_setr_epi16((short)cblue, (short)cgreen, (short)cred, (short)calpha,
+                                         (short)cblue, (short)cgreen, (short)cred, (short)calpha);
+    jint i, c4;
+
+    for (i = 0; i + 4 <= w; i += 4) {
+        __m128i d, lo, hi;
+
+        memcpy(&c4, coverage + i, sizeof(c4));
+        if (c4 == 0) {
+            continue;
+        }
+        d = _mm_loadu_si128((const __m128i *)(intData + i));
+        sse2_spread(coverage + i, &lo, &hi);
+        lo = sse2_src(_mm_unpacklo_epi8(d, zero), lo, vcalpha, color, solid);
+        hi = sse2_src(_mm_unpackhi_epi8(d, zero), hi, vcalpha, color, solid);
+        _mm_storeu_si128((__m128i *)(intData + i), _mm_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+static jint sse2_srcOverPTRow(jint *intData, const jbyte *coverage, const jint *paint, jint w) {
+    const __m128i zero = _mm_setzero_si128();
+    jint i, c4;
+
+    for (i = 0; i + 4 <= w; i += 4) {
+        __m128i d, p, lo, hi;
+
+        memcpy(&c4, coverage + i, sizeof(c4));
+        if (c4 == 0) {
+            continue;
+        }
+        d = _mm_loadu_si128((const __m128i *)(intData + i));
+        p = _mm_loadu_si128((const __m128i *)(paint + i));
+        sse2_spread(coverage + i, &lo, &hi);
+        lo = sse2_srcOverPT(_mm_unpacklo_epi8(d, zero), lo, _mm_unpacklo_epi8(p, zero));
+        hi = sse2_srcOverPT(_mm_unpackhi_epi8(d, zero), hi, _mm_unpackhi_epi8(p, zero));
+        _mm_storeu_si128((__m128i *)(intData + i), _mm_packus_epi16(lo, hi));
+    }
+    return i;
+}
+// --- End SSE2 blitters
+#endif // ENABLE_SIMD_SSE2
+
+#if ENABLE_SIMD_AVX2
+// --- Begin AVX2 blitters
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#define AVX2_FUNCTION
+#include <intrin.h>
+#else
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+
+static int cpu_has_avx2() {
+#ifdef _MSC_VER
+    int info[4];
+
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return 0;
+    }
+
+    // AVX and OSXSAVE, then the OS must save the ymm registers
+    __cpuid(info, 1);
+    if ((info[2] & 0x18000000) != 0x18000000) {
+        return 0;
+    }
+    if ((_xgetbv(0) & 6) != 6) {
+        return 0;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & 0x20) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+AVX2_FUNCTION static INLINE __m256i avx2_div255(__m256i x) {
+    return _mm256_mulhi_epu16(_mm256_add_epi16(x, _mm256_set1_epi16(1)),
+                              _mm256_set1_epi16(257));
+}
+
+AVX2_FUNCTION static INLINE __m256i avx2_combine(__m128i lane0, __m128i lane1) {
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lane0), lane1, 1);
+}
+
+// Spreads the coverage of 8 pixels in the order of _mm256_unpacklo_epi8
+// (pixels 0, 1, 4, 5) and _mm256_unpackhi_epi8 (pixels 2, 3, 6, 7)
+AVX2_FUNCTION static INLINE void avx2_spread(const jbyte *coverage, __m256i *lo, __m256i *hi) {
+    __m128i c = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)coverage),
+                                  _mm_setzero_si128());
+    __m128i c0123 = _mm_unpacklo_epi16(c, c);
+    __m128i c4567 = _mm_unpackhi_epi16(c, c);
+    *lo = avx2_combine(_mm_unpacklo_epi32(c0123, c0123), _mm_unpacklo_epi32(c4567, c4567));
+    *hi = avx2_combine(_mm_unpackhi_epi32(c0123, c0123), _mm_unpackhi_epi32(c4567, c4567));
+}
+
+AVX2_FUNCTION static INLINE jboolean avx2_isClear(const jbyte *coverage) {
+    jlong c8;
+    memcpy(&c8, coverage, sizeof(c8));
+    return c8 == 0;
+}
+
+AVX2_FUNCTION static INLINE __m256i avx2_select(__m256i mask, __m256i a, __m256i b) {
+    return _mm256_blendv_epi8(b, a, mask);
+}
+
+AVX2_FUNCTION static INLINE __m256i avx2_alphas(__m256i c) {
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 3, 3)),
+                                  _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+AVX2_FUNCTION static INLINE __m256i avx2_srcOver(__m256i d, __m256i cov, __m256i calpha, __m256i color) {
+    __m256i aval = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_add_epi16(cov, _mm256_set1_epi16(1)), calpha), 8);
+    __m256i raval = _mm256_sub_epi16(_mm256_set1_epi16(255), aval);
+    return avx2_div255(_mm256_add_epi16(_mm256_mullo_epi16(color, aval),
+                                        _mm256_mullo_epi16(d, raval)));
+}
+
+AVX2_FUNCTION static INLINE __m256i avx2_src(__m256i d, __m256i cov, __m256i calpha,
+                                             __m256i color, __m256i solid) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i aval = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_add_epi16(cov, _mm256_set1_epi16(1)), calpha), 8);
+    __m256i raaval = _mm256_sub_epi16(_mm256_set1_epi16(255), cov);
+    __m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(color, aval), _mm256_mullo_epi16(d, raaval));
+    __m256i o = _mm256_andnot_si256(avx2_alphas(_mm256_cmpeq_epi16(sum, zero)), avx2_div255(sum));
+    o = avx2_select(_mm256_cmpeq_epi16(cov, zero), d, o);
+    return avx2_select(_mm256_cmpeq_epi16(cov, _mm256_set1_epi16(255)), solid, o);
+}
+
+AVX2_FUNCTION static INLINE __m256i avx2_srcOverPT(__m256i d, __m256i cov, __m256i p) {
+    __m256i frac = _mm256_add_epi16(cov, _mm256_set1_epi16(1));
+    __m256i aval = _mm256_srli_epi16(_mm256_mullo_epi16(avx2_alphas(p), frac), 8);
+    __m256i raval = _mm256_sub_epi16(_mm256_set1_epi16(255), aval);
+    __m256i o = _mm256_add_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(p, frac), 8),
+                                 avx2_div255(_mm256_mullo_epi16(d, raval)));
+    return avx2_select(_mm256_cmpeq_epi16(aval, _mm256_setzero_si256()), d, o);
+}
+
+// The row functions return the number of pixels they blitted, a multiple of 8
+AVX2_FUNCTION static jint avx2_srcOverRow(jint *intData, const jbyte *coverage, jint w,
+                                          jint calpha, jint cred, jint cgreen, jint cblue) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i vcalpha = _mm256_set1_epi16((short)calpha);
+    const __m256i color = _mm256_set1_epi64x(((jlong)255 << 48) | ((jlong)cred << 32) |
+                                             ((jlong)cgreen << 16) | cblue);
+    jint i;
+
+    for (i = 0; i + 8 <= w; i += 8) {
+        __m256i d, lo, hi;
+
+        if (avx2_isClear(coverage + i)) {
+            continue;
+        }
+        d = _mm256_loadu_si256((const __m256i *)(intData + i));
+        avx2_spread(coverage + i, &lo, &hi);
+        lo = avx2_srcOver(_mm256_unpacklo_epi8(d, zero), lo, vcalpha, color);
+        hi = avx2_srcOver(_mm256_unpackhi_epi8(d, zero), hi, vcalpha, color);
+        _mm256_storeu_si256((__m256i *)(intData + i), _mm256_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+AVX2_FUNCTION static jint avx2_srcRow(jint *intData, const jbyte *coverage, jint w,
+                                      jint calpha, jint cred, jint cgreen, jint cblue) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i vcalpha = _mm256_set1_epi16((short)calpha);
+    const __m256i color = _mm256_set1_epi64x(((jlong)255 << 48) | ((jlong)cred << 32) |
+                                             ((jlong)cgreen << 16) | cblue);
+    const __m256i solid = _mm256_set1_epi64x(((jlong)calpha << 48) | ((jlong)cred << 32) |
+                                             ((jlong)cgreen << 16) | cblue);
+    jint i;
+
+    for (i = 0; i + 8 <= w; i += 8) {
+        __m256i d, lo, hi;
+
+        if (avx2_isClear(coverage + i)) {
+            continue;
+        }
+        d = _mm256_loadu_si256((const __m256i *)(intData + i));
+        avx2_spread(coverage + i, &lo, &hi);
+        lo = avx2_src(_mm256_unpacklo_epi8(d, zero), lo, vcalpha, color, solid);
+        hi = avx2_src(_mm256_unpackhi_epi8(d, zero), hi, vcalpha, color, solid);
+        _mm256_storeu_si256((__m256i *)(intData + i), _mm256_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+AVX2_FUNCTION static jint avx2_srcOverPTRow(jint *intData, const jbyte *coverage,
+                                            const jint *paint, jint w) {
+    const __m256i zero = _mm256_setzero_si256();
+    jint i;
+
+    for (i = 0; i + 8 <= w; i += 8) {
+        __m256i d, p, lo, hi;
+
+        if (avx2_isClear(coverage + i)) {
+            continue;
+        }
+        d = _mm256_loadu_si256((const __m256i *)(intData + i));
+        p = _mm256_loadu_si256((const __m256i *)(paint + i));
+        avx2_spread(coverage + i, &lo, &hi);
+        lo = avx2_srcOverPT(_mm256_unpacklo_epi8(d, zero), lo, _mm256_unpacklo_epi8(p, zero));
+        hi = avx2_srcOverPT(_mm256_unpackhi_epi8(d, zero), hi, _mm256_unpackhi_epi8(p, zero));
+        _mm256_storeu_si256((__m256i *)(intData + i), _mm256_packus_epi16(lo, hi));
+    }
+    return i;
+}
+// --- End AVX2 blitters
+#endif // ENABLE_SIMD_AVX2
+
+jint setMaxBlitKernel(jint maxKernel) {
+    jint kernel = BLIT_KERNEL_C;
+#if ENABLE_SIMD_SSE2
+    kernel = BLIT_KERNEL_SSE2;
+#endif
+#if ENABLE_SIMD_AVX2
+    if (cpu_has_avx2()) {
+        kernel = BLIT_KERNEL_AVX2;
+    }
+#endif
+    blitKernel = MAX(BLIT_KERNEL_C, MIN(kernel, maxKernel));
+    return blitKernel;
+}
+
+/*
+ * The row blitters run the SIMD variants of the current kernel over the
+ * coverage of w pixels, and the C code over the pixels they leave.
+ */
+static void srcOverRow(jint kernel, jint *intData, const jbyte *coverage, jint w,
+                       jint calpha, jint cred, jint cgreen, jint cblue) {
+    jint i = 0;
+#if ENABLE_SIMD_AVX2
+    if (kernel >= BLIT_KERNEL_AVX2) {
+        i = avx2_srcOverRow(intData, coverage, w, calpha, cred, cgreen, cblue);
+    }
+#endif
+#if ENABLE_SIMD_SSE2
+    if (kernel >= BLIT_KERNEL_SSE2) {
+        i += sse2_srcOverRow(intData + i, coverage + i, w - i, calpha, cred, cgreen, cblue);
+    }
+#endif
+    for (; i < w; i++) {
+        srcOverPixel(intData + i, coverage[i] & 0xff, calpha, cred, cgreen, cblue);
+    }
+}
+
+static void srcRow(jint kernel, jint *intData, const jbyte *coverage, jint w,
+                   jint calpha, jint cred, jint cgreen, jint cblue) {
+    jint i = 0;
+#if ENABLE_SIMD_AVX2
+    if (kernel >= BLIT_KERNEL_AVX2) {
+        i = avx2_srcRow(intData, coverage, w, calpha, cred, cgreen, cblue);
+    }
+#endif
+#if ENABLE_SIMD_SSE2
+    if (kernel >= BLIT_KERNEL_SSE2) {
+        i += sse2_srcRow(intData + i, coverage + i, w - i, calpha, cred, cgreen, cblue);
+    }
+#endif
+    for (; i < w; i++) {
+        srcPixel(intData + i, coverage[i] & 0xff, calpha, cred, cgreen, cblue);
+    }
+}
+
+static void srcOverPTRow(jint kernel, jint *intData, const jbyte *coverage,
+                         const jint *paint, jint w) {
+    jint i = 0;
+#if ENABLE_SIMD_AVX2
+    if (kernel >= BLIT_KERNEL_AVX2) {
+        i = avx2_srcOverPTRow(intData, coverage, paint, w);
+    }
+#endif
+#if ENABLE_SIMD_SSE2
+    if (kernel >= BLIT_KERNEL_SSE2) {
+        i += sse2_srcOverPTRow(intData + i, coverage + i, paint + i, w - i);
+    }
+#endif
+    for (; i < w; i++) {
+        srcOverPTPixel(intData + i, coverage[i] & 0xff, paint[i]);
+    }
+}
+
+/*
+ * Converts and clears the alpha deltas of up to COVERAGE_CHUNK pixels, the
+ * running sum of the deltas is kept in *aval_relative. Sums of 0 get no
+ * coverage when skipZero is set, as in the SrcOver blitters.
+ */
+static jint deltasToCoverage(jint *a, jint w, jint *aval_relative, jbyte *alphaMap,
+                             jboolean skipZero, jbyte *coverage) {
+    jint i, n = MIN(w, COVERAGE_CHUNK);
+    jint sum = *aval_relative;
+    for (i = 0; i < n; i++) {
+        sum += a[i];
+        a[i] = 0;
+        coverage[i] = (skipZero && sum == 0) ? 0 : alphaMap[sum];
+    }
+    *aval_relative = sum;
+    return n;
+}
+
 void
 emitLineSource8888_pre(Renderer *rdr, jint height, jint frac) {
     jint j, minX, maxX, w, iidx;
@@ -350,7 +813,7 @@ emitLinePTSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
 
 void
 blitSrc8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, kernel;
     jint minX, maxX, w;
     jint iidx, aval, acoverage;
     jint aval_relative;
@@ -375,6 +838,22 @@ blitSrc8888_pre(Renderer *rdr, jint height) {
     maxX = rdr->_maxTouched;
     w = (maxX >= minX) ? (maxX - minX + 1) : 0;
 
+    kernel = currentBlitKernel();
+    if (kernel != BLIT_KERNEL_C && imagePixelStride == 1) {
+        jbyte coverage[COVERAGE_CHUNK];
+        jint x, n;
+        for (j = 0; j < height; j++) {
+            aval_relative = 0;
+            for (x = 0; x < w; x += n) {
+                n = deltasToCoverage(alpha + x, w - x, &aval_relative, alphaMap, JNI_FALSE, coverage);
+                srcRow(kernel, intData + imageOffset + minX + x, coverage, n,
+                    calpha, cred, cgreen, cblue);
+            }
+            imageOffset += imageScanlineStride;
+        }
+        return;
+    }
+
     for (j = 0; j < height; j++) {
         iidx = imageOffset + minX * imagePixelStride;
 
@@ -402,7 +881,7 @@ blitSrc8888_pre(Renderer *rdr, jint height) {
 
 void
 blitSrcMask8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, kernel;
     jint minX, maxX, w;
     jint iidx, aval, acoverage;
 
@@ -425,6 +904,17 @@ blitSrcMask8888_pre(Renderer *rdr, jint height) {
     maxX = rdr->_maxTouched;
     w = (maxX >= minX) ? (maxX - minX + 1) : 0;
 
+    kernel = currentBlitKernel();
+    if (kernel != BLIT_KERNEL_C && imagePixelStride == 1) {
+        for (j = 0; j < height; j++) {
+            srcRow(kernel, intData + imageOffset + minX, alpha + alphaOffset, w,
+                calpha, cred, cgreen, cblue);
+            imageOffset += imageScanlineStride;
+            alphaOffset += alphaStride;
+        }
+        return;
+    }
+
     for (j = 0; j < height; j++) {
         iidx = imageOffset + minX * imagePixelStride;
 
@@ -554,7 +1044,7 @@ blitPTSrcMask8888_pre(Renderer *rdr, jint height) {
 
 void
 blitSrcOver8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, kernel;
     jint minX, maxX, w;
     jint  iidx, aval;
     jint aval_relative;
@@ -579,6 +1069,22 @@ blitSrcOver8888_pre(Renderer *rdr, jint height) {
     maxX = rdr->_maxTouched;
     w = (maxX >= minX) ? (maxX - minX + 1) : 0;
 
+    kernel = currentBlitKernel();
+    if (kernel != BLIT_KERNEL_C && imagePixelStride == 1) {
+        jbyte coverage[COVERAGE_CHUNK];
+        jint x, n;
+        for (j = 0; j < height; j++) {
+            aval_relative = 0;
+            for (x = 0; x < w; x += n) {
+                n = deltasToCoverage(alpha + x, w - x, &aval_relative, alphaMap, JNI_TRUE, coverage);
+                srcOverRow(kernel, intData + imageOffset + minX + x, coverage, n,
+                    calpha, cred, cgreen, cblue);
+            }
+            imageOffset += imageScanlineStride;
+        }
+        return;
+    }
+
     for (j = 0; j < height; j++) {
         iidx = imageOffset + minX * imagePixelStride;
 
@@ -607,7 +1113,7 @@ blitSrcOver8888_pre(Renderer *rdr, jint height) {
 
 void
 blitSrcOverMask8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, kernel;
     jint minX, maxX, w;
     jint iidx, aval;
 
@@ -630,6 +1136,17 @@ blitSrcOverMask8888_pre(Renderer *rdr, jint height) {
     maxX = rdr->_maxTouched;
     w = (maxX >= minX) ? (maxX - minX + 1) : 0;
 
+    kernel = currentBlitKernel();
+    if (kernel != BLIT_KERNEL_C && imagePixelStride == 1) {
+        for (j = 0; j < height; j++) {
+            srcOverRow(kernel, intData + imageOffset + minX, alpha + alphaOffset, w,
+                calpha, cred, cgreen, cblue);
+            imageOffset += imageScanlineStride;
+            alphaOffset += alphaStride;
+        }
+        return;
+    }
+
     for (j = 0; j < height; j++) {
         iidx = imageOffset + minX * imagePixelStride;
 
@@ -711,7 +1228,7 @@ blitSrcOverLCDMask8888_pre(Renderer *rdr, jint height) {
 
 void
 blitPTSrcOver8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, kernel;
     jint minX, maxX, w;
     jint cval, aidx, iidx, aval;
     jint aval_relative;
@@ -733,6 +1250,21 @@ blitPTSrcOver8888_pre(Renderer *rdr, jint height) {
     maxX = rdr->_maxTouched;
     w = (maxX >= minX) ? (maxX - minX + 1) : 0;
 
+    kernel = currentBlitKernel();
+    if (kernel != BLIT_KERNEL_C && imagePixelStride == 1) {
+        jbyte coverage[COVERAGE_CHUNK];
+        jint x, n;
+        for (j = 0; j < height; j++) {
+            aval_relative = 0;
+            for (x = 0; x < w; x += n) {
+                n = deltasToCoverage(alpha + x, w - x, &aval_relative, alphaMap, JNI_TRUE, coverage);
+                srcOverPTRow(kernel, intData + imageOffset + minX + x, coverage, paint + x, n);
+            }
+            imageOffset += imageScanlineStride;
+        }
+        return;
+    }
+
     for (j = 0; j < height; j++) {
         aidx = 0;
         iidx = imageOffset + minX * imagePixelStride;
@@ -769,7 +1301,7 @@ blitPTSrcOver8888_pre(Renderer *rdr, jint height) {
 
 void
 blitPTSrcOverMask8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, kernel;
     jint minX, maxX, w;
     jint cval, aidx, iidx, aval;
 
@@ -789,6 +1321,15 @@ blitPTSrcOverMask8888_pre(Renderer *rdr, jint height) {
     maxX = rdr->_maxTouched;
     w = (maxX >= minX) ? (maxX - minX + 1) : 0;
 
+    kernel = currentBlitKernel();
+    if (kernel != BLIT_KERNEL_C && imagePixelStride == 1) {
+        for (j = 0; j < height; j++) {
+            srcOverPTRow(kernel, intData + imageOffset + minX, alpha + alphaOffset, paint, w);
+            imageOffset += imageScanlineStride;
+        }
+        return;
+    }
+
     for (j = 0; j < height; j++) {
         aidx = 0;
         iidx = imageOffset + minX * imagePixelStride;
@@ -34,6 +34,18 @@
 
 void initGammaArrays(jfloat gamma);
 
+/*
+ * The SrcOver and Src blitters have SSE2 and AVX2 variants on x86, which
+ * produce the same pixels as the C code. The best variant the processor
+ * supports is used unless it is limited with setMaxBlitKernel(), which
+ * returns the variant then in use.
+ */
+#define BLIT_KERNEL_C    0
+#define BLIT_KERNEL_SSE2 1
+#define BLIT_KERNEL_AVX2 2
+
+jint setMaxBlitKernel(jint maxKernel);
+
 void genLinearGradientPaint(Renderer *rdr, jint height);
 void genRadialGradientPaint(Renderer *rdr, jint height);
 void genTexturePaint(Renderer *rdr, jint height);
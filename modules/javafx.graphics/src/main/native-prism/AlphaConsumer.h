@@ -30,12 +30,26 @@
 extern "C" {
 #endif
 
+// Coverage of a TILE_SIZE x TILE_SIZE block of a sparse mask.
+#define TILE_LG_SIZE    5
+#define TILE_SIZE       (1 << TILE_LG_SIZE)
+#define TILE_EMPTY      0
+#define TILE_PARTIAL    1
+#define TILE_FULL       2
+
 typedef struct {
     jint originX;
     jint originY;
     jint width;
     jint height;
     jbyte *alphas;
+    // Optional sparse output.  When tileFlags is set, only the covered span
+    // of each row is written to alphas and stored in rowSpans as 2 indices,
+    // from and to, relative to originX.  tileFlags then gets a TILE_* value
+    // for each tile, row by row.  The bytes of alphas outside of the spans
+    // are zeroed in partial tiles, and left alone in empty and full tiles.
+    jint *rowSpans;
+    jbyte *tileFlags;
 //    public void setMaxAlpha(jint maxalpha);
 //    public void setAndClearRelativeAlphas(jint alphaDeltas[], jint pix_y,
 //                                          jint firstdelta, jint lastdelta);
@@ -102,6 +102,33 @@ void Dasher_init(Dasher *pDasher,
     Dasher_reset(pDasher, dash, numdashes, phase);
 }
 
+// Same as Dasher_init, for a Dasher which was used for another path
+// and keeps its buffer.
+void Dasher_reuse(Dasher *pDasher,
+                  PathConsumer *out,
+                  jfloat dash[], jint numdashes,
+                  jfloat phase)
+{
+    jfloat *firstSegmentsBuffer = this.firstSegmentsBuffer;
+    jint firstSegmentsBufferSIZE = this.firstSegmentsBufferSIZE;
+
+    memset(pDasher, 0, sizeof(Dasher));
+    PathConsumer_init(&this.consumer,
+                      Dasher_MoveTo,
+                      Dasher_LineTo,
+                      Dasher_QuadTo,
+                      Dasher_CurveTo,
+                      Dasher_ClosePath,
+                      Dasher_PathDone);
+
+    this.firstSegmentsBufferSIZE = firstSegmentsBufferSIZE;
+    this.firstSegmentsBuffer = firstSegmentsBuffer;
+    this.firstSegidx = 0;
+
+    this.out = out;
+    Dasher_reset(pDasher, dash, numdashes, phase);
+}
+
 #define MAX_CYCLES 16000000.0f
 void Dasher_reset(Dasher *pDasher, jfloat dash[], jint ndashes, jfloat phase) {
     jint sidx;
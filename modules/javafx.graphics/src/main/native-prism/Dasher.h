@@ -132,6 +132,11 @@ void Dasher_init(Dasher *pDasher,
                  jfloat dash[], jint numdashes,
                  jfloat phase);
 
+void Dasher_reuse(Dasher *pDasher,
+                  PathConsumer *out,
+                  jfloat dash[], jint numdashes,
+                  jfloat phase);
+
 void Dasher_reset(Dasher *pDasher, jfloat dash[], jint ndashes, jfloat phase);
 
 void Dasher_destroy(Dasher *pDasher);
@@ -27,6 +27,7 @@
 #ifdef ANDROID_NDK
 #include <stddef.h>
 #endif
+#include <stdlib.h>
 #include "com_sun_prism_impl_shape_NativePiscesRasterizer.h"
 
 #include "Renderer.h"
@@ -35,6 +36,14 @@
 #include "Transformer.h"
 #include "AlphaConsumer.h"
 
+#if defined (_LP64) || defined(_WIN64)
+#define jlong_to_ptr(a) ((void*)(a))
+#define ptr_to_jlong(a) ((jlong)(a))
+#else
+#define jlong_to_ptr(a) ((void*)(int)(a))
+#define ptr_to_jlong(a) ((jlong)(int)(a))
+#endif
+
 #define SEG(T) com_sun_prism_impl_shape_NativePiscesRasterizer_SEG_ ## T
 
 #define SEG_MOVETO   SEG(MOVETO)
@@ -43,6 +52,13 @@
 #define SEG_CUBICTO  SEG(CUBICTO)
 #define SEG_CLOSE    SEG(CLOSE)
 
+#if TILE_LG_SIZE != com_sun_prism_impl_shape_NativePiscesRasterizer_TILE_LG_SIZE || \
+    TILE_EMPTY != com_sun_prism_impl_shape_NativePiscesRasterizer_TILE_EMPTY || \
+    TILE_PARTIAL != com_sun_prism_impl_shape_NativePiscesRasterizer_TILE_PARTIAL || \
+    TILE_FULL != com_sun_prism_impl_shape_NativePiscesRasterizer_TILE_FULL
+#error "tile constants of AlphaConsumer.h and NativePiscesRasterizer.java differ"
+#endif
+
 #define NPException    "java/lang/NullPointerException"
 #define AIOOBException "java/lang/ArrayIndexOutOfBoundsException"
 #define IError         "java/lang/InternalError"
@@ -71,6 +87,78 @@ static void Throw(JNIEnv *env, char *throw_class_name, char *detail) {
     }
 }
 
+// State kept by a NativePiscesRasterizer from one path to the next, so
+// that the buffers of its renderer, stroker and dasher are only allocated
+// when they need to grow.
+typedef struct {
+    Renderer renderer;
+    Stroker stroker;
+    Dasher dasher;
+    jboolean hasDasher;
+} RasterizerContext;
+
+static char * feedPath
+    (PathConsumer *consumer,
+     jfloat *coords, jint coordSize,
+     jbyte *commands, jint numCommands)
+{
+    char *failure = NULL;
+    jint cmdoff, coordoff = 0;
+    for (cmdoff = 0; cmdoff < numCommands && failure == NULL; cmdoff++) {
+        switch (commands[cmdoff]) {
+            case SEG_MOVETO:
+                if (coordoff + 2 > coordSize) {
+                    failure = "[not enough coordinates for moveTo";
+                } else {
+                    consumer->moveTo(consumer,
+                                     coords[coordoff+0], coords[coordoff+1]);
+                    coordoff += 2;
+                }
+                break;
+            case SEG_LINETO:
+                if (coordoff + 2 > coordSize) {
+                    failure = "[not enough coordinates for lineTo";
+                } else {
+                    consumer->lineTo(consumer,
+                                     coords[coordoff+0], coords[coordoff+1]);
+                    coordoff += 2;
+                }
+                break;
+            case SEG_QUADTO:
+                if (coordoff + 4 > coordSize) {
+                    failure = "[not enough coordinates for quadTo";
+                } else {
+                    consumer->quadTo(consumer,
+                                     coords[coordoff+0], coords[coordoff+1],
+                                     coords[coordoff+2], coords[coordoff+3]);
+                    coordoff += 4;
+                }
+                break;
+            case SEG_CUBICTO:
+                if (coordoff + 6 > coordSize) {
+                    failure = "[not enough coordinates for curveTo";
+                } else {
+                    consumer->curveTo(consumer,
+                                      coords[coordoff+0], coords[coordoff+1],
+                                      coords[coordoff+2], coords[coordoff+3],
+                                      coords[coordoff+4], coords[coordoff+5]);
+                    coordoff += 6;
+                }
+                break;
+            case SEG_CLOSE:
+                consumer->closePath(consumer);
+                break;
+            default:
+                failure = "unrecognized Path segment";
+                break;
+        }
+    }
+    if (failure == NULL) {
+        consumer->pathDone(consumer);
+    }
+    return failure;
+}
+
 static char * feedConsumer
     (JNIEnv *env, PathConsumer *consumer,
      jfloatArray coordsArray, jint coordSize,
@@ -87,66 +175,77 @@ static char * feedConsumer
         if (commands == NULL) {
             failure = "";
         } else {
-            jint cmdoff, coordoff = 0;
-            for (cmdoff = 0; cmdoff < numCommands && failure == NULL; cmdoff++) {
-                switch (commands[cmdoff]) {
-                    case SEG_MOVETO:
-                        if (coordoff + 2 > coordSize) {
-                            failure = "[not enough coordinates for moveTo";
-                        } else {
-                            consumer->moveTo(consumer,
-                                             coords[coordoff+0], coords[coordoff+1]);
-                            coordoff += 2;
-                        }
-                        break;
-                    case SEG_LINETO:
-                        if (coordoff + 2 > coordSize) {
-                            failure = "[not enough coordinates for lineTo";
-                        } else {
-                            consumer->lineTo(consumer,
-                                             coords[coordoff+0], coords[coordoff+1]);
-                            coordoff += 2;
-                        }
-                        break;
-                    case SEG_QUADTO:
-                        if (coordoff + 4 > coordSize) {
-                            failure = "[not enough coordinates for quadTo";
-                        } else {
-                            consumer->quadTo(consumer,
-                                             coords[coordoff+0], coords[coordoff+1],
-                                             coords[coordoff+2], coords[coordoff+3]);
-                            coordoff += 4;
-                        }
-                        break;
-                    case SEG_CUBICTO:
-                        if (coordoff + 6 > coordSize) {
-                            failure = "[not enough coordinates for curveTo";
-                        } else {
-                            consumer->curveTo(consumer,
-                                              coords[coordoff+0], coords[coordoff+1],
-                                              coords[coordoff+2], coords[coordoff+3],
-                                              coords[coordoff+4], coords[coordoff+5]);
-                            coordoff += 6;
-                        }
-                        break;
-                    case SEG_CLOSE:
-                        consumer->closePath(consumer);
-                        break;
-                    default:
-                        failure = "unrecognized Path segment";
-                        break;
-                }
-            }
+            failure = feedPath(consumer, coords, coordSize, commands, numCommands);
             (*env)->ReleasePrimitiveArrayCritical(env, commandsArray, commands, JNI_ABORT);
         }
         (*env)->ReleasePrimitiveArrayCritical(env, coordsArray, coords, JNI_ABORT);
-        if (failure == NULL) {
-            consumer->pathDone(consumer);
-        }
     }
     return failure;
 }
 
+static void throwFailure(JNIEnv *env, char *failure) {
+    if (*failure != 0) {
+        if (*failure == '[') {
+            Throw(env, AIOOBException, failure + 1);
+        } else {
+            Throw(env, IError, failure);
+        }
+    }
+}
+
+/*
+ * Reports the output bounds and fills the mask, and the spans and tiles
+ * when they are given, once the path was fed to the renderer.
+ */
+static void produceAlphas
+    (JNIEnv *env, Renderer *pRenderer, char *failure, jint bounds[],
+     jintArray boundsArray, jbyteArray maskArray,
+     jintArray spansArray, jbyteArray tilesArray)
+{
+    if (failure == NULL) {
+        Renderer_getOutputBounds(pRenderer, bounds);
+        (*env)->SetIntArrayRegion(env, boundsArray, 0, 4, bounds);
+        if (bounds[0] < bounds[2] && bounds[1] < bounds[3]) {
+            AlphaConsumer ac = {
+                bounds[0],
+                bounds[1],
+                bounds[2] - bounds[0],
+                bounds[3] - bounds[1],
+            };
+            jint tiles = ((ac.width + TILE_SIZE - 1) >> TILE_LG_SIZE) *
+                         ((ac.height + TILE_SIZE - 1) >> TILE_LG_SIZE);
+            if ((*env)->GetArrayLength(env, maskArray) / ac.width < ac.height) {
+                Throw(env, AIOOBException, "maskArray");
+            } else if (tilesArray != NULL &&
+                       ((*env)->GetArrayLength(env, spansArray) / 2 < ac.height ||
+                        (*env)->GetArrayLength(env, tilesArray) < tiles))
+            {
+                Throw(env, AIOOBException, "spansArray");
+            } else {
+                ac.alphas = (*env)->GetPrimitiveArrayCritical(env, maskArray, 0);
+                if (ac.alphas != NULL) {
+                    if (tilesArray == NULL) {
+                        Renderer_produceAlphas(pRenderer, &ac);
+                    } else {
+                        ac.rowSpans = (*env)->GetPrimitiveArrayCritical(env, spansArray, 0);
+                        if (ac.rowSpans != NULL) {
+                            ac.tileFlags = (*env)->GetPrimitiveArrayCritical(env, tilesArray, 0);
+                            if (ac.tileFlags != NULL) {
+                                Renderer_produceAlphas(pRenderer, &ac);
+                                (*env)->ReleasePrimitiveArrayCritical(env, tilesArray, ac.tileFlags, 0);
+                            }
+                            (*env)->ReleasePrimitiveArrayCritical(env, spansArray, ac.rowSpans, 0);
+                        }
+                    }
+                    (*env)->ReleasePrimitiveArrayCritical(env, maskArray, ac.alphas, 0);
+                }
+            }
+        }
+    } else {
+        throwFailure(env, failure);
+    }
+}
+
 /*
  * Class:     com_sun_prism_impl_shape_NativePiscesRasterizer
  * Method:    init
@@ -162,19 +261,53 @@ Java_com_sun_prism_impl_shape_NativePiscesRasterizer_init
 
 /*
  * Class:     com_sun_prism_impl_shape_NativePiscesRasterizer
- * Method:    produceFillAlphas
- * Signature: ([F[BIZDDDDDD[I[B)V
+ * Method:    createContext
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL
+Java_com_sun_prism_impl_shape_NativePiscesRasterizer_createContext
+    (JNIEnv *env, jclass klass)
+{
+    RasterizerContext *ctx = calloc(1, sizeof(RasterizerContext));
+    if (ctx == NULL) {
+        return 0L;
+    }
+    Renderer_init(&ctx->renderer);
+    Stroker_init(&ctx->stroker, &ctx->renderer.consumer, 1.0f, 0, 0, 10.0f);
+    return ptr_to_jlong(ctx);
+}
+
+/*
+ * Class:     com_sun_prism_impl_shape_NativePiscesRasterizer
+ * Method:    disposeContext
+ * Signature: (J)V
  */
 JNIEXPORT void JNICALL
-Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceFillAlphas
-    (JNIEnv *env, jclass klass,
+Java_com_sun_prism_impl_shape_NativePiscesRasterizer_disposeContext
+    (JNIEnv *env, jclass klass, jlong context)
+{
+    RasterizerContext *ctx = jlong_to_ptr(context);
+    if (ctx != NULL) {
+        if (ctx->hasDasher) {
+            Dasher_destroy(&ctx->dasher);
+        }
+        Stroker_destroy(&ctx->stroker);
+        Renderer_destroy(&ctx->renderer);
+        free(ctx);
+    }
+}
+
+static void fillPath
+    (JNIEnv *env, RasterizerContext *ctx,
      jfloatArray coordsArray, jbyteArray commandsArray, jint numCommands, jboolean nonzero,
      jdouble mxx, jdouble mxy, jdouble mxt, jdouble myx, jdouble myy, jdouble myt,
-     jintArray boundsArray, jbyteArray maskArray)
+     jintArray boundsArray, jbyteArray maskArray,
+     jintArray spansArray, jbyteArray tilesArray)
 {
     jint bounds[4];
     Transformer transformer;
     Renderer renderer;
+    Renderer *pRenderer = (ctx == NULL) ? &renderer : &ctx->renderer;
     PathConsumer *consumer;
     char *failure;
     jint coordSize;
@@ -188,62 +321,39 @@ Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceFillAlphas
 
     (*env)->GetIntArrayRegion(env, boundsArray, 0, 4, bounds);
     coordSize = (*env)->GetArrayLength(env, coordsArray);
-    Renderer_init(&renderer);
-    Renderer_reset(&renderer,
+    if (ctx == NULL) {
+        Renderer_init(&renderer);
+    }
+    Renderer_reset(pRenderer,
                    bounds[0], bounds[1], bounds[2] - bounds[0], bounds[3] - bounds[1],
                    nonzero ? WIND_NON_ZERO : WIND_EVEN_ODD);
-    consumer = Transformer_init(&transformer, &renderer.consumer,
+    consumer = Transformer_init(&transformer, &pRenderer->consumer,
                                 mxx, mxy, mxt, myx, myy, myt);
     failure = feedConsumer(env, consumer,
                            coordsArray, coordSize, commandsArray, numCommands);
-    if (failure == NULL) {
-        Renderer_getOutputBounds(&renderer, bounds);
-        (*env)->SetIntArrayRegion(env, boundsArray, 0, 4, bounds);
-        if (bounds[0] < bounds[2] && bounds[1] < bounds[3]) {
-            AlphaConsumer ac = {
-                bounds[0],
-                bounds[1],
-                bounds[2] - bounds[0],
-                bounds[3] - bounds[1],
-            };
-            if ((*env)->GetArrayLength(env, maskArray) / ac.width < ac.height) {
-                Throw(env, AIOOBException, "maskArray");
-            } else {
-                ac.alphas = (*env)->GetPrimitiveArrayCritical(env, maskArray, 0);
-                if (ac.alphas != NULL) {
-                    Renderer_produceAlphas(&renderer, &ac);
-                    (*env)->ReleasePrimitiveArrayCritical(env, maskArray, ac.alphas, 0);
-                }
-            }
-        }
-    } else if (*failure != 0) {
-        if (*failure == '[') {
-            Throw(env, AIOOBException, failure + 1);
-        } else {
-            Throw(env, IError, failure);
-        }
+    produceAlphas(env, pRenderer, failure, bounds,
+                  boundsArray, maskArray, spansArray, tilesArray);
+    if (ctx == NULL) {
+        Renderer_destroy(&renderer);
     }
-    Renderer_destroy(&renderer);
 }
 
-/*
- * Class:     com_sun_prism_impl_shape_NativePiscesRasterizer
- * Method:    produceStrokeAlphas
- * Signature: ([F[BIFIIF[FFDDDDDD[I[B)V
- */
-JNIEXPORT void JNICALL
-Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceStrokeAlphas
-    (JNIEnv *env, jclass klass,
+static void strokePath
+    (JNIEnv *env, RasterizerContext *ctx,
      jfloatArray coordsArray, jbyteArray commandsArray, jint numCommands,
      jfloat linewidth, jint linecap, jint linejoin, jfloat miterlimit,
      jfloatArray dashArray, jfloat dashphase,
      jdouble mxx, jdouble mxy, jdouble mxt, jdouble myx, jdouble myy, jdouble myt,
-     jintArray boundsArray, jbyteArray maskArray)
+     jintArray boundsArray, jbyteArray maskArray,
+     jintArray spansArray, jbyteArray tilesArray)
 {
     jint bounds[4];
     Stroker stroker;
     Dasher dasher;
     Renderer renderer;
+    Stroker *pStroker = (ctx == NULL) ? &stroker : &ctx->stroker;
+    Dasher *pDasher = (ctx == NULL) ? &dasher : &ctx->dasher;
+    Renderer *pRenderer = (ctx == NULL) ? &renderer : &ctx->renderer;
     Transformer transformer;
     PathConsumer *consumer;
     jint coordSize;
@@ -259,58 +369,142 @@ Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceStrokeAlphas
 
     (*env)->GetIntArrayRegion(env, boundsArray, 0, 4, bounds);
     coordSize = (*env)->GetArrayLength(env, coordsArray);
-    Renderer_init(&renderer);
-    Renderer_reset(&renderer,
+    if (ctx == NULL) {
+        Renderer_init(&renderer);
+    }
+    Renderer_reset(pRenderer,
                    bounds[0], bounds[1], bounds[2] - bounds[0], bounds[3] - bounds[1],
                    WIND_NON_ZERO);
-    consumer = Transformer_init(&transformer, &renderer.consumer,
+    consumer = Transformer_init(&transformer, &pRenderer->consumer,
                                 mxx, mxy, mxt, myx, myy, myt);
-    Stroker_init(&stroker, consumer, linewidth, linecap, linejoin, miterlimit);
+    if (ctx == NULL) {
+        Stroker_init(&stroker, consumer, linewidth, linecap, linejoin, miterlimit);
+    } else {
+        Stroker_reuse(pStroker, consumer, linewidth, linecap, linejoin, miterlimit);
+    }
     if (dashArray == NULL) {
         dashes = NULL;
-        consumer = &stroker.consumer;
+        consumer = &pStroker->consumer;
     } else {
         jint numdashes = (*env)->GetArrayLength(env, dashArray);
         dashes = (*env)->GetPrimitiveArrayCritical(env, dashArray, 0);
         if (dashes == NULL) {
+            if (ctx == NULL) {
+                Stroker_destroy(&stroker);
+                Renderer_destroy(&renderer);
+            }
             return;
         }
-        Dasher_init(&dasher, &stroker.consumer, dashes, numdashes, dashphase);
-        consumer = &dasher.consumer;
+        if (ctx == NULL || !ctx->hasDasher) {
+            Dasher_init(pDasher, &pStroker->consumer, dashes, numdashes, dashphase);
+            if (ctx != NULL) {
+                ctx->hasDasher = JNI_TRUE;
+            }
+        } else {
+            Dasher_reuse(pDasher, &pStroker->consumer, dashes, numdashes, dashphase);
+        }
+        consumer = &pDasher->consumer;
     }
     failure = feedConsumer(env, consumer,
                            coordsArray, coordSize, commandsArray, numCommands);
     if (dashArray != NULL) {
         (*env)->ReleasePrimitiveArrayCritical(env, dashArray, dashes, JNI_ABORT);
-        Dasher_destroy(&dasher);
-    }
-    Stroker_destroy(&stroker);
-    if (failure == NULL) {
-        Renderer_getOutputBounds(&renderer, bounds);
-        (*env)->SetIntArrayRegion(env, boundsArray, 0, 4, bounds);
-        if (bounds[0] < bounds[2] && bounds[1] < bounds[3]) {
-            AlphaConsumer ac = {
-                bounds[0],
-                bounds[1],
-                bounds[2] - bounds[0],
-                bounds[3] - bounds[1],
-            };
-            if ((*env)->GetArrayLength(env, maskArray) / ac.width < ac.height) {
-                Throw(env, AIOOBException, "Mask");
-            } else {
-                ac.alphas = (*env)->GetPrimitiveArrayCritical(env, maskArray, 0);
-                if (ac.alphas != NULL) {
-                    Renderer_produceAlphas(&renderer, &ac);
-                    (*env)->ReleasePrimitiveArrayCritical(env, maskArray, ac.alphas, 0);
-                }
-            }
-        }
-    } else if (*failure != 0) {
-        if (*failure == '[') {
-            Throw(env, AIOOBException, failure + 1);
-        } else {
-            Throw(env, IError, failure);
+        if (ctx == NULL) {
+            Dasher_destroy(&dasher);
         }
     }
-    Renderer_destroy(&renderer);
+    if (ctx == NULL) {
+        Stroker_destroy(&stroker);
+    }
+    produceAlphas(env, pRenderer, failure, bounds,
+                  boundsArray, maskArray, spansArray, tilesArray);
+    if (ctx == NULL) {
+        Renderer_destroy(&renderer);
+    }
+}
+
+/*
+ * Class:     com_sun_prism_impl_shape_NativePiscesRasterizer
+ * Method:    produceFillAlphas
+ * Signature: (J[F[BIZDDDDDD[I[B)V
+ */
+JNIEXPORT void JNICALL
+Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceFillAlphas
+    (JNIEnv *env, jclass klass,
+     jlong context,
+     jfloatArray coordsArray, jbyteArray commandsArray, jint numCommands, jboolean nonzero,
+     jdouble mxx, jdouble mxy, jdouble mxt, jdouble myx, jdouble myy, jdouble myt,
+     jintArray boundsArray, jbyteArray maskArray)
+{
+    fillPath(env, jlong_to_ptr(context), coordsArray, commandsArray, numCommands, nonzero,
+             mxx, mxy, mxt, myx, myy, myt,
+             boundsArray, maskArray, NULL, NULL);
+}
+
+/*
+ * Class:     com_sun_prism_impl_shape_NativePiscesRasterizer
+ * Method:    produceFillTiles
+ * Signature: (J[F[BIZDDDDDD[I[B[I[B)V
+ */
+JNIEXPORT void JNICALL
+Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceFillTiles
+    (JNIEnv *env, jclass klass,
+     jlong context,
+     jfloatArray coordsArray, jbyteArray commandsArray, jint numCommands, jboolean nonzero,
+     jdouble mxx, jdouble mxy, jdouble mxt, jdouble myx, jdouble myy, jdouble myt,
+     jintArray boundsArray, jbyteArray maskArray,
+     jintArray spansArray, jbyteArray tilesArray)
+{
+    CheckNPE(env, spansArray);
+    CheckNPE(env, tilesArray);
+    fillPath(env, jlong_to_ptr(context), coordsArray, commandsArray, numCommands, nonzero,
+             mxx, mxy, mxt, myx, myy, myt,
+             boundsArray, maskArray, spansArray, tilesArray);
+}
+
+/*
+ * Class:     com_sun_prism_impl_shape_NativePiscesRasterizer
+ * Method:    produceStrokeAlphas
+ * Signature: (J[F[BIFIIF[FFDDDDDD[I[B)V
+ */
+JNIEXPORT void JNICALL
+Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceStrokeAlphas
+    (JNIEnv *env, jclass klass,
+     jlong context,
+     jfloatArray coordsArray, jbyteArray commandsArray, jint numCommands,
+     jfloat linewidth, jint linecap, jint linejoin, jfloat miterlimit,
+     jfloatArray dashArray, jfloat dashphase,
+     jdouble mxx, jdouble mxy, jdouble mxt, jdouble myx, jdouble myy, jdouble myt,
+     jintArray boundsArray, jbyteArray maskArray)
+{
+    strokePath(env, jlong_to_ptr(context), coordsArray, commandsArray, numCommands,
+               linewidth, linecap, linejoin, miterlimit,
+               dashArray, dashphase,
+               mxx, mxy, mxt, myx, myy, myt,
+               boundsArray, maskArray, NULL, NULL);
+}
+
+/*
+ * Class:     com_sun_prism_impl_shape_NativePiscesRasterizer
+ * Method:    produceStrokeTiles
+ * Signature: (J[F[BIFIIF[FFDDDDDD[I[B[I[B)V
+ */
+JNIEXPORT void JNICALL
+Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceStrokeTiles
+    (JNIEnv *env, jclass klass,
+     jlong context,
+     jfloatArray coordsArray, jbyteArray commandsArray, jint numCommands,
+     jfloat linewidth, jint linecap, jint linejoin, jfloat miterlimit,
+     jfloatArray dashArray, jfloat dashphase,
+     jdouble mxx, jdouble mxy, jdouble mxt, jdouble myx, jdouble myy, jdouble myt,
+     jintArray boundsArray, jbyteArray maskArray,
+     jintArray spansArray, jbyteArray tilesArray)
+{
+    CheckNPE(env, spansArray);
+    CheckNPE(env, tilesArray);
+    strokePath(env, jlong_to_ptr(context), coordsArray, commandsArray, numCommands,
+               linewidth, linecap, linejoin, miterlimit,
+               dashArray, dashphase,
+               mxx, mxy, mxt, myx, myy, myt,
+               boundsArray, maskArray, spansArray, tilesArray);
 }
@@ -44,10 +44,13 @@ static void ScanlineIterator_reset(ScanlineIterator *pIterator,
 static void ScanlineIterator_init(ScanlineIterator *pIterator,
                                   Renderer *pRenderer)
 {
-    this.crossings = new_int(INIT_CROSSINGS_SIZE);
-    this.crossingsSIZE = INIT_CROSSINGS_SIZE;
-    this.edgePtrs = new_int(INIT_CROSSINGS_SIZE);
-    this.edgePtrsSIZE = INIT_CROSSINGS_SIZE;
+    // The buffers are kept by the renderer from one path to the next
+    if (this.crossings == NULL) {
+        this.crossings = new_int(INIT_CROSSINGS_SIZE);
+        this.crossingsSIZE = INIT_CROSSINGS_SIZE;
+        this.edgePtrs = new_int(INIT_CROSSINGS_SIZE);
+        this.edgePtrsSIZE = INIT_CROSSINGS_SIZE;
+    }
     ScanlineIterator_reset(pIterator, pRenderer);
 }
 
@@ -408,6 +411,7 @@ void Renderer_reset(Renderer *pRenderer,
         // The last 2 entries are ignored and only used to store unused
         // values for segments ending on the last line of the bounds
         // so we can avoid having to check the bounds on this array.
+        free(this.edgeBuckets);
         this.edgeBuckets = new_int(numBuckets*2 + 2);
         this.edgeBucketsSIZE = numBuckets*2 + 2;
     } else {
@@ -424,6 +428,13 @@ void Renderer_reset(Renderer *pRenderer,
 }
 
 void Renderer_destroy(Renderer *pRenderer) {
+    ScanlineIterator_destroy(&pRenderer->iterator);
+    free(pRenderer->alphaRow);
+    pRenderer->alphaRow = NULL;
+    pRenderer->alphaRowSIZE = 0;
+    free(pRenderer->tileCounts);
+    pRenderer->tileCounts = NULL;
+    pRenderer->tileCountsSIZE = 0;
     free(pRenderer->edgeBuckets);
     pRenderer->edgeBuckets = NULL;
     pRenderer->edgeBucketsSIZE = 0;
@@ -504,6 +515,22 @@ static void setAndClearRelativeAlphas(AlphaConsumer *pAC,
                                       jint alphaRow[], jint pix_y,
                                       jint pix_from, jint pix_to);
 
+// State of the sparse output of Renderer_produceAlphas.
+typedef struct {
+    // For each tile column of the current band of rows, the number of
+    // covered pixels followed by the number of fully covered pixels.
+    jint *counts;
+    jint tilesX;
+    jint tilesY;
+    jint bandsDone;
+} TileCounter;
+
+static void setAndClearRelativeSpan(AlphaConsumer *pAC, TileCounter *pTC,
+                                    jint alphaRow[], jint pix_y,
+                                    jint pix_from, jint pix_to);
+
+static void finishTileBands(AlphaConsumer *pAC, TileCounter *pTC, jint bandsDone);
+
 void Renderer_produceAlphas(Renderer *pRenderer, AlphaConsumer *pAC) {
 //    ac.setMaxAlpha(MAX_AA_ALPHA);
 
@@ -513,19 +540,46 @@ void Renderer_produceAlphas(Renderer *pRenderer, AlphaConsumer *pAC) {
     jint bboxx0, bboxx1;
     jint pix_minX, pix_maxX;
     jint y;
-    ScanlineIterator it;
+    ScanlineIterator *pIt = &this.iterator;
+    TileCounter tc;
 
     // add 2 to better deal with the last pixel in a pixel row.
     jint width = pAC->width;
-    jint savedAlpha[1024];
     jint *alpha;
-    if (1024 < width+2) {
-        alpha = new_int(width+2);
-    } else {
-        alpha = savedAlpha;
+    if (this.alphaRowSIZE < width+2) {
+        free(this.alphaRow);
+        this.alphaRow = new_int(width+2);
+        this.alphaRowSIZE = width+2;
     }
+    alpha = this.alphaRow;
     Arrays_fill(alpha, 0, width+2, 0);
 
+    tc.counts = NULL;
+    if (pAC->tileFlags != NULL) {
+        tc.tilesX = (width + TILE_SIZE - 1) >> TILE_LG_SIZE;
+        tc.tilesY = (pAC->height + TILE_SIZE - 1) >> TILE_LG_SIZE;
+        tc.bandsDone = 0;
+        if (this.tileCountsSIZE < tc.tilesX * 2) {
+            free(this.tileCounts);
+            this.tileCounts = new_int(tc.tilesX * 2);
+            this.tileCountsSIZE = (this.tileCounts == NULL) ? 0 : tc.tilesX * 2;
+        } else {
+            Arrays_fill(this.tileCounts, 0, tc.tilesX * 2, 0);
+        }
+        tc.counts = this.tileCounts;
+        if (tc.counts == NULL) {
+            // Fall back to the dense mask, with every tile partial
+            memset(pAC->tileFlags, TILE_PARTIAL, tc.tilesX * tc.tilesY);
+            for (y = 0; y < pAC->height; y++) {
+                pAC->rowSpans[y*2] = 0;
+                pAC->rowSpans[y*2 + 1] = width;
+            }
+        } else {
+            // Rows without crossings are not emitted, their span is empty
+            Arrays_fill(pAC->rowSpans, 0, pAC->height * 2, 0);
+        }
+    }
+
     bboxx0 = pAC->originX << SUBPIXEL_LG_POSITIONS_X;
     bboxx1 = bboxx0 + (width << SUBPIXEL_LG_POSITIONS_X);
 
@@ -535,18 +589,18 @@ void Renderer_produceAlphas(Renderer *pRenderer, AlphaConsumer *pAC) {
     // that we will emit.
     // We also need to accumulate pix_bbox*, but the iterator does it
     // for us. We will just get the values from it once this loop is done
-    pix_maxX = bboxx1 >> SUBPIXEL_LG_POSITIONS_X;
-    pix_minX = bboxx0 >> SUBPIXEL_LG_POSITIONS_Y;
+    pix_maxX = bboxx0 >> SUBPIXEL_LG_POSITIONS_X;
+    pix_minX = bboxx1 >> SUBPIXEL_LG_POSITIONS_X;
 
     y = this.boundsMinY; // needs to be declared here so we emit the last row properly.
-    ScanlineIterator_init(&it, pRenderer);
-    for ( ; ScanlineIterator_hasNext(&it, pRenderer); ) {
-        jint numCrossings = ScanlineIterator_next(&it, pRenderer);
-        jint *crossings = it.crossings;
+    ScanlineIterator_init(pIt, pRenderer);
+    for ( ; ScanlineIterator_hasNext(pIt, pRenderer); ) {
+        jint numCrossings = ScanlineIterator_next(pIt, pRenderer);
+        jint *crossings = pIt->crossings;
         jint sum, prev;
         jint i;
 
-        y = ScanlineIterator_curY(&it);
+        y = ScanlineIterator_curY(pIt);
 
         if (numCrossings > 0) {
             jint lowx = crossings[0] >> 1;
@@ -597,21 +651,32 @@ void Renderer_produceAlphas(Renderer *pRenderer, AlphaConsumer *pAC) {
         // from the last emitRow call. But this doesn't matter because
         // maxX < minX, so no row will be emitted to the cache.
         if ((y & SUBPIXEL_MASK_Y) == SUBPIXEL_MASK_Y) {
-            setAndClearRelativeAlphas(pAC, alpha, y >> SUBPIXEL_LG_POSITIONS_Y,
-                                      pix_minX, pix_maxX);
-            pix_maxX = bboxx1 >> SUBPIXEL_LG_POSITIONS_X;
-            pix_minX = bboxx0 >> SUBPIXEL_LG_POSITIONS_Y;
+            if (tc.counts != NULL) {
+                setAndClearRelativeSpan(pAC, &tc, alpha, y >> SUBPIXEL_LG_POSITIONS_Y,
+                                        pix_minX, pix_maxX);
+            } else {
+                setAndClearRelativeAlphas(pAC, alpha, y >> SUBPIXEL_LG_POSITIONS_Y,
+                                          pix_minX, pix_maxX);
+            }
+            pix_maxX = bboxx0 >> SUBPIXEL_LG_POSITIONS_X;
+            pix_minX = bboxx1 >> SUBPIXEL_LG_POSITIONS_X;
         }
     }
 
     // Emit final row.
     // Note, if y is on a MASK row then it was already sent above...
     if ((y & SUBPIXEL_MASK_Y) < SUBPIXEL_MASK_Y) {
-        setAndClearRelativeAlphas(pAC, alpha, y >> SUBPIXEL_LG_POSITIONS_Y,
-                                  pix_minX, pix_maxX);
+        if (tc.counts != NULL) {
+            setAndClearRelativeSpan(pAC, &tc, alpha, y >> SUBPIXEL_LG_POSITIONS_Y,
+                                    pix_minX, pix_maxX);
+        } else {
+            setAndClearRelativeAlphas(pAC, alpha, y >> SUBPIXEL_LG_POSITIONS_Y,
+                                      pix_minX, pix_maxX);
+        }
+    }
+    if (tc.counts != NULL) {
+        finishTileBands(pAC, &tc, tc.tilesY);
     }
-    ScanlineIterator_destroy(&it);
-    if (alpha != savedAlpha) free (alpha);
 }
 
 //@Override
@@ -672,6 +737,84 @@ static void setAndClearRelativeAlphas(AlphaConsumer *pAC,
     }
 }
 
+// Sparse variant of setAndClearRelativeAlphas, which only writes the pixels
+// in [pix_from, pix_to], the range touched by the crossings of the row.
+static void setAndClearRelativeSpan(AlphaConsumer *pAC, TileCounter *pTC,
+                                    jint alphaRow[], jint pix_y,
+                                    jint pix_from, jint pix_to)
+{
+    jint w = pAC->width;
+    jint row = pix_y - pAC->originY;
+    jint off = row * w;
+    jbyte *out = pAC->alphas;
+    jint *counts = pTC->counts;
+    jint from = Math_max(pix_from - pAC->originX, 0);
+    // the deltas of the last pixel may spill into the next one
+    jint to = Math_min(pix_to - pAC->originX + 1, w);
+    jint clearTo = Math_min(pix_to - pAC->originX + 2, w + 2);
+    jint a = 0;
+    jint i;
+
+    finishTileBands(pAC, pTC, row >> TILE_LG_SIZE);
+    if (from >= to) {
+        pAC->rowSpans[row*2] = pAC->rowSpans[row*2 + 1] = 0;
+        return;
+    }
+    for (i = from; i < to; i++) {
+        a += alphaRow[i];
+        alphaRow[i] = 0;
+        out[off+i] = alphaMap[a];
+        if (a != 0) {
+            jint *c = &counts[(i >> TILE_LG_SIZE) * 2];
+            c[0]++;
+            if (a == alphaMax) {
+                c[1]++;
+            }
+        }
+    }
+    for (; i < clearTo; i++) {
+        alphaRow[i] = 0;
+    }
+    pAC->rowSpans[row*2] = from;
+    pAC->rowSpans[row*2 + 1] = to;
+}
+
+// Sets the flags of the bands of tiles before bandsDone that are not set
+// yet, and resets the counts for the next band.
+static void finishTileBands(AlphaConsumer *pAC, TileCounter *pTC, jint bandsDone) {
+    jint w = pAC->width;
+    jint *counts = pTC->counts;
+    for (; pTC->bandsDone < bandsDone; pTC->bandsDone++) {
+        jint band = pTC->bandsDone;
+        jint y0 = band << TILE_LG_SIZE;
+        jint y1 = Math_min(y0 + TILE_SIZE, pAC->height);
+        jint t;
+        for (t = 0; t < pTC->tilesX; t++) {
+            jint x0 = t << TILE_LG_SIZE;
+            jint x1 = Math_min(x0 + TILE_SIZE, w);
+            jbyte flag;
+            if (counts[t*2] == 0) {
+                flag = TILE_EMPTY;
+            } else if (counts[t*2 + 1] == (x1 - x0) * (y1 - y0)) {
+                flag = TILE_FULL;
+            } else {
+                // Consumers read the whole tile, clear what the spans missed
+                jint y;
+                flag = TILE_PARTIAL;
+                for (y = y0; y < y1; y++) {
+                    jbyte *out = pAC->alphas + y * w;
+                    jint from = Math_min(Math_max(pAC->rowSpans[y*2], x0), x1);
+                    jint to = Math_max(Math_min(pAC->rowSpans[y*2 + 1], x1), from);
+                    memset(out + x0, 0, from - x0);
+                    memset(out + to, 0, x1 - to);
+                }
+            }
+            pAC->tileFlags[band * pTC->tilesX + t] = flag;
+            counts[t*2] = counts[t*2 + 1] = 0;
+        }
+    }
+}
+
 static jint getSubpixMinX(Renderer *pRenderer) {
     jint sampleColMin = (jint) ceil(this.edgeMinX - 0.5f);
     if (sampleColMin < this.boundsMinX) sampleColMin = this.boundsMinX;
@@ -95,6 +95,13 @@ typedef struct {
     jfloat pix_sx0, pix_sy0;
 
     Curve c;
+
+    // Buffers of Renderer_produceAlphas.  Like the edges, the crossings
+    // and the buckets, they are kept for the next paths and only grow.
+    jint *alphaRow;
+    jint alphaRowSIZE;
+    jint *tileCounts;
+    jint tileCountsSIZE;
 } Renderer;
 
 extern void Renderer_setup(jint subpixelLgPositionsX, jint subpixelLgPositionsY);
@@ -163,6 +163,33 @@ void Stroker_init(Stroker *pStroker,
     PolyStack_init(&pStroker->reverse);
 }
 
+// Same as Stroker_init, for a Stroker which was used for another path
+// and keeps the buffers of its PolyStack.
+void Stroker_reuse(Stroker *pStroker,
+                   PathConsumer *out,
+                   jfloat lineWidth,
+                   jint capStyle,
+                   jint joinStyle,
+                   jfloat miterLimit)
+{
+    PolyStack reverse = this.reverse;
+
+    memset(pStroker, 0, sizeof(Stroker));
+    PathConsumer_init(&this.consumer,
+                      Stroker_moveTo,
+                      Stroker_lineTo,
+                      Stroker_quadTo,
+                      Stroker_curveTo,
+                      Stroker_closePath,
+                      Stroker_pathDone);
+
+    this.out = out;
+    Stroker_reset(pStroker, lineWidth, capStyle, joinStyle, miterLimit);
+    this.reverse = reverse;
+    this.reverse.end = 0;
+    this.reverse.numCurves = 0;
+}
+
 void Stroker_reset(Stroker *pStroker, jfloat lineWidth,
                    jint capStyle, jint joinStyle, jfloat miterLimit)
 {
@@ -112,6 +112,13 @@ extern void Stroker_init(Stroker *pStroker,
                          jint joinStyle,
                          jfloat miterLimit);
 
+extern void Stroker_reuse(Stroker *pStroker,
+                          PathConsumer *out,
+                          jfloat lineWidth,
+                          jint capStyle,
+                          jint joinStyle,
+                          jfloat miterLimit);
+
 extern void Stroker_destroy(Stroker *pStroker);
 
 #ifdef __cplusplus
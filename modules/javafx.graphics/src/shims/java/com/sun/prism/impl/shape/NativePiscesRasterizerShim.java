@@ -27,12 +27,16 @@ package com.sun.prism.impl.shape;
 
 public class NativePiscesRasterizerShim {
 
+    public static void init(int subpixelLgPositionsX, int subpixelLgPositionsY) {
+        NativePiscesRasterizer.init(subpixelLgPositionsX, subpixelLgPositionsY);
+    }
+
     public static void produceFillAlphas(float coords[], byte commands[], int nsegs, boolean nonzero,
                                          double mxx, double mxy, double mxt,
                                          double myx, double myy, double myt,
                                          int bounds[], byte mask[]) {
         NativePiscesRasterizer.produceFillAlphas(
-                coords, commands, nsegs, nonzero,
+                0L, coords, commands, nsegs, nonzero,
                 mxx, mxy, mxt,
                 myx, myy, myt,
                 bounds, mask);
@@ -45,11 +49,59 @@ public class NativePiscesRasterizerShim {
                                            double myx, double myy, double myt,
                                            int bounds[], byte mask[]) {
         NativePiscesRasterizer.produceStrokeAlphas(
-                coords, commands, nsegs,
+                0L, coords, commands, nsegs,
+                lw, cap, join, mlimit,
+                dashes, dashoff,
+                mxx, mxy, mxt,
+                myx, myy, myt,
+                bounds, mask);
+    }
+
+    public static void produceFillTiles(float coords[], byte commands[], int nsegs, boolean nonzero,
+                                        double mxx, double mxy, double mxt,
+                                        double myx, double myy, double myt,
+                                        int bounds[], byte mask[],
+                                        int spans[], byte tiles[]) {
+        NativePiscesRasterizer.produceFillTiles(
+                0L, coords, commands, nsegs, nonzero,
+                mxx, mxy, mxt,
+                myx, myy, myt,
+                bounds, mask, spans, tiles);
+    }
+
+    public static void produceStrokeTiles(float coords[], byte commands[], int nsegs,
+                                          float lw, int cap, int join, float mlimit,
+                                          float dashes[], float dashoff,
+                                          double mxx, double mxy, double mxt,
+                                          double myx, double myy, double myt,
+                                          int bounds[], byte mask[],
+                                          int spans[], byte tiles[]) {
+        NativePiscesRasterizer.produceStrokeTiles(
+                0L, coords, commands, nsegs,
                 lw, cap, join, mlimit,
                 dashes, dashoff,
                 mxx, mxy, mxt,
                 myx, myy, myt,
+                bounds, mask, spans, tiles);
+    }
+
+    public static long createContext() {
+        return NativePiscesRasterizer.createContext();
+    }
+
+    public static void disposeContext(long context) {
+        NativePiscesRasterizer.disposeContext(context);
+    }
+
+    public static void produceFillAlphas(long context,
+                                         float coords[], byte commands[], int nsegs, boolean nonzero,
+                                         double mxx, double mxy, double mxt,
+                                         double myx, double myy, double myt,
+                                         int bounds[], byte mask[]) {
+        NativePiscesRasterizer.produceFillAlphas(
+                context, coords, commands, nsegs, nonzero,
+                mxx, mxy, mxt,
+                myx, myy, myt,
                 bounds, mask);
     }
 
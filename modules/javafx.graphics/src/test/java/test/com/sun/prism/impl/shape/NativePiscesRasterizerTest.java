@@ -28,8 +28,13 @@ package test.com.sun.prism.impl.shape;
 import com.sun.javafx.geom.PathIterator;
 import com.sun.prism.BasicStroke;
 import com.sun.prism.impl.shape.NativePiscesRasterizerShim;
+import com.sun.prism.impl.shape.TiledMaskData;
+import java.util.Arrays;
 import org.junit.Test;
 
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+
 public class NativePiscesRasterizerTest {
     static final int JOIN_BEVEL = BasicStroke.JOIN_BEVEL;
     static final int JOIN_MITER = BasicStroke.JOIN_MITER;
@@ -259,4 +264,121 @@ public class NativePiscesRasterizerTest {
                                                    1, 0, 0, 0, 1, 0,
                                                    bounds10, mask1k);
     }
+
+    @Test(expected=java.lang.NullPointerException.class)
+    public void FillTilesNullSpans() {
+        NativePiscesRasterizerShim.produceFillTiles(coords6, move_arr, 1, true,
+                                                1, 0, 0, 0, 1, 0,
+                                                bounds10, mask1k, null, new byte[1]);
+    }
+
+    @Test(expected=java.lang.NullPointerException.class)
+    public void StrokeTilesNullTiles() {
+        NativePiscesRasterizerShim.produceStrokeTiles(coords6, move_arr, 1,
+                                                  10, CAP_ROUND, JOIN_ROUND, 10, null, 0,
+                                                  1, 0, 0, 0, 1, 0,
+                                                  bounds10, mask1k, new int[20], null);
+    }
+
+    @Test(expected=java.lang.ArrayIndexOutOfBoundsException.class)
+    public void FillTilesShortSpans() {
+        NativePiscesRasterizerShim.init(3, 3);
+        NativePiscesRasterizerShim.produceFillTiles(square(0, 0, 10), square_arr, 5, true,
+                                                1, 0, 0, 0, 1, 0,
+                                                new int[] { 0, 0, 10, 10 }, mask1k,
+                                                new int[19], new byte[1]);
+    }
+
+    static final byte square_arr[] = { SEG_MOVETO, SEG_LINETO, SEG_LINETO, SEG_LINETO, SEG_CLOSE };
+
+    static float[] square(float x, float y, float size) {
+        return new float[] { x, y, x + size, y, x + size, y + size, x, y + size };
+    }
+
+    @Test
+    public void FillTilesMatchAlphas() {
+        NativePiscesRasterizerShim.init(3, 3);
+        // A 100 pixel square, with fractional edges, in 128x128 bounds
+        float coords[] = square(10.5f, 10.25f, 100);
+        int denseBounds[] = { 0, 0, 128, 128 };
+        int tiledBounds[] = { 0, 0, 128, 128 };
+        byte dense[] = new byte[128 * 128];
+        byte tiled[] = new byte[128 * 128];
+        int spans[] = new int[2 * 128];
+        byte tiles[] = new byte[16];
+
+        NativePiscesRasterizerShim.produceFillAlphas(coords, square_arr, 5, true,
+                                                 1, 0, 0, 0, 1, 0,
+                                                 denseBounds, dense);
+        NativePiscesRasterizerShim.produceFillTiles(coords, square_arr, 5, true,
+                                                1, 0, 0, 0, 1, 0,
+                                                tiledBounds, tiled, spans, tiles);
+        assertArrayEquals(denseBounds, tiledBounds);
+
+        int w = tiledBounds[2] - tiledBounds[0];
+        int h = tiledBounds[3] - tiledBounds[1];
+        int tilesX = (w + TiledMaskData.TILE_SIZE - 1) / TiledMaskData.TILE_SIZE;
+        int tilesY = (h + TiledMaskData.TILE_SIZE - 1) / TiledMaskData.TILE_SIZE;
+        int full = 0;
+        for (int ty = 0; ty < tilesY; ty++) {
+            for (int tx = 0; tx < tilesX; tx++) {
+                byte flag = tiles[ty * tilesX + tx];
+                for (int y = ty * TiledMaskData.TILE_SIZE; y < Math.min(h, (ty + 1) * TiledMaskData.TILE_SIZE); y++) {
+                    for (int x = tx * TiledMaskData.TILE_SIZE; x < Math.min(w, (tx + 1) * TiledMaskData.TILE_SIZE); x++) {
+                        int i = y * w + x;
+                        boolean inSpan = x >= spans[2 * y] && x < spans[2 * y + 1];
+                        if (flag == TiledMaskData.TILE_EMPTY) {
+                            assertEquals(0, dense[i]);
+                        } else if (flag == TiledMaskData.TILE_FULL) {
+                            assertEquals((byte) 0xff, dense[i]);
+                        } else {
+                            assertEquals(dense[i], tiled[i]);
+                        }
+                        if (inSpan) {
+                            assertEquals(dense[i], tiled[i]);
+                        } else {
+                            assertEquals(0, dense[i]);
+                        }
+                    }
+                }
+                if (flag == TiledMaskData.TILE_FULL) {
+                    full++;
+                }
+            }
+        }
+        // The 2x2 tiles fully inside of the square
+        assertEquals(Arrays.toString(tiles), 4, full);
+    }
+
+    @Test
+    public void FillContextMatchAlphas() {
+        NativePiscesRasterizerShim.init(3, 3);
+        // A big square, then a small scaled and translated one, so that the
+        // second shape reuses the larger buffers of the context
+        float shapes[][] = { square(2.25f, 3.5f, 100), square(1.5f, 0.75f, 10) };
+        double transforms[][] = { { 1, 0, 0, 0, 1, 0 },
+                                  { 2, 0, 5.25, 0, 2, 7.5 } };
+
+        long context = NativePiscesRasterizerShim.createContext();
+        try {
+            for (int i = 0; i < shapes.length; i++) {
+                double tx[] = transforms[i];
+                int bounds[] = { 0, 0, 128, 128 };
+                byte mask[] = new byte[128 * 128];
+                NativePiscesRasterizerShim.produceFillAlphas(shapes[i], square_arr, 5, true,
+                                                         tx[0], tx[1], tx[2], tx[3], tx[4], tx[5],
+                                                         bounds, mask);
+                int contextBounds[] = { 0, 0, 128, 128 };
+                byte contextMask[] = new byte[128 * 128];
+                NativePiscesRasterizerShim.produceFillAlphas(context, shapes[i], square_arr, 5, true,
+                                                         tx[0], tx[1], tx[2], tx[3], tx[4], tx[5],
+                                                         contextBounds, contextMask);
+                assertArrayEquals(bounds, contextBounds);
+                int size = (bounds[2] - bounds[0]) * (bounds[3] - bounds[1]);
+                assertArrayEquals(Arrays.copyOf(mask, size), Arrays.copyOf(contextMask, size));
+            }
+        } finally {
+            NativePiscesRasterizerShim.disposeContext(context);
+        }
+    }
 }
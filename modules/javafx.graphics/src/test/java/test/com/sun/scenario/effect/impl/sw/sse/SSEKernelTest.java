@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.scenario.effect.impl.sw.sse;
+
+import java.util.Arrays;
+import java.util.Random;
+
+import com.sun.scenario.effect.impl.sw.sse.SSEPeerShim;
+import com.sun.scenario.effect.impl.sw.sse.SSERendererDelegate;
+import org.junit.After;
+import org.junit.Assume;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import static org.junit.Assert.*;
+
+/**
+ * Checks that the SSE2 and AVX2 kernels of the native SSE peers produce
+ * exactly the same pixels as the scalar loops.
+ */
+public class SSEKernelTest {
+
+    private static int supportedLevel;
+
+    private final Random random = new Random(20171017);
+
+    private interface Filter {
+        void run(int[] dst, int[] src);
+    }
+
+    @BeforeClass
+    public static void loadNatives() {
+        try {
+            Assume.assumeTrue(SSERendererDelegate.isSupported());
+            supportedLevel = SSERendererDelegate.getSIMDLevel();
+        } catch (LinkageError e) {
+            // The decora_sse library is not available
+            Assume.assumeNoException(e);
+        }
+    }
+
+    @After
+    public void restoreLevel() {
+        SSERendererDelegate.setSIMDLevel(supportedLevel);
+    }
+
+    private int[] randomImage(int w, int h, int scan) {
+        int[] pixels = new int[scan * h];
+        for (int i = 0; i < pixels.length; i++) {
+            // Premultiplied colors, with runs of transparent pixels
+            int a = random.nextInt(4) == 0 ? 0 : random.nextInt(256);
+            int r = random.nextInt(a + 1);
+            int g = random.nextInt(a + 1);
+            int b = random.nextInt(a + 1);
+            pixels[i] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+        return pixels;
+    }
+
+    private void checkLevels(String name, int dstlen, int[] src, Filter filter) {
+        SSERendererDelegate.setSIMDLevel(SSERendererDelegate.SIMD_SCALAR);
+        assertEquals(SSERendererDelegate.SIMD_SCALAR, SSERendererDelegate.getSIMDLevel());
+        int[] expected = new int[dstlen];
+        filter.run(expected, src);
+        for (int level = SSERendererDelegate.SIMD_SSE2; level <= supportedLevel; level++) {
+            assertEquals(level, SSERendererDelegate.setSIMDLevel(level));
+            int[] actual = new int[dstlen];
+            filter.run(actual, src);
+            assertArrayEquals(name + " at level " + level, expected, actual);
+        }
+    }
+
+    // Sizes around the 4 and 8 pixel vector widths, and box sizes that
+    // grow the image by both odd and even amounts.
+    private static final int[] SIZES = { 1, 3, 4, 7, 8, 9, 17, 64, 131 };
+    private static final int[] KSIZES = { 1, 2, 3, 8, 15 };
+
+    @Test
+    public void testBoxBlur() {
+        for (int srcw : SIZES) {
+            for (int srch : SIZES) {
+                for (int k : KSIZES) {
+                    int srcscan = srcw + 3;
+                    int[] src = randomImage(srcw, srch, srcscan);
+                    int dstw = srcw + k - 1;
+                    int dsth = srch + k - 1;
+                    int hscan = dstw + 1;
+                    checkLevels("horizontal blur " + srcw + "x" + srch + " k=" + k,
+                                hscan * srch, src, (dst, s) ->
+                        SSEPeerShim.boxBlurHorizontal(dst, dstw, srch, hscan,
+                                                      s, srcw, srch, srcscan));
+                    checkLevels("vertical blur " + srcw + "x" + srch + " k=" + k,
+                                srcw * dsth, src, (dst, s) ->
+                        SSEPeerShim.boxBlurVertical(dst, srcw, dsth, srcw,
+                                                    s, srcw, srch, srcscan));
+                }
+            }
+        }
+    }
+
+    @Test
+    public void testBoxShadow() {
+        float[] spreads = { 0f, 0.3f, 1f };
+        float[][] colors = {
+            { 0f, 0f, 0f, 1f },
+            { 1f, 0.5f, 0.25f, 0.75f },
+        };
+        for (int srcw : SIZES) {
+            for (int srch : SIZES) {
+                for (int k : KSIZES) {
+                    int srcscan = srcw + 1;
+                    int[] src = randomImage(srcw, srch, srcscan);
+                    int dstw = srcw + k - 1;
+                    int dsth = srch + k - 1;
+                    for (float spread : spreads) {
+                        String size = srcw + "x" + srch + " k=" + k + " spread=" + spread;
+                        checkLevels("horizontal shadow " + size, dstw * srch, src, (dst, s) ->
+                            SSEPeerShim.boxShadowHorizontalBlack(dst, dstw, srch, dstw,
+                                                                 s, srcw, srch, srcscan,
+                                                                 spread));
+                        checkLevels("vertical shadow " + size, srcw * dsth, src, (dst, s) ->
+                            SSEPeerShim.boxShadowVerticalBlack(dst, srcw, dsth, srcw,
+                                                               s, srcw, srch, srcscan,
+                                                               spread));
+                        for (float[] color : colors) {
+                            checkLevels("vertical shadow " + size + " color=" + Arrays.toString(color),
+                                        srcw * dsth, src, (dst, s) ->
+                                SSEPeerShim.boxShadowVertical(dst, srcw, dsth, srcw,
+                                                              s, srcw, srch, srcscan,
+                                                              spread, color));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    @Test
+    public void testLinearConvolve() {
+        for (int srcw : SIZES) {
+            for (int srch : SIZES) {
+                for (int k : KSIZES) {
+                    // Gaussian-like weights, repeated as the peer passes them
+                    float[] weights = new float[2 * k];
+                    float total = 0f;
+                    for (int i = 0; i < k; i++) {
+                        float d = i - (k - 1) / 2f;
+                        weights[i] = (float) Math.exp(-d * d / k);
+                        total += weights[i];
+                    }
+                    for (int i = 0; i < k; i++) {
+                        weights[i] /= total;
+                        weights[i + k] = weights[i];
+                    }
+                    int srcscan = srcw + 2;
+                    int[] src = randomImage(srcw, srch, srcscan);
+                    int dstw = srcw + k - 1;
+                    int dsth = srch + k - 1;
+                    String size = srcw + "x" + srch + " k=" + k;
+                    checkLevels("horizontal convolve " + size, dstw * srch, src, (dst, s) ->
+                        SSEPeerShim.linearConvolveHV(dst, dstw, srch, 1, dstw,
+                                                     s, srcw, srch, 1, srcscan,
+                                                     weights));
+                    checkLevels("vertical convolve " + size, srcw * dsth, src, (dst, s) ->
+                        SSEPeerShim.linearConvolveHV(dst, dsth, srcw, srcw, 1,
+                                                     s, srch, srcw, srcscan, 1,
+                                                     weights));
+                }
+            }
+        }
+    }
+}
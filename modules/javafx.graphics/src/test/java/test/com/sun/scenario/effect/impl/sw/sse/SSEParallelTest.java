@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.scenario.effect.impl.sw.sse;
+
+import java.util.Random;
+
+import com.sun.scenario.effect.impl.sw.sse.SSEPeerShim;
+import com.sun.scenario.effect.impl.sw.sse.SSERendererDelegate;
+import org.junit.After;
+import org.junit.Assume;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import static org.junit.Assert.*;
+
+/**
+ * Checks that splitting the passes of the native SSE peers across worker
+ * threads produces exactly the same pixels as filtering on one thread.
+ */
+public class SSEParallelTest {
+
+    private static int defaultThreads;
+    private static int defaultThreshold;
+
+    private final Random random = new Random(20171017);
+
+    private interface Filter {
+        void run(int[] dst, int[] src);
+    }
+
+    @BeforeClass
+    public static void loadNatives() {
+        try {
+            Assume.assumeTrue(SSERendererDelegate.isSupported());
+            defaultThreads = SSERendererDelegate.getParallelThreads();
+            defaultThreshold = SSERendererDelegate.getParallelThreshold();
+        } catch (LinkageError e) {
+            // The decora_sse library is not available
+            Assume.assumeNoException(e);
+        }
+    }
+
+    @After
+    public void restoreParallelism() {
+        SSERendererDelegate.setParallelism(defaultThreads, defaultThreshold);
+    }
+
+    private int[] randomImage(int w, int h, int scan) {
+        int[] pixels = new int[scan * h];
+        for (int i = 0; i < pixels.length; i++) {
+            int a = random.nextInt(4) == 0 ? 0 : random.nextInt(256);
+            int r = random.nextInt(a + 1);
+            int g = random.nextInt(a + 1);
+            int b = random.nextInt(a + 1);
+            pixels[i] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+        return pixels;
+    }
+
+    private static final int[] THREADS = { 2, 3, 4, 7 };
+
+    private void checkThreads(String name, int dstlen, int[] src, Filter filter) {
+        SSERendererDelegate.setParallelism(1, 0);
+        int[] expected = new int[dstlen];
+        filter.run(expected, src);
+        for (int threads : THREADS) {
+            SSERendererDelegate.setParallelism(threads, 0);
+            int[] actual = new int[dstlen];
+            filter.run(actual, src);
+            assertArrayEquals(name + " with " + threads + " threads", expected, actual);
+        }
+    }
+
+    // Sizes smaller than the number of bands, and around the 8 column
+    // alignment of the bands of the vertical passes.
+    private static final int[] SIZES = { 1, 2, 5, 8, 17, 63, 100 };
+    private static final int K = 9;
+
+    private static float[] weights() {
+        float[] weights = new float[2 * K];
+        for (int i = 0; i < K; i++) {
+            weights[i] = weights[i + K] = (i + 1) / 45f;
+        }
+        return weights;
+    }
+
+    @Test
+    public void testBoxBlur() {
+        for (int srcw : SIZES) {
+            for (int srch : SIZES) {
+                int[] src = randomImage(srcw, srch, srcw);
+                int dstw = srcw + K - 1;
+                int dsth = srch + K - 1;
+                String size = srcw + "x" + srch;
+                checkThreads("horizontal blur " + size, dstw * srch, src, (dst, s) ->
+                    SSEPeerShim.boxBlurHorizontal(dst, dstw, srch, dstw,
+                                                  s, srcw, srch, srcw));
+                checkThreads("vertical blur " + size, srcw * dsth, src, (dst, s) ->
+                    SSEPeerShim.boxBlurVertical(dst, srcw, dsth, srcw,
+                                                s, srcw, srch, srcw));
+            }
+        }
+    }
+
+    @Test
+    public void testBoxShadow() {
+        float[] color = { 1f, 0.5f, 0.25f, 0.75f };
+        for (int srcw : SIZES) {
+            for (int srch : SIZES) {
+                int[] src = randomImage(srcw, srch, srcw);
+                int dstw = srcw + K - 1;
+                int dsth = srch + K - 1;
+                String size = srcw + "x" + srch;
+                checkThreads("horizontal shadow " + size, dstw * srch, src, (dst, s) ->
+                    SSEPeerShim.boxShadowHorizontalBlack(dst, dstw, srch, dstw,
+                                                         s, srcw, srch, srcw, 0.3f));
+                checkThreads("vertical black shadow " + size, srcw * dsth, src, (dst, s) ->
+                    SSEPeerShim.boxShadowVerticalBlack(dst, srcw, dsth, srcw,
+                                                       s, srcw, srch, srcw, 0.3f));
+                checkThreads("vertical shadow " + size, srcw * dsth, src, (dst, s) ->
+                    SSEPeerShim.boxShadowVertical(dst, srcw, dsth, srcw,
+                                                  s, srcw, srch, srcw, 0.3f, color));
+            }
+        }
+    }
+
+    @Test
+    public void testLinearConvolve() {
+        float[] weights = weights();
+        float[] color = { 0f, 0f, 0f, 1f };
+        for (int srcw : SIZES) {
+            for (int srch : SIZES) {
+                int[] src = randomImage(srcw, srch, srcw);
+                int dstw = srcw + K - 1;
+                int dsth = srch + K - 1;
+                String size = srcw + "x" + srch;
+                checkThreads("horizontal convolve " + size, dstw * srch, src, (dst, s) ->
+                    SSEPeerShim.linearConvolveHV(dst, dstw, srch, 1, dstw,
+                                                 s, srcw, srch, 1, srcw,
+                                                 weights));
+                checkThreads("vertical convolve " + size, srcw * dsth, src, (dst, s) ->
+                    SSEPeerShim.linearConvolveHV(dst, dsth, srcw, srcw, 1,
+                                                 s, srch, srcw, srcw, 1,
+                                                 weights));
+                checkThreads("horizontal shadow convolve " + size, dstw * srch, src, (dst, s) ->
+                    SSEPeerShim.linearConvolveShadowHV(dst, dstw, srch, 1, dstw,
+                                                       s, srcw, srch, 1, srcw,
+                                                       weights, color));
+            }
+        }
+    }
+
+    @Test
+    public void testLinearConvolveVector() {
+        float[] weights = weights();
+        for (int srcw : SIZES) {
+            for (int srch : SIZES) {
+                int[] src = randomImage(srcw, srch, srcw);
+                int dstw = srcw + K - 1;
+                int dsth = srch + K - 1;
+                // A sampling vector that is not aligned with the axes, so
+                // every row starts at a different fractional position.
+                float dxcol = 1f / srcw, dycol = 0.1f / srch;
+                float dxrow = -0.1f / srcw, dyrow = 1f / srch;
+                checkThreads("vector convolve " + srcw + "x" + srch, dstw * dsth, src, (dst, s) ->
+                    SSEPeerShim.linearConvolveVector(dst, dstw, dsth, dstw,
+                                                     s, srcw, srch, srcw,
+                                                     weights, K,
+                                                     -0.25f, -0.25f,
+                                                     -4f / srcw, 0f,
+                                                     1f / srcw, 0f,
+                                                     dxcol, dycol, dxrow, dyrow));
+            }
+        }
+    }
+}
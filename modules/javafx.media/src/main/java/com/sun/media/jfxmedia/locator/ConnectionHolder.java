@@ -38,6 +38,8 @@ import java.nio.channels.Channels;
 import java.nio.channels.ClosedChannelException;
 import java.nio.channels.FileChannel;
 import java.nio.channels.ReadableByteChannel;
+import java.security.AccessController;
+import java.security.PrivilegedAction;
 import java.util.Map;
 import sun.nio.ch.DirectBuffer;
 
@@ -48,8 +50,23 @@ import sun.nio.ch.DirectBuffer;
 public abstract class ConnectionHolder {
     private static int DEFAULT_BUFFER_SIZE = 4096;
 
+    // Size of the read-ahead ring of the javasource element, which may be
+    // set with the jfxmedia.readAheadSize property.  Zero disables read-ahead.
+    private static final int DEFAULT_READ_AHEAD_SIZE = 1024 * 1024;
+    private static final int MIN_READ_AHEAD_SIZE = 64 * 1024;
+    private static final int MAX_READ_AHEAD_SIZE = 64 * 1024 * 1024;
+    private static final int READ_AHEAD_SIZE = AccessController.doPrivileged(
+            (PrivilegedAction<Integer>) () -> {
+        int size = Integer.getInteger("jfxmedia.readAheadSize", DEFAULT_READ_AHEAD_SIZE);
+        if (size <= 0) {
+            return 0;
+        }
+        return Math.min(Math.max(size, MIN_READ_AHEAD_SIZE), MAX_READ_AHEAD_SIZE);
+    });
+
     ReadableByteChannel channel;
     ByteBuffer          buffer = ByteBuffer.allocateDirect(DEFAULT_BUFFER_SIZE);
+    ByteBuffer          readAheadBuffer;
 
     static ConnectionHolder createMemoryConnectionHolder(ByteBuffer buffer) {
         return new MemoryConnectionHolder(buffer);
@@ -92,6 +109,44 @@ public abstract class ConnectionHolder {
         return buffer;
     }
 
+    /**
+     * Returns the size of the read-ahead ring the native source should
+     * allocate for this holder, or zero if data should only be pulled
+     * through readNextBlock.
+     */
+    int getReadAheadSize() {
+        return READ_AHEAD_SIZE;
+    }
+
+    /**
+     * Sets the read-ahead ring, a direct buffer wrapping native memory owned
+     * by the source element.
+     */
+    public void setReadAheadBuffer(ByteBuffer ring) {
+        readAheadBuffer = ring;
+    }
+
+    /**
+     * Reads as much data as is available, up to size bytes, from the current
+     * position of the opened stream into the read-ahead ring at offset.
+     * The native source only asks for regions it no longer references.
+     *
+     * @return The number of bytes read, possibly zero, or -1 if the channel
+     * has reached end-of-stream.
+     *
+     * @throws ClosedChannelException if an attempt is made to read after
+     * closeConnection has been called
+     */
+    public int readAhead(int offset, int size) throws IOException {
+        // avoid NPE if channel does not exist or has been closed
+        if (null == channel || null == readAheadBuffer) {
+            throw new ClosedChannelException();
+        }
+        readAheadBuffer.limit(offset + size);
+        readAheadBuffer.position(offset);
+        return channel.read(readAheadBuffer);
+    }
+
     /**
      * Reads a block of data from the arbitrary position of the opened stream.
      *
@@ -144,6 +199,7 @@ public abstract class ConnectionHolder {
         } catch (IOException ioex) {}
         finally {
             channel = null;
+            readAheadBuffer = null;
         }
     }
 
@@ -372,7 +428,7 @@ public abstract class ConnectionHolder {
                     }
 
                     int actual;
-                    if (bb.equals(buffer)) {
+                    if (bb == buffer) {
                         // we'll cheat here as we know that bb is buffer and rather
                         // than copy the data, just slice it like for readBlock
                         actual = Math.min(DEFAULT_BUFFER_SIZE, backingBuffer.remaining());
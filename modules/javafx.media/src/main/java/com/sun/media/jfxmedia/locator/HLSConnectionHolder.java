@@ -91,6 +91,13 @@ final class HLSConnectionHolder extends ConnectionHolder {
         throw new IOException();
     }
 
+    @Override
+    int getReadAheadSize() {
+        // Segments are pulled through readNextBlock, which tracks the
+        // download time for bitrate switching.
+        return 0;
+    }
+
     boolean needBuffer() {
         return true;
     }
@@ -31,6 +31,8 @@ import com.sun.media.jfxmedia.locator.Locator;
 import com.sun.media.jfxmediaimpl.MediaUtils;
 import com.sun.media.jfxmediaimpl.NativeMedia;
 import com.sun.media.jfxmediaimpl.platform.Platform;
+import java.security.AccessController;
+import java.security.PrivilegedAction;
 
 /**
  * GStreamer implementation of Media
@@ -64,13 +66,23 @@ final class GSTMedia extends NativeMedia {
         Locator loc = getLocator();
         ret = MediaError.getFromCode(gstInitNativeMedia(loc,
                 loc.getContentType(), loc.getContentLength(),
-                nativeMediaHandle));
+                getDecoderThreads(), nativeMediaHandle));
         if (ret != MediaError.ERROR_NONE && ret != MediaError.ERROR_PLATFORM_UNSUPPORTED) {
             MediaUtils.nativeError(this, ret);
         }
         this.refNativeMedia = nativeMediaHandle[0];
     }
 
+    /**
+     * Gets the number of threads the video decoder may use, from the
+     * "jfxmedia.decoderThreads" system property. 0 means one per CPU core,
+     * -1 (the default) leaves it to the decoder.
+     */
+    private static int getDecoderThreads() {
+        return AccessController.doPrivileged((PrivilegedAction<Integer>) () ->
+                Integer.getInteger("jfxmedia.decoderThreads", -1));
+    }
+
     long getNativeMediaRef() {
         return refNativeMedia;
     }
@@ -92,6 +104,7 @@ final class GSTMedia extends NativeMedia {
     private native int gstInitNativeMedia(Locator locator,
                                                String contentType,
                                                long sizeHint,
+                                               int decoderThreads,
                                                long[] nativeMediaHandle);
     private native void gstDispose(long refNativeMedia);
 }
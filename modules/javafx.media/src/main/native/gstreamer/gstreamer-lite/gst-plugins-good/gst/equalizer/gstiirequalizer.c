@@ -36,6 +36,13 @@
 
 #include "gst/glib-compat-private.h"
 
+#ifdef GSTREAMER_LITE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENABLE_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+#endif // GSTREAMER_LITE
+
 GST_DEBUG_CATEGORY (equalizer_debug);
 #define GST_CAT_DEFAULT equalizer_debug
 
@@ -139,6 +146,9 @@ struct _GstIirEqualizerBand
   /* second order iir filter */
   gdouble b1, b2;               /* IIR coefficients for outputs */
   gdouble a0, a1, a2;           /* IIR coefficients for inputs */
+#ifdef GSTREAMER_LITE
+  gboolean bypass;              /* gain is 0 dB, the band is not applied */
+#endif // GSTREAMER_LITE
 };
 
 struct _GstIirEqualizerBandClass
@@ -425,6 +435,9 @@ gst_iir_equalizer_finalize (GObject * object)
 
   g_free (equ->bands);
   g_free (equ->history);
+#ifdef GSTREAMER_LITE
+  g_free (equ->work);
+#endif // GSTREAMER_LITE
 
   g_mutex_clear (&equ->bands_lock);
 
@@ -640,6 +653,10 @@ update_coefficients (GstIirEqualizer * equ)
       setup_low_shelf_filter (equ, equ->bands[i]);
     else
       setup_high_shelf_filter (equ, equ->bands[i]);
+#ifdef GSTREAMER_LITE
+    /* Like set_passthrough(), a band without gain is treated as identity */
+    equ->bands[i]->bypass = (equ->bands[i]->gain == 0.0);
+#endif // GSTREAMER_LITE
   }
 
   equ->need_new_coefficients = FALSE;
@@ -845,9 +862,169 @@ guint size, guint channels)                                             \
   }                                                                     \
 }
 
+#ifdef GSTREAMER_LITE
+/* The cascade is run one band at a time over blocks of samples converted to
+ * double, rather than through every band for each sample. The state of a band
+ * then stays in registers for the whole block, bands without gain are
+ * skipped, and with SSE2 two channels are filtered at once. For S16 and F32
+ * the output of each band and the history are rounded to float, as they were
+ * by the per-sample functions. */
+#define WORK_SAMPLES 2048
+
+typedef struct {
+  gdouble x1, x2;               /* history of input values for a filter */
+  gdouble y1, y2;               /* history of output values for a filter */
+} SecondOrderHistoryBlock;
+
+static const guint history_size_block = sizeof (SecondOrderHistoryBlock);
+
+/* history holds the state of the band for every channel */
+static void
+filter_band_block (const GstIirEqualizerBand * filter,
+    SecondOrderHistoryBlock * history, gdouble * work, guint frames,
+    guint channels, gboolean float_history)
+{
+  guint c = 0, i;
+  gdouble *p;
+
+#ifdef ENABLE_SIMD_SSE2
+  const __m128d a0 = _mm_set1_pd (filter->a0);
+  const __m128d a1 = _mm_set1_pd (filter->a1);
+  const __m128d a2 = _mm_set1_pd (filter->a2);
+  const __m128d b1 = _mm_set1_pd (filter->b1);
+  const __m128d b2 = _mm_set1_pd (filter->b2);
+
+  for (; c + 2 <= channels; c += 2) {
+    SecondOrderHistoryBlock *h0 = &history[c], *h1 = &history[c + 1];
+    __m128d x1 = _mm_set_pd (h1->x1, h0->x1);
+    __m128d x2 = _mm_set_pd (h1->x2, h0->x2);
+    __m128d y1 = _mm_set_pd (h1->y1, h0->y1);
+    __m128d y2 = _mm_set_pd (h1->y2, h0->y2);
+
+    for (i = 0, p = work + c; i < frames; i++, p += channels) {
+      __m128d x = _mm_loadu_pd (p);
+      /* same order of operations as one_step_gdouble() */
+      __m128d y = _mm_add_pd (_mm_add_pd (_mm_add_pd (_mm_add_pd (
+                      _mm_mul_pd (a0, x), _mm_mul_pd (a1, x1)),
+                  _mm_mul_pd (a2, x2)), _mm_mul_pd (b1, y1)),
+          _mm_mul_pd (b2, y2));
+      if (float_history)
+        y = _mm_cvtps_pd (_mm_cvtpd_ps (y));
+      x2 = x1;
+      x1 = x;
+      y2 = y1;
+      y1 = y;
+      _mm_storeu_pd (p, y);
+    }
+
+    _mm_storel_pd (&h0->x1, x1);
+    _mm_storeh_pd (&h1->x1, x1);
+    _mm_storel_pd (&h0->x2, x2);
+    _mm_storeh_pd (&h1->x2, x2);
+    _mm_storel_pd (&h0->y1, y1);
+    _mm_storeh_pd (&h1->y1, y1);
+    _mm_storel_pd (&h0->y2, y2);
+    _mm_storeh_pd (&h1->y2, y2);
+  }
+#endif // ENABLE_SIMD_SSE2
+
+  for (; c < channels; c++) {
+    gdouble a0 = filter->a0, a1 = filter->a1, a2 = filter->a2;
+    gdouble b1 = filter->b1, b2 = filter->b2;
+    gdouble x1 = history[c].x1, x2 = history[c].x2;
+    gdouble y1 = history[c].y1, y2 = history[c].y2;
+
+    for (i = 0, p = work + c; i < frames; i++, p += channels) {
+      gdouble x = *p;
+      gdouble y = a0 * x + a1 * x1 + a2 * x2 + b1 * y1 + b2 * y2;
+      if (float_history)
+        y = (gfloat) y;
+      x2 = x1;
+      x1 = x;
+      y2 = y1;
+      y1 = y;
+      *p = y;
+    }
+
+    history[c].x1 = x1;
+    history[c].x2 = x2;
+    history[c].y1 = y1;
+    history[c].y2 = y2;
+  }
+}
+
+/* A band without gain passes its input through. Its history is still moved
+ * along as if the band had been applied, so that it does not start from a
+ * stale state, and click, once its gain changes. */
+static void
+bypass_band_block (SecondOrderHistoryBlock * history, const gdouble * work,
+    guint frames, guint channels)
+{
+  const gdouble *last = work + (frames - 1) * channels;
+  guint c;
+
+  for (c = 0; c < channels; c++) {
+    if (frames > 1) {
+      history[c].x2 = history[c].y2 = (last - channels)[c];
+    } else {
+      history[c].x2 = history[c].x1;
+      history[c].y2 = history[c].y1;
+    }
+    history[c].x1 = history[c].y1 = last[c];
+  }
+}
+
+static void
+filter_bands_block (GstIirEqualizer * equ, guint frames, guint channels,
+    gboolean float_history)
+{
+  SecondOrderHistoryBlock *history = equ->history;
+  guint f, nf = equ->freq_band_count;
+
+  for (f = 0; f < nf; f++, history += channels) {
+    if (equ->bands[f]->bypass)
+      bypass_band_block (history, equ->work, frames, channels);
+    else
+      filter_band_block (equ->bands[f], history, equ->work, frames, channels,
+          float_history);
+  }
+}
+
+#define CREATE_BLOCK_FUNCTIONS(TYPE,TO_TYPE,FLOAT_HISTORY)              \
+static void                                                             \
+gst_iir_equ_process_block_ ## TYPE (GstIirEqualizer *equ, guint8 *data, \
+guint size, guint channels)                                             \
+{                                                                       \
+  TYPE *samples = (TYPE *) data;                                        \
+  guint frames = size / channels / sizeof (TYPE);                       \
+  guint block = WORK_SAMPLES / channels;                                \
+  gdouble *work = equ->work;                                            \
+  guint i, n;                                                           \
+                                                                        \
+  while (frames > 0) {                                                  \
+    n = MIN (frames, block);                                            \
+    for (i = 0; i < n * channels; i++)                                  \
+      work[i] = samples[i];                                             \
+    filter_bands_block (equ, n, channels, FLOAT_HISTORY);               \
+    for (i = 0; i < n * channels; i++)                                  \
+      samples[i] = TO_TYPE (work[i]);                                   \
+    samples += n * channels;                                            \
+    frames -= n;                                                        \
+  }                                                                     \
+}
+
+#define TO_GINT16(v) ((gint16) floor (CLAMP ((v), -32768.0, 32767.0)))
+#define TO_GFLOAT(v) ((gfloat) (v))
+#define TO_GDOUBLE(v) (v)
+
+CREATE_BLOCK_FUNCTIONS (gint16, TO_GINT16, TRUE);
+CREATE_BLOCK_FUNCTIONS (gfloat, TO_GFLOAT, TRUE);
+CREATE_BLOCK_FUNCTIONS (gdouble, TO_GDOUBLE, FALSE);
+#else // GSTREAMER_LITE
 CREATE_OPTIMIZED_FUNCTIONS_INT (gint16, gfloat, -32768.0, 32767.0);
 CREATE_OPTIMIZED_FUNCTIONS (gfloat);
 CREATE_OPTIMIZED_FUNCTIONS (gdouble);
+#endif // GSTREAMER_LITE
 
 static GstFlowReturn
 gst_iir_equalizer_transform_ip (GstBaseTransform * btrans, GstBuffer * buf)
@@ -902,6 +1079,31 @@ gst_iir_equalizer_setup (GstAudioFilter * audio, const GstAudioInfo * info)
 {
   GstIirEqualizer *equ = GST_IIR_EQUALIZER (audio);
 
+#ifdef GSTREAMER_LITE
+  /* Channels are filtered in blocks of WORK_SAMPLES samples */
+  if (GST_AUDIO_INFO_CHANNELS (info) > WORK_SAMPLES)
+    return FALSE;
+
+  if (equ->work == NULL)
+    equ->work = g_new (gdouble, WORK_SAMPLES);
+
+  switch (GST_AUDIO_INFO_FORMAT (info)) {
+    case GST_AUDIO_FORMAT_S16:
+          equ->history_size = history_size_block;
+          equ->process = gst_iir_equ_process_block_gint16;
+          break;
+    case GST_AUDIO_FORMAT_F32:
+          equ->history_size = history_size_block;
+          equ->process = gst_iir_equ_process_block_gfloat;
+          break;
+    case GST_AUDIO_FORMAT_F64:
+          equ->history_size = history_size_block;
+          equ->process = gst_iir_equ_process_block_gdouble;
+          break;
+        default:
+          return FALSE;
+      }
+#else // GSTREAMER_LITE
   switch (GST_AUDIO_INFO_FORMAT (info)) {
     case GST_AUDIO_FORMAT_S16:
           equ->history_size = history_size_gint16;
@@ -918,6 +1120,7 @@ gst_iir_equalizer_setup (GstAudioFilter * audio, const GstAudioInfo * info)
         default:
           return FALSE;
       }
+#endif // GSTREAMER_LITE
 
   alloc_history (equ, info);
   return TRUE;
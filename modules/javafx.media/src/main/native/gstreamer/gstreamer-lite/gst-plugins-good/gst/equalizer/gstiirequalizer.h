@@ -62,6 +62,10 @@ struct _GstIirEqualizer
   gboolean need_new_coefficients;
 
   ProcessFunc process;
+#ifdef GSTREAMER_LITE
+  /* samples converted to double, processed one band at a time */
+  gdouble *work;
+#endif // GSTREAMER_LITE
 };
 
 struct _GstIirEqualizerClass
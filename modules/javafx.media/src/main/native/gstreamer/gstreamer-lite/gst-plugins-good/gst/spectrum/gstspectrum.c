@@ -280,6 +280,14 @@ gst_spectrum_alloc_channel_data (GstSpectrum * spectrum)
     cd->spect_magnitude = g_new0 (gfloat, bands);
     cd->spect_phase = g_new0 (gfloat, bands);
   }
+
+#ifdef GSTREAMER_LITE
+  /* Same coefficients as gst_fft_f32_window(), which would compute them with
+   * a double precision cos() for every sample of every FFT. */
+  spectrum->window = g_new (gfloat, nfft);
+  for (i = 0; i < nfft; i++)
+    spectrum->window[i] = (gfloat) (0.53836 - 0.46164 * cos (2.0 * G_PI * i / nfft));
+#endif // GSTREAMER_LITE
 }
 
 static void
@@ -305,6 +313,10 @@ gst_spectrum_free_channel_data (GstSpectrum * spectrum)
     g_free (spectrum->channel_data);
     spectrum->channel_data = NULL;
   }
+#ifdef GSTREAMER_LITE
+  g_free (spectrum->window);
+  spectrum->window = NULL;
+#endif // GSTREAMER_LITE
 }
 
 static void
@@ -728,6 +740,24 @@ gst_spectrum_message_new (GstSpectrum * spectrum, GstClockTime timestamp,
       "running-time", G_TYPE_UINT64, running_time,
       "duration", G_TYPE_UINT64, duration, NULL);
 
+#ifdef GSTREAMER_LITE
+  if (!spectrum->multi_channel) {
+    /* Magnitudes followed by phases in a single buffer, which the pipeline
+     * copies to the application as is, instead of lists of GValues. */
+    gsize length = spectrum->bands * sizeof (gfloat);
+    GstBuffer *bands = gst_buffer_new_allocate (NULL, 2 * length, NULL);
+
+    cd = &spectrum->channel_data[0];
+    if (bands) {
+      gst_buffer_fill (bands, 0, cd->spect_magnitude, length);
+      gst_buffer_fill (bands, length, cd->spect_phase, length);
+      gst_structure_set (s, "bands", GST_TYPE_BUFFER, bands, NULL);
+      gst_buffer_unref (bands);
+    }
+    return gst_message_new_element (GST_OBJECT (spectrum), s);
+  }
+#endif // GSTREAMER_LITE
+
   if (!spectrum->multi_channel) {
     cd = &spectrum->channel_data[0];
 
@@ -783,13 +813,48 @@ gst_spectrum_run_fft (GstSpectrum * spectrum, GstSpectrumChannel * cd,
   GstFFTF32Complex *freqdata = cd->freqdata;
   GstFFTF32 *fft_ctx = cd->fft_ctx;
 
+#ifdef GSTREAMER_LITE
+  {
+    /* Unroll the ring buffer and apply the window in the same pass */
+    const gfloat *window = spectrum->window;
+    guint head = nfft - input_pos;
+
+    for (i = 0; i < head; i++)
+      input_tmp[i] = input[input_pos + i] * window[i];
+    for (; i < nfft; i++)
+      input_tmp[i] = input[i - head] * window[i];
+  }
+#else // GSTREAMER_LITE
   for (i = 0; i < nfft; i++)
     input_tmp[i] = input[(input_pos + i) % nfft];
 
   gst_fft_f32_window (fft_ctx, input_tmp, GST_FFT_WINDOW_HAMMING);
+#endif // GSTREAMER_LITE
 
   gst_fft_f32_fft (fft_ctx, input_tmp, freqdata);
 
+#ifdef GSTREAMER_LITE
+  /* Single precision all the way, the FFT itself is single precision. */
+  if (spectrum->message_magnitude) {
+    const gfloat scale = 1.0f / ((gfloat) nfft * (gfloat) nfft);
+    const gfloat min_db = (gfloat) threshold;
+    gfloat val;
+    /* Calculate magnitude in db */
+    for (i = 0; i < bands; i++) {
+      val = freqdata[i].r * freqdata[i].r + freqdata[i].i * freqdata[i].i;
+      val = 10.0f * log10f (val * scale);
+      if (val < min_db)
+        val = min_db;
+      spect_magnitude[i] += val;
+    }
+  }
+
+  if (spectrum->message_phase) {
+    /* Calculate phase */
+    for (i = 0; i < bands; i++)
+      spect_phase[i] += atan2f (freqdata[i].i, freqdata[i].r);
+  }
+#else // GSTREAMER_LITE
   if (spectrum->message_magnitude) {
     gdouble val;
     /* Calculate magnitude in db */
@@ -809,6 +874,7 @@ gst_spectrum_run_fft (GstSpectrum * spectrum, GstSpectrumChannel * cd,
     for (i = 0; i < bands; i++)
       spect_phase[i] += atan2 (freqdata[i].i, freqdata[i].r);
   }
+#endif // GSTREAMER_LITE
 }
 
 static void
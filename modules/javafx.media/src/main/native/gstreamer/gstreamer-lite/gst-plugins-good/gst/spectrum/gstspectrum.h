@@ -81,6 +81,9 @@ struct _GstSpectrum
   GMutex lock;
 
   GstSpectrumInputData input_data;
+#ifdef GSTREAMER_LITE
+  gfloat *window;               /* Hamming window, nfft coefficients */
+#endif // GSTREAMER_LITE
 };
 
 struct _GstSpectrumClass
@@ -35,7 +35,22 @@
  ***********************************************************************************/
 G_LOCK_DEFINE_STATIC(avlib_lock);
 
+enum
+{
+    PROP_0,
+    PROP_THREAD_COUNT,
+    PROP_THREAD_TYPE
+};
+
+#define DEFAULT_THREAD_COUNT 0
+#define DEFAULT_THREAD_TYPE  (BASEDECODER_THREAD_FRAME | BASEDECODER_THREAD_SLICE)
+
+// libavcodec never uses more threads than that for a decoder.
+#define MAX_THREAD_COUNT     16
+
 static void basedecoder_init_context_default(BaseDecoder *decoder);
+static void basedecoder_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+static void basedecoder_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 
 /***********************************************************************************
  * Substitution for
@@ -72,15 +87,68 @@ GType basedecoder_get_type (void)
 
 static void basedecoder_init(BaseDecoder *self)
 {
+    self->thread_count = DEFAULT_THREAD_COUNT;
+    self->thread_type = DEFAULT_THREAD_TYPE;
 }
 
 static void basedecoder_class_init(BaseDecoderClass *g_class)
 {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(g_class);
+
     avcodec_register_all();
 
+    gobject_class->set_property = basedecoder_set_property;
+    gobject_class->get_property = basedecoder_get_property;
+
+    g_object_class_install_property (gobject_class, PROP_THREAD_COUNT,
+        g_param_spec_int ("thread-count", "Thread count", "Number of decoding threads, 0 for one per CPU core",
+        0, MAX_THREAD_COUNT, DEFAULT_THREAD_COUNT,
+        G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY));
+
+    g_object_class_install_property (gobject_class, PROP_THREAD_TYPE,
+        g_param_spec_int ("thread-type", "Thread type", "Multithreading methods allowed: 1 - frame, 2 - slice, 3 - both",
+        0, BASEDECODER_THREAD_FRAME | BASEDECODER_THREAD_SLICE, DEFAULT_THREAD_TYPE,
+        G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY));
+
     g_class->init_context = basedecoder_init_context_default;
 }
 
+static void basedecoder_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+    BaseDecoder *decoder = BASEDECODER(object);
+
+    switch (property_id)
+    {
+        case PROP_THREAD_COUNT:
+            decoder->thread_count = g_value_get_int(value);
+            break;
+        case PROP_THREAD_TYPE:
+            decoder->thread_type = g_value_get_int(value);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+static void basedecoder_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+    BaseDecoder *decoder = BASEDECODER(object);
+
+    switch (property_id)
+    {
+        case PROP_THREAD_COUNT:
+            g_value_set_int(value, decoder->thread_count);
+            break;
+        case PROP_THREAD_TYPE:
+            g_value_set_int(value, decoder->thread_type);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
 void basedecoder_init_state(BaseDecoder *decoder)
 {
     decoder->codec_data = NULL;
@@ -149,6 +217,21 @@ static void basedecoder_init_context_default(BaseDecoder *decoder)
         decoder->context->extradata = decoder->codec_data;
         decoder->context->extradata_size = decoder->codec_data_size;
     }
+
+    // Codecs without threading support ignore these.
+    int thread_type = 0;
+    if (decoder->thread_type & BASEDECODER_THREAD_FRAME)
+        thread_type |= FF_THREAD_FRAME;
+    if (decoder->thread_type & BASEDECODER_THREAD_SLICE)
+        thread_type |= FF_THREAD_SLICE;
+
+    if (thread_type != 0)
+    {
+        decoder->context->thread_count = decoder->thread_count;
+        decoder->context->thread_type = thread_type;
+    }
+    else
+        decoder->context->thread_count = 1;
 }
 
 void basedecoder_set_codec_data(BaseDecoder *decoder, GstStructure *s)
@@ -41,6 +41,10 @@ G_BEGIN_DECLS
 
 #define NO_DATA_USED -1
 
+// Values of the "thread-type" property, which can be combined.
+#define BASEDECODER_THREAD_FRAME    1   // decode several frames in parallel
+#define BASEDECODER_THREAD_SLICE    2   // decode slices of a frame in parallel
+
 typedef struct _BaseDecoder       BaseDecoder;
 typedef struct _BaseDecoderClass  BaseDecoderClass;
 
@@ -56,6 +60,9 @@ struct _BaseDecoder
 
     gboolean      is_hls;
 
+    gint          thread_count;      // number of decoding threads, 0 to let libavcodec choose
+    gint          thread_type;       // BASEDECODER_THREAD_* flags
+
     guint8        *codec_data;       // codec-specific data
     gint          codec_data_size;   // number of bytes of codec-specific data
 
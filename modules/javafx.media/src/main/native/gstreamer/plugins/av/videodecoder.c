@@ -34,6 +34,31 @@
 
 #include "videodecoder.h"
 #include <libavformat/avformat.h>
+#include <libavutil/mem.h>
+
+#if NEW_GET_BUFFER2
+#include <libavutil/buffer.h>
+#include <libavutil/frame.h>
+#endif
+
+#ifndef AV_INPUT_BUFFER_PADDING_SIZE
+#define AV_INPUT_BUFFER_PADDING_SIZE FF_INPUT_BUFFER_PADDING_SIZE
+#endif
+
+#ifndef AV_CODEC_CAP_DR1
+#define AV_CODEC_CAP_DR1 CODEC_CAP_DR1
+#endif
+
+// Alignment of frame buffers and of their strides. Covers every linesize
+// alignment requested by avcodec_align_dimensions2().
+#define FRAME_ALIGN 64
+
+// Frames referenced by buffers downstream at once. Further frames are
+// copied, so that a stalled sink can't pin an unbounded number of them.
+#define MAX_EXPORTED_FRAMES 8
+
+// Unused frame buffers kept by the frame pool.
+#define MAX_FREE_FRAMES 16
 
 GST_DEBUG_CATEGORY_STATIC(videodecoder_debug);
 #define GST_CAT_DEFAULT videodecoder_debug
@@ -108,12 +133,16 @@ static GstFlowReturn        videodecoder_chain(GstPad *pad, GstObject *parent, G
 
 static void                 videodecoder_init_state(VideoDecoder *decoder);
 static void                 videodecoder_state_reset(VideoDecoder *decoder);
+static void                 videodecoder_drain(VideoDecoder *decoder);
 
 static gboolean videodecoder_configure(VideoDecoder *decoder, GstCaps *sink_caps);
+static void     videodecoder_init_context(BaseDecoder *base);
+static void     videodecoder_close(VideoDecoder *decoder);
 
 static void videodecoder_class_init(VideoDecoderClass *klass)
 {
     GstElementClass *element_class = GST_ELEMENT_CLASS(klass);
+    BaseDecoderClass *base_class = BASEDECODER_CLASS(klass);
 
     gst_element_class_set_details_simple(element_class,
                 "Videodecoder",
@@ -127,6 +156,8 @@ static void videodecoder_class_init(VideoDecoderClass *klass)
             gst_static_pad_template_get(&sink_template));
 
     element_class->change_state = videodecoder_change_state;
+
+    base_class->init_context = videodecoder_init_context;
 }
 
 static void videodecoder_init(VideoDecoder *decoder)
@@ -175,7 +206,7 @@ videodecoder_change_state(GstElement* element, GstStateChange transition)
     switch (transition)
     {
         case GST_STATE_CHANGE_PAUSED_TO_READY:
-            basedecoder_close_decoder(BASEDECODER(decoder));
+            videodecoder_close(decoder);
             break;
         default:
             break;
@@ -184,6 +215,251 @@ videodecoder_change_state(GstElement* element, GstStateChange transition)
     return ret;
 }
 
+/***********************************************************************************
+ * Frame pool
+ *
+ * libavcodec decodes into buffers of the pool, each holding all three planes of
+ * a frame. Decoded frames are pushed downstream in GstBuffers wrapping these
+ * buffers, which keep a reference to the AVBufferRef of the frame. A buffer
+ * returns to the pool when both libavcodec and GStreamer are done with it.
+ ***********************************************************************************/
+#if NEW_GET_BUFFER2
+typedef struct
+{
+    FramePool *pool;
+    uint8_t   *memory;     // as returned by av_malloc()
+    uint8_t   *data;       // memory aligned to FRAME_ALIGN
+    size_t     size;       // usable bytes at data
+    int        frame_size; // bytes taken by the planes of the current frame
+} FrameBlock;
+
+struct _FramePool
+{
+    volatile gint refcount;
+    volatile gint exported; // blocks referenced by pushed buffers
+    GMutex        lock;
+    GSList        *free_blocks;
+    guint         free_count;
+};
+
+static FramePool* framepool_new(void)
+{
+    FramePool *pool = g_new0(FramePool, 1);
+    pool->refcount = 1;
+    g_mutex_init(&pool->lock);
+    return pool;
+}
+
+static void framepool_free_block(FrameBlock *block)
+{
+    av_free(block->memory);
+    g_free(block);
+}
+
+static void framepool_unref(FramePool *pool)
+{
+    if (g_atomic_int_dec_and_test(&pool->refcount))
+    {
+        g_slist_free_full(pool->free_blocks, (GDestroyNotify)framepool_free_block);
+        g_mutex_clear(&pool->lock);
+        g_free(pool);
+    }
+}
+
+static FrameBlock* framepool_acquire(FramePool *pool, size_t size)
+{
+    FrameBlock *block = NULL;
+
+    g_mutex_lock(&pool->lock);
+    while (pool->free_blocks && block == NULL)
+    {
+        block = (FrameBlock*)pool->free_blocks->data;
+        pool->free_blocks = g_slist_delete_link(pool->free_blocks, pool->free_blocks);
+        pool->free_count--;
+
+        // Blocks of another frame size are left from before a resolution change.
+        if (block->size != size)
+        {
+            framepool_free_block(block);
+            block = NULL;
+        }
+    }
+    g_mutex_unlock(&pool->lock);
+
+    if (block == NULL)
+    {
+        block = g_new0(FrameBlock, 1);
+        block->memory = av_malloc(size + FRAME_ALIGN);
+        if (block->memory == NULL)
+        {
+            g_free(block);
+            return NULL;
+        }
+        block->data = (uint8_t*)(((uintptr_t)block->memory + FRAME_ALIGN - 1) & ~(uintptr_t)(FRAME_ALIGN - 1));
+        block->size = size;
+    }
+
+    g_atomic_int_inc(&pool->refcount);
+    block->pool = pool;
+    return block;
+}
+
+// Free callback of the AVBufferRef of a frame.
+static void framepool_release(void *opaque, uint8_t *data)
+{
+    FrameBlock *block = (FrameBlock*)opaque;
+    FramePool *pool = block->pool;
+
+    g_mutex_lock(&pool->lock);
+    if (pool->free_count < MAX_FREE_FRAMES)
+    {
+        pool->free_blocks = g_slist_prepend(pool->free_blocks, block);
+        pool->free_count++;
+        block = NULL;
+    }
+    g_mutex_unlock(&pool->lock);
+
+    if (block)
+        framepool_free_block(block);
+    framepool_unref(pool);
+}
+
+static int videodecoder_get_buffer2(AVCodecContext *context, AVFrame *frame, int flags)
+{
+    FramePool *pool = (FramePool*)context->opaque;
+
+    if (frame->format != AV_PIX_FMT_YUV420P && frame->format != AV_PIX_FMT_YUVJ420P)
+    {
+        int ret = avcodec_default_get_buffer2(context, frame, flags);
+        frame->opaque = NULL;
+        return ret;
+    }
+
+    int width = frame->width;
+    int height = frame->height;
+    int linesize_align[AV_NUM_DATA_POINTERS];
+    avcodec_align_dimensions2(context, &width, &height, linesize_align);
+    height = FFALIGN(height, 2);
+
+    int stride_y = FFALIGN(width, FRAME_ALIGN);
+    int stride_uv = FFALIGN((width + 1) / 2, FRAME_ALIGN);
+    size_t size_y = (size_t)stride_y * height;
+    size_t size_uv = (size_t)stride_uv * (height / 2);
+    // Leave room for SIMD reads past the end of the last row.
+    size_t size = size_y + 2 * size_uv + FRAME_ALIGN;
+
+    FrameBlock *block = framepool_acquire(pool, size);
+    if (block == NULL)
+        return AVERROR(ENOMEM);
+
+    frame->buf[0] = av_buffer_create(block->data, block->size, framepool_release, block, 0);
+    if (frame->buf[0] == NULL)
+    {
+        framepool_release(block, block->data);
+        return AVERROR(ENOMEM);
+    }
+
+    frame->data[0] = block->data;
+    frame->data[1] = block->data + size_y;
+    frame->data[2] = block->data + size_y + size_uv;
+    frame->linesize[0] = stride_y;
+    frame->linesize[1] = stride_uv;
+    frame->linesize[2] = stride_uv;
+    frame->extended_data = frame->data;
+    frame->opaque = block;
+    block->frame_size = (int)(size_y + 2 * size_uv);
+
+    return 0;
+}
+
+// Returns the pool block holding the decoded frame, or NULL.
+static FrameBlock* videodecoder_frame_block(AVFrame *frame)
+{
+    if (frame->opaque == NULL || frame->buf[0] == NULL ||
+        av_buffer_get_opaque(frame->buf[0]) != frame->opaque)
+        return NULL;
+
+    return (FrameBlock*)frame->opaque;
+}
+
+static void videodecoder_release_frame(gpointer data)
+{
+    AVBufferRef *ref = (AVBufferRef*)data;
+    FrameBlock *block = (FrameBlock*)av_buffer_get_opaque(ref);
+
+    g_atomic_int_add(&block->pool->exported, -1);
+    av_buffer_unref(&ref);
+}
+
+// Wraps the decoded frame into a buffer without copying it. Returns NULL if the
+// frame is not from the pool or too many frames are referenced downstream.
+static GstBuffer* videodecoder_export_frame(VideoDecoder *decoder)
+{
+    AVFrame *frame = BASEDECODER(decoder)->frame;
+    FrameBlock *block = videodecoder_frame_block(frame);
+
+    if (block == NULL || g_atomic_int_get(&block->pool->exported) >= MAX_EXPORTED_FRAMES)
+        return NULL;
+
+    AVBufferRef *ref = av_buffer_ref(frame->buf[0]);
+    if (ref == NULL)
+        return NULL;
+
+    g_atomic_int_inc(&block->pool->exported);
+    return gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY, block->data, block->size,
+                                       0, decoder->frame_size, ref, videodecoder_release_frame);
+}
+#endif // NEW_GET_BUFFER2
+
+static void videodecoder_init_context(BaseDecoder *base)
+{
+    BASEDECODER_CLASS(parent_class)->init_context(base);
+
+#if NEW_GET_BUFFER2
+    if (base->codec->capabilities & AV_CODEC_CAP_DR1)
+    {
+        VideoDecoder *decoder = VIDEODECODER(base);
+        if (decoder->frame_pool == NULL)
+            decoder->frame_pool = framepool_new();
+
+        base->context->opaque = decoder->frame_pool;
+        base->context->get_buffer2 = videodecoder_get_buffer2;
+        // The pool is thread safe, so frame threads may allocate frames themselves.
+        base->context->thread_safe_callbacks = 1;
+        // Decoded frames keep their AVBufferRef, which is what gets exported.
+        base->context->refcounted_frames = 1;
+#ifdef CODEC_FLAG_EMU_EDGE
+        base->context->flags |= CODEC_FLAG_EMU_EDGE;
+#endif
+    }
+#endif // NEW_GET_BUFFER2
+}
+
+static void videodecoder_close(VideoDecoder *decoder)
+{
+#if NEW_GET_BUFFER2
+    if (BASEDECODER(decoder)->frame)
+        av_frame_unref(BASEDECODER(decoder)->frame);
+#endif
+    basedecoder_close_decoder(BASEDECODER(decoder));
+
+    if (decoder->packet_data)
+    {
+        av_free(decoder->packet_data);
+        decoder->packet_data = NULL;
+    }
+    decoder->packet_data_size = 0;
+
+#if NEW_GET_BUFFER2
+    // Buffers still downstream keep the pool alive.
+    if (decoder->frame_pool)
+    {
+        framepool_unref(decoder->frame_pool);
+        decoder->frame_pool = NULL;
+    }
+#endif
+}
+
 /***********************************************************************************
  * Sink event handler
  ***********************************************************************************/
@@ -208,6 +484,10 @@ static gboolean videodecoder_sink_event(GstPad *pad, GstObject *parent, GstEvent
             BASEDECODER(decoder)->is_flushing = FALSE;
             break;
 
+        case GST_EVENT_EOS:
+            videodecoder_drain(decoder);
+            break;
+
         case GST_EVENT_CAPS:
         {
             GstCaps *caps;
@@ -261,8 +541,14 @@ static void videodecoder_init_state(VideoDecoder *decoder)
     decoder->v_offset = 0;
     decoder->uv_blocksize = 0;
     decoder->frame_size = 0;
+    decoder->stride_y = 0;
+    decoder->stride_uv = 0;
     decoder->discont = FALSE;
 
+    decoder->packet_data = NULL;
+    decoder->packet_data_size = 0;
+    decoder->frame_pool = NULL;
+
     basedecoder_init_state(BASEDECODER(decoder));
 }
 
@@ -309,19 +595,43 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
     int height = base->context->height;
 #endif // NEW_CODEC_ID
 
+    // Frames of the pool are pushed as they are, so their layout is described
+    // by the caps. Other frames are copied into the same layout.
+    int u_offset, v_offset, uv_blocksize, frame_size;
+#if NEW_GET_BUFFER2
+    FrameBlock *block = videodecoder_frame_block(base->frame);
+    if (block)
+    {
+        u_offset = (int)(base->frame->data[1] - base->frame->data[0]);
+        v_offset = (int)(base->frame->data[2] - base->frame->data[0]);
+        uv_blocksize = v_offset - u_offset;
+        frame_size = block->frame_size;
+    }
+    else
+#endif // NEW_GET_BUFFER2
+    {
+        u_offset = base->frame->linesize[0] * height;
+        uv_blocksize = base->frame->linesize[1] * height / 2;
+        v_offset = u_offset + uv_blocksize;
+        frame_size = (base->frame->linesize[0] + base->frame->linesize[1]) * height;
+    }
+
     if (caps == NULL ||
-        decoder->width != width || decoder->height != height)
+        decoder->width != width || decoder->height != height ||
+        decoder->stride_y != base->frame->linesize[0] || decoder->stride_uv != base->frame->linesize[1] ||
+        decoder->u_offset != u_offset || decoder->v_offset != v_offset || decoder->frame_size != frame_size)
     {
         decoder->width = width;
         decoder->height = height;
 
         decoder->discont = (caps != NULL);
 
-        decoder->u_offset = base->frame->linesize[0] * decoder->height;
-        decoder->uv_blocksize = base->frame->linesize[1] * decoder->height / 2;
-
-        decoder->v_offset = decoder->u_offset + decoder->uv_blocksize;
-        decoder->frame_size = (base->frame->linesize[0] + base->frame->linesize[1]) * decoder->height;
+        decoder->stride_y = base->frame->linesize[0];
+        decoder->stride_uv = base->frame->linesize[1];
+        decoder->u_offset = u_offset;
+        decoder->uv_blocksize = uv_blocksize;
+        decoder->v_offset = v_offset;
+        decoder->frame_size = frame_size;
 
         GstCaps *src_caps = gst_caps_new_simple("video/x-raw-yuv",
                                                 "format", G_TYPE_STRING, "YV12",
@@ -357,6 +667,121 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
 
     return TRUE;
 }
+/***********************************************************************************
+ * Pushes the decoded frame in base->frame downstream.
+ ***********************************************************************************/
+static GstFlowReturn videodecoder_push_frame(VideoDecoder *decoder, GstClockTime duration, gboolean discont)
+{
+    BaseDecoder   *base = BASEDECODER(decoder);
+    GstFlowReturn  result = GST_FLOW_OK;
+    GstMapInfo     info2;
+
+    if (!videodecoder_configure_sourcepad(decoder))
+        result = GST_FLOW_ERROR;
+    else
+    {
+        GstBuffer *outbuf = NULL;
+        gboolean copy_frame = FALSE;
+#if NEW_GET_BUFFER2
+        outbuf = videodecoder_export_frame(decoder);
+#endif
+        if (outbuf == NULL)
+        {
+            outbuf = gst_buffer_new_allocate(NULL, decoder->frame_size, NULL);
+            copy_frame = TRUE;
+        }
+
+        if (outbuf == NULL)
+        {
+            if (result != GST_FLOW_FLUSHING)
+            {
+                gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
+                                         GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
+                                         ("Decoded video buffer allocation failed"), NULL,
+                                         ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+            }
+        }
+        else
+        {
+            GST_BUFFER_OFFSET(outbuf) = base->context->frame_number;
+            if (base->frame->reordered_opaque != AV_NOPTS_VALUE)
+            {
+                GST_BUFFER_TIMESTAMP(outbuf) = base->frame->reordered_opaque;
+                GST_BUFFER_DURATION(outbuf) = duration; // Duration for video usually same
+            }
+
+            if (copy_frame)
+            {
+                if (!gst_buffer_map(outbuf, &info2, GST_MAP_WRITE))
+                {
+                    // INLINE - gst_buffer_unref()
+                    gst_buffer_unref(outbuf);
+                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                                     g_strdup("Decoded video buffer allocation failed"), NULL, ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+                    return GST_FLOW_OK;
+                }
+
+                // Copy image by parts from different arrays.
+                memcpy(info2.data,                     base->frame->data[0], decoder->u_offset);
+                memcpy(info2.data + decoder->u_offset, base->frame->data[1], decoder->uv_blocksize);
+                memcpy(info2.data + decoder->v_offset, base->frame->data[2], decoder->uv_blocksize);
+
+                gst_buffer_unmap(outbuf, &info2);
+            }
+
+            GST_BUFFER_OFFSET_END(outbuf) = GST_BUFFER_OFFSET_NONE;
+
+            if (decoder->discont || discont)
+            {
+#ifdef DEBUG_OUTPUT
+                g_print("Video discont: frame size=%dx%d\n", base->context->width, base->context->height);
+#endif
+                GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_DISCONT);
+                decoder->discont = FALSE;
+            }
+
+
+#ifdef VERBOSE_DEBUG
+            g_print("videodecoder: pushing buffer ts=%.4f sec", (double)GST_BUFFER_TIMESTAMP(outbuf)/GST_SECOND);
+#endif
+            result = gst_pad_push(base->srcpad, outbuf);
+#ifdef VERBOSE_DEBUG
+            g_print(" done, res=%s\n", gst_flow_get_name(result));
+#endif
+        }
+    }
+
+    return result;
+}
+
+/***********************************************************************************
+ * Outputs the frames libavcodec still holds, delayed by reordering or threading.
+ ***********************************************************************************/
+static void videodecoder_drain(VideoDecoder *decoder)
+{
+    BaseDecoder *base = BASEDECODER(decoder);
+
+    if (!base->is_initialized || base->context == NULL || base->is_flushing)
+        return;
+
+    do
+    {
+#if NEW_GET_BUFFER2
+        av_frame_unref(base->frame);
+#endif
+        av_init_packet(&decoder->packet);
+        decoder->packet.data = NULL;
+        decoder->packet.size = 0;
+
+        if (avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet) < 0)
+            break;
+
+        if (decoder->frame_finished > 0 &&
+            videodecoder_push_frame(decoder, GST_CLOCK_TIME_NONE, FALSE) != GST_FLOW_OK)
+            break;
+    } while (decoder->frame_finished > 0);
+}
+
 /***********************************************************************************
  * chain
  ***********************************************************************************/
@@ -367,7 +792,6 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
     GstFlowReturn  result = GST_FLOW_OK;
     int            num_dec = NO_DATA_USED;
     GstMapInfo     info;
-    GstMapInfo     info2;
     gboolean       unmap_buf = FALSE;
 
     if (base->is_flushing)  // Reject buffers in flushing state.
@@ -390,36 +814,45 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
 
     unmap_buf = TRUE;
 
-    if (!base->is_hls)
+#if NEW_GET_BUFFER2
+    // Drop the reference to the previous frame, buffers pushed downstream hold their own.
+    av_frame_unref(base->frame);
+#endif
+
+    av_init_packet(&decoder->packet);
+    if (base->is_hls || info.maxsize - info.size >= AV_INPUT_BUFFER_PADDING_SIZE)
     {
-        if (av_new_packet(&decoder->packet, info.size) == 0)
-        {
-            memcpy(decoder->packet.data, info.data, info.size);
-            if (GST_BUFFER_TIMESTAMP_IS_VALID(buf))
-                base->context->reordered_opaque = GST_BUFFER_TIMESTAMP(buf);
-            else
-                base->context->reordered_opaque = AV_NOPTS_VALUE;
-            num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet);
-            av_free_packet(&decoder->packet);
-        }
-        else
+        // The bitstream reader may read up to AV_INPUT_BUFFER_PADDING_SIZE bytes
+        // past the end of the packet, which stays within the memory of buf here.
+        decoder->packet.data = info.data;
+    }
+    else
+    {
+        // Copy into a padded buffer, which is reused for the following packets.
+        if (decoder->packet_data_size < (int)info.size + AV_INPUT_BUFFER_PADDING_SIZE)
         {
-            result = GST_FLOW_ERROR;
-            goto _exit;
+            av_free(decoder->packet_data);
+            decoder->packet_data_size = (int)info.size + (int)info.size / 4 + AV_INPUT_BUFFER_PADDING_SIZE;
+            decoder->packet_data = av_malloc(decoder->packet_data_size);
+            if (decoder->packet_data == NULL)
+            {
+                decoder->packet_data_size = 0;
+                result = GST_FLOW_ERROR;
+                goto _exit;
+            }
         }
+        memcpy(decoder->packet_data, info.data, info.size);
+        memset(decoder->packet_data + info.size, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+        decoder->packet.data = decoder->packet_data;
     }
+    decoder->packet.size = info.size;
+
+    if (GST_BUFFER_TIMESTAMP_IS_VALID(buf))
+        base->context->reordered_opaque = GST_BUFFER_TIMESTAMP(buf);
     else
-    {
-        av_init_packet(&decoder->packet);
-        decoder->packet.data = info.data;
-        decoder->packet.size = info.size;
-        if (GST_BUFFER_TIMESTAMP_IS_VALID(buf))
-            base->context->reordered_opaque = GST_BUFFER_TIMESTAMP(buf);
-        else
-            base->context->reordered_opaque = AV_NOPTS_VALUE;
+        base->context->reordered_opaque = AV_NOPTS_VALUE;
 
-        num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet);
-    }
+    num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet);
 
     if (num_dec < 0)
     {
@@ -431,69 +864,7 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
     }
 
     if (decoder->frame_finished > 0)
-    {
-        if (!videodecoder_configure_sourcepad(decoder))
-            result = GST_FLOW_ERROR;
-        else
-        {
-            GstBuffer *outbuf = gst_buffer_new_allocate(NULL, decoder->frame_size, NULL);
-            if (outbuf == NULL)
-            {
-                if (result != GST_FLOW_FLUSHING)
-                {
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
-                                             GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
-                                             ("Decoded video buffer allocation failed"), NULL,
-                                             ("videodecoder.c"), ("videodecoder_chain"), 0);
-                }
-            }
-            else
-            {
-                GST_BUFFER_OFFSET(outbuf) = base->context->frame_number;
-                if (base->frame->reordered_opaque != AV_NOPTS_VALUE)
-                {
-                    GST_BUFFER_TIMESTAMP(outbuf) = base->frame->reordered_opaque;
-                    GST_BUFFER_DURATION(outbuf) = GST_BUFFER_DURATION(buf); // Duration for video usually same
-                }
-
-                if (!gst_buffer_map(outbuf, &info2, GST_MAP_WRITE))
-                {
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Decoded video buffer allocation failed"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
-
-                // Copy image by parts from different arrays.
-                memcpy(info2.data,                     base->frame->data[0], decoder->u_offset);
-                memcpy(info2.data + decoder->u_offset, base->frame->data[1], decoder->uv_blocksize);
-                memcpy(info2.data + decoder->v_offset, base->frame->data[2], decoder->uv_blocksize);
-
-                gst_buffer_unmap(outbuf, &info2);
-
-                GST_BUFFER_OFFSET_END(outbuf) = GST_BUFFER_OFFSET_NONE;
-
-                if (decoder->discont || GST_BUFFER_IS_DISCONT(buf))
-                {
-#ifdef DEBUG_OUTPUT
-                    g_print("Video discont: frame size=%dx%d\n", base->context->width, base->context->height);
-#endif
-                    GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_DISCONT);
-                    decoder->discont = FALSE;
-                }
-
-
-#ifdef VERBOSE_DEBUG
-                g_print("videodecoder: pushing buffer ts=%.4f sec", (double)GST_BUFFER_TIMESTAMP(outbuf)/GST_SECOND);
-#endif
-                result = gst_pad_push(base->srcpad, outbuf);
-#ifdef VERBOSE_DEBUG
-                g_print(" done, res=%s\n", gst_flow_get_name(result));
-#endif
-            }
-        }
-    }
+        result = videodecoder_push_frame(decoder, GST_BUFFER_DURATION(buf), GST_BUFFER_IS_DISCONT(buf));
 
 _exit:
     if (unmap_buf)
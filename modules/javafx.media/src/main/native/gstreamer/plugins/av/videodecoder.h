@@ -45,6 +45,7 @@ G_BEGIN_DECLS
 
 typedef struct _VideoDecoder      VideoDecoder;
 typedef struct _VideoDecoderClass VideoDecoderClass;
+typedef struct _FramePool         FramePool;
 
 struct _VideoDecoder {
     BaseDecoder parent;
@@ -58,8 +59,14 @@ struct _VideoDecoder {
     int         u_offset;
     int         v_offset;
     int         uv_blocksize;
+    int         stride_y;
+    int         stride_uv;
 
     AVPacket       packet;
+    uint8_t        *packet_data;       // padded copy of the input, when it can't be referenced
+    int            packet_data_size;   // allocated size of packet_data
+
+    FramePool      *frame_pool;        // frame buffers handed to libavcodec and pushed downstream
 };
 
 struct _VideoDecoderClass
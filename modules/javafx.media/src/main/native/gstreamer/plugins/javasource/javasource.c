@@ -52,6 +52,8 @@ enum
     SIGNAL_CLOSE_CONNECTION,
     SIGNAL_PROPERTY,
     SIGNAL_GET_STREAM_SIZE,
+    SIGNAL_SET_READ_AHEAD_BUFFER,
+    SIGNAL_READ_AHEAD,
     LAST_SIGNAL
 };
 
@@ -64,7 +66,8 @@ enum
     PROP_STOP_ON_PAUSE,
     PROP_LOCATION,
     PROP_MIMETYPE,
-    PROP_HLS_MODE
+    PROP_HLS_MODE,
+    PROP_READ_AHEAD_SIZE
 };
 
 /***********************************************************************************
@@ -77,6 +80,31 @@ enum
     MODE_HLS_LIVE = 0x04
 };
 
+/***********************************************************************************
+* Read-ahead ring. The Java side fills free regions of the ring in large chunks
+* and every chunk is pushed downstream as a buffer wrapping the ring memory.
+* A region is free again once all buffers pushed before it have been released.
+***********************************************************************************/
+#define MAX_READ_AHEAD_SIZE (64 * 1024 * 1024)
+
+typedef struct _ReadAheadRing
+{
+    gint    refcount;
+    GMutex  lock;
+    guint8  *data;
+    guint   size;
+    guint64 head;   // Bytes handed out since the ring was created
+    guint64 tail;   // Bytes released in ring order, guarded by lock
+    GQueue  slices; // Outstanding slices in ring order, guarded by lock
+} ReadAheadRing;
+
+typedef struct _ReadAheadSlice
+{
+    ReadAheadRing *ring;
+    guint         length;
+    gboolean      released;
+} ReadAheadSlice;
+
 /***********************************************************************************
 * Element structures are hidden from outside
 ***********************************************************************************/
@@ -104,6 +132,9 @@ struct _JavaSource
     gchar*        location; // property controlled
     gchar*        mimetype; // property controlled
     gdouble       rate;
+
+    guint         read_ahead_size; // property controlled
+    ReadAheadRing *ring;
 };
 
 struct _JavaSourceClass
@@ -211,6 +242,11 @@ static void java_source_class_init (JavaSourceClass *klass)
         g_param_spec_boolean ("hls-mode", "HLS Mode", "HTTP Live Streaming Mode", FALSE,
         G_PARAM_WRITABLE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
 
+    g_object_class_install_property (gobject_klass, PROP_READ_AHEAD_SIZE,
+        g_param_spec_uint ("read-ahead-size", "Read-ahead size", "Size of the ring filled by read-ahead, 0 to pull every block with read-next-block",
+        0, MAX_READ_AHEAD_SIZE, 0,
+        G_PARAM_WRITABLE | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY));
+
     g_object_class_install_property (gobject_klass, PROP_LOCATION,
         g_param_spec_string ("location", "Source Location", "Location of the source to read", NULL,
         G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY));
@@ -292,6 +328,28 @@ static void java_source_class_init (JavaSourceClass *klass)
         source_marshal_INT__VOID,
         G_TYPE_INT, /* return_type */
         0    /* n_params */ );
+
+    klass->signals[SIGNAL_SET_READ_AHEAD_BUFFER] = g_signal_new ("set-read-ahead-buffer",
+        G_TYPE_FROM_CLASS (klass),
+        G_SIGNAL_RUN_LAST | G_SIGNAL_NO_RECURSE | G_SIGNAL_NO_HOOKS,
+        0,
+        NULL, /* accumulator */
+        NULL, /* accu_data */
+        source_marshal_VOID__POINTER_INT,
+        G_TYPE_NONE, /* return_type */
+        2,     /* n_params */
+        G_TYPE_POINTER, G_TYPE_INT);
+
+    klass->signals[SIGNAL_READ_AHEAD] = g_signal_new ("read-ahead",
+        G_TYPE_FROM_CLASS (klass),
+        G_SIGNAL_RUN_LAST | G_SIGNAL_NO_RECURSE | G_SIGNAL_NO_HOOKS,
+        0,
+        NULL, /* accumulator */
+        NULL, /* accu_data */
+        source_marshal_INT__INT_INT,
+        G_TYPE_INT, /* return_type */
+        2,    /* n_params */
+        G_TYPE_INT, G_TYPE_INT);
 }
 
 static void java_source_init(JavaSource *element)
@@ -314,6 +372,9 @@ static void java_source_init(JavaSource *element)
     element->rate = 1.0; // Default to 1.0
 
     element->mimetype = NULL;
+
+    element->read_ahead_size = 0;
+    element->ring = NULL;
 }
 
 /***********************************************************************************
@@ -349,6 +410,9 @@ static void java_source_set_property (GObject *object, guint prop_id,
     case PROP_MIMETYPE:
         element->mimetype = g_strdup(g_value_get_string (value));
         break;
+    case PROP_READ_AHEAD_SIZE:
+        element->read_ahead_size = g_value_get_uint (value);
+        break;
     default:
         break;
     }
@@ -367,9 +431,180 @@ static void java_source_get_property (GObject *object, guint prop_id,
     }
 }
 
+/***********************************************************************************
+* Read-ahead ring
+***********************************************************************************/
+static ReadAheadRing* read_ahead_ring_new(guint size)
+{
+    ReadAheadRing *ring = g_new0(ReadAheadRing, 1);
+
+    size = (size + BUFFER_SIZE - 1) & ~(BUFFER_SIZE - 1);
+    ring->data = (guint8*)g_try_malloc(size);
+    if (NULL == ring->data)
+    {
+        g_free(ring);
+        return NULL;
+    }
+
+    ring->refcount = 1;
+    ring->size = size;
+    g_mutex_init(&ring->lock);
+    g_queue_init(&ring->slices);
+    return ring;
+}
+
+static void read_ahead_ring_unref(ReadAheadRing *ring)
+{
+    if (g_atomic_int_dec_and_test(&ring->refcount))
+    {
+        ReadAheadSlice *slice;
+        // Only released padding can be left, every pushed slice holds a reference.
+        while ((slice = (ReadAheadSlice*)g_queue_pop_head(&ring->slices)) != NULL)
+            g_free(slice);
+        g_mutex_clear(&ring->lock);
+        g_free(ring->data);
+        g_free(ring);
+    }
+}
+
+// Must be called with the ring lock held.
+static void read_ahead_ring_trim(ReadAheadRing *ring)
+{
+    ReadAheadSlice *slice;
+    while ((slice = (ReadAheadSlice*)g_queue_peek_head(&ring->slices)) != NULL && slice->released)
+    {
+        g_queue_pop_head(&ring->slices);
+        ring->tail += slice->length;
+        g_free(slice);
+    }
+}
+
+static void read_ahead_slice_release(gpointer data)
+{
+    ReadAheadSlice *slice = (ReadAheadSlice*)data;
+    ReadAheadRing  *ring = slice->ring;
+
+    g_mutex_lock(&ring->lock);
+    slice->released = TRUE;
+    read_ahead_ring_trim(ring);
+    g_mutex_unlock(&ring->lock);
+
+    read_ahead_ring_unref(ring);
+}
+
+/***********************************************************************************
+* Returns the number of bytes the Java side may write at *offset, which is 0 if
+* the buffers pushed downstream still reference the whole ring. Only called
+* from the streaming thread, the only one that moves the head.
+***********************************************************************************/
+static guint read_ahead_ring_reserve(ReadAheadRing *ring, guint *offset)
+{
+    guint start, free_space, contiguous;
+
+    g_mutex_lock(&ring->lock);
+    start = (guint)(ring->head % ring->size);
+    free_space = ring->size - (guint)(ring->head - ring->tail);
+    contiguous = MIN(free_space, ring->size - start);
+
+    if (contiguous < BUFFER_SIZE && free_space - contiguous >= BUFFER_SIZE)
+    {
+        // Too little room left before the end of the ring, wrap around.
+        if (g_queue_is_empty(&ring->slices))
+            ring->tail += contiguous;
+        else
+        {
+            ReadAheadSlice *padding = g_new0(ReadAheadSlice, 1);
+            padding->length = contiguous;
+            padding->released = TRUE;
+            g_queue_push_tail(&ring->slices, padding);
+        }
+        ring->head += contiguous;
+        free_space -= contiguous;
+        start = 0;
+        contiguous = MIN(free_space, ring->size);
+    }
+    g_mutex_unlock(&ring->lock);
+
+    *offset = start;
+    if (contiguous < BUFFER_SIZE)
+        return 0;
+
+    // Read in quarters of the ring, so the Java side can refill it while
+    // downstream still holds the previous chunks.
+    return MIN(contiguous, MAX(ring->size / 4, BUFFER_SIZE));
+}
+
+static GstBuffer* read_ahead_ring_commit(ReadAheadRing *ring, guint offset, guint size)
+{
+    ReadAheadSlice *slice = g_new0(ReadAheadSlice, 1);
+    GstBuffer *buffer;
+
+    slice->ring = ring;
+    slice->length = size;
+    g_atomic_int_inc(&ring->refcount);
+
+    g_mutex_lock(&ring->lock);
+    g_queue_push_tail(&ring->slices, slice);
+    ring->head += size;
+    g_mutex_unlock(&ring->lock);
+
+    buffer = gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY, ring->data + offset,
+                                         size, 0, size, slice, read_ahead_slice_release);
+    if (NULL == buffer)
+        read_ahead_slice_release(slice);
+    return buffer;
+}
+
+/***********************************************************************************
+* Reads the next block through the read-ahead ring. Returns FALSE if the ring can
+* not be used, in which case the block has to be read with read-next-block.
+* Otherwise *size is set to the number of bytes read or an error code, and
+* *buffer to the buffer to push if *size is positive.
+***********************************************************************************/
+static gboolean java_source_read_ahead(JavaSource *element, GstBuffer **buffer, gint *size)
+{
+    guint offset, length;
+
+    if (0 == element->read_ahead_size || (element->mode & MODE_DEFAULT) != MODE_DEFAULT)
+        return FALSE;
+
+    if (NULL == element->ring)
+    {
+        element->ring = read_ahead_ring_new(element->read_ahead_size);
+        if (NULL == element->ring)
+        {
+            GST_WARNING_OBJECT(element, "Failed to allocate %u bytes read-ahead ring", element->read_ahead_size);
+            element->read_ahead_size = 0;
+            return FALSE;
+        }
+        g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_SET_READ_AHEAD_BUFFER], 0,
+                      element->ring->data, (gint)element->ring->size);
+    }
+
+    length = read_ahead_ring_reserve(element->ring, &offset);
+    if (0 == length)
+    {
+        GST_LOG_OBJECT(element, "Read-ahead ring is full");
+        return FALSE;
+    }
+
+    *buffer = NULL;
+    g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_AHEAD], 0, (gint)offset, (gint)length, size);
+    if (*size > 0)
+    {
+        *buffer = read_ahead_ring_commit(element->ring, offset, (guint)*size);
+        if (NULL == *buffer)
+            *size = OTHER_ERROR_CODE;
+    }
+
+    return TRUE;
+}
+
 static void java_source_finalize (GObject *object)
 {
     JavaSource *element = JAVA_SOURCE(object);
+    if (element->ring)
+        read_ahead_ring_unref(element->ring);
     g_mutex_clear(&element->lock);
     g_free(element->location);
     if (element->mimetype)
@@ -618,25 +853,37 @@ next_event:
 
         case GST_EVENT_UNKNOWN: // Pushing buffers
             {
-                gint     size;
+                gint     size = 0;
+                GstBuffer *buffer = NULL;
                 GstMapInfo info;
-                g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK], 0, &size);
-                if (size > 0)
+
+                if (!java_source_read_ahead(element, &buffer, &size))
                 {
-                    GstBuffer *buffer = gst_buffer_new_allocate(NULL, size, NULL);
-                    if (buffer)
+                    g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK], 0, &size);
+                    if (size > 0)
                     {
-                        GST_BUFFER_OFFSET(buffer) = element->position;
-
-                        if (!gst_buffer_map(buffer, &info, GST_MAP_WRITE))
+                        buffer = gst_buffer_new_allocate(NULL, size, NULL);
+                        if (buffer)
                         {
-                            result = GST_FLOW_ERROR;
-                            break;
-                        }
+                            if (!gst_buffer_map(buffer, &info, GST_MAP_WRITE))
+                            {
+                                gst_buffer_unref(buffer);
+                                result = GST_FLOW_ERROR;
+                                break;
+                            }
 
-                        g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data, size);
+                            g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data, size);
 
-                        gst_buffer_unmap(buffer, &info);
+                            gst_buffer_unmap(buffer, &info);
+                        }
+                    }
+                }
+
+                if (size > 0)
+                {
+                    if (buffer)
+                    {
+                        GST_BUFFER_OFFSET(buffer) = element->position;
 
                         if (element->discont)
                         {
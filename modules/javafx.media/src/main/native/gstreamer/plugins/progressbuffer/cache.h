@@ -32,9 +32,24 @@ typedef struct _Cache Cache;
 
 void      cache_static_init(void); // Must be called only once from the ProgressBuffer class initializer
 
-Cache*    create_cache();
+typedef enum
+{
+    CACHE_MODE_FILE, // Temporary file accessed with read() and write()
+    CACHE_MODE_MMAP, // Temporary file read through memory mapped segments without copying
+    CACHE_MODE_RAM   // Memory only, for short content
+} CacheMode;
+
+Cache*    create_cache(); // Same as create_cache_with_mode(CACHE_MODE_FILE)
+// Modes not supported by the platform fall back to CACHE_MODE_FILE.
+Cache*    create_cache_with_mode(CacheMode mode);
 void      destroy_cache(Cache* instance);
 
+// Content of up to ram_cache_limit bytes is cached in memory, whatever the mode.
+static inline CacheMode cache_mode_for_size(CacheMode mode, gint64 size, gint64 ram_cache_limit)
+{
+    return size <= ram_cache_limit ? CACHE_MODE_RAM : mode;
+}
+
 // Writes a buffer.
 void           cache_write_buffer(Cache* cache, GstBuffer* buffer);
 
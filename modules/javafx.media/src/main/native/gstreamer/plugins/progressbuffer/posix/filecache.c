@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2017, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,20 +26,56 @@
 #include <cache.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
+#include <string.h>
 #include <unistd.h>
 
 #define DEFAULT_BUFFER_SIZE 4096
+
+// Segmented modes (CACHE_MODE_MMAP and CACHE_MODE_RAM) keep the data in
+// segments of SEGMENT_SIZE bytes. Buffers handed out wrap the segment memory
+// and hold a reference to the segment, so they stay valid after the cache
+// rewinds or is destroyed.
+#define SEGMENT_SIZE      (1024 * 1024)
+#define SEGMENT_READ_SIZE (64 * 1024)
+
 static const char *tempDir = NULL;
 
+typedef struct _CacheFile    CacheFile;
+typedef struct _CacheSegment CacheSegment;
+
+// Temporary file of CACHE_MODE_MMAP. Segments own SEGMENT_SIZE ranges of the
+// file, which are reused once the segments are released.
+struct _CacheFile
+{
+    gint    refcount;
+    int     handle;
+    GMutex  lock;
+    GArray* free_offsets;
+    gint64  size;
+};
+
+struct _CacheSegment
+{
+    gint       refcount;
+    CacheFile* file;     // NULL in CACHE_MODE_RAM
+    gint64     offset;   // offset in the file
+    guint8*    data;     // mapped lazily in CACHE_MODE_MMAP
+};
+
 struct _Cache
 {
-    char*   filename;
-    int     readHandle;
-    int     writeHandle;
+    CacheMode mode;
+    char*     filename;
+    int       readHandle;
+    int       writeHandle;
+
+    gint64    read_position;
+    gint64    write_position;
 
-    gint64  read_position;
-    gint64  write_position;
+    CacheFile* file;
+    GPtrArray* segments; // CacheSegment* for each SEGMENT_SIZE of data
 };
 
 void cache_static_init(void)
@@ -47,43 +83,339 @@ void cache_static_init(void)
     tempDir = g_get_tmp_dir();
 }
 
-Cache* create_cache()
+static int create_temp_file(char** filename)
 {
-    Cache* result= (Cache*)g_try_malloc(sizeof(Cache));
-    if (result)
+    int handle;
+
+    *filename = g_build_filename(tempDir, "jfxmpbXXXXXX", NULL);
+    if (*filename == NULL)
+        return -1;
+
+    handle = g_mkstemp_full(*filename, O_RDWR, S_IRUSR|S_IWUSR);
+    return handle;
+}
+
+/***********************************************************************************
+ * Segments
+ ***********************************************************************************/
+static void cache_file_unref(CacheFile* file)
+{
+    if (g_atomic_int_dec_and_test(&file->refcount))
+    {
+        close(file->handle);
+        g_array_free(file->free_offsets, TRUE);
+        g_mutex_clear(&file->lock);
+        g_free(file);
+    }
+}
+
+static CacheSegment* segment_ref(CacheSegment* segment)
+{
+    g_atomic_int_inc(&segment->refcount);
+    return segment;
+}
+
+// May be called on any thread, when the last buffer wrapping the segment is freed.
+static void segment_unref(CacheSegment* segment)
+{
+    if (g_atomic_int_dec_and_test(&segment->refcount))
     {
-        result->filename = g_build_filename(tempDir, "jfxmpbXXXXXX", NULL);
-        if (result->filename == NULL)
-            goto _error_exit;
+        if (segment->file)
+        {
+            if (segment->data)
+                munmap(segment->data, SEGMENT_SIZE);
+
+            g_mutex_lock(&segment->file->lock);
+            g_array_append_val(segment->file->free_offsets, segment->offset);
+            g_mutex_unlock(&segment->file->lock);
+            cache_file_unref(segment->file);
+        }
         else
+            g_free(segment->data);
+
+        g_free(segment);
+    }
+}
+
+static CacheSegment* segment_new(Cache* cache)
+{
+    CacheSegment* segment = g_try_new0(CacheSegment, 1);
+    if (!segment)
+        return NULL;
+
+    segment->refcount = 1;
+    if (cache->mode == CACHE_MODE_RAM)
+    {
+        segment->data = (guint8*)g_try_malloc(SEGMENT_SIZE);
+        if (!segment->data)
         {
-        result->writeHandle = g_mkstemp_full(result->filename, O_RDWR, S_IRUSR|S_IWUSR);
-            result->readHandle = open(result->filename, O_RDONLY, 0);
+            g_free(segment);
+            return NULL;
+        }
+    }
+    else
+    {
+        CacheFile* file = cache->file;
 
-            if(result->writeHandle < 0 || result->readHandle < 0)
-                goto _error_exit;
+        g_mutex_lock(&file->lock);
+        if (file->free_offsets->len > 0)
+        {
+            segment->offset = g_array_index(file->free_offsets, gint64, file->free_offsets->len - 1);
+            g_array_set_size(file->free_offsets, file->free_offsets->len - 1);
+        }
+        else
+        {
+            segment->offset = file->size;
+            file->size += SEGMENT_SIZE;
+        }
+        g_mutex_unlock(&file->lock);
+
+        g_atomic_int_inc(&file->refcount);
+        segment->file = file;
+    }
+    return segment;
+}
+
+// Maps the segment on first use. Only the part of the segment below the write
+// position is ever accessed, which is always backed by the file.
+static gboolean segment_map(CacheSegment* segment)
+{
+    if (!segment->data && segment->file)
+    {
+        void* data = mmap(NULL, SEGMENT_SIZE, PROT_READ, MAP_SHARED, segment->file->handle, segment->offset);
+        if (data == MAP_FAILED)
+            return FALSE;
+        segment->data = (guint8*)data;
+    }
+    return segment->data != NULL;
+}
+
+static inline CacheSegment* cache_get_segment(Cache* cache, gint64 position)
+{
+    guint index = (guint)(position / SEGMENT_SIZE);
+    return index < cache->segments->len ? (CacheSegment*)g_ptr_array_index(cache->segments, index) : NULL;
+}
+
+// Copies size bytes at position, which must be below the write position.
+static gboolean cache_copy_data(Cache* cache, gint64 position, guint8* data, guint size)
+{
+    while (size > 0)
+    {
+        CacheSegment* segment = cache_get_segment(cache, position);
+        guint inner = (guint)(position % SEGMENT_SIZE);
+        guint count = MIN(size, SEGMENT_SIZE - inner);
+
+        if (!segment)
+            return FALSE;
+
+        if (segment_map(segment))
+            memcpy(data, segment->data + inner, count);
+        else if (pread(segment->file->handle, data, count, segment->offset + inner) != (ssize_t)count)
+            return FALSE;
+
+        position += count;
+        data += count;
+        size -= count;
+    }
+    return TRUE;
+}
+
+// Returns a buffer of size bytes at position, which must be below the write position.
+static GstBuffer* cache_create_buffer(Cache* cache, gint64 position, guint size)
+{
+    CacheSegment* segment = cache_get_segment(cache, position);
+    guint inner = (guint)(position % SEGMENT_SIZE);
+    GstBuffer* buffer = NULL;
+
+    if (segment && inner + size <= SEGMENT_SIZE && segment_map(segment))
+    {
+        // Zero copy: the buffer wraps the segment memory
+        buffer = gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY, segment->data, inner + size, inner, size,
+                                             segment_ref(segment), (GDestroyNotify)segment_unref);
+    }
+    else
+    {
+        // The data spans segments or could not be mapped
+        guint8 *data = (guint8*)g_try_malloc(size);
+        if (data)
+        {
+            if (cache_copy_data(cache, position, data, size))
+                buffer = gst_buffer_new_wrapped_full(0, data, size, 0, size, data, g_free);
+            else
+                g_free(data);
+        }
+    }
+
+    if (buffer != NULL)
+        GST_BUFFER_OFFSET(buffer) = position;
+    return buffer;
+}
+
+static gboolean cache_write_data(Cache* cache, const guint8* data, gsize size)
+{
+    while (size > 0)
+    {
+        guint index = (guint)(cache->write_position / SEGMENT_SIZE);
+        guint inner = (guint)(cache->write_position % SEGMENT_SIZE);
+        guint count = (guint)MIN(size, (gsize)(SEGMENT_SIZE - inner));
+        CacheSegment* segment;
+
+        if (index >= cache->segments->len)
+            g_ptr_array_set_size(cache->segments, index + 1);
+
+        segment = (CacheSegment*)g_ptr_array_index(cache->segments, index);
+        if (!segment)
+        {
+            segment = segment_new(cache);
+            if (!segment)
+                return FALSE;
+            g_ptr_array_index(cache->segments, index) = segment;
+        }
 
-        if (unlink(result->filename) < 0)
+        if (segment->file)
         {
-            close (result->writeHandle);
-            close (result->readHandle);
-        goto _error_exit;
+            if (pwrite(segment->file->handle, data, count, segment->offset + inner) != (ssize_t)count)
+                return FALSE;
         }
+        else
+            memcpy(segment->data + inner, data, count);
+
+        cache->write_position += count;
+        data += count;
+        size -= count;
+    }
+    return TRUE;
+}
+
+// Data from position on is going to be written again. Segments still wrapped by
+// buffers are replaced, so that the buffers keep their data.
+static gboolean cache_detach_segments(Cache* cache, gint64 position)
+{
+    guint index;
+    for (index = (guint)(position / SEGMENT_SIZE); index < cache->segments->len; index++)
+    {
+        CacheSegment* segment = (CacheSegment*)g_ptr_array_index(cache->segments, index);
+        if (segment && g_atomic_int_get(&segment->refcount) > 1)
+        {
+            gint64 start = (gint64)index * SEGMENT_SIZE;
+            guint8* prefix = NULL;
+            guint prefix_size = position > start ? (guint)(position - start) : 0;
+
+            // Keep the data in front of position
+            if (prefix_size > 0)
+            {
+                prefix = (guint8*)g_try_malloc(prefix_size);
+                if (!prefix || !cache_copy_data(cache, start, prefix, prefix_size))
+                {
+                    g_free(prefix);
+                    return FALSE;
+                }
+            }
+
+            g_ptr_array_index(cache->segments, index) = NULL;
+            segment_unref(segment);
+
+            if (prefix)
+            {
+                gint64 write_position = cache->write_position;
+                gboolean result;
 
-            result->read_position = result->write_position = 0;
+                cache->write_position = start;
+                result = cache_write_data(cache, prefix, prefix_size);
+                cache->write_position = write_position;
+                g_free(prefix);
+                if (!result)
+                    return FALSE;
+            }
+        }
+    }
+    return TRUE;
+}
+
+/***********************************************************************************
+ * Cache
+ ***********************************************************************************/
+Cache* create_cache()
+{
+    return create_cache_with_mode(CACHE_MODE_FILE);
+}
+
+Cache* create_cache_with_mode(CacheMode mode)
+{
+    Cache* result= (Cache*)g_try_malloc0(sizeof(Cache));
+    if (result)
+    {
+        result->mode = mode;
+        result->readHandle = result->writeHandle = -1;
+        result->read_position = result->write_position = 0;
+
+        if (mode != CACHE_MODE_RAM)
+        {
+            result->writeHandle = create_temp_file(&result->filename);
+            if (result->writeHandle < 0)
+                goto _error_exit;
+
+            if (mode == CACHE_MODE_FILE)
+            {
+                result->readHandle = open(result->filename, O_RDONLY, 0);
+                if (result->readHandle < 0)
+                {
+                    close (result->writeHandle);
+                    goto _error_exit;
+                }
+            }
+
+            if (unlink(result->filename) < 0)
+            {
+                close (result->writeHandle);
+                if (result->readHandle >= 0)
+                    close (result->readHandle);
+                goto _error_exit;
+            }
+        }
+
+        if (mode != CACHE_MODE_FILE)
+        {
+            result->segments = g_ptr_array_new();
+            if (mode == CACHE_MODE_MMAP)
+            {
+                result->file = g_new0(CacheFile, 1);
+                result->file->refcount = 1;
+                result->file->handle = result->writeHandle;
+                result->file->free_offsets = g_array_new(FALSE, FALSE, sizeof(gint64));
+                g_mutex_init(&result->file->lock);
+            }
         }
     }
     return result;
 
 _error_exit:
+    g_free(result->filename);
     g_free(result);
     return NULL;
 }
 
 void destroy_cache(Cache* instance)
 {
-    close(instance->writeHandle);
-    close(instance->readHandle);
+    if (instance->segments)
+    {
+        guint index;
+        for (index = 0; index < instance->segments->len; index++)
+        {
+            CacheSegment* segment = (CacheSegment*)g_ptr_array_index(instance->segments, index);
+            if (segment)
+                segment_unref(segment);
+        }
+        g_ptr_array_free(instance->segments, TRUE);
+    }
+
+    if (instance->file)
+        cache_file_unref(instance->file); // Closes writeHandle once all the segments are released
+    else if (instance->writeHandle >= 0)
+        close(instance->writeHandle);
+
+    if (instance->readHandle >= 0)
+        close(instance->readHandle);
     g_free(instance->filename);
 
     g_free(instance);
@@ -94,18 +426,46 @@ void cache_write_buffer(Cache* cache, GstBuffer* buffer)
     GstMapInfo info;
     if (gst_buffer_map(buffer, &info, GST_MAP_READ))
     {
-        ssize_t written = write(cache->writeHandle, info.data, info.size);
-        if (written > 0)
-            cache->write_position += written;
+        if (cache->mode == CACHE_MODE_FILE)
+        {
+            ssize_t written = write(cache->writeHandle, info.data, info.size);
+            if (written > 0)
+                cache->write_position += written;
+        }
+        else
+            cache_write_data(cache, info.data, info.size);
         gst_buffer_unmap(buffer, &info);
     }
 }
 
 gint64 cache_read_buffer(Cache* cache, GstBuffer** buffer)
 {
-    guint8 *data = (guint8*)g_try_malloc(DEFAULT_BUFFER_SIZE);
+    guint8 *data;
     *buffer = NULL;
 
+    if (cache->mode != CACHE_MODE_FILE)
+    {
+        gint64 available = cache->write_position - cache->read_position;
+        if (available > 0)
+        {
+            guint size = (guint)MIN(available, SEGMENT_READ_SIZE);
+            guint inner = (guint)(cache->read_position % SEGMENT_SIZE);
+
+            // Stop at the end of the segment rather than copying
+            if (inner + size > SEGMENT_SIZE)
+                size = SEGMENT_SIZE - inner;
+
+            *buffer = cache_create_buffer(cache, cache->read_position, size);
+            if (*buffer != NULL)
+            {
+                cache->read_position += size;
+                return cache->read_position;
+            }
+        }
+        return 0;
+    }
+
+    data = (guint8*)g_try_malloc(DEFAULT_BUFFER_SIZE);
     if (data)
     {
         ssize_t size = 0;
@@ -137,6 +497,20 @@ GstFlowReturn cache_read_buffer_from_position(Cache* cache, gint64 start_positio
     GstFlowReturn result = GST_FLOW_ERROR;
     *buffer = NULL;
 
+    if (cache->mode != CACHE_MODE_FILE)
+    {
+        if (start_position >= 0 && start_position + size <= cache->write_position)
+        {
+            *buffer = cache_create_buffer(cache, start_position, size);
+            if (*buffer != NULL)
+            {
+                cache->read_position = start_position + size;
+                result = GST_FLOW_OK;
+            }
+        }
+        return result;
+    }
+
     if (cache_set_read_position(cache, start_position))
     {
         guint8 *data = (guint8*)g_try_malloc(size);
@@ -171,7 +545,10 @@ gboolean cache_set_write_position(Cache* cache, gint64 position)
     gboolean result = (position == cache->write_position);
     if (!result)
     {
-        result = cache_set_handler_position(cache->writeHandle, position);
+        if (cache->mode == CACHE_MODE_FILE)
+            result = cache_set_handler_position(cache->writeHandle, position);
+        else
+            result = position >= 0 && cache_detach_segments(cache, position);
         if (result)
             cache->write_position = position;
     }
@@ -183,7 +560,10 @@ gboolean cache_set_read_position(Cache* cache, gint64 position)
     gboolean result = (position == cache->read_position);
     if (!result)
     {
-        result = cache_set_handler_position(cache->readHandle, position);
+        if (cache->mode == CACHE_MODE_FILE)
+            result = cache_set_handler_position(cache->readHandle, position);
+        else
+            result = position >= 0;
         if (result)
             cache->read_position = position;
     }
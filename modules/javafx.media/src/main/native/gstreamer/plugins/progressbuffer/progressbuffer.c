@@ -48,9 +48,14 @@ enum
     PROP_THRESHOLD,
     PROP_BANDWIDTH,
     PROP_PREBUFFER_TIME,
-    PROP_WAIT_TOLERANCE
+    PROP_WAIT_TOLERANCE,
+    PROP_CACHE_MODE,
+    PROP_RAM_CACHE_LIMIT
 };
 
+#define DEFAULT_CACHE_MODE     CACHE_MODE_FILE
+#define DEFAULT_RAM_CACHE_LIMIT (4 * 1024 * 1024)
+
 /***********************************************************************************
  * Element structures are hidden from outside
  ***********************************************************************************/
@@ -85,6 +90,8 @@ struct _ProgressBuffer
     gdouble       bandwidth; // property accessible.
     gdouble       prebuffer_time; // property controlled.
     gdouble       wait_tolerance; // property controlled.
+    gint          cache_mode; // property controlled.
+    gint64        ram_cache_limit; // property controlled.
     GTimer        *bandwidth_timer;
 
     gboolean      unexpected;
@@ -237,6 +244,24 @@ static void progress_buffer_class_init (ProgressBufferClass *klass)
                                                           2.0  /* default value */,
                                                           G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
 
+    g_object_class_install_property (gobject_class, PROP_CACHE_MODE,
+                                     g_param_spec_int ("cache-mode",
+                                                       "Cache mode",
+                                                       "Backing cache: 0 - file, 1 - memory mapped file, 2 - memory.",
+                                                       CACHE_MODE_FILE  /* minimum value */,
+                                                       CACHE_MODE_RAM /* maximum value */,
+                                                       DEFAULT_CACHE_MODE  /* default value */,
+                                                       G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
+    g_object_class_install_property (gobject_class, PROP_RAM_CACHE_LIMIT,
+                                     g_param_spec_int64 ("ram-cache-limit",
+                                                         "Memory cache limit",
+                                                         "Content of up to this many bytes is cached in memory, whatever the cache mode.",
+                                                         0  /* minimum value */,
+                                                         G_MAXINT64 /* maximum value */,
+                                                         DEFAULT_RAM_CACHE_LIMIT  /* default value */,
+                                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
     cache_static_init();
 }
 
@@ -288,6 +313,12 @@ static void progress_buffer_set_property (GObject *object, guint property_id,
         case PROP_WAIT_TOLERANCE:
             element->wait_tolerance = g_value_get_double(value);
             break;
+        case PROP_CACHE_MODE:
+            element->cache_mode = g_value_get_int(value);
+            break;
+        case PROP_RAM_CACHE_LIMIT:
+            element->ram_cache_limit = g_value_get_int64(value);
+            break;
 
         default:
             break;
@@ -321,6 +352,14 @@ static void progress_buffer_get_property (GObject *object, guint property_id,
             g_value_set_double(value, element->wait_tolerance);
             break;
 
+        case PROP_CACHE_MODE:
+            g_value_set_int(value, element->cache_mode);
+            break;
+
+        case PROP_RAM_CACHE_LIMIT:
+            g_value_set_int64(value, element->ram_cache_limit);
+            break;
+
         default:
             break;
     }
@@ -627,7 +666,9 @@ static GstFlowReturn progress_buffer_enqueue_item(ProgressBuffer *element, GstMi
                     if (element->cache)
                         destroy_cache(element->cache);
 
-                    element->cache = create_cache();
+                    element->cache = create_cache_with_mode(cache_mode_for_size((CacheMode)element->cache_mode,
+                                                                                segment.stop - segment.start,
+                                                                                element->ram_cache_limit));
                     if (!element->cache)
                     {
                         gst_element_message_full(GST_ELEMENT(element), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_OPEN_READ_WRITE,
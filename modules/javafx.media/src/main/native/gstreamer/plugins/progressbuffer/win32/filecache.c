@@ -76,6 +76,12 @@ _error_exit:
     return NULL;
 }
 
+Cache* create_cache_with_mode(CacheMode mode)
+{
+    // Only CACHE_MODE_FILE is implemented on Windows
+    return create_cache();
+}
+
 void destroy_cache(Cache* instance)
 {
     CloseHandle(instance->writeHandle);
@@ -75,6 +75,22 @@ public:
     /* Get stream size. */
     virtual int GetStreamSize() = 0;
 
+    /* GetReadAheadSize returns the size of the read-ahead ring to use for
+     * the stream, or 0 if it has to be read with ReadNextBlock only.
+     */
+    virtual int  GetReadAheadSize() = 0;
+
+    /* SetReadAheadBuffer passes the read-ahead ring, which stays valid until
+     * the connection is closed, to the stream.
+     */
+    virtual void SetReadAheadBuffer(void* data, int size) = 0;
+
+    /* ReadAhead reads up to size bytes from the current position of the stream
+     * into the read-ahead ring at offset, without an intermediate copy.
+     * Returns the same values as ReadNextBlock.
+     */
+    virtual int  ReadAhead(int offset, int size) = 0;
+
     /* Virtual destructor */
     virtual ~CStreamCallbacks() {}
 };
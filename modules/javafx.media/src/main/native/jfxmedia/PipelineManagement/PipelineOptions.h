@@ -48,7 +48,8 @@ public:
     :   m_PipelineType(pipelineType),
         m_bBufferingEnabled(false),
         m_StreamMimeType(-1),
-        m_bHLSModeEnabled(false)
+        m_bHLSModeEnabled(false),
+        m_iDecoderThreadCount(-1)
     {}
 
     virtual ~CPipelineOptions() {}
@@ -64,11 +65,16 @@ public:
     inline void SetHLSModeEnabled(bool enabled) { m_bHLSModeEnabled = enabled; }
     inline bool GetHLSModeEnabled() { return m_bHLSModeEnabled; }
 
+    // Threads of the video decoder, 0 for one per core, -1 for the decoder default.
+    inline void SetDecoderThreadCount(int threadCount) { m_iDecoderThreadCount = threadCount; }
+    inline int GetDecoderThreadCount() { return m_iDecoderThreadCount; }
+
 private:
     int         m_PipelineType;
     bool        m_bBufferingEnabled;
     int         m_StreamMimeType;
     bool        m_bHLSModeEnabled;
+    int         m_iDecoderThreadCount;
 };
 
 #endif  //_PIPELINE_OPTIONS_H_
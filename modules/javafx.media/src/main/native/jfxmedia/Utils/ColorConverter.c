@@ -25,6 +25,15 @@
 
 #include "ColorConverter.h"
 #include <stdio.h>
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
 
 #if (! TARGET_OS_LINUX || defined(__SSE2__))
 #define ENABLE_SIMD_SSE2 1
@@ -32,6 +41,15 @@
 #define ENABLE_SIMD_SSE2 0
 #endif
 
+// The AVX2 kernels are built into every x86 library and only used when the
+// processor supports them, see select_kernel().
+#if ENABLE_SIMD_SSE2 && (defined(_MSC_VER) || defined(__GNUC__)) && \
+    (defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64))
+#define ENABLE_SIMD_AVX2 1
+#else
+#define ENABLE_SIMD_AVX2 0
+#endif
+
 // --- Begin macros
 #define TCLAMP_U8(val, dst) dst = pClip[val]
 
@@ -439,7 +457,7 @@ __m128i inline_loadu_si128(const __m128i *p)
     cc = _mm_packus_epi16(tt, x_temp1); \
 }
 
-int ColorConvert_YCbCr420p_to_ARGB32(
+static int convert_YCbCr420p_to_ARGB32(
                                uint8_t *argb,
                                int32_t argb_stride,
                                int32_t width,
@@ -926,7 +944,7 @@ int ColorConvert_YCbCr420p_to_ARGB32(
     return 0;
 }
 
-int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
+static int convert_YCbCr420p_to_ARGB32_no_alpha(
                                      uint8_t *argb,
                                      int32_t argb_stride,
                                      int32_t width,
@@ -1379,7 +1397,7 @@ int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
     return 0;
 }
 
-int ColorConvert_YCbCr420p_to_BGRA32(
+static int convert_YCbCr420p_to_BGRA32(
                                      uint8_t *bgra,
                                      int32_t bgra_stride,
                                      int32_t width,
@@ -1893,7 +1911,7 @@ int ColorConvert_YCbCr420p_to_BGRA32(
     return 0;
 }
 
-int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
+static int convert_YCbCr420p_to_BGRA32_no_alpha(
                                               uint8_t *bgra,
                                               int32_t bgra_stride,
                                               int32_t width,
@@ -2350,7 +2368,7 @@ int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
 #else // Generic C implementation
 
 // --- Begin C YCbCr420p conversion functions
-int ColorConvert_YCbCr420p_to_ARGB32(
+static int convert_YCbCr420p_to_ARGB32(
                                uint8_t *argb,
                                int32_t argb_stride,
                                int32_t width,
@@ -2367,7 +2385,7 @@ int ColorConvert_YCbCr420p_to_ARGB32(
     return 1; // NOTE: Not implemented
 }
 
-int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
+static int convert_YCbCr420p_to_ARGB32_no_alpha(
                                      uint8_t *argb,
                                      int32_t argb_stride,
                                      int32_t width,
@@ -2382,7 +2400,7 @@ int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
     return 1; // NOTE: Not implemented
 }
 
-int ColorConvert_YCbCr420p_to_BGRA32(uint8_t *bgra,
+static int convert_YCbCr420p_to_BGRA32(uint8_t *bgra,
                                      int32_t bgra_stride,
                                      int32_t width,
                                      int32_t height,
@@ -2492,7 +2510,7 @@ int ColorConvert_YCbCr420p_to_BGRA32(uint8_t *bgra,
     return 0;
 }
 
-int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
+static int convert_YCbCr420p_to_BGRA32_no_alpha(
                                               uint8_t *bgra,
                                               int32_t bgra_stride,
                                               int32_t width,
@@ -2590,92 +2608,974 @@ int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
 #endif // ENABLE_SIMD_SSE2
 // --- End YCbCr420p conversion functions
 
-// --- Begin YCbCr422p conversion functions
 
-int ColorConvert_YCbCr422p_to_ARGB32_no_alpha(uint8_t *argb,
-                                              int32_t argb_stride,
+// --- Begin fixed point helpers
+/*
+ * The BT.601 coefficients of the SSE2 YCbCr420p kernels. The YCbCr422 and
+ * AVX2 kernels use the same fixed point math, so every kernel of a
+ * conversion produces the same output.
+ */
+#define YUV_C0      0x2543                  /* 1.1644  * 8192 */
+#define YUV_C1      0x4097                  /* 2.0184  * 8192 */
+#define YUV_C4      0xc8b                   /* abs( -0.3920 * 8192 ) */
+#define YUV_C5      0x1a06                  /* abs( -0.8132 * 8192 ) */
+#define YUV_C8      0x3317                  /* 1.5966  * 8192 */
+#define YUV_COFF0   ((int32_t)0xffffdd60)   /* -276.9856 * 32 */
+#define YUV_COFF1   0x10f4                  /* 135.6352  * 32 */
+#define YUV_COFF2   ((int32_t)0xffffe420)   /* -222.9952 * 32 */
+
+// Like packus, without branches as the values are hard to predict
+static uint8_t fixed_to_u8(int32_t s)
+{
+    s >>= 5;
+    s &= ~(s >> 31);
+    return (uint8_t)(s | ((255 - s) >> 31));
+}
+
+static void store_pixel(uint8_t *d, int32_t y, int32_t ir, int32_t ig, int32_t ib, int bgra)
+{
+    if (bgra) {
+        d[0] = fixed_to_u8(y + ib);
+        d[1] = fixed_to_u8(y + ig);
+        d[2] = fixed_to_u8(y + ir);
+        d[3] = 0xff;
+    } else {
+        d[0] = 0xff;
+        d[1] = fixed_to_u8(y + ir);
+        d[2] = fixed_to_u8(y + ig);
+        d[3] = fixed_to_u8(y + ib);
+    }
+}
+// --- End fixed point helpers
+
+// --- Begin YCbCr422 conversion functions
+/*
+ * Converts packed 4:2:2 data, y, v and u point into the same interleaved
+ * plane, so every pixel pair takes 4 bytes.
+ */
+static void convert_YCbCr422_rows(uint8_t *dst,
+                                  int32_t dst_stride,
+                                  int32_t width,
+                                  int32_t height,
+                                  const uint8_t *y,
+                                  const uint8_t *v,
+                                  const uint8_t *u,
+                                  int32_t y_stride,
+                                  int32_t uv_stride,
+                                  int bgra)
+{
+    int32_t i, j;
+
+    for (j = 0; j < height; j++) {
+        const uint8_t *sy = y + (intptr_t)j * y_stride;
+        const uint8_t *su = u + (intptr_t)j * uv_stride;
+        const uint8_t *sv = v + (intptr_t)j * uv_stride;
+        uint8_t *d = dst + (intptr_t)j * dst_stride;
+
+        for (i = 0; i < (width >> 1); i++) {
+            int32_t iu = su[0];
+            int32_t iv = sv[0];
+            int32_t ib = YUV_COFF0 + ((iu * YUV_C1) >> 8);
+            int32_t ig = YUV_COFF1 - (((iu * YUV_C4) >> 8) + ((iv * YUV_C5) >> 8));
+            int32_t ir = ((iv * YUV_C8) >> 8) + YUV_COFF2;
+
+            store_pixel(d, (sy[0] * YUV_C0) >> 8, ir, ig, ib, bgra);
+            store_pixel(d + 4, (sy[2] * YUV_C0) >> 8, ir, ig, ib, bgra);
+
+            sy += 4;
+            su += 4;
+            sv += 4;
+            d += 8;
+        }
+    }
+}
+// --- End YCbCr422 conversion functions
+
+// --- Begin RGB swap functions
+static void swap_rgb32_rows(uint8_t *dst,
+                            int32_t dst_stride,
+                            int32_t width,
+                            int32_t height,
+                            const uint8_t *src,
+                            int32_t src_stride)
+{
+    int32_t i, j;
+
+    for (j = 0; j < height; j++) {
+        const uint8_t *s = src + (intptr_t)j * src_stride;
+        uint8_t *d = dst + (intptr_t)j * dst_stride;
+
+        for (i = 0; i < width; i++) {
+            uint8_t b0 = s[0], b1 = s[1], b2 = s[2], b3 = s[3];
+
+            d[0] = b3;
+            d[1] = b2;
+            d[2] = b1;
+            d[3] = b0;
+            s += 4;
+            d += 4;
+        }
+    }
+}
+
+#if ENABLE_SIMD_SSE2
+static void swap_rgb32_rows_sse2(uint8_t *dst,
+                                 int32_t dst_stride,
+                                 int32_t width,
+                                 int32_t height,
+                                 const uint8_t *src,
+                                 int32_t src_stride)
+{
+    const __m128i x_mask1 = _mm_set1_epi32(0x00ff0000);
+    const __m128i x_mask2 = _mm_set1_epi32(0x0000ff00);
+    int32_t i, j;
+
+    for (j = 0; j < height; j++) {
+        const uint8_t *s = src + (intptr_t)j * src_stride;
+        uint8_t *d = dst + (intptr_t)j * dst_stride;
+
+        for (i = 0; i <= width - 4; i += 4) {
+            __m128i x_p = _mm_loadu_si128((const __m128i*)(s + 4 * i));
+            __m128i x_outer = _mm_or_si128(_mm_slli_epi32(x_p, 24), _mm_srli_epi32(x_p, 24));
+            __m128i x_inner = _mm_or_si128(_mm_and_si128(_mm_slli_epi32(x_p, 8), x_mask1),
+                                           _mm_and_si128(_mm_srli_epi32(x_p, 8), x_mask2));
+            _mm_storeu_si128((__m128i*)(d + 4 * i), _mm_or_si128(x_outer, x_inner));
+        }
+    }
+}
+#endif // ENABLE_SIMD_SSE2
+// --- End RGB swap functions
+
+#if ENABLE_SIMD_AVX2
+// --- Begin AVX2 conversion functions
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#define AVX2_FUNCTION
+#include <intrin.h>
+#else
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+
+static int cpu_has_avx2(void)
+{
+#ifdef _MSC_VER
+    int info[4];
+
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return 0;
+
+    // AVX and OSXSAVE, then the OS must save the ymm registers
+    __cpuid(info, 1);
+    if ((info[2] & 0x18000000) != 0x18000000)
+        return 0;
+    if ((_xgetbv(0) & 6) != 6)
+        return 0;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & 0x20) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+/*
+ * c = 32 color values
+ * a = 32 corresponding alpha values to premultiply with, see
+ * PREMULTIPLY_ALPHA
+ */
+AVX2_FUNCTION static __m256i avx2_premultiply(__m256i c, __m256i a)
+{
+    const __m256i y_zero = _mm256_setzero_si256();
+    const __m256i y_one = _mm256_set1_epi16(1);
+    __m256i y_lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(c, y_zero),
+                                      _mm256_add_epi16(_mm256_unpacklo_epi8(a, y_zero), y_one));
+    __m256i y_hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(c, y_zero),
+                                      _mm256_add_epi16(_mm256_unpackhi_epi8(a, y_zero), y_one));
+
+    return _mm256_packus_epi16(_mm256_srli_epi16(y_lo, 8), _mm256_srli_epi16(y_hi, 8));
+}
+
+// Adds luma and chroma of 32 pixels and packs them back to bytes
+AVX2_FUNCTION static __m256i avx2_pack_channel(__m256i y_lo, __m256i y_hi, __m256i c_lo, __m256i c_hi)
+{
+    return _mm256_packus_epi16(_mm256_srai_epi16(_mm256_add_epi16(y_lo, c_lo), 5),
+                               _mm256_srai_epi16(_mm256_add_epi16(y_hi, c_hi), 5));
+}
+
+// Interleaves and stores 32 pixels, r, g, b and a hold them in order
+AVX2_FUNCTION static void avx2_store_pixels(uint8_t *d, __m256i r, __m256i g, __m256i b, __m256i a, int bgra)
+{
+    __m256i y_c0, y_c1, y_c2, y_c3, y_lo01, y_hi01, y_lo23, y_hi23, y_p0, y_p1, y_p2, y_p3;
+
+    if (bgra) {
+        y_c0 = b; y_c1 = g; y_c2 = r; y_c3 = a;
+    } else {
+        y_c0 = a; y_c1 = r; y_c2 = g; y_c3 = b;
+    }
+
+    // unpack works within 128 bit lanes, so the low lanes get pixels 0-7
+    // and the high lanes pixels 16-23 and so on
+    y_lo01 = _mm256_unpacklo_epi8(y_c0, y_c1);
+    y_hi01 = _mm256_unpackhi_epi8(y_c0, y_c1);
+    y_lo23 = _mm256_unpacklo_epi8(y_c2, y_c3);
+    y_hi23 = _mm256_unpackhi_epi8(y_c2, y_c3);
+
+    y_p0 = _mm256_unpacklo_epi16(y_lo01, y_lo23);   // 0-3, 16-19
+    y_p1 = _mm256_unpackhi_epi16(y_lo01, y_lo23);   // 4-7, 20-23
+    y_p2 = _mm256_unpacklo_epi16(y_hi01, y_hi23);   // 8-11, 24-27
+    y_p3 = _mm256_unpackhi_epi16(y_hi01, y_hi23);   // 12-15, 28-31
+
+    _mm256_storeu_si256((__m256i*)d, _mm256_permute2x128_si256(y_p0, y_p1, 0x20));
+    _mm256_storeu_si256((__m256i*)(d + 32), _mm256_permute2x128_si256(y_p2, y_p3, 0x20));
+    _mm256_storeu_si256((__m256i*)(d + 64), _mm256_permute2x128_si256(y_p0, y_p1, 0x31));
+    _mm256_storeu_si256((__m256i*)(d + 96), _mm256_permute2x128_si256(y_p2, y_p3, 0x31));
+}
+
+/*
+ * Converts the first width & ~31 columns, the caller converts the rest with
+ * the SSE2 kernel. a may be NULL for opaque frames.
+ */
+AVX2_FUNCTION static void avx2_YCbCr420p_rows(uint8_t *dst,
+                                              int32_t dst_stride,
                                               int32_t width,
                                               int32_t height,
                                               const uint8_t *y,
                                               const uint8_t *v,
                                               const uint8_t *u,
+                                              const uint8_t *a,
                                               int32_t y_stride,
-                                              int32_t uv_stride)
+                                              int32_t v_stride,
+                                              int32_t u_stride,
+                                              int32_t a_stride,
+                                              int bgra)
 {
-    return 1; // NOTE: Not implemented
+    const __m256i y_c0 = _mm256_set1_epi16(YUV_C0);
+    const __m256i y_c1 = _mm256_set1_epi16(YUV_C1);
+    const __m256i y_c4 = _mm256_set1_epi16(YUV_C4);
+    const __m256i y_c5 = _mm256_set1_epi16(YUV_C5);
+    const __m256i y_c8 = _mm256_set1_epi16(YUV_C8);
+    const __m256i y_coff0 = _mm256_set1_epi16((short)YUV_COFF0);
+    const __m256i y_coff1 = _mm256_set1_epi16(YUV_COFF1);
+    const __m256i y_coff2 = _mm256_set1_epi16((short)YUV_COFF2);
+    const __m256i y_zero = _mm256_setzero_si256();
+    const __m256i y_opaque = _mm256_set1_epi8((char)0xff);
+    int32_t i, j, k;
+
+    for (j = 0; j < (height >> 1); j++) {
+        const uint8_t *pU = u + (intptr_t)j * u_stride;
+        const uint8_t *pV = v + (intptr_t)j * v_stride;
+
+        for (i = 0; i <= width - 32; i += 32) {
+            __m256i y_u, y_v, y_cb, y_cg, y_cr, y_b_lo, y_b_hi, y_g_lo, y_g_hi, y_r_lo, y_r_hi;
+
+            y_u = _mm256_slli_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pU + i / 2))), 8);
+            y_v = _mm256_slli_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pV + i / 2))), 8);
+
+            y_cb = _mm256_add_epi16(_mm256_mulhi_epu16(y_u, y_c1), y_coff0);
+            y_cg = _mm256_sub_epi16(y_coff1, _mm256_add_epi16(_mm256_mulhi_epu16(y_u, y_c4),
+                                                              _mm256_mulhi_epu16(y_v, y_c5)));
+            y_cr = _mm256_add_epi16(_mm256_mulhi_epu16(y_v, y_c8), y_coff2);
+
+            // one chroma value for two pixels, laid out like the luma
+            // values unpacked below
+            y_b_lo = _mm256_unpacklo_epi16(y_cb, y_cb);
+            y_b_hi = _mm256_unpackhi_epi16(y_cb, y_cb);
+            y_g_lo = _mm256_unpacklo_epi16(y_cg, y_cg);
+            y_g_hi = _mm256_unpackhi_epi16(y_cg, y_cg);
+            y_r_lo = _mm256_unpacklo_epi16(y_cr, y_cr);
+            y_r_hi = _mm256_unpackhi_epi16(y_cr, y_cr);
+
+            for (k = 0; k < 2; k++) {
+                const int32_t row = 2 * j + k;
+                __m256i y_y, y_lo, y_hi, y_r, y_g, y_b, y_a;
+
+                y_y = _mm256_loadu_si256((const __m256i*)(y + (intptr_t)row * y_stride + i));
+                y_lo = _mm256_mulhi_epu16(_mm256_unpacklo_epi8(y_zero, y_y), y_c0);
+                y_hi = _mm256_mulhi_epu16(_mm256_unpackhi_epi8(y_zero, y_y), y_c0);
+
+                y_r = avx2_pack_channel(y_lo, y_hi, y_r_lo, y_r_hi);
+                y_g = avx2_pack_channel(y_lo, y_hi, y_g_lo, y_g_hi);
+                y_b = avx2_pack_channel(y_lo, y_hi, y_b_lo, y_b_hi);
+
+                if (a) {
+                    y_a = _mm256_loadu_si256((const __m256i*)(a + (intptr_t)row * a_stride + i));
+                    if (bgra) {
+                        y_r = avx2_premultiply(y_r, y_a);
+                        y_g = avx2_premultiply(y_g, y_a);
+                        y_b = avx2_premultiply(y_b, y_a);
+                    }
+                } else {
+                    y_a = y_opaque;
+                }
+
+                avx2_store_pixels(dst + (intptr_t)row * dst_stride + 4 * i, y_r, y_g, y_b, y_a, bgra);
+            }
+        }
+    }
 }
 
-int ColorConvert_YCbCr422p_to_BGRA32_no_alpha(uint8_t *bgra,
-                                              int32_t bgra_stride,
+/*
+ * Converts the first width & ~31 columns of packed UYVY data starting at
+ * src, the caller converts the rest.
+ */
+AVX2_FUNCTION static void avx2_YCbCr422_rows(uint8_t *dst,
+                                             int32_t dst_stride,
+                                             int32_t width,
+                                             int32_t height,
+                                             const uint8_t *src,
+                                             int32_t src_stride,
+                                             int bgra)
+{
+    const __m256i y_c0 = _mm256_set1_epi16(YUV_C0);
+    const __m256i y_c1 = _mm256_set1_epi16(YUV_C1);
+    const __m256i y_c4 = _mm256_set1_epi16(YUV_C4);
+    const __m256i y_c5 = _mm256_set1_epi16(YUV_C5);
+    const __m256i y_c8 = _mm256_set1_epi16(YUV_C8);
+    const __m256i y_coff0 = _mm256_set1_epi16((short)YUV_COFF0);
+    const __m256i y_coff1 = _mm256_set1_epi16(YUV_COFF1);
+    const __m256i y_coff2 = _mm256_set1_epi16((short)YUV_COFF2);
+    const __m256i y_luma = _mm256_set1_epi16((short)0xff00);
+    const __m256i y_opaque = _mm256_set1_epi8((char)0xff);
+    int32_t i, j, k;
+
+    for (j = 0; j < height; j++) {
+        const uint8_t *s = src + (intptr_t)j * src_stride;
+        uint8_t *d = dst + (intptr_t)j * dst_stride;
+
+        for (i = 0; i <= width - 32; i += 32) {
+            __m256i y_r[2], y_g[2], y_b[2];
+
+            for (k = 0; k < 2; k++) {
+                // 16 pixels, one 16 bit value per pixel in order
+                __m256i y_p = _mm256_loadu_si256((const __m256i*)(s + 2 * i + 32 * k));
+                __m256i y_y = _mm256_mulhi_epu16(_mm256_and_si256(y_p, y_luma), y_c0);
+                __m256i y_uv = _mm256_slli_epi16(y_p, 8);
+                __m256i y_u = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(y_uv, 0xa0), 0xa0);
+                __m256i y_v = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(y_uv, 0xf5), 0xf5);
+
+                y_b[k] = _mm256_add_epi16(y_y, _mm256_add_epi16(_mm256_mulhi_epu16(y_u, y_c1), y_coff0));
+                y_g[k] = _mm256_add_epi16(y_y, _mm256_sub_epi16(y_coff1,
+                                                                _mm256_add_epi16(_mm256_mulhi_epu16(y_u, y_c4),
+                                                                                 _mm256_mulhi_epu16(y_v, y_c5))));
+                y_r[k] = _mm256_add_epi16(y_y, _mm256_add_epi16(_mm256_mulhi_epu16(y_v, y_c8), y_coff2));
+
+                y_b[k] = _mm256_srai_epi16(y_b[k], 5);
+                y_g[k] = _mm256_srai_epi16(y_g[k], 5);
+                y_r[k] = _mm256_srai_epi16(y_r[k], 5);
+            }
+
+            // packus interleaves the 64 bit quarters of both halves
+            avx2_store_pixels(d + 4 * i,
+                              _mm256_permute4x64_epi64(_mm256_packus_epi16(y_r[0], y_r[1]), 0xd8),
+                              _mm256_permute4x64_epi64(_mm256_packus_epi16(y_g[0], y_g[1]), 0xd8),
+                              _mm256_permute4x64_epi64(_mm256_packus_epi16(y_b[0], y_b[1]), 0xd8),
+                              y_opaque, bgra);
+        }
+    }
+}
+
+AVX2_FUNCTION static void avx2_swap_rgb32_rows(uint8_t *dst,
+                                               int32_t dst_stride,
+                                               int32_t width,
+                                               int32_t height,
+                                               const uint8_t *src,
+                                               int32_t src_stride)
+{
+    const __m256i y_shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                               3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    int32_t i, j;
+
+    for (j = 0; j < height; j++) {
+        const uint8_t *s = src + (intptr_t)j * src_stride;
+        uint8_t *d = dst + (intptr_t)j * dst_stride;
+
+        for (i = 0; i <= width - 8; i += 8) {
+            __m256i y_p = _mm256_loadu_si256((const __m256i*)(s + 4 * i));
+            _mm256_storeu_si256((__m256i*)(d + 4 * i), _mm256_shuffle_epi8(y_p, y_shuffle));
+        }
+    }
+}
+// --- End AVX2 conversion functions
+#endif // ENABLE_SIMD_AVX2
+
+// --- Begin kernel selection
+static volatile int max_kernel = COLOR_CONVERT_KERNEL_AVX2;
+static volatile int cpu_kernel = -1;
+
+static int detect_kernel(void)
+{
+#if ENABLE_SIMD_AVX2
+    if (cpu_has_avx2())
+        return COLOR_CONVERT_KERNEL_AVX2;
+#endif
+#if ENABLE_SIMD_SSE2
+    return COLOR_CONVERT_KERNEL_SSE2;
+#else
+    return COLOR_CONVERT_KERNEL_C;
+#endif
+}
+
+static int select_kernel(void)
+{
+    int kernel = cpu_kernel;
+
+    if (kernel < 0)
+        cpu_kernel = kernel = detect_kernel();
+
+    return kernel < max_kernel ? kernel : max_kernel;
+}
+
+int ColorConvert_SetMaxKernel(int kernel)
+{
+    max_kernel = kernel;
+    return select_kernel();
+}
+// --- End kernel selection
+
+// --- Begin parallel conversion
+/*
+ * Large frames are converted in bands of rows by a small pool of worker
+ * threads, the calling thread works on a band too. See SSEWorkers.cc in
+ * decora for the same scheme.
+ */
+#define MAX_CONVERSION_THREADS 4
+
+typedef void (*band_function)(void *data, int32_t begin, int32_t end);
+
+#ifdef WIN32
+static CRITICAL_SECTION pool_lock;
+static HANDLE work_available;   // semaphore, counts the workers to wake up
+static HANDLE work_done;        // auto reset event, set by the last band
+
+static void lock_pool(void)     { EnterCriticalSection(&pool_lock); }
+static void unlock_pool(void)   { LeaveCriticalSection(&pool_lock); }
+#else
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_available = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t work_done = PTHREAD_COND_INITIALIZER;
+
+static void lock_pool(void)     { pthread_mutex_lock(&pool_lock); }
+static void unlock_pool(void)   { pthread_mutex_unlock(&pool_lock); }
+#endif
+
+// Configuration, see ColorConvert_SetParallelism()
+static volatile int32_t max_threads = 1;
+static volatile int32_t min_pixels = 0;
+static int pool_initialized = 0;
+static int32_t worker_count = 0;
+
+// The conversion currently run by the pool, all guarded by pool_lock.
+static int busy = 0;
+static unsigned int generation = 0;
+static band_function job_function;
+static void *job_data;
+static int32_t job_count;
+static int32_t job_align;
+static int32_t job_bands;
+static int32_t next_band;
+static int32_t pending_bands;
+
+static void run_bands(void)
+{
+    lock_pool();
+    while (next_band < job_bands) {
+        int32_t band = next_band++;
+        band_function fn = job_function;
+        void *data = job_data;
+        int32_t units = job_count / job_align;
+        int32_t begin = (int32_t)((int64_t)units * band / job_bands) * job_align;
+        int32_t end = (band == job_bands - 1) ? job_count
+            : (int32_t)((int64_t)units * (band + 1) / job_bands) * job_align;
+        unlock_pool();
+
+        fn(data, begin, end);
+
+        lock_pool();
+        if (--pending_bands == 0) {
+#ifdef WIN32
+            SetEvent(work_done);
+#else
+            pthread_cond_broadcast(&work_done);
+#endif
+        }
+    }
+    unlock_pool();
+}
+
+#ifdef WIN32
+static unsigned __stdcall worker_main(void *arg)
+{
+    (void)arg;
+    for (;;) {
+        // A worker woken after the conversion has finished finds no band
+        WaitForSingleObject(work_available, INFINITE);
+        run_bands();
+    }
+    return 0;
+}
+#else
+static void *worker_main(void *arg)
+{
+    unsigned int seen;
+
+    (void)arg;
+    lock_pool();
+    seen = generation;
+    for (;;) {
+        while (generation == seen) {
+            pthread_cond_wait(&work_available, &pool_lock);
+        }
+        seen = generation;
+        unlock_pool();
+        run_bands();
+        lock_pool();
+    }
+    return NULL;
+}
+#endif
+
+// Must be called with pool_lock held.
+static void start_workers(int32_t count)
+{
+    while (worker_count < count) {
+#ifdef WIN32
+        HANDLE thread = (HANDLE)_beginthreadex(NULL, 0, worker_main, NULL, 0, NULL);
+        if (thread == 0) return;
+        CloseHandle(thread);
+#else
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, worker_main, NULL) != 0) return;
+        pthread_detach(thread);
+#endif
+        worker_count++;
+    }
+}
+
+static void run_in_bands(band_function fn, void *data, int32_t count, int32_t align, int32_t pixels)
+{
+    int32_t bands = max_threads;
+
+    if (bands > count / align)
+        bands = count / align;
+    if (bands < 2 || pixels < min_pixels || !pool_initialized) {
+        fn(data, 0, count);
+        return;
+    }
+
+    lock_pool();
+    start_workers(bands - 1);
+    if (busy || worker_count == 0) {
+        // Another frame is converted, or no worker could be started
+        unlock_pool();
+        fn(data, 0, count);
+        return;
+    }
+    busy = 1;
+    job_function = fn;
+    job_data = data;
+    job_count = count;
+    job_align = align;
+    job_bands = bands;
+    next_band = 0;
+    pending_bands = bands;
+#ifdef WIN32
+    ReleaseSemaphore(work_available, bands - 1, NULL);
+#else
+    generation++;
+    pthread_cond_broadcast(&work_available);
+#endif
+    unlock_pool();
+
+    run_bands();
+
+    lock_pool();
+    while (pending_bands > 0) {
+#ifdef WIN32
+        unlock_pool();
+        WaitForSingleObject(work_done, INFINITE);
+        lock_pool();
+#else
+        pthread_cond_wait(&work_done, &pool_lock);
+#endif
+    }
+    busy = 0;
+    unlock_pool();
+}
+
+static int32_t processor_count(void)
+{
+#ifdef WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int32_t)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int32_t)count : 1;
+#endif
+}
+
+void ColorConvert_SetParallelism(int32_t threads, int32_t pixels)
+{
+    if (!pool_initialized) {
+#ifdef WIN32
+        InitializeCriticalSection(&pool_lock);
+        work_available = CreateSemaphore(NULL, 0, 0x7fffffff, NULL);
+        work_done = CreateEvent(NULL, FALSE, FALSE, NULL);
+        pool_initialized = (work_available != NULL && work_done != NULL);
+#else
+        pool_initialized = 1;
+#endif
+    }
+
+    if (threads <= 0) {
+        threads = processor_count();
+        if (threads > MAX_CONVERSION_THREADS)
+            threads = MAX_CONVERSION_THREADS;
+    }
+    max_threads = threads;
+    min_pixels = pixels;
+}
+// --- End parallel conversion
+
+// --- Begin public conversion functions
+typedef enum {
+    CONVERT_420P_TO_ARGB32,
+    CONVERT_420P_TO_ARGB32_NO_ALPHA,
+    CONVERT_420P_TO_BGRA32,
+    CONVERT_420P_TO_BGRA32_NO_ALPHA,
+    CONVERT_422_TO_ARGB32,
+    CONVERT_422_TO_BGRA32,
+    CONVERT_SWAP_RGB32
+} conversion_type;
+
+typedef struct {
+    conversion_type type;
+    int kernel;
+    volatile int status;
+    uint8_t *dst;
+    int32_t dst_stride;
+    int32_t width;
+    const uint8_t *y;   // the source of CONVERT_SWAP_RGB32
+    const uint8_t *v;
+    const uint8_t *u;
+    const uint8_t *a;
+    int32_t y_stride;
+    int32_t v_stride;
+    int32_t u_stride;
+    int32_t a_stride;
+} conversion_job;
+
+// Converts rows begin to end of a frame
+static void convert_band(void *data, int32_t begin, int32_t end)
+{
+    conversion_job *job = (conversion_job*)data;
+    const int32_t width = job->width;
+    const int32_t rows = end - begin;
+    const int32_t chroma_row = (job->type <= CONVERT_420P_TO_BGRA32_NO_ALPHA) ? begin / 2 : begin;
+    uint8_t *dst = job->dst + (intptr_t)begin * job->dst_stride;
+    const uint8_t *y = job->y + (intptr_t)begin * job->y_stride;
+    const uint8_t *v = job->v ? job->v + (intptr_t)chroma_row * job->v_stride : NULL;
+    const uint8_t *u = job->u ? job->u + (intptr_t)chroma_row * job->u_stride : NULL;
+    const uint8_t *a = job->a ? job->a + (intptr_t)begin * job->a_stride : NULL;
+    const int bgra = (job->type == CONVERT_420P_TO_BGRA32 || job->type == CONVERT_420P_TO_BGRA32_NO_ALPHA ||
+                      job->type == CONVERT_422_TO_BGRA32);
+    int32_t cols = 0;   // converted by the AVX2 kernels
+    int status = 0;
+
+    switch (job->type) {
+        case CONVERT_420P_TO_ARGB32:
+        case CONVERT_420P_TO_ARGB32_NO_ALPHA:
+        case CONVERT_420P_TO_BGRA32:
+        case CONVERT_420P_TO_BGRA32_NO_ALPHA:
+#if ENABLE_SIMD_AVX2
+            if (job->kernel == COLOR_CONVERT_KERNEL_AVX2) {
+                cols = width & ~31;
+                avx2_YCbCr420p_rows(dst, job->dst_stride, cols, rows, y, v, u, a,
+                                    job->y_stride, job->v_stride, job->u_stride, job->a_stride, bgra);
+            }
+#endif
+            if (cols == width)
+                break;
+
+            dst += 4 * cols;
+            y += cols;
+            v += cols / 2;
+            u += cols / 2;
+            if (job->type == CONVERT_420P_TO_ARGB32)
+                status = convert_YCbCr420p_to_ARGB32(dst, job->dst_stride, width - cols, rows,
+                                                     y, v, u, a + cols,
+                                                     job->y_stride, job->v_stride, job->u_stride, job->a_stride);
+            else if (job->type == CONVERT_420P_TO_ARGB32_NO_ALPHA)
+                status = convert_YCbCr420p_to_ARGB32_no_alpha(dst, job->dst_stride, width - cols, rows,
+                                                              y, v, u,
+                                                              job->y_stride, job->v_stride, job->u_stride);
+            else if (job->type == CONVERT_420P_TO_BGRA32)
+                status = convert_YCbCr420p_to_BGRA32(dst, job->dst_stride, width - cols, rows,
+                                                     y, v, u, a + cols,
+                                                     job->y_stride, job->v_stride, job->u_stride, job->a_stride);
+            else
+                status = convert_YCbCr420p_to_BGRA32_no_alpha(dst, job->dst_stride, width - cols, rows,
+                                                              y, v, u,
+                                                              job->y_stride, job->v_stride, job->u_stride);
+            break;
+
+        case CONVERT_422_TO_ARGB32:
+        case CONVERT_422_TO_BGRA32:
+#if ENABLE_SIMD_AVX2
+            // The AVX2 kernel needs the usual UYVY layout
+            if (job->kernel == COLOR_CONVERT_KERNEL_AVX2 && job->y == job->u + 1 && job->v == job->u + 2) {
+                cols = width & ~31;
+                avx2_YCbCr422_rows(dst, job->dst_stride, cols, rows, u, job->y_stride, bgra);
+            }
+#endif
+            convert_YCbCr422_rows(dst + 4 * cols, job->dst_stride, width - cols, rows,
+                                  y + 2 * cols, v + 2 * cols, u + 2 * cols,
+                                  job->y_stride, job->u_stride, bgra);
+            break;
+
+        case CONVERT_SWAP_RGB32:
+#if ENABLE_SIMD_AVX2
+            if (job->kernel == COLOR_CONVERT_KERNEL_AVX2) {
+                cols = width & ~7;
+                avx2_swap_rgb32_rows(dst, job->dst_stride, cols, rows, y, job->y_stride);
+            }
+#endif
+#if ENABLE_SIMD_SSE2
+            if (job->kernel == COLOR_CONVERT_KERNEL_SSE2) {
+                cols = width & ~3;
+                swap_rgb32_rows_sse2(dst, job->dst_stride, cols, rows, y, job->y_stride);
+            }
+#endif
+            swap_rgb32_rows(dst + 4 * cols, job->dst_stride, width - cols, rows,
+                            y + 4 * cols, job->y_stride);
+            break;
+    }
+
+    if (status != 0)
+        job->status = status;
+}
+
+static void init_job(conversion_job *job, conversion_type type, uint8_t *dst, int32_t dst_stride, int32_t width)
+{
+    memset(job, 0, sizeof(conversion_job));
+    job->type = type;
+    job->kernel = select_kernel();
+    job->dst = dst;
+    job->dst_stride = dst_stride;
+    job->width = width;
+}
+
+static int run_job(conversion_job *job, int32_t height, int32_t align)
+{
+    run_in_bands(convert_band, job, height, align, job->width * height);
+    return job->status;
+}
+
+int ColorConvert_YCbCr420p_to_ARGB32(uint8_t *argb,
+                                     int32_t argb_stride,
+                                     int32_t width,
+                                     int32_t height,
+                                     const uint8_t *y,
+                                     const uint8_t *v,
+                                     const uint8_t *u,
+                                     const uint8_t *a,
+                                     int32_t y_stride,
+                                     int32_t v_stride,
+                                     int32_t u_stride,
+                                     int32_t a_stride)
+{
+    conversion_job job;
+
+    if (argb == NULL || y == NULL || u == NULL || v == NULL || a == NULL)
+        return 1;
+
+    if (width <= 0 || height <= 0)
+        return 0;
+
+    init_job(&job, CONVERT_420P_TO_ARGB32, argb, argb_stride, width);
+    job.y = y;
+    job.v = v;
+    job.u = u;
+    job.a = a;
+    job.y_stride = y_stride;
+    job.v_stride = v_stride;
+    job.u_stride = u_stride;
+    job.a_stride = a_stride;
+    return run_job(&job, height, 2);
+}
+
+int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(uint8_t *argb,
+                                              int32_t argb_stride,
                                               int32_t width,
                                               int32_t height,
                                               const uint8_t *y,
                                               const uint8_t *v,
                                               const uint8_t *u,
                                               int32_t y_stride,
-                                              int32_t uv_stride)
+                                              int32_t v_stride,
+                                              int32_t u_stride)
 {
-    int32_t i, j;
-    const uint8_t *say1, *sau, *sav, *sly1, *slu, *slv;
-    uint8_t *da1, *dl1;
+    conversion_job job;
 
-    int32_t BBi = 554;
-    int32_t RRi = 446;
+    if (argb == NULL || y == NULL || u == NULL || v == NULL)
+        return 1;
 
-    uint8_t *const pClip = (uint8_t *const)color_tClip + 288 * 2;
+    if (width <= 0 || height <= 0)
+        return 0;
+
+    init_job(&job, CONVERT_420P_TO_ARGB32_NO_ALPHA, argb, argb_stride, width);
+    job.y = y;
+    job.v = v;
+    job.u = u;
+    job.y_stride = y_stride;
+    job.v_stride = v_stride;
+    job.u_stride = u_stride;
+    return run_job(&job, height, 2);
+}
 
-    if (bgra == NULL || y == NULL || u == NULL || v == NULL)
+int ColorConvert_YCbCr420p_to_BGRA32(uint8_t *bgra,
+                                     int32_t bgra_stride,
+                                     int32_t width,
+                                     int32_t height,
+                                     const uint8_t *y,
+                                     const uint8_t *v,
+                                     const uint8_t *u,
+                                     const uint8_t *a,
+                                     int32_t y_stride,
+                                     int32_t v_stride,
+                                     int32_t u_stride,
+                                     int32_t a_stride)
+{
+    conversion_job job;
+
+    if (bgra == NULL || y == NULL || u == NULL || v == NULL || a == NULL)
         return 1;
 
     if (width <= 0 || height <= 0)
-        return 1;
+        return 0;
+
+    init_job(&job, CONVERT_420P_TO_BGRA32, bgra, bgra_stride, width);
+    job.y = y;
+    job.v = v;
+    job.u = u;
+    job.a = a;
+    job.y_stride = y_stride;
+    job.v_stride = v_stride;
+    job.u_stride = u_stride;
+    job.a_stride = a_stride;
+    return run_job(&job, height, 2);
+}
 
-    if (width & 1)
+int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(uint8_t *bgra,
+                                              int32_t bgra_stride,
+                                              int32_t width,
+                                              int32_t height,
+                                              const uint8_t *y,
+                                              const uint8_t *v,
+                                              const uint8_t *u,
+                                              int32_t y_stride,
+                                              int32_t v_stride,
+                                              int32_t u_stride)
+{
+    conversion_job job;
+
+    if (bgra == NULL || y == NULL || u == NULL || v == NULL)
         return 1;
 
-    sly1 = say1 = y;
-    slu = sau = u;
-    slv = sav = v;
-    dl1 = da1 = bgra;
+    if (width <= 0 || height <= 0)
+        return 0;
+
+    init_job(&job, CONVERT_420P_TO_BGRA32_NO_ALPHA, bgra, bgra_stride, width);
+    job.y = y;
+    job.v = v;
+    job.u = u;
+    job.y_stride = y_stride;
+    job.v_stride = v_stride;
+    job.u_stride = u_stride;
+    return run_job(&job, height, 2);
+}
 
-    for (j = 0; j < height; j++) {
-        for (i = 0; i < (width >> 1); i++) {
-            int32_t sf01, sf03, sf1, sf2, sfr, sfg, sfb;
+static int convert_YCbCr422(conversion_type type,
+                            uint8_t *dst,
+                            int32_t dst_stride,
+                            int32_t width,
+                            int32_t height,
+                            const uint8_t *y,
+                            const uint8_t *v,
+                            const uint8_t *u,
+                            int32_t y_stride,
+                            int32_t uv_stride)
+{
+    conversion_job job;
 
-            sf1 = sau[0];
-            sf2 = sav[0];
+    if (dst == NULL || y == NULL || u == NULL || v == NULL)
+        return 1;
 
-            sf01 = say1[0];
-            sf03 = say1[2];
+    if (width <= 0 || height <= 0)
+        return 1;
 
-            sfr = color_tRV[sf2] - RRi;
-            sfg = color_tGU[sf1] - color_tGV[sf2];
-            sfb = color_tBU[sf1] - BBi;
+    if (width & 1)
+        return 1;
 
-            sf01 = color_tYY[sf01];
-            sf03 = color_tYY[sf03];
+    init_job(&job, type, dst, dst_stride, width);
+    job.y = y;
+    job.v = v;
+    job.u = u;
+    job.y_stride = y_stride;
+    job.v_stride = uv_stride;
+    job.u_stride = uv_stride;
+    return run_job(&job, height, 1);
+}
 
-            TCLAMP_U8(sf01 + sfr, da1[2]);
-            TCLAMP_U8(sf01 + sfg, da1[1]);
-            SCLAMP_U8(sf01 + sfb, da1[0]);
-            TCLAMP_U8(sf03 + sfr, da1[6]);
-            TCLAMP_U8(sf03 + sfg, da1[5]);
-            SCLAMP_U8(sf03 + sfb, da1[4]);
+int ColorConvert_YCbCr422p_to_ARGB32_no_alpha(uint8_t *argb,
+                                              int32_t argb_stride,
+                                              int32_t width,
+                                              int32_t height,
+                                              const uint8_t *y,
+                                              const uint8_t *v,
+                                              const uint8_t *u,
+                                              int32_t y_stride,
+                                              int32_t uv_stride)
+{
+    return convert_YCbCr422(CONVERT_422_TO_ARGB32, argb, argb_stride, width, height,
+                            y, v, u, y_stride, uv_stride);
+}
 
-            da1[3] = da1[7] = 0xff;
+int ColorConvert_YCbCr422p_to_BGRA32_no_alpha(uint8_t *bgra,
+                                              int32_t bgra_stride,
+                                              int32_t width,
+                                              int32_t height,
+                                              const uint8_t *y,
+                                              const uint8_t *v,
+                                              const uint8_t *u,
+                                              int32_t y_stride,
+                                              int32_t uv_stride)
+{
+    return convert_YCbCr422(CONVERT_422_TO_BGRA32, bgra, bgra_stride, width, height,
+                            y, v, u, y_stride, uv_stride);
+}
 
-            say1 += 4;
-            sau += 4;
-            sav += 4;
-            da1 += 8;
-        }
+int ColorConvert_SwapRGB32(uint8_t *dst,
+                           int32_t dst_stride,
+                           int32_t width,
+                           int32_t height,
+                           const uint8_t *src,
+                           int32_t src_stride)
+{
+    conversion_job job;
 
-        sly1 = say1 = ((uint8_t *)sly1 + y_stride);
-        slu = sau = ((uint8_t *)slu + uv_stride);
-        slv = sav = ((uint8_t *)slv + uv_stride);
-        dl1 = da1 = ((uint8_t *)dl1 + bgra_stride);
-    }
+    if (dst == NULL || src == NULL)
+        return 1;
 
-    return 0;
+    if (width <= 0 || height <= 0)
+        return 0;
+
+    init_job(&job, CONVERT_SWAP_RGB32, dst, dst_stride, width);
+    job.y = src;
+    job.y_stride = src_stride;
+    return run_job(&job, height, 1);
 }
-// --- End YCbCr422p conversion functions
+// --- End public conversion functions
@@ -32,6 +32,11 @@
 extern "C" {
 #endif
 
+// Kernels, see ColorConvert_SetMaxKernel()
+#define COLOR_CONVERT_KERNEL_C      0
+#define COLOR_CONVERT_KERNEL_SSE2   1
+#define COLOR_CONVERT_KERNEL_AVX2   2
+
     int ColorConvert_YCbCr420p_to_ARGB32(uint8_t *argb,
                                          int32_t argb_stride,
                                          int32_t width,
@@ -101,6 +106,33 @@ extern "C" {
                                                   int32_t y_stride,
                                                   int32_t uv_stride);
 
+    /*
+     * Reverses the byte order of every 32 bit pixel, converting ARGB to BGRA
+     * and back. dst may be equal to src.
+     */
+    int ColorConvert_SwapRGB32(uint8_t *dst,
+                               int32_t dst_stride,
+                               int32_t width,
+                               int32_t height,
+                               const uint8_t *src,
+                               int32_t src_stride);
+
+    /*
+     * Limits the kernels used to the given one, the fastest kernel the
+     * processor supports is used by default. Returns the kernel that is
+     * used now. The YCbCr420p conversions fall back to SSE2 rather than C
+     * where SSE2 is available.
+     */
+    int ColorConvert_SetMaxKernel(int kernel);
+
+    /*
+     * Converts frames of at least pixels pixels in bands of rows, using up
+     * to threads threads including the calling one. threads <= 0 uses one
+     * per processor, up to 4. Frames are converted by the calling thread
+     * alone until this is called.
+     */
+    void ColorConvert_SetParallelism(int32_t threads, int32_t pixels);
+
 #ifdef __cplusplus
 };
 #endif
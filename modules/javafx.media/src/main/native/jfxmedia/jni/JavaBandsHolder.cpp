@@ -26,7 +26,13 @@
 #include "JavaBandsHolder.h"
 #include "JniUtils.h"
 
+#include <string.h>
+
 CJavaBandsHolder::CJavaBandsHolder()
+    : m_jvm(NULL),
+      m_Bands(0),
+      m_Buffer(NULL),
+      m_pData(NULL)
 {
 }
 
@@ -36,21 +42,15 @@ CJavaBandsHolder::~CJavaBandsHolder()
         CJavaEnvironment jenv(m_jvm);
         JNIEnv *pEnv = jenv.getEnvironment();
 
-        if (pEnv) {
-            if (m_Magnitudes) {
-                pEnv->DeleteGlobalRef(m_Magnitudes);
-                m_Magnitudes = NULL;
-            }
-
-            if (m_Phases) {
-                pEnv->DeleteGlobalRef(m_Phases);
-                m_Phases = NULL;
-            }
+        if (pEnv && m_Buffer) {
+            pEnv->DeleteGlobalRef(m_Buffer);
+            m_Buffer = NULL;
+            m_pData = NULL;
         }
     }
 }
 
-bool CJavaBandsHolder::Init(JNIEnv* env, int bands, jfloatArray magnitudes, jfloatArray phases)
+bool CJavaBandsHolder::Init(JNIEnv* env, int bands, jobject buffer)
 {
     env->GetJavaVM(&m_jvm);
     if (env->ExceptionCheck()) {
@@ -59,33 +59,33 @@ bool CJavaBandsHolder::Init(JNIEnv* env, int bands, jfloatArray magnitudes, jflo
         return false;
     }
 
+    float *pData = (float*)env->GetDirectBufferAddress(buffer);
+    if (pData == NULL || env->GetDirectBufferCapacity(buffer) < (jlong)(2 * bands * sizeof(float))) {
+        m_jvm = NULL;
+        return false;
+    }
+
+    m_Buffer = env->NewGlobalRef(buffer);
+    if (m_Buffer == NULL) {
+        m_jvm = NULL;
+        return false;
+    }
     m_Bands = bands;
-    m_Magnitudes = (jfloatArray)env->NewGlobalRef(magnitudes);
-    m_Phases = (jfloatArray)env->NewGlobalRef(phases);
+    m_pData = pData;
 
     InitRef(this);
 
     return true;
 }
 
+// Called from the streaming thread for every spectrum message. The global
+// reference keeps the buffer reachable, so the bands are stored without
+// attaching to the JVM.
 void CJavaBandsHolder::UpdateBands(int size, const float* magnitudes, const float* phases)
 {
-    if (m_Bands != size || m_jvm == NULL)
+    if (m_Bands != size || m_pData == NULL)
         return;
 
-    CJavaEnvironment jenv(m_jvm);
-    JNIEnv *pEnv = jenv.getEnvironment();
-    if (pEnv) {
-        // use local references due to threading issues
-        jfloatArray localMagnitudes = (jfloatArray)pEnv->NewLocalRef(m_Magnitudes);
-        jfloatArray localPhases = (jfloatArray)pEnv->NewLocalRef(m_Phases);
-
-        if (localMagnitudes && localPhases) {
-            pEnv->SetFloatArrayRegion(localMagnitudes, 0, size, magnitudes);
-            pEnv->SetFloatArrayRegion(localPhases, 0, size, phases);
-        }
-
-        pEnv->DeleteLocalRef(localMagnitudes);
-        pEnv->DeleteLocalRef(localPhases);
-    }
+    memcpy(m_pData, magnitudes, size * sizeof(float));
+    memcpy(m_pData + size, phases, size * sizeof(float));
 }
@@ -36,14 +36,14 @@ public:
     ~CJavaBandsHolder();
 
 public:
-    bool Init(JNIEnv* env, int bands, jfloatArray magnitudes, jfloatArray phases);
+    bool Init(JNIEnv* env, int bands, jobject buffer);
     void UpdateBands(int size, const float* magnitudes, const float* phases);
 
 private:
     JavaVM      *m_jvm;
     int         m_Bands;
-    jfloatArray m_Magnitudes;
-    jfloatArray m_Phases;
+    jobject     m_Buffer;   // direct buffer holding the magnitudes, then the phases
+    float       *m_pData;   // address of m_Buffer
 };
 
 #endif // _JAVA_SPECTRUM_UPDATER_H_
@@ -41,6 +41,9 @@ jmethodID CJavaInputStreamCallbacks::m_SeekMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_CloseConnectionMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_PropertyMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_GetStreamSizeMID = 0;
+jmethodID CJavaInputStreamCallbacks::m_GetReadAheadSizeMID = 0;
+jmethodID CJavaInputStreamCallbacks::m_SetReadAheadBufferMID = 0;
+jmethodID CJavaInputStreamCallbacks::m_ReadAheadMID = 0;
 
 CJavaInputStreamCallbacks::CJavaInputStreamCallbacks()
     : m_ConnectionHolder(0)
@@ -148,6 +151,24 @@ bool CJavaInputStreamCallbacks::Init(JNIEnv *env, jobject jLocator)
             hasException = javaEnv.reportException();
         }
 
+        if (!hasException)
+        {
+            m_GetReadAheadSizeMID = env->GetMethodID(klass, "getReadAheadSize", "()I");
+            hasException = javaEnv.reportException();
+        }
+
+        if (!hasException)
+        {
+            m_SetReadAheadBufferMID = env->GetMethodID(klass, "setReadAheadBuffer", "(Ljava/nio/ByteBuffer;)V");
+            hasException = javaEnv.reportException();
+        }
+
+        if (!hasException)
+        {
+            m_ReadAheadMID = env->GetMethodID(klass, "readAhead", "(II)I");
+            hasException = javaEnv.reportException();
+        }
+
         if (NULL != klass)
             env->DeleteLocalRef(klass);
 
@@ -348,3 +369,67 @@ int CJavaInputStreamCallbacks::GetStreamSize()
 
     return result;
 }
+
+int CJavaInputStreamCallbacks::GetReadAheadSize()
+{
+    CJavaEnvironment javaEnv(m_jvm);
+    JNIEnv *pEnv = javaEnv.getEnvironment();
+    int result = 0;
+
+    if (pEnv) {
+        jobject connection = pEnv->NewLocalRef(m_ConnectionHolder);
+        if (connection) {
+            result = pEnv->CallIntMethod(connection, m_GetReadAheadSizeMID);
+            pEnv->DeleteLocalRef(connection);
+        }
+
+        if (javaEnv.reportException()) {
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+void CJavaInputStreamCallbacks::SetReadAheadBuffer(void* data, int size)
+{
+    CJavaEnvironment javaEnv(m_jvm);
+    JNIEnv *pEnv = javaEnv.getEnvironment();
+
+    if (pEnv) {
+        jobject connection = pEnv->NewLocalRef(m_ConnectionHolder);
+        if (connection) {
+            // The ring is owned by the javasource element, Java only writes to it
+            // from ReadAhead() calls made by the element.
+            jobject buffer = pEnv->NewDirectByteBuffer(data, (jlong)size);
+            if (buffer) {
+                pEnv->CallVoidMethod(connection, m_SetReadAheadBufferMID, buffer);
+                pEnv->DeleteLocalRef(buffer);
+            }
+            pEnv->DeleteLocalRef(connection);
+        }
+
+        javaEnv.reportException();
+    }
+}
+
+int CJavaInputStreamCallbacks::ReadAhead(int offset, int size)
+{
+    int result = -1;
+    CJavaEnvironment javaEnv(m_jvm);
+    JNIEnv *pEnv = javaEnv.getEnvironment();
+
+    if (pEnv) {
+        jobject connection = pEnv->NewLocalRef(m_ConnectionHolder);
+        if (connection) {
+            result = pEnv->CallIntMethod(connection, m_ReadAheadMID, (jint)offset, (jint)size);
+            pEnv->DeleteLocalRef(connection);
+        }
+
+        if (javaEnv.clearException()) {
+            result = -2;
+        }
+    }
+
+    return result;
+}
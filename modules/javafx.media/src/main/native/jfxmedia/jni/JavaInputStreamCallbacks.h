@@ -47,6 +47,9 @@ virtual ~CJavaInputStreamCallbacks();
     void CloseConnection();
     int  Property(int prop, int value);
     int  GetStreamSize();
+    int  GetReadAheadSize();
+    void SetReadAheadBuffer(void* data, int size);
+    int  ReadAhead(int offset, int size);
 
 private:
     jobject          m_ConnectionHolder;
@@ -62,6 +65,9 @@ private:
     static jmethodID m_CloseConnectionMID;
     static jmethodID m_PropertyMID;
     static jmethodID m_GetStreamSizeMID;
+    static jmethodID m_GetReadAheadSizeMID;
+    static jmethodID m_SetReadAheadBufferMID;
+    static jmethodID m_ReadAheadMID;
 };
 
 #endif // _JAVA_INPUT_STREAM_CALLBACKS_H_
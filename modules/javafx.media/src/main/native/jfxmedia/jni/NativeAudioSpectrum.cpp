@@ -51,11 +51,11 @@ Java_com_sun_media_jfxmediaimpl_NativeAudioSpectrum_nativeSetEnabled(JNIEnv *env
 
 JNIEXPORT void JNICALL
 Java_com_sun_media_jfxmediaimpl_NativeAudioSpectrum_nativeSetBands(JNIEnv *env, jobject obj, jlong nativeRef,
-                                                                                jint bands, jfloatArray magnitudes, jfloatArray phases)
+                                                                                jint bands, jobject buffer)
 {
     CAudioSpectrum *pSpectrum = (CAudioSpectrum*)jlong_to_ptr(nativeRef);
     CJavaBandsHolder *pHolder = new (std::nothrow) CJavaBandsHolder();
-    if (!pHolder->Init(env, bands, magnitudes, phases)) {
+    if (pHolder != NULL && !pHolder->Init(env, bands, buffer)) {
         delete pHolder;
         pHolder = NULL;
     }
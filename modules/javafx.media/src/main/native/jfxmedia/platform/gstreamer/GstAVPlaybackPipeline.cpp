@@ -60,6 +60,7 @@ CGstAVPlaybackPipeline::CGstAVPlaybackPipeline(const GstElementContainer& elemen
     m_FrameHeight = 0;
     m_videoCodecErrorCode = ERROR_NONE;
     m_bStaticPipeline = false; // For now all video pipelines are dynamic
+    m_pFramePool = NULL;
 }
 
 /**
@@ -73,6 +74,10 @@ CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()
     g_print ("CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()\n");
 #endif
     LOGGER_LOGMSG(LOGGER_DEBUG, "CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()");
+
+    // Frames still held by Java keep the pool alive
+    if (m_pFramePool != NULL)
+        m_pFramePool->Release();
 }
 
 /**
@@ -82,6 +87,10 @@ CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()
  */
 uint32_t CGstAVPlaybackPipeline::Init()
 {
+    m_pFramePool = new (nothrow) CGstVideoFramePool();
+    if (m_pFramePool == NULL)
+        return ERROR_MEMORY_ALLOCATION;
+
     g_signal_connect(m_Elements[AV_DEMUXER], "pad-added", G_CALLBACK (on_pad_added), this);
     g_signal_connect(m_Elements[AV_DEMUXER], "no-more-pads", G_CALLBACK (no_more_pads), this);
     g_signal_connect(m_Elements[AUDIO_QUEUE], "overrun", G_CALLBACK (queue_overrun), this);
@@ -274,7 +283,7 @@ GstFlowReturn CGstAVPlaybackPipeline::OnAppSinkHaveFrame(GstElement* pElem, CGst
 
     //***** Create a VideoFrame object
     CGstVideoFrame* pVideoFrame = new CGstVideoFrame();
-    if (!pVideoFrame->Init(pSample))
+    if (!pVideoFrame->Init(pSample, pPipeline->m_pFramePool))
     {
         gst_sample_unref(pSample);
         delete pVideoFrame;
@@ -338,7 +347,7 @@ GstFlowReturn CGstAVPlaybackPipeline::OnAppSinkPreroll(GstElement* pElem, CGstAV
     if(pPipeline->m_pEventDispatcher != NULL)
     {
         CGstVideoFrame* pVideoFrame = new CGstVideoFrame();
-        if (!pVideoFrame->Init(pSample))
+        if (!pVideoFrame->Init(pSample, pPipeline->m_pFramePool))
         {
             // INLINE - gst_sample_unref()
             gst_sample_unref (pSample);
@@ -391,6 +400,9 @@ void CGstAVPlaybackPipeline::OnAppSinkVideoFrameDiscont(CGstAVPlaybackPipeline*
         pPipeline->m_FrameWidth = width;
         pPipeline->m_FrameHeight = height;
 
+        // Buffers of the old size won't be needed anymore
+        pPipeline->m_pFramePool->Reset();
+
         if(pPipeline->m_pEventDispatcher != NULL)
         {
             pPipeline->m_SendFrameSizeEvent = !pPipeline->m_pEventDispatcher->SendFrameSizeChangedEvent(pPipeline->m_FrameWidth, pPipeline->m_FrameHeight);
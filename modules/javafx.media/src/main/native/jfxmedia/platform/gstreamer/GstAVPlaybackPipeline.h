@@ -32,6 +32,7 @@
 #include "GstAudioPlaybackPipeline.h"
 #include "GstPipelineFactory.h"
 
+class CGstVideoFramePool;
 
 /**
  * class CGstAVPlaybackPipeline
@@ -81,6 +82,7 @@ private:
     gulong                  m_videoDecoderSrcProbeHID;
     gfloat                  m_EncodedVideoFrameRate;
     int                     m_videoCodecErrorCode;
+    CGstVideoFramePool*     m_pFramePool;
 };
 
 #endif  //_GST_AV_PLAYBACK_PIPELINE_H_
@@ -1427,24 +1427,21 @@ gboolean CGstAudioPlaybackPipeline::BusCallback(GstBus* bus, GstMessage* msg, sB
                 if (!gst_structure_get_clock_time (pStr, "duration", &duration))
                     duration = GST_CLOCK_TIME_NONE;
 
-                size_t bandsNum = pPipeline->GetAudioSpectrum()->GetBands();
+                // The spectrum element passes the magnitudes followed by the phases
+                // in one buffer, which goes to the bands holder without conversion.
+                const GValue *bands_value = gst_structure_get_value(pStr, "bands");
+                GstBuffer *bands = (NULL != bands_value) ? gst_value_get_buffer(bands_value) : NULL;
+                GstMapInfo info;
 
-                if (bandsNum > 0)
+                if (NULL != bands && gst_buffer_map(bands, &info, GST_MAP_READ))
                 {
-                    float *magnitudes = new float[bandsNum];
-                    float *phases = new float[bandsNum];
-
-                    const GValue *magnitudes_value = gst_structure_get_value(pStr, "magnitude");
-                    const GValue *phases_value = gst_structure_get_value(pStr, "phase");
-                    for (int i=0; i < bandsNum; i++)
+                    int bandsNum = (int)(info.size / (2 * sizeof(float)));
+                    if (bandsNum > 0)
                     {
-                        magnitudes[i] = g_value_get_float( gst_value_list_get_value (magnitudes_value, i));
-                        phases[i] = g_value_get_float( gst_value_list_get_value (phases_value, i));
+                        const float *magnitudes = (const float*)info.data;
+                        pPipeline->GetAudioSpectrum()->UpdateBands(bandsNum, magnitudes, magnitudes + bandsNum);
                     }
-                    pPipeline->GetAudioSpectrum()->UpdateBands((int)bandsNum, magnitudes, phases);
-
-                    delete [] magnitudes;
-                    delete [] phases;
+                    gst_buffer_unmap(bands, &info);
                 }
 
                 if (!pPipeline->m_pEventDispatcher->SendAudioSpectrumEvent(GST_TIME_AS_SECONDS((double)timestamp),
@@ -102,7 +102,8 @@ void CGstAudioSpectrum::SetBands(int bands, CBandsHolder* holder)
 void CGstAudioSpectrum::UpdateBands(int size, const float* magnitudes, const float* phases)
 {
     CBandsHolder *holder = CBandsHolder::AddRef((CBandsHolder*)g_atomic_pointer_get(&m_pHolder));
-    holder->UpdateBands(size, magnitudes, phases);
+    if (holder != NULL)
+        holder->UpdateBands(size, magnitudes, phases);
     CBandsHolder::ReleaseRef(holder);
 }
 
@@ -166,11 +166,22 @@ extern "C" {
      * @return  Media reference.  This reference must be used when calling GSTMediaPlayer function.
      */
     JNIEXPORT jint JNICALL Java_com_sun_media_jfxmediaimpl_platform_gstreamer_GSTMedia_gstInitNativeMedia
-    (JNIEnv *env, jobject obj, jobject jLocator, jstring jContentType, jlong jSizeHint, jlongArray jlMediaHandle)
+    (JNIEnv *env, jobject obj, jobject jLocator, jstring jContentType, jlong jSizeHint, jint jDecoderThreads, jlongArray jlMediaHandle)
     {
         LOWLEVELPERF_EXECTIMESTART("gstInitNativeMediaToSendToJavaPlayerStateEventPaused");
         LOWLEVELPERF_EXECTIMESTART("gstInitNativeMedia()");
-        uint32_t result = InitMedia(env, NULL, jLocator, jContentType, jSizeHint, jlMediaHandle);
+
+        //***** Default options are created by the media manager, unless something is set
+        CPipelineOptions* pOptions = NULL;
+        if (jDecoderThreads >= 0)
+        {
+            pOptions = new (nothrow) CPipelineOptions();
+            if (NULL == pOptions)
+                return ERROR_MEMORY_ALLOCATION;
+            pOptions->SetDecoderThreadCount((int)jDecoderThreads);
+        }
+
+        uint32_t result = InitMedia(env, pOptions, jLocator, jContentType, jSizeHint, jlMediaHandle);
         LOWLEVELPERF_EXECTIMESTOP("gstInitNativeMedia()");
 
         return result;
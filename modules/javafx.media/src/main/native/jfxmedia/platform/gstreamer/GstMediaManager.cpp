@@ -28,6 +28,7 @@
 #include <jni/Logger.h>
 #include <Common/VSMemory.h>
 #include <Utils/LowLevelPerf.h>
+#include <Utils/ColorConverter.h>
 
 //*************************************************************************************************
 //********** class CGstMediaManager
@@ -137,6 +138,9 @@ uint32_t CGstMediaManager::Init()
     }
     LOWLEVELPERF_EXECTIMESTOP("gst_init_check()");
 
+    //***** Convert HD and larger frames on several threads
+    ColorConvert_SetParallelism(0, 1280 * 720);
+
 #if ENABLE_VISUAL_STUDIO_MEMORY_LEAKS_DETECTION && TARGET_OS_WIN32
     _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 #endif // ENABLE_VISUAL_STUDIO_MEMORY_LEAKS_DETECTION
@@ -198,6 +198,7 @@ uint32_t CGstPipelineFactory::CreateSourceElement(CLocator* locator, GstElement*
                 return ERROR_GSTREAMER_ELEMENT_CREATE;
 
             bool isRandomAccess = callbacks->IsRandomAccess();
+            int readAheadSize = callbacks->GetReadAheadSize();
             int hlsMode = callbacks->Property(HLS_PROP_GET_HLS_MODE, 0);
             int streamMimeType = callbacks->Property(HLS_PROP_GET_MIMETYPE, 0);
             pOptions->SetHLSModeEnabled(hlsMode == 1);
@@ -213,6 +214,13 @@ uint32_t CGstPipelineFactory::CreateSourceElement(CLocator* locator, GstElement*
             if (isRandomAccess)
                 g_signal_connect (javaSource, "read-block", G_CALLBACK (SourceReadBlock), callbacks);
 
+            if (readAheadSize > 0)
+            {
+                g_signal_connect (javaSource, "set-read-ahead-buffer", G_CALLBACK (SourceSetReadAheadBuffer), callbacks);
+                g_signal_connect (javaSource, "read-ahead", G_CALLBACK (SourceReadAhead), callbacks);
+                g_object_set (javaSource, "read-ahead-size", (guint)readAheadSize, NULL);
+            }
+
             if (hlsMode == 1)
                 g_object_set (javaSource, "hls-mode", TRUE, NULL);
 
@@ -312,6 +320,16 @@ int CGstPipelineFactory::SourceGetStreamSize(GstElement *src, gpointer data)
     return ((CStreamCallbacks*)data)->GetStreamSize();
 }
 
+void CGstPipelineFactory::SourceSetReadAheadBuffer(GstElement *src, gpointer buffer, int size, gpointer data)
+{
+    ((CStreamCallbacks*)data)->SetReadAheadBuffer(buffer, size);
+}
+
+gint CGstPipelineFactory::SourceReadAhead(GstElement *src, int offset, int size, gpointer data)
+{
+    return ((CStreamCallbacks*)data)->ReadAhead(offset, size);
+}
+
 void CGstPipelineFactory::SourceCloseConnection(GstElement *src, gpointer data)
 {
     CStreamCallbacks* callbacks = (CStreamCallbacks*)data;
@@ -323,6 +341,8 @@ void CGstPipelineFactory::SourceCloseConnection(GstElement *src, gpointer data)
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceCloseConnection), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceProperty), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceGetStreamSize), callbacks);
+    g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceSetReadAheadBuffer), callbacks);
+    g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceReadAhead), callbacks);
     delete callbacks;
 }
 
@@ -651,6 +671,12 @@ uint32_t CGstPipelineFactory::CreateAVPipeline(GstElement* source, const char* s
         g_object_set(G_OBJECT(elements[VIDEO_DECODER]), "location", location, NULL);
     }
 
+    if (elements[VIDEO_DECODER] != NULL && pOptions->GetDecoderThreadCount() >= 0 &&
+        NULL != g_object_class_find_property(G_OBJECT_GET_CLASS(G_OBJECT(elements[VIDEO_DECODER])), "thread-count"))
+    {
+        g_object_set(G_OBJECT(elements[VIDEO_DECODER]), "thread-count", pOptions->GetDecoderThreadCount(), NULL);
+    }
+
     *ppPipeline = new CGstAVPlaybackPipeline(elements, audioFlags, pOptions);
     if( NULL == *ppPipeline)
         return ERROR_MEMORY_ALLOCATION;
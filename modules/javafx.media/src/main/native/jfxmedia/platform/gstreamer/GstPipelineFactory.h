@@ -92,6 +92,8 @@ private:
     static void     SourceCloseConnection(GstElement *src, gpointer data);
     static int      SourceProperty(GstElement *src, int prop, int value, gpointer data);
     static int      SourceGetStreamSize(GstElement *src, gpointer data);
+    static void     SourceSetReadAheadBuffer(GstElement *src, gpointer buffer, int size, gpointer data);
+    static gint     SourceReadAhead(GstElement *src, int offset, int size, gpointer data);
 
 private:
     ContentTypesList m_ContentTypes;
@@ -31,15 +31,6 @@
 #include <Utils/LowLevelPerf.h>
 #include <Utils/ColorConverter.h>
 
-static inline guint32 swap_uint32(guint32 x)
-{
-    return
-        ((x & 0x000000ffU) << 24) |
-        ((x & 0x0000ff00U) <<  8) |
-        ((x & 0x00ff0000U) >>  8) |
-        ((x & 0xff000000U) >> 24);
-}
-
 static void free_aligned_buffer(gpointer ptr)
 {
     if (ptr != NULL) {
@@ -67,6 +58,130 @@ static GstBuffer *alloc_aligned_buffer(guint size)
     return gst_buffer_new_wrapped_full((GstMemoryFlags)0, alignedData, alignedSize, 0, 0, newData, free_aligned_buffer);
 }
 
+//*************************************************************************************************
+//********** class CGstVideoFramePool
+//*************************************************************************************************
+
+// The number of free buffers kept for reuse. Converted frames are disposed
+// soon after they have been rendered, so a few are enough.
+#define MAX_FREE_BLOCKS 4
+
+struct CGstVideoFramePool::Block
+{
+    CGstVideoFramePool* pPool;
+    guint               uGeneration;
+    guint8*             pData;
+};
+
+CGstVideoFramePool::CGstVideoFramePool()
+{
+    m_RefCount = 1;
+    g_mutex_init(&m_Mutex);
+    m_uSize = 0;
+    m_Type = CVideoFrame::UNKNOWN;
+    m_uGeneration = 0;
+    m_pFreeBlocks = NULL;
+    m_uFreeCount = 0;
+}
+
+CGstVideoFramePool::~CGstVideoFramePool()
+{
+    FreeBlocks();
+    g_mutex_clear(&m_Mutex);
+}
+
+void CGstVideoFramePool::AddRef()
+{
+    g_atomic_int_inc(&m_RefCount);
+}
+
+void CGstVideoFramePool::Release()
+{
+    if (g_atomic_int_dec_and_test(&m_RefCount)) {
+        delete this;
+    }
+}
+
+// Must be called with m_Mutex held, or from the destructor.
+void CGstVideoFramePool::FreeBlocks()
+{
+    while (m_pFreeBlocks != NULL) {
+        g_free(m_pFreeBlocks->data);
+        m_pFreeBlocks = g_slist_delete_link(m_pFreeBlocks, m_pFreeBlocks);
+        LOWLEVELPERF_COUNTERDEC("CGstVideoFramePool", 1, 1);
+    }
+    m_uFreeCount = 0;
+}
+
+void CGstVideoFramePool::Reset()
+{
+    g_mutex_lock(&m_Mutex);
+    m_uGeneration++;
+    FreeBlocks();
+    g_mutex_unlock(&m_Mutex);
+}
+
+GstBuffer *CGstVideoFramePool::AllocBuffer(guint size, CVideoFrame::FrameType type)
+{
+    Block *pBlock = NULL;
+
+    g_mutex_lock(&m_Mutex);
+    if (size != m_uSize || type != m_Type) {
+        m_uSize = size;
+        m_Type = type;
+        m_uGeneration++;
+        FreeBlocks();
+    }
+
+    if (m_pFreeBlocks != NULL) {
+        pBlock = (Block*)m_pFreeBlocks->data;
+        m_pFreeBlocks = g_slist_delete_link(m_pFreeBlocks, m_pFreeBlocks);
+        m_uFreeCount--;
+    }
+    guint uGeneration = m_uGeneration;
+    g_mutex_unlock(&m_Mutex);
+
+    // The average of the logged values is the reuse rate
+    LOWLEVELPERF_LOGVALUE("CGstVideoFramePool reuse", pBlock != NULL ? 100 : 0, "%", 1);
+
+    if (pBlock == NULL) {
+        // The header and a 16 byte aligned buffer in one allocation
+        pBlock = (Block*)g_try_malloc(sizeof(Block) + size + 16);
+        if (pBlock == NULL) {
+            return NULL;
+        }
+        pBlock->pPool = this;
+        pBlock->uGeneration = uGeneration;
+        pBlock->pData = (guint8*)(((intptr_t)(pBlock + 1) + 15) & ~15);
+        LOWLEVELPERF_COUNTERINC("CGstVideoFramePool", 1, 1);
+    }
+
+    // Each buffer in use holds a reference, the pool gets the block back
+    AddRef();
+    return gst_buffer_new_wrapped_full((GstMemoryFlags)0, pBlock->pData, size, 0, size, pBlock, ReleaseBlock);
+}
+
+void CGstVideoFramePool::ReleaseBlock(gpointer data)
+{
+    Block *pBlock = (Block*)data;
+    CGstVideoFramePool *pPool = pBlock->pPool;
+
+    g_mutex_lock(&pPool->m_Mutex);
+    if (pBlock->uGeneration == pPool->m_uGeneration && pPool->m_uFreeCount < MAX_FREE_BLOCKS) {
+        pPool->m_pFreeBlocks = g_slist_prepend(pPool->m_pFreeBlocks, pBlock);
+        pPool->m_uFreeCount++;
+        pBlock = NULL;
+    }
+    g_mutex_unlock(&pPool->m_Mutex);
+
+    if (pBlock != NULL) {
+        g_free(pBlock);
+        LOWLEVELPERF_COUNTERDEC("CGstVideoFramePool", 1, 1);
+    }
+
+    pPool->Release();
+}
+
 GstCaps *create_RGB_caps(CVideoFrame::FrameType type, gint width, gint height, gint encodedWidth, gint encodedHeight, gint stride)
 {
     gint red_mask, green_mask, blue_mask, alpha_mask;
@@ -108,6 +223,7 @@ CGstVideoFrame::CGstVideoFrame()
     m_pSample = NULL;
     m_pBuffer = NULL;
     m_bIsI420 = false;
+    m_pFramePool = NULL;
 }
 
 CGstVideoFrame::~CGstVideoFrame()
@@ -116,12 +232,20 @@ CGstVideoFrame::~CGstVideoFrame()
 
     if (NULL != m_pBuffer)
         Dispose();
+
+    if (NULL != m_pFramePool)
+        m_pFramePool->Release();
 }
 
-bool CGstVideoFrame::Init(GstSample* sample)
+bool CGstVideoFrame::Init(GstSample* sample, CGstVideoFramePool* pFramePool)
 {
     LOWLEVELPERF_COUNTERINC("CGstVideoFrame", 1, 1);
 
+    if (pFramePool != NULL) {
+        pFramePool->AddRef();
+        m_pFramePool = pFramePool;
+    }
+
     // Increment the ref count as this object will be created
     // by the video sink and pushed into the FrameQueue.
     m_pSample = gst_sample_ref(sample);
@@ -375,6 +499,14 @@ CVideoFrame *CGstVideoFrame::ConvertToFormat(FrameType type)
     return newFrame;
 }
 
+GstBuffer *CGstVideoFrame::AllocConvertedBuffer(guint size, FrameType destType)
+{
+    if (m_pFramePool != NULL) {
+        return m_pFramePool->AllocBuffer(size, destType);
+    }
+    return alloc_aligned_buffer(size);
+}
+
 CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr420p(FrameType destType)
 {
     GstSample *destSample = NULL;
@@ -394,7 +526,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr420p(FrameType destType)
     }
 
     stride = ((stride + 15) & ~15); // round up to multiple of 16 bytes
-    destBuffer = alloc_aligned_buffer(stride * m_iEncodedHeight);
+    destBuffer = AllocConvertedBuffer(stride * m_iEncodedHeight, destType);
     if (!destBuffer) {
         return NULL;
     }
@@ -476,7 +608,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr420p(FrameType destType)
 
     if (0 == status && destSample) {
         CGstVideoFrame *newFrame = new CGstVideoFrame();
-        bool result = newFrame->Init(destSample);
+        bool result = newFrame->Init(destSample, m_pFramePool);
         // INLINE - gst_sample_unref()
         gst_buffer_unref(destBuffer); // else we'll have a massive memory leak!
         // INLINE - gst_sample_unref()
@@ -502,7 +634,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr422(FrameType destType)
     }
 
     stride = ((stride + 15) & ~15); // round up to multiple of 16 bytes
-    destBuffer = alloc_aligned_buffer(stride * m_iEncodedHeight);
+    destBuffer = AllocConvertedBuffer(stride * m_iEncodedHeight, destType);
     if (!destBuffer) {
         return NULL;
     }
@@ -556,7 +688,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr422(FrameType destType)
 
     if (0 == status && destBuffer) {
         CGstVideoFrame *newFrame = new CGstVideoFrame();
-        bool result = newFrame->Init(destSample);
+        bool result = newFrame->Init(destSample, m_pFramePool);
         // INLINE - gst_buffer_unref()
         gst_buffer_unref(destBuffer); // else we'll have a massive memory leak!
         // INLINE - gst_sample_unref()
@@ -574,12 +706,11 @@ CGstVideoFrame *CGstVideoFrame::ConvertSwapRGB(FrameType destType)
     GstCaps *srcCaps, *dstCaps;
     GstMapInfo srcInfo, destInfo;
     GstStructure* str;
-    gint xx, yy, size;
-    guint32 *srcData, *dstData;
+    gint size;
 
     size = gst_buffer_get_size(m_pBuffer);
 
-    destBuffer = alloc_aligned_buffer(size);
+    destBuffer = AllocConvertedBuffer(size, destType);
     if (!destBuffer) {
         return NULL;
     }
@@ -644,21 +775,16 @@ CGstVideoFrame *CGstVideoFrame::ConvertSwapRGB(FrameType destType)
     }
 
     // Now copy data from src to dest, byteswapping as we copy
-    srcData = (guint32*)srcInfo.data;
-    dstData = (guint32*)destInfo.data;
-    if (!(m_piPlaneStrides[0] & 3)) {
-        // four byte alignment on the entire buffer, we can just loop once
-        for (xx = 0; xx < size; xx += 4) {
-            *dstData++ = swap_uint32(*srcData++); // NOTE: SSE could be used here instead
-        }
+    if (m_piPlaneStrides[0] > 0 && !(m_piPlaneStrides[0] & 3)) {
+        // four byte alignment on the entire buffer, we can swap the padding
+        // along with the pixels
+        ColorConvert_SwapRGB32(destInfo.data, m_piPlaneStrides[0],
+                               m_piPlaneStrides[0] / 4, size / m_piPlaneStrides[0],
+                               srcInfo.data, m_piPlaneStrides[0]);
     } else {
-        for (yy = 0; yy < m_iHeight; yy++) {
-            for (xx = 0; xx < m_iWidth; xx++) {
-                dstData[xx] = swap_uint32(srcData[xx]); // NOTE: SSE could be used here instead
-            }
-            dstData += m_piPlaneStrides[0];
-            srcData += m_piPlaneStrides[0];
-        }
+        ColorConvert_SwapRGB32(destInfo.data, m_piPlaneStrides[0],
+                               m_iWidth, m_iHeight,
+                               srcInfo.data, m_piPlaneStrides[0]);
     }
 
     gst_buffer_unmap(m_pBuffer, &srcInfo);
@@ -666,7 +792,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertSwapRGB(FrameType destType)
 
     if (destBuffer) {
         CGstVideoFrame *newFrame = new CGstVideoFrame();
-        bool result = newFrame->Init(destSample);
+        bool result = newFrame->Init(destSample, m_pFramePool);
         // INLINE - gst_buffer_unref()
         gst_buffer_unref(destBuffer); // else we'll have a massive memory leak!
         // INLINE - gst_sample_unref()
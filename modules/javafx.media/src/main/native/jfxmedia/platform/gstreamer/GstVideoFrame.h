@@ -32,6 +32,51 @@
 #define FOURCC_I420 "I420"
 #define FOURCC_UYVY "UYVY"
 
+/**
+ * class CGstVideoFramePool
+ *
+ * Recycles the aligned buffers of the frames converted from the frames of one
+ * stream, so continuous playback does not allocate a new buffer for every
+ * converted frame. Buffers are recycled when the Java side disposes their frame.
+ * The pool is reference counted, as frames may outlive their pipeline.
+ */
+class CGstVideoFramePool
+{
+public:
+    CGstVideoFramePool();
+
+    void AddRef();
+    void Release();
+
+    /*
+     * Drops the free buffers. Buffers in use are freed rather than recycled,
+     * called when the caps of the stream change.
+     */
+    void Reset();
+
+    /*
+     * Returns a buffer of size bytes, 16 byte aligned, for a frame of the
+     * given type. Buffers are only reused for the same size and type.
+     */
+    GstBuffer *AllocBuffer(guint size, CVideoFrame::FrameType type);
+
+private:
+    struct Block;
+
+    ~CGstVideoFramePool();
+
+    static void ReleaseBlock(gpointer data);
+    void FreeBlocks();
+
+    volatile gint           m_RefCount;
+    GMutex                  m_Mutex;
+    guint                   m_uSize;
+    CVideoFrame::FrameType  m_Type;
+    guint                   m_uGeneration;
+    GSList*                 m_pFreeBlocks;
+    guint                   m_uFreeCount;
+};
+
 /**
  * class CGstVideoFrame
  *
@@ -46,9 +91,10 @@ public:
 
     /*
      * Initialize a VideoFrame that wraps the given GstBuffer. The frame caps are
-     * extracted from the buffer itself.
+     * extracted from the buffer itself. Frames converted from this one get their
+     * buffers from pFramePool, if given.
      */
-    bool Init(GstSample* sample);
+    bool Init(GstSample* sample, CGstVideoFramePool* pFramePool = NULL);
 
     virtual void Dispose();
 
@@ -69,7 +115,9 @@ private:
     void*       m_pvBufferBaseAddress;
     unsigned long m_ulBufferSize;
     bool        m_bIsI420;
+    CGstVideoFramePool* m_pFramePool;
 
+    GstBuffer *AllocConvertedBuffer(guint size, FrameType destType);
     CGstVideoFrame *ConvertSwapRGB(FrameType destType);
     CGstVideoFrame *ConvertFromYCbCr420p(FrameType destType);
     CGstVideoFrame *ConvertFromYCbCr422(FrameType destType);
@@ -160,6 +160,16 @@ final class WCFontImpl extends WCFont {
         return getFontStrike().getFontResource().getAdvance(glyph, font.getSize());
     }
 
+    @Override public float[] getGlyphWidths(int firstGlyph, int count) {
+        FontResource fr = getFontStrike().getFontResource();
+        float size = font.getSize();
+        float[] widths = new float[count];
+        for (int i = 0; i < count; i++) {
+            widths[i] = fr.getAdvance(firstGlyph + i, size);
+        }
+        return widths;
+    }
+
     @Override public float getXHeight() {
         return getFontStrike().getMetrics().getXHeight();
     }
@@ -38,7 +38,6 @@ import com.sun.webkit.graphics.WCImageFrame;
 import java.io.ByteArrayInputStream;
 import java.io.IOException;
 import java.io.InputStream;
-import java.util.Arrays;
 import java.util.logging.Level;
 import java.util.logging.Logger;
 import javafx.concurrent.Service;
@@ -90,26 +89,29 @@ final class WCImageDecoderImpl extends WCImageDecoder {
         return imageWidth > 0 && imageHeight > 0;
     }
 
-    @Override protected void addImageData(byte[] dataPortion) {
-        if (dataPortion != null) {
+    @Override protected byte[] getImageDataArray(int length) {
+        int newDataSize = dataSize + length;
+        if (newDataSize < 0) {
+            return null;
+        }
+        if (data == null) {
+            data = new byte[Math.max(length, length * 2)];
+        } else if (newDataSize > data.length) {
+            resizeDataArray(Math.max(newDataSize, data.length * 2));
+        }
+        return data;
+    }
+
+    @Override protected void addImageData(int length) {
+        if (length >= 0) {
             fullDataReceived = false;
-            if (data == null) {
-                data = Arrays.copyOf(dataPortion, dataPortion.length * 2);
-                dataSize = dataPortion.length;
-            } else {
-                int newDataSize = dataSize + dataPortion.length;
-                if (newDataSize > data.length) {
-                    resizeDataArray(Math.max(newDataSize, data.length * 2));
-                }
-                System.arraycopy(dataPortion, 0, data, dataSize, dataPortion.length);
-                dataSize = newDataSize;
-            }
+            dataSize += length;
             // Try to decode the partial data until we get image size.
             if (!imageSizeAvilable()) {
                 loadFrames();
             }
         } else if (data != null && !fullDataReceived) {
-            // null dataPortion means data completion
+            // negative length means data completion
             if (data.length > dataSize) {
                 resizeDataArray(dataSize);
             }
@@ -189,7 +191,10 @@ final class WCImageDecoderImpl extends WCImageDecoder {
     }
 
     private ImageFrame[] loadFrames() {
-        return loadFrames(new ByteArrayInputStream(this.data, 0, this.dataSize));
+        // Read the size first: the data array always holds that many bytes,
+        // even if it is replaced while the data is received.
+        int size = this.dataSize;
+        return loadFrames(new ByteArrayInputStream(this.data, 0, size));
     }
 
     private final ImageLoadListener readerListener = new ImageLoadListener() {
@@ -339,6 +339,18 @@ final class WCPathImpl extends WCPath<Path2D> {
         path.append(((WCPathImpl)p).path, false);
     }
 
+    public void setPath(byte[] types, int numTypes,
+                        float[] coords, int numCoords)
+    {
+        if (log.isLoggable(Level.FINE)) {
+            log.log(Level.FINE, "WCPathImpl({0}).setPath({1},{2})",
+                    new Object[] {getID(), numTypes, numCoords});
+        }
+        hasCP = numTypes > 0;
+        path.setTo(new Path2D(path.getWindingRule(),
+                              types, numTypes, coords, numCoords));
+    }
+
     public void closeSubpath() {
         if (log.isLoggable(Level.FINE)) {
             log.log(Level.FINE, "WCPathImpl({0}).closeSubpath()", getID());
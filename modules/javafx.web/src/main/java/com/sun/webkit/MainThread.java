@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2017, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,9 @@
 
 package com.sun.webkit;
 
+import java.util.Timer;
+import java.util.TimerTask;
+
 /**
  * The class reflects the native webkit module.
  */
@@ -37,4 +40,51 @@ final class MainThread {
     }
 
     private static native void twkScheduleDispatchFunctions();
+
+    private static Timer runLoopTimer;
+    // Package-private for MainThreadShim
+    static TimerTask runLoopTask;
+
+    /**
+     * Fires the timer of the main WebKit RunLoop after the given delay.
+     * The native code keeps the RunLoop timers in a heap and only sets this
+     * timer for the earliest one, so there is at most one pending task.
+     */
+    static synchronized void fwkSetRunLoopTimer(long delayMillis) {
+        if (runLoopTask != null) {
+            runLoopTask.cancel();
+        }
+        if (runLoopTimer == null) {
+            runLoopTimer = new Timer("WebKit-RunLoop-Timer", true);
+        }
+        runLoopTask = new TimerTask() {
+            @Override public void run() {
+                Invoker.getInvoker().postOnEventThread(() -> {
+                    twkFireRunLoopTimer();
+                });
+            }
+        };
+        runLoopTimer.schedule(runLoopTask, delayMillis);
+    }
+
+    private static native void twkFireRunLoopTimer();
+
+    // Number of native threads attached to and detached from the JVM by
+    // WebKit so far. Native threads stay attached until they exit.
+    static native int twkGetJavaThreadAttachCount();
+
+    static native int twkGetJavaThreadDetachCount();
+
+    // Calls fwkScheduleDispatchFunctions() {@code count} times from a new
+    // native thread, and returns after that thread has exited
+    static native void twkScheduleDispatchFunctionsFromNewThread(int count);
+
+    // Starts {@code count} timers of the main RunLoop due within
+    // {@code delayMillis}, and dispatches {@code count} functions to it
+    // from a new native thread. Must be called on the event thread.
+    static native void twkStartRunLoopTest(int count, long delayMillis);
+
+    static native int twkGetRunLoopTestTimersFired();
+
+    static native int twkGetRunLoopTestFunctionsRun();
 }
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.webkit;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.Charset;
+import java.nio.charset.StandardCharsets;
+
+/**
+ * The characters of a native string, exposed without copying them.
+ *
+ * The buffer is a direct view of the native string, which stays alive
+ * until the buffer and all the buffers derived from it are unreachable.
+ * 8-bit strings are exposed as ISO-8859-1 bytes, other strings as UTF-16
+ * code units in native byte order.
+ */
+public final class NativeText {
+
+    private static final Charset UTF_16_NATIVE =
+            ByteOrder.nativeOrder() == ByteOrder.BIG_ENDIAN
+                    ? StandardCharsets.UTF_16BE
+                    : StandardCharsets.UTF_16LE;
+
+    private final ByteBuffer buffer;
+    private final boolean latin1;
+
+    private NativeText(ByteBuffer buffer, boolean latin1) {
+        this.buffer = buffer;
+        this.latin1 = latin1;
+    }
+
+    private static NativeText fwkCreate(ByteBuffer buffer, boolean latin1,
+                                        long pImpl)
+    {
+        NativeText text = new NativeText(buffer, latin1);
+        Disposer.addRecord(buffer, new SelfDisposer(pImpl));
+        return text;
+    }
+
+    /**
+     * Returns a read-only view of the characters, positioned at the first
+     * one and ordered in native byte order.
+     */
+    public ByteBuffer getBuffer() {
+        return buffer.asReadOnlyBuffer().order(ByteOrder.nativeOrder());
+    }
+
+    /**
+     * Returns the charset of the bytes returned by {@link #getBuffer}.
+     */
+    public Charset getCharset() {
+        return latin1 ? StandardCharsets.ISO_8859_1 : UTF_16_NATIVE;
+    }
+
+    public boolean isLatin1() {
+        return latin1;
+    }
+
+    public int length() {
+        return latin1 ? buffer.capacity() : buffer.capacity() / 2;
+    }
+
+    @Override
+    public String toString() {
+        return getCharset().decode(getBuffer()).toString();
+    }
+
+    private static final class SelfDisposer implements DisposerRecord {
+        private long pImpl;
+
+        private SelfDisposer(long pImpl) {
+            this.pImpl = pImpl;
+        }
+
+        @Override public void dispose() {
+            if (pImpl != 0) {
+                twkRelease(pImpl);
+                pImpl = 0;
+            }
+        }
+    }
+
+    private static native void twkRelease(long pImpl);
+}
@@ -145,8 +145,19 @@ public final class WebPage {
             final boolean useDFGJIT = Boolean.valueOf(System.getProperty(
                     "com.sun.webkit.useDFGJIT", "true"));
 
+            // Pages without a compositing layer may keep their contents in
+            // tiles of tileSize pixels, taking up to tileCacheSize megabytes
+            // per page. Disabled unless tiledBackingStore is set.
+            final boolean useTiles = Boolean.valueOf(System.getProperty(
+                    "com.sun.webkit.tiledBackingStore", "false"));
+            final int tileSize = Integer.getInteger(
+                    "com.sun.webkit.tileSize", 256);
+            final int tileCacheSize = Integer.getInteger(
+                    "com.sun.webkit.tileCacheSize", 32);
+
             // Initialize WTF, WebCore and JavaScriptCore.
-            twkInitWebCore(useJIT, useDFGJIT);
+            twkInitWebCore(useJIT, useDFGJIT,
+                    useTiles ? Math.max(tileSize, 0) : 0, tileCacheSize);
             return null;
         });
 
@@ -292,9 +303,11 @@ public final class WebPage {
         if (clip == null) {
             clip = new WCRectangle(0, 0, width, height);
         }
+        // The damage of the layout done here is reported before the dirty
+        // rects are taken, so that it is painted in this frame
+        twkPrePaint(getPage());
         List<WCRectangle> oldDirtyRects = dirtyRects;
         dirtyRects = new LinkedList<WCRectangle>();
-        twkPrePaint(getPage());
         while (!oldDirtyRects.isEmpty()) {
             WCRectangle r = oldDirtyRects.remove(0).intersection(clip);
             if (r.getWidth() <= 0 || r.getHeight() <= 0) {
@@ -1112,6 +1125,27 @@ public final class WebPage {
         }
     }
 
+    /**
+     * Same as {@link #getInnerText}, but returns the text without copying
+     * it into a {@code String}, which matters for large documents.
+     */
+    public NativeText getInnerTextBuffer(long frameID) {
+        lockPage();
+        try {
+            log.log(Level.FINE, "Get inner text buffer: frame = " + frameID);
+            if (isDisposed) {
+                log.log(Level.FINE, "getInnerTextBuffer() request for a disposed web page.");
+                return null;
+            }
+            if (!frames.contains(frameID)) {
+                return null;
+            }
+            return twkGetInnerTextBuffer(frameID);
+        } finally {
+            unlockPage();
+        }
+    }
+
     // DRT support
     public String getRenderTree(long frameID) {
         lockPage();
@@ -1779,6 +1813,27 @@ public final class WebPage {
         }
     }
 
+    /**
+     * Same as {@link #getHtml}, but returns the markup without copying it
+     * into a {@code String}, which matters for large documents.
+     */
+    public NativeText getHtmlBuffer(long frameID) {
+        lockPage();
+        try {
+            log.log(Level.FINE, "getHtmlBuffer");
+            if (isDisposed) {
+                log.log(Level.FINE, "getHtmlBuffer() request for a disposed web page.");
+                return null;
+            }
+            if (!frames.contains(frameID)) {
+                return null;
+            }
+            return twkGetHtmlBuffer(frameID);
+        } finally {
+            unlockPage();
+        }
+    }
+
     // ---- PRINTING SUPPORT ---- //
 
     public int beginPrinting(float width, float height) {
@@ -2035,6 +2090,25 @@ public final class WebPage {
         }
     }
 
+    /**
+     * Sets how long changes to local storage are batched before they are
+     * written to the database, and how many items are written per batch.
+     * Takes effect when the page first uses local storage, for all the pages
+     * sharing its database path.
+     */
+    public void setLocalStorageSyncPolicy(int syncIntervalMillis, int maxItemsToSync) {
+        if (syncIntervalMillis < 0 || maxItemsToSync <= 0) {
+            throw new IllegalArgumentException("syncIntervalMillis: "
+                    + syncIntervalMillis + ", maxItemsToSync: " + maxItemsToSync);
+        }
+        lockPage();
+        try {
+            twkSetLocalStorageSyncPolicy(getPage(), syncIntervalMillis, maxItemsToSync);
+        } finally {
+            unlockPage();
+        }
+    }
+
     public void setLocalStorageEnabled(boolean enabled) {
         lockPage();
         try {
@@ -2103,14 +2177,19 @@ public final class WebPage {
         frames.remove(frameID);
     }
 
-    private void fwkRepaint(int x, int y, int w, int h) {
+    // The rects are packed as (x, y, w, h), already coalesced natively
+    private void fwkRepaint(int[] rects) {
         lockPage();
         try {
-            if (paintLog.isLoggable(Level.FINEST)) {
-                paintLog.log(Level.FINEST, "x: {0}, y: {1}, w: {2}, h: {3}",
-                        new Object[] {x, y, w, h});
+            for (int i = 0; i + 3 < rects.length; i += 4) {
+                int x = rects[i], y = rects[i + 1];
+                int w = rects[i + 2], h = rects[i + 3];
+                if (paintLog.isLoggable(Level.FINEST)) {
+                    paintLog.log(Level.FINEST, "x: {0}, y: {1}, w: {2}, h: {3}",
+                            new Object[] {x, y, w, h});
+                }
+                addDirtyRect(new WCRectangle(x, y, w, h));
             }
-            addDirtyRect(new WCRectangle(x, y, w, h));
         } finally {
             unlockPage();
         }
@@ -2517,11 +2596,22 @@ public final class WebPage {
         return frames.size();
     }
 
+    // Package scope method for testing
+    List<WCRectangle> test_getDirtyRects() {
+        lockPage();
+        try {
+            return new ArrayList<WCRectangle>(dirtyRects);
+        } finally {
+            unlockPage();
+        }
+    }
+
     // *************************************************************************
     // Native methods
     // *************************************************************************
 
-    private static native void twkInitWebCore(boolean useJIT, boolean useDFGJIT);
+    private static native void twkInitWebCore(boolean useJIT, boolean useDFGJIT,
+                                              int tileSize, int tileCacheSize);
     private native long twkCreatePage(boolean editable);
     private native void twkInit(long pPage, boolean usePlugins, float devicePixelScale);
     private native void twkDestroyPage(long pPage);
@@ -2533,6 +2623,7 @@ public final class WebPage {
     private native String twkGetName(long pFrame);
     private native String twkGetURL(long pFrame);
     private native String twkGetInnerText(long pFrame);
+    private native NativeText twkGetInnerTextBuffer(long pFrame);
     private native String twkGetRenderTree(long pFrame);
     private native String twkGetContentType(long pFrame);
     private native String twkGetTitle(long pFrame);
@@ -2627,6 +2718,7 @@ public final class WebPage {
     private native boolean twkIsEditable(long page);
     private native void twkSetEditable(long page, boolean editable);
     private native String twkGetHtml(long pFrame);
+    private native NativeText twkGetHtmlBuffer(long pFrame);
 
     private native boolean twkGetUsePageCache(long page);
     private native void twkSetUsePageCache(long page, boolean usePageCache);
@@ -2641,6 +2733,7 @@ public final class WebPage {
     private native String twkGetUserAgent(long page);
     private native void twkSetUserAgent(long page, String userAgent);
     private native void twkSetLocalStorageDatabasePath(long page, String path);
+    private native void twkSetLocalStorageSyncPolicy(long page, int syncIntervalMillis, int maxItemsToSync);
     private native void twkSetLocalStorageEnabled(long page, boolean enabled);
 
     private native int twkGetUnloadEventListenersCount(long pFrame);
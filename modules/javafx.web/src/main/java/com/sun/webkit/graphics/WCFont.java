@@ -42,6 +42,19 @@ public abstract class WCFont extends Ref {
 
     public abstract double getGlyphWidth(int glyph);
 
+    /**
+     * Returns the advances of {@code count} consecutive glyphs starting
+     * with {@code firstGlyph}. Used by the native glyph cache to fill
+     * a whole block of advances with a single call.
+     */
+    public float[] getGlyphWidths(int firstGlyph, int count) {
+        float[] widths = new float[count];
+        for (int i = 0; i < count; i++) {
+            widths[i] = (float) getGlyphWidth(firstGlyph + i);
+        }
+        return widths;
+    }
+
     public abstract double[] getStringBounds(String str, int from, int to,
                                              boolean rtl);
 
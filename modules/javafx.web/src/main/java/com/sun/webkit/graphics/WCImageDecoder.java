@@ -29,12 +29,24 @@ package com.sun.webkit.graphics;
 public abstract class WCImageDecoder {
 
     /**
-     * Receives a portion of image data.
+     * Returns the array to which the next portion of image data is written.
+     * The portion is copied to the array in place, right after the data
+     * received so far, and is then passed to {@link #addImageData}.
      *
-     * @param data  a portion of image data,
-     *              or {@code null} if all data received
+     * @param length  the length of the portion
+     * @return  an array with room for at least {@code length} more bytes,
+     *          or {@code null} if it could not be allocated
      */
-    protected abstract void addImageData(byte[] data);
+    protected abstract byte[] getImageDataArray(int length);
+
+    /**
+     * Receives a portion of image data written to the array returned by
+     * {@link #getImageDataArray}.
+     *
+     * @param length  the length of the portion,
+     *                or {@code -1} if all data received
+     */
+    protected abstract void addImageData(int length);
 
     /**
      * Returns image size.
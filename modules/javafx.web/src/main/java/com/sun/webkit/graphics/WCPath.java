@@ -80,6 +80,15 @@ public abstract class WCPath<P> extends Ref {
 
     public abstract void addPath(WCPath path);
 
+    /**
+     * Replaces the contents of this path with the given segments.
+     * The segment types are {@link WCPathIterator} {@code SEG_*} constants,
+     * each followed by its points in {@code coords}. Called from native code
+     * once per fill, stroke or clip of a modified path.
+     */
+    public abstract void setPath(byte[] types, int numTypes,
+                                 float[] coords, int numCoords);
+
     public abstract void closeSubpath();
 
     public abstract boolean hasCurrentPoint();
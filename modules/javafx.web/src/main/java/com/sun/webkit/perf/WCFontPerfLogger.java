@@ -101,6 +101,13 @@ public final class WCFontPerfLogger extends WCFont {
         return res;
     }
 
+    public float[] getGlyphWidths(int firstGlyph, int count) {
+        logger.resumeCount("GETGLYPHWIDTHS");
+        float[] res = fnt.getGlyphWidths(firstGlyph, count);
+        logger.suspendCount("GETGLYPHWIDTHS");
+        return res;
+    }
+
     public double getStringWidth(String str) {
         logger.resumeCount("GETSTRINGLENGTH");
         double res = fnt.getStringWidth(str);
@@ -332,6 +332,7 @@ SOURCES += \
     parser/SourceCode.cpp \
     parser/SourceProvider.cpp \
     parser/SourceProviderCache.cpp \
+    parser/SourceProviderCacheFile.cpp \
     profiler/ProfilerBytecode.cpp \
     profiler/ProfilerBytecode.h \
     profiler/ProfilerBytecodeSequence.cpp \
@@ -0,0 +1,448 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#include "config.h"
+#include "SourceProviderCacheFile.h"
+
+#include "Identifier.h"
+#include "JSCInlines.h"
+#include "Options.h"
+#include "SourceCode.h"
+#include "SourceProviderCache.h"
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+#include <wtf/HashMap.h>
+#include <wtf/ProcessID.h>
+#include <wtf/SHA1.h>
+#include <wtf/text/CString.h>
+
+#if OS(WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace JSC {
+
+// Smaller programs are parsed faster than their file is read.
+static const unsigned minimumSourceLength = 64 * 1024;
+static const size_t maximumFileSize = 64 * 1024 * 1024;
+
+static const uint32_t fileMagic = 0x4a534346; // 'JSCF'
+static const uint32_t fileVersion = 2;
+
+// The items mirror the parser's scopes, so a file is only read by the version
+// of JavaScriptCore that wrote it, built from the same parser sources, and
+// only if the item and the enums stored in it are laid out as they were when
+// it was written.
+static SHA1::Digest buildID()
+{
+    static SHA1::Digest digest;
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, [] {
+        uint32_t layout[] = {
+            sizeof(SourceProviderCacheItem),
+            sizeof(SourceProviderCacheItemCreationParameters),
+            AllInnerArrowFunctionCodeFeatures,
+            static_cast<uint32_t>(ConstructorKind::Extends),
+            static_cast<uint32_t>(SuperBinding::NotNeeded),
+            LastUntaggedToken,
+            CLOSEBRACE,
+            EOFTOK,
+            ErrorTokenFlag
+        };
+        SHA1 sha1;
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(JAVASCRIPTCORE_VERSION), strlen(JAVASCRIPTCORE_VERSION));
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(JAVASCRIPTCORE_PARSER_SOURCE_ID), strlen(JAVASCRIPTCORE_PARSER_SOURCE_ID));
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(layout), sizeof(layout));
+        sha1.computeHash(digest);
+    });
+    return digest;
+}
+
+// Tokens are stored by value; the error tokens and anything above the flags
+// of the token bitfield are never the end of a cached function.
+static bool isValidTokenType(uint32_t tokenType)
+{
+    return tokenType < (RightAssociativeBinaryOpTokenFlag << 1)
+        && !(tokenType & (ErrorTokenFlag | UnterminatedErrorTokenFlag));
+}
+
+class MappedFile {
+    WTF_MAKE_NONCOPYABLE(MappedFile);
+public:
+    explicit MappedFile(const CString& path)
+    {
+#if OS(WINDOWS)
+        HANDLE file = CreateFileA(path.data(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return;
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && static_cast<uint64_t>(size.QuadPart) <= maximumFileSize) {
+            if (HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+                m_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (m_data)
+                    m_size = static_cast<size_t>(size.QuadPart);
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+#else
+        int fd = open(path.data(), O_RDONLY);
+        if (fd < 0)
+            return;
+        struct stat info;
+        if (!fstat(fd, &info) && info.st_size > 0 && static_cast<uint64_t>(info.st_size) <= maximumFileSize) {
+            void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                m_data = data;
+                m_size = info.st_size;
+            }
+        }
+        close(fd);
+#endif
+    }
+
+    ~MappedFile()
+    {
+        if (!m_data)
+            return;
+#if OS(WINDOWS)
+        UnmapViewOfFile(m_data);
+#else
+        munmap(m_data, m_size);
+#endif
+    }
+
+    const uint8_t* data() const { return static_cast<const uint8_t*>(m_data); }
+    size_t size() const { return m_size; }
+
+private:
+    void* m_data { nullptr };
+    size_t m_size { 0 };
+};
+
+// The file is a sequence of 32 bit words in the byte order of the build:
+//
+//   header:  magic, version, build ID, source digest, source length,
+//            string count, item count
+//   strings: length, is8Bit, characters padded to a word
+//   items:   source position, the fields of the item, used variable count,
+//            used variable string indices
+class FileWriter {
+public:
+    void write(uint32_t value)
+    {
+        m_buffer.append(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+    }
+
+    void writeBytes(const void* bytes, size_t length)
+    {
+        m_buffer.append(static_cast<const uint8_t*>(bytes), length);
+        while (m_buffer.size() % sizeof(uint32_t))
+            m_buffer.append(0);
+    }
+
+    const Vector<uint8_t>& buffer() const { return m_buffer; }
+
+private:
+    Vector<uint8_t> m_buffer;
+};
+
+class FileReader {
+public:
+    FileReader(const uint8_t* data, size_t size)
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    bool read(uint32_t& value)
+    {
+        if (m_size - m_offset < sizeof(value))
+            return false;
+        memcpy(&value, m_data + m_offset, sizeof(value));
+        m_offset += sizeof(value);
+        return true;
+    }
+
+    const uint8_t* readBytes(size_t length)
+    {
+        size_t paddedLength = (length + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1);
+        if (paddedLength < length || m_size - m_offset < paddedLength)
+            return nullptr;
+        const uint8_t* bytes = m_data + m_offset;
+        m_offset += paddedLength;
+        return bytes;
+    }
+
+    bool atEnd() const { return m_offset == m_size; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset { 0 };
+};
+
+bool shouldPersistSourceProviderCache(const SourceCode& source)
+{
+    return Options::sourceProviderCachePath()
+        && Options::useSourceProviderCache()
+        && source.provider()->sourceType() == SourceProviderSourceType::Program
+        && source.length() >= minimumSourceLength;
+}
+
+static SHA1::Digest sourceDigest(const SourceCode& source)
+{
+    // The cached offsets are in the whole provider, and the lines and
+    // columns relative to the start of the source.
+    StringView characters = source.provider()->source();
+    SHA1 sha1;
+    if (characters.is8Bit())
+        sha1.addBytes(characters.characters8(), characters.length());
+    else
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(characters.characters16()), characters.length() * sizeof(UChar));
+    uint32_t position[] = {
+        static_cast<uint32_t>(source.startOffset()),
+        static_cast<uint32_t>(source.endOffset()),
+        static_cast<uint32_t>(source.firstLine().zeroBasedInt()),
+        static_cast<uint32_t>(source.startColumn().zeroBasedInt()),
+        characters.is8Bit()
+    };
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(position), sizeof(position));
+    SHA1::Digest digest;
+    sha1.computeHash(digest);
+    return digest;
+}
+
+static String cacheFilePath(const SHA1::Digest& digest)
+{
+    return String::fromUTF8(Options::sourceProviderCachePath()) + "/" + SHA1::hexDigest(digest).data() + ".jsccache";
+}
+
+static bool readHeader(FileReader& reader, const SHA1::Digest& digest, uint32_t sourceLength)
+{
+    uint32_t magic, version, length;
+    if (!reader.read(magic) || magic != fileMagic
+        || !reader.read(version) || version != fileVersion)
+        return false;
+    SHA1::Digest expectedBuildID = buildID();
+    const uint8_t* fileBuildID = reader.readBytes(expectedBuildID.size());
+    if (!fileBuildID || memcmp(fileBuildID, expectedBuildID.data(), expectedBuildID.size()))
+        return false;
+    const uint8_t* fileDigest = reader.readBytes(digest.size());
+    if (!fileDigest || memcmp(fileDigest, digest.data(), digest.size()))
+        return false;
+    return reader.read(length) && length == sourceLength;
+}
+
+static bool readItem(FileReader& reader, const Vector<Identifier>& strings, uint32_t sourceLength, uint32_t& sourcePosition, SourceProviderCacheItemCreationParameters& parameters)
+{
+    uint32_t needsFullActivation, usesEval, strictMode, needsSuperBinding, innerArrowFunctionFeatures;
+    uint32_t isBodyArrowExpression, tokenType, constructorKind, expectedSuperBinding, usedVariablesCount;
+    if (!reader.read(sourcePosition)
+        || !reader.read(parameters.functionNameStart)
+        || !reader.read(parameters.lastTokenLine)
+        || !reader.read(parameters.lastTokenStartOffset)
+        || !reader.read(parameters.lastTokenEndOffset)
+        || !reader.read(parameters.lastTokenLineStartOffset)
+        || !reader.read(parameters.endFunctionOffset)
+        || !reader.read(parameters.parameterCount)
+        || !reader.read(parameters.functionLength)
+        || !reader.read(needsFullActivation)
+        || !reader.read(usesEval)
+        || !reader.read(strictMode)
+        || !reader.read(needsSuperBinding)
+        || !reader.read(innerArrowFunctionFeatures)
+        || !reader.read(isBodyArrowExpression)
+        || !reader.read(tokenType)
+        || !reader.read(constructorKind)
+        || !reader.read(expectedSuperBinding)
+        || !reader.read(usedVariablesCount))
+        return false;
+
+    // The offsets end up in 31 bit fields and the lexer's position.
+    if (sourcePosition >= sourceLength
+        || parameters.functionNameStart > sourceLength
+        || parameters.lastTokenStartOffset > sourceLength
+        || parameters.lastTokenEndOffset > sourceLength
+        || parameters.lastTokenLineStartOffset > sourceLength
+        || parameters.endFunctionOffset > sourceLength
+        || parameters.lastTokenLine >= 1u << 31
+        || parameters.parameterCount > sourceLength
+        || needsFullActivation > 1 || usesEval > 1 || strictMode > 1 || needsSuperBinding > 1
+        || innerArrowFunctionFeatures > AllInnerArrowFunctionCodeFeatures
+        || isBodyArrowExpression > 1
+        || !isValidTokenType(tokenType)
+        || (!isBodyArrowExpression && tokenType != CLOSEBRACE)
+        || constructorKind > static_cast<uint32_t>(ConstructorKind::Extends)
+        || expectedSuperBinding > static_cast<uint32_t>(SuperBinding::NotNeeded)
+        || usedVariablesCount > strings.size())
+        return false;
+
+    parameters.needsFullActivation = needsFullActivation;
+    parameters.usesEval = usesEval;
+    parameters.strictMode = strictMode;
+    parameters.needsSuperBinding = needsSuperBinding;
+    parameters.innerArrowFunctionFeatures = innerArrowFunctionFeatures;
+    parameters.isBodyArrowExpression = isBodyArrowExpression;
+    parameters.tokenType = static_cast<JSTokenType>(tokenType);
+    parameters.constructorKind = static_cast<ConstructorKind>(constructorKind);
+    parameters.expectedSuperBinding = static_cast<SuperBinding>(expectedSuperBinding);
+    parameters.usedVariables.clear();
+    for (uint32_t i = 0; i < usedVariablesCount; ++i) {
+        uint32_t index;
+        if (!reader.read(index) || index >= strings.size())
+            return false;
+        parameters.usedVariables.append(strings[index].impl());
+    }
+    return true;
+}
+
+unsigned loadSourceProviderCache(VM& vm, const SourceCode& source)
+{
+    ASSERT(shouldPersistSourceProviderCache(source));
+    SHA1::Digest digest = sourceDigest(source);
+    MappedFile file(cacheFilePath(digest).utf8());
+    if (!file.data())
+        return 0;
+
+    uint32_t sourceLength = source.provider()->source().length();
+    FileReader reader(file.data(), file.size());
+    uint32_t stringCount, itemCount;
+    if (!readHeader(reader, digest, sourceLength)
+        || !reader.read(stringCount)
+        || !reader.read(itemCount))
+        return 0;
+
+    Vector<Identifier> strings;
+    for (uint32_t i = 0; i < stringCount; ++i) {
+        uint32_t length, is8Bit;
+        if (!reader.read(length) || !reader.read(is8Bit) || length > sourceLength || is8Bit > 1)
+            return 0;
+        const uint8_t* characters = reader.readBytes(is8Bit ? length : length * sizeof(UChar));
+        if (!characters)
+            return 0;
+        if (is8Bit)
+            strings.append(Identifier::fromString(&vm, reinterpret_cast<const LChar*>(characters), length));
+        else
+            strings.append(Identifier::fromString(&vm, reinterpret_cast<const UChar*>(characters), length));
+    }
+
+    // Nothing is added to the cache unless the whole file is valid.
+    Vector<std::pair<int, std::unique_ptr<SourceProviderCacheItem>>> items;
+    SourceProviderCacheItemCreationParameters parameters;
+    for (uint32_t i = 0; i < itemCount; ++i) {
+        uint32_t sourcePosition;
+        if (!readItem(reader, strings, sourceLength, sourcePosition, parameters))
+            return 0;
+        items.append(std::make_pair(static_cast<int>(sourcePosition), SourceProviderCacheItem::create(parameters)));
+    }
+    if (!reader.atEnd())
+        return 0;
+
+    SourceProviderCache* cache = vm.addSourceProviderCache(source.provider());
+    for (auto& item : items)
+        cache->add(item.first, WTFMove(item.second));
+    return itemCount;
+}
+
+static bool writeFile(const String& filePath, const Vector<uint8_t>& contents)
+{
+    // Written aside and renamed, so that a reader never maps a partial file.
+    // Each write has its own file, as VMs on several threads of the process
+    // can save the same source at once.
+    static std::atomic<unsigned> writeCount;
+    CString path = filePath.utf8();
+    CString temporaryPath = String(filePath + "." + String::number(getCurrentProcessID()) + "." + String::number(++writeCount) + ".tmp").utf8();
+    FILE* file = fopen(temporaryPath.data(), "wb");
+    if (!file)
+        return false;
+    bool written = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    written = !fclose(file) && written;
+#if OS(WINDOWS)
+    written = written && !!MoveFileExA(temporaryPath.data(), path.data(), MOVEFILE_REPLACE_EXISTING);
+#else
+    written = written && !rename(temporaryPath.data(), path.data());
+#endif
+    if (!written)
+        remove(temporaryPath.data());
+    return written;
+}
+
+void saveSourceProviderCache(VM& vm, const SourceCode& source, unsigned loadedCount)
+{
+    ASSERT(shouldPersistSourceProviderCache(source));
+    SourceProviderCache* cache = vm.addSourceProviderCache(source.provider());
+    if (cache->size() <= loadedCount)
+        return;
+
+    Vector<UniquedStringImpl*> strings;
+    HashMap<UniquedStringImpl*, uint32_t> stringIndices;
+    bool hasSymbols = false;
+    cache->forEach([&] (int, const SourceProviderCacheItem& item) {
+        for (unsigned i = 0; i < item.usedVariablesCount; ++i) {
+            UniquedStringImpl* string = item.usedVariables()[i];
+            // Private names of builtins can not be recreated from their text
+            hasSymbols |= string->isSymbol();
+            if (stringIndices.add(string, strings.size()).isNewEntry)
+                strings.append(string);
+        }
+    });
+    if (hasSymbols)
+        return;
+
+    SHA1::Digest digest = sourceDigest(source);
+    FileWriter writer;
+    writer.write(fileMagic);
+    writer.write(fileVersion);
+    SHA1::Digest fileBuildID = buildID();
+    writer.writeBytes(fileBuildID.data(), fileBuildID.size());
+    writer.writeBytes(digest.data(), digest.size());
+    writer.write(source.provider()->source().length());
+    writer.write(strings.size());
+    writer.write(cache->size());
+
+    for (UniquedStringImpl* string : strings) {
+        writer.write(string->length());
+        writer.write(string->is8Bit());
+        if (string->is8Bit())
+            writer.writeBytes(string->characters8(), string->length());
+        else
+            writer.writeBytes(string->characters16(), string->length() * sizeof(UChar));
+    }
+
+    cache->forEach([&] (int sourcePosition, const SourceProviderCacheItem& item) {
+        writer.write(sourcePosition);
+        writer.write(item.functionNameStart);
+        writer.write(item.lastTokenLine);
+        writer.write(item.lastTokenStartOffset);
+        writer.write(item.lastTokenEndOffset);
+        writer.write(item.lastTokenLineStartOffset);
+        writer.write(item.endFunctionOffset);
+        writer.write(item.parameterCount);
+        writer.write(item.functionLength);
+        writer.write(item.needsFullActivation);
+        writer.write(item.usesEval);
+        writer.write(item.strictMode);
+        writer.write(item.needsSuperBinding);
+        writer.write(item.innerArrowFunctionFeatures);
+        writer.write(item.isBodyArrowExpression);
+        writer.write(item.tokenType);
+        writer.write(item.constructorKind);
+        writer.write(item.expectedSuperBinding);
+        writer.write(item.usedVariablesCount);
+        for (unsigned i = 0; i < item.usedVariablesCount; ++i)
+            writer.write(stringIndices.get(item.usedVariables()[i]));
+    });
+
+    if (writer.buffer().size() <= maximumFileSize)
+        writeFile(cacheFilePath(digest), writer.buffer());
+}
+
+} // namespace JSC
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#pragma once
+
+namespace JSC {
+
+class SourceCode;
+class VM;
+
+// The function info the parser keeps in the SourceProviderCache of a large
+// program, persisted under Options::sourceProviderCachePath() so that the
+// next run of the same script can skip the function bodies on its first
+// parse. A file is named after the SHA1 of the source and its position, and
+// is only used if its build ID, source digest, sizes and offsets all check
+// out; otherwise the source is parsed as if there was no file.
+
+// Fills the SourceProviderCache of the provider of the source from its file,
+// returns the number of functions loaded.
+unsigned loadSourceProviderCache(VM&, const SourceCode&);
+
+// Writes the SourceProviderCache of the provider of the source, if it holds
+// more functions than were loaded.
+void saveSourceProviderCache(VM&, const SourceCode&, unsigned loadedCount);
+
+bool shouldPersistSourceProviderCache(const SourceCode&);
+
+} // namespace JSC
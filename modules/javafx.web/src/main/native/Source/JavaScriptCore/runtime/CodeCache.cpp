@@ -27,6 +27,7 @@
 #include "CodeCache.h"
 
 #include "IndirectEvalExecutable.h"
+#include "SourceProviderCacheFile.h"
 
 namespace JSC {
 
@@ -71,12 +72,20 @@ UnlinkedCodeBlockType* CodeCache::getUnlinkedGlobalCodeBlock(VM& vm, ExecutableT
         return unlinkedCodeBlock;
     }
 
+    // The function bodies of a large program parsed by an earlier run are
+    // skipped by its first parse here.
+    bool persistsSourceProviderCache = CacheTypes<UnlinkedCodeBlockType>::codeType == SourceCodeType::ProgramType && shouldPersistSourceProviderCache(source);
+    unsigned loadedFunctionCount = persistsSourceProviderCache ? loadSourceProviderCache(vm, source) : 0;
+
     VariableEnvironment variablesUnderTDZ;
     UnlinkedCodeBlockType* unlinkedCodeBlock = generateUnlinkedCodeBlock<UnlinkedCodeBlockType, ExecutableType>(vm, executable, source, strictMode, scriptMode, debuggerMode, error, evalContextType, &variablesUnderTDZ);
 
     if (unlinkedCodeBlock && Options::useCodeCache())
         m_sourceCode.addCache(key, SourceCodeValue(vm, unlinkedCodeBlock, m_sourceCode.age()));
 
+    if (unlinkedCodeBlock && persistsSourceProviderCache)
+        saveSourceProviderCache(vm, source, loadedFunctionCount);
+
     return unlinkedCodeBlock;
 }
 
@@ -46,6 +46,7 @@ elseif (UNIX)
     list(APPEND WTF_SOURCES
         generic/RunLoopGeneric.cpp
         generic/WorkQueueGeneric.cpp
+        java/RunLoopJava.cpp
         PlatformUserPreferredLanguagesUnix.cpp
     )
     list(APPEND WTF_INCLUDE_DIRECTORIES
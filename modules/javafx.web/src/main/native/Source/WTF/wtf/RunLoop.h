@@ -40,6 +40,10 @@
 #include <wtf/glib/GRefPtr.h>
 #endif
 
+#if PLATFORM(JAVA) && USE(GENERIC_EVENT_LOOP)
+#include <wtf/MonotonicTime.h>
+#endif
+
 namespace WTF {
 
 class RunLoop : public FunctionDispatcher {
@@ -77,6 +81,12 @@ public:
     WTF_EXPORT_PRIVATE void dispatchAfter(std::chrono::nanoseconds, Function<void ()>&&);
 #endif
 
+#if PLATFORM(JAVA) && USE(GENERIC_EVENT_LOOP)
+    // Runs the pending functions and expired timers of the main RunLoop on
+    // the JavaFX thread, see RunLoopJava.cpp.
+    void iterateJava(bool timerFired);
+#endif
+
     class TimerBase {
         friend class RunLoop;
     public:
@@ -190,6 +200,17 @@ private:
     Vector<Status*> m_mainLoops;
     bool m_shutdown { false };
     bool m_pendingTasks { false };
+#if PLATFORM(JAVA)
+    // The main RunLoop is never run(), it is iterated on the JavaFX thread
+    // when functions are dispatched to it or when its earliest timer is due.
+    void scheduleJavaIteration();
+    void scheduleJavaTimer(MonotonicTime);
+    static void setJavaTimer(Seconds delay);
+    Lock m_javaTimerLock;
+    bool m_isJavaMain { false };
+    bool m_javaIterationScheduled { false };
+    MonotonicTime m_javaTimerFireTime { MonotonicTime::infinity() };
+#endif
 #endif
 };
 
@@ -27,6 +27,10 @@
 #include "config.h"
 #include "RunLoop.h"
 
+#if PLATFORM(JAVA)
+#include <wtf/MainThread.h>
+#endif
+
 namespace WTF {
 
 class RunLoop::TimerBase::ScheduledTask : public ThreadSafeRefCounted<ScheduledTask> {
@@ -98,6 +102,9 @@ private:
 };
 
 RunLoop::RunLoop()
+#if PLATFORM(JAVA)
+    : m_isJavaMain(isMainThread())
+#endif
 {
 }
 
@@ -214,8 +221,14 @@ void RunLoop::wakeUp(const LockHolder&)
 
 void RunLoop::wakeUp()
 {
-    LockHolder locker(m_loopLock);
-    wakeUp(locker);
+    {
+        LockHolder locker(m_loopLock);
+        wakeUp(locker);
+    }
+#if PLATFORM(JAVA)
+    if (m_isJavaMain)
+        scheduleJavaIteration();
+#endif
 }
 
 void RunLoop::schedule(const LockHolder&, RefPtr<TimerBase::ScheduledTask>&& task)
@@ -232,6 +245,15 @@ void RunLoop::schedule(RefPtr<TimerBase::ScheduledTask>&& task)
 
 void RunLoop::scheduleAndWakeUp(RefPtr<TimerBase::ScheduledTask> task)
 {
+#if PLATFORM(JAVA)
+    if (m_isJavaMain) {
+        // The JavaFX thread only has to wake up once the task is due.
+        MonotonicTime fireTime = task->scheduledTimePoint();
+        schedule(WTFMove(task));
+        scheduleJavaTimer(fireTime);
+        return;
+    }
+#endif
     LockHolder locker(m_loopLock);
     schedule(locker, WTFMove(task));
     wakeUp(locker);
@@ -239,11 +261,71 @@ void RunLoop::scheduleAndWakeUp(RefPtr<TimerBase::ScheduledTask> task)
 
 void RunLoop::dispatchAfter(std::chrono::nanoseconds delay, Function<void ()>&& function)
 {
-    LockHolder locker(m_loopLock);
     bool repeating = false;
-    schedule(locker, TimerBase::ScheduledTask::create(WTFMove(function), Seconds(delay.count() / 1000.0 / 1000.0 / 1000.0), repeating));
-    wakeUp(locker);
+    scheduleAndWakeUp(TimerBase::ScheduledTask::create(WTFMove(function), Seconds(delay.count() / 1000.0 / 1000.0 / 1000.0), repeating));
+}
+
+#if PLATFORM(JAVA)
+// Both calls below go into Java, so they are made without holding
+// m_loopLock.
+
+void RunLoop::scheduleJavaIteration()
+{
+    {
+        LockHolder locker(m_loopLock);
+        if (m_javaIterationScheduled)
+            return;
+        m_javaIterationScheduled = true;
+    }
+    callOnMainThread([this] {
+        iterateJava(false);
+    });
+}
+
+void RunLoop::scheduleJavaTimer(MonotonicTime fireTime)
+{
+    // A single Java timer is set for the earliest task of m_schedules, so
+    // tasks that are due later do not call into Java at all. The Java
+    // timer is set in the order the fire times were taken.
+    LockHolder javaTimerLocker(m_javaTimerLock);
+    {
+        LockHolder locker(m_loopLock);
+        if (fireTime >= m_javaTimerFireTime)
+            return;
+        m_javaTimerFireTime = fireTime;
+    }
+    setJavaTimer(fireTime - MonotonicTime::now());
+}
+
+void RunLoop::iterateJava(bool timerFired)
+{
+    ASSERT(m_isJavaMain);
+    {
+        LockHolder locker(m_loopLock);
+        if (timerFired)
+            m_javaTimerFireTime = MonotonicTime::infinity();
+        else
+            m_javaIterationScheduled = false;
+    }
+
+    iterate();
+
+    MonotonicTime nextFireTime = MonotonicTime::infinity();
+    {
+        LockHolder locker(m_loopLock);
+        // Stopped timers stay in the heap until they are due, drop them here
+        // so that they do not wake up the JavaFX thread.
+        while (!m_schedules.isEmpty() && !m_schedules.first()->isActive()) {
+            std::pop_heap(m_schedules.begin(), m_schedules.end(), TimerBase::ScheduledTask::EarliestSchedule());
+            m_schedules.removeLast();
+        }
+        if (!m_schedules.isEmpty())
+            nextFireTime = m_schedules.first()->scheduledTimePoint();
+    }
+    if (nextFireTime != MonotonicTime::infinity())
+        scheduleJavaTimer(nextFireTime);
 }
+#endif
 
 // Since RunLoop does not own the registered TimerBase,
 // TimerBase and its owner should manage these lifetime.
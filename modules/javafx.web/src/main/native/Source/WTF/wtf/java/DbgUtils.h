@@ -330,6 +330,12 @@ struct SSizeCounterLogger {\
 #define LOG_COMMON_SIZE_ADD(size)    __lSizeCount__.add((LONG)size);
 #define LOG_COMMON_SIZE_REMOVE(size) __lSizeCount__.remove((LONG)size);
 
+#define LOG_POOL_STATISTICS(T, stat) \
+    DBG::snTrace(L"=" L#T L" Allocated:%d Reused:%d Discarded:%d Pooled:%d/%d Live:%d/%d" \
+        , int((stat).allocated), int((stat).reused), int((stat).discarded) \
+        , int((stat).pooledBytes), int((stat).pooledBytesHighWater) \
+        , int((stat).liveBytes), int((stat).liveBytesHighWater));
+
 #else //WIN32 & debug
 
 #define DBG_CHECKPOINT(a1, a2)
@@ -338,6 +344,7 @@ struct SSizeCounterLogger {\
 #define LOG_COMMON_SIZE(T)
 #define LOG_COMMON_SIZE_ADD(size)
 #define LOG_COMMON_SIZE_REMOVE(size)
+#define LOG_POOL_STATISTICS(T, stat)
 
 #endif//WIN32 & debug
 
@@ -346,11 +353,13 @@ struct SSizeCounterLogger {\
 #define RQ_LOG_COMMON_SIZE(T) LOG_COMMON_SIZE(T)
 #define RQ_LOG_COMMON_SIZE_ADD(size) LOG_COMMON_SIZE_ADD(size)
 #define RQ_LOG_COMMON_SIZE_REMOVE(size) LOG_COMMON_SIZE_REMOVE(size)
+#define RQ_LOG_POOL_STATISTICS(T, stat) LOG_POOL_STATISTICS(T, stat)
 #else
 #define RQ_LOG_INSTANCE_COUNT(T)
 #define RQ_LOG_COMMON_SIZE(T)
 #define RQ_LOG_COMMON_SIZE_ADD(size)
 #define RQ_LOG_COMMON_SIZE_REMOVE(size)
+#define RQ_LOG_POOL_STATISTICS(T, stat)
 #endif
 
 #endif//_DBGUTILS_H
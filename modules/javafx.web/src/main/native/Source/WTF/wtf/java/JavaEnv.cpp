@@ -26,7 +26,9 @@
 #include <wtf/java/JavaEnv.h>
 
 #include <wtf/Assertions.h>
+#include <wtf/ThreadSpecific.h>
 
+#include <atomic>
 
 JavaVM* jvm = 0;
 
@@ -264,6 +266,71 @@ bool PL_IsEnabled(JNIEnv* env, jobject perfLogger)
 
 } // namespace WebCore
 
+namespace WTF {
+
+static std::atomic<unsigned> javaThreadAttaches;
+static std::atomic<unsigned> javaThreadDetaches;
+
+// The attachment of a native thread to the JVM, made the first time the
+// thread needs a JNIEnv and undone when the thread exits. Threads that were
+// attached by someone else are left alone. The Java threads of attached
+// threads are named, so that they can be told apart in thread dumps.
+class JavaThreadAttachment {
+public:
+    JNIEnv* env()
+    {
+        if (m_env) {
+            return m_env;
+        }
+        JNIEnv* env = nullptr;
+        if (jvm->GetEnv((void**)&env, JNI_VERSION_1_2) == JNI_EDETACHED) {
+            JavaVMAttachArgs args = { JNI_VERSION_1_2, const_cast<char*>("WebKit-Native-Thread"), nullptr };
+            if (jvm->AttachCurrentThreadAsDaemon((void**)&env, &args) != JNI_OK) {
+                return nullptr;
+            }
+            ++javaThreadAttaches;
+            m_env = env;
+        }
+        return env;
+    }
+
+    ~JavaThreadAttachment()
+    {
+        if (m_env && jvm) {
+            jvm->DetachCurrentThread();
+            ++javaThreadDetaches;
+        }
+    }
+
+private:
+    JNIEnv* m_env { nullptr };
+};
+
+static ThreadSpecific<JavaThreadAttachment, CanBeGCThread::True>& javaThreadAttachment()
+{
+    // Never destroyed, see ThreadSpecific
+    static ThreadSpecific<JavaThreadAttachment, CanBeGCThread::True>* attachment =
+        new ThreadSpecific<JavaThreadAttachment, CanBeGCThread::True>();
+    return *attachment;
+}
+
+JNIEnv* attachCurrentThreadToJava()
+{
+    return javaThreadAttachment()->env();
+}
+
+unsigned javaThreadAttachCount()
+{
+    return javaThreadAttaches;
+}
+
+unsigned javaThreadDetachCount()
+{
+    return javaThreadDetaches;
+}
+
+} // namespace WTF
+
 extern "C" {
 
 #if PLATFORM(JAVA_WIN) && !defined(NDEBUG)
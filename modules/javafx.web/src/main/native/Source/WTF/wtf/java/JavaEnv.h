@@ -102,32 +102,25 @@ struct EntryJavaLogger
 } // namespace WebCore
 
 namespace WTF {
+// Attaches the current thread to the JVM as a daemon thread, unless it is
+// already attached. The thread then stays attached, with its JNIEnv cached,
+// until it exits.
+JNIEnv* attachCurrentThreadToJava();
+
+// Number of threads attached and detached by attachCurrentThreadToJava()
+unsigned javaThreadAttachCount();
+unsigned javaThreadDetachCount();
+
 class AutoAttachToJavaThread {
 public:
-    AutoAttachToJavaThread(bool daemon = false)
-    {
-        m_status = jvm->GetEnv((void **)&m_env, JNI_VERSION_1_2);
-        if (m_status == JNI_EDETACHED) {
-            if (daemon) {
-                jvm->AttachCurrentThreadAsDaemon((void **)&m_env, nullptr);
-            } else {
-                jvm->AttachCurrentThread((void **)&m_env, nullptr);
-            }
-        }
-    }
-
-    ~AutoAttachToJavaThread()
+    AutoAttachToJavaThread()
+        : m_env(attachCurrentThreadToJava())
     {
-        if (m_status == JNI_EDETACHED) {
-            jvm->DetachCurrentThread();
-        }
     }
 
     JNIEnv* env() { return m_env; }
 private:
     JNIEnv* m_env;
-    int m_status;
-
 };
 } // namespace
 
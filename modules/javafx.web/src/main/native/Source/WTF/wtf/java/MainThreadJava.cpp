@@ -6,6 +6,11 @@
 #include <wtf/java/JavaEnv.h>
 #include <wtf/java/JavaRef.h>
 #include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/RunLoop.h>
+#include <wtf/Threading.h>
+
+#include <atomic>
 
 namespace WTF {
 void scheduleDispatchFunctionsOnMainThread()
@@ -29,6 +34,36 @@ void initializeMainThreadPlatform()
 {
 }
 
+// See MainThread.twkStartRunLoopTest. Callbacks only count when they run on
+// the main thread.
+static std::atomic<int> runLoopTestTimersFired;
+static std::atomic<int> runLoopTestFunctionsRun;
+
+class RunLoopTestTimer {
+public:
+    RunLoopTestTimer()
+        : m_timer(RunLoop::main(), this, &RunLoopTestTimer::fired)
+    {
+    }
+
+    void start(double interval) { m_timer.startOneShot(interval); }
+
+private:
+    void fired()
+    {
+        if (isMainThread())
+            ++runLoopTestTimersFired;
+    }
+
+    RunLoop::Timer<RunLoopTestTimer> m_timer;
+};
+
+static Vector<std::unique_ptr<RunLoopTestTimer>>& runLoopTestTimers()
+{
+    static NeverDestroyed<Vector<std::unique_ptr<RunLoopTestTimer>>> timers;
+    return timers;
+}
+
 extern "C" {
 
 /*
@@ -41,6 +76,98 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_MainThread_twkScheduleDispatchFunctio
 {
     dispatchFunctionsFromMainThread();
 }
+
+/*
+ * Class:     com_sun_webkit_MainThread
+ * Method:    twkGetJavaThreadAttachCount
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_com_sun_webkit_MainThread_twkGetJavaThreadAttachCount
+  (JNIEnv*, jclass)
+{
+    return javaThreadAttachCount();
+}
+
+/*
+ * Class:     com_sun_webkit_MainThread
+ * Method:    twkGetJavaThreadDetachCount
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_com_sun_webkit_MainThread_twkGetJavaThreadDetachCount
+  (JNIEnv*, jclass)
+{
+    return javaThreadDetachCount();
+}
+
+/*
+ * Class:     com_sun_webkit_MainThread
+ * Method:    twkScheduleDispatchFunctionsFromNewThread
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_webkit_MainThread_twkScheduleDispatchFunctionsFromNewThread
+  (JNIEnv*, jclass, jint count)
+{
+    // Calls into Java from a native thread that is not attached yet, and
+    // returns once that thread has exited
+    ThreadIdentifier thread = createThread("WebKit-Dispatch-Test", [count] {
+        for (jint i = 0; i < count; i++) {
+            scheduleDispatchFunctionsOnMainThread();
+        }
+    });
+    waitForThreadCompletion(thread);
+}
+
+/*
+ * Class:     com_sun_webkit_MainThread
+ * Method:    twkStartRunLoopTest
+ * Signature: (IJ)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_webkit_MainThread_twkStartRunLoopTest
+  (JNIEnv*, jclass, jint count, jlong delayMillis)
+{
+    runLoopTestTimersFired = 0;
+    runLoopTestFunctionsRun = 0;
+    runLoopTestTimers().clear();
+
+    // Timers due at different times, started in reverse order
+    for (jint i = count; i > 0; i--) {
+        auto timer = std::make_unique<RunLoopTestTimer>();
+        timer->start(delayMillis * i / (1000.0 * count));
+        runLoopTestTimers().append(WTFMove(timer));
+    }
+
+    ThreadIdentifier thread = createThread("WebKit-RunLoop-Test", [count] {
+        for (jint i = 0; i < count; i++) {
+            RunLoop::main().dispatch([] {
+                if (isMainThread())
+                    ++runLoopTestFunctionsRun;
+            });
+        }
+    });
+    waitForThreadCompletion(thread);
+}
+
+/*
+ * Class:     com_sun_webkit_MainThread
+ * Method:    twkGetRunLoopTestTimersFired
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_com_sun_webkit_MainThread_twkGetRunLoopTestTimersFired
+  (JNIEnv*, jclass)
+{
+    return runLoopTestTimersFired;
+}
+
+/*
+ * Class:     com_sun_webkit_MainThread
+ * Method:    twkGetRunLoopTestFunctionsRun
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_com_sun_webkit_MainThread_twkGetRunLoopTestFunctionsRun
+  (JNIEnv*, jclass)
+{
+    return runLoopTestFunctionsRun;
+}
 }
 
 } // namespace WTF
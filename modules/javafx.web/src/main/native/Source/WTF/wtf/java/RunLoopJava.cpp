@@ -1,45 +1,57 @@
 /*
- * Copyright (c) 2015, 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2017, Oracle and/or its affiliates. All rights reserved.
  */
 
 #include "config.h"
 #include "RunLoop.h"
 
-namespace WTF {
-
-// JDK-8146878
-//XXX: implement these stubs?
-
-RunLoop::RunLoop() {}
-RunLoop::~RunLoop() {}
+#include <cmath>
+#include <wtf/java/JavaEnv.h>
+#include <wtf/java/JavaRef.h>
 
-void RunLoop::TimerBase::fired() {}
+// The main RunLoop of the generic event loop is not run() by the JavaFX
+// thread. RunLoopGeneric.cpp iterates it there instead, through
+// callOnMainThread() when functions are dispatched to it and through the
+// timer set below when its earliest timer is due.
 
-void RunLoop::run() {}
-void RunLoop::stop() {}
-void RunLoop::wakeUp() {}
+namespace WTF {
 
-RunLoop::TimerBase::TimerBase(RunLoop& runLoop)
-    : m_runLoop(runLoop)
+static jclass getMainThreadClass(JNIEnv* env)
 {
+    static JGClass jMainThreadCls(env->FindClass("com/sun/webkit/MainThread"));
+    ASSERT(jMainThreadCls);
+    return jMainThreadCls;
 }
 
-RunLoop::TimerBase::~TimerBase()
+void RunLoop::setJavaTimer(Seconds delay)
 {
-    stop();
+    AutoAttachToJavaThread autoAttach;
+    JNIEnv* env = autoAttach.env();
+
+    static jmethodID mid = env->GetStaticMethodID(
+            getMainThreadClass(env),
+            "fwkSetRunLoopTimer",
+            "(J)V");
+    ASSERT(mid);
+
+    jlong delayMillis = static_cast<jlong>(std::ceil(delay.milliseconds()));
+    env->CallStaticVoidMethod(getMainThreadClass(env), mid, std::max<jlong>(delayMillis, 0));
+    CheckAndClearException(env);
 }
 
-void RunLoop::TimerBase::start(double fireInterval, bool repeat)
-{
-}
+extern "C" {
 
-void RunLoop::TimerBase::stop()
+/*
+ * Class:     com_sun_webkit_MainThread
+ * Method:    twkFireRunLoopTimer
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_com_sun_webkit_MainThread_twkFireRunLoopTimer
+  (JNIEnv*, jclass)
 {
+    RunLoop::main().iterateJava(true);
 }
 
-bool RunLoop::TimerBase::isActive() const
-{
-  return true;
 }
 
 } // namespace WTF
@@ -3,11 +3,112 @@
  */
 #include "config.h"
 
+#include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
 #include <wtf/Vector.h>
+#include <wtf/java/JavaEnv.h>
 #include <wtf/text/WTFString.h>
 
+#if CPU(X86_SSE2)
+#include <emmintrin.h>
+#endif
+
 namespace WTF {
 
+// Widens latin1 chars to unicode, 16 chars at a time where SSE2 is available.
+static void copyJCharsFromLCharSource(jchar* destination, const LChar* source, unsigned length)
+{
+    unsigned i = 0;
+#if CPU(X86_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), _mm_unpacklo_epi8(chars, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i + 8]), _mm_unpackhi_epi8(chars, zero));
+    }
+#endif
+    for (; i < length; i++) {
+        destination[i] = source[i];
+    }
+}
+
+static JLString createJavaString(JNIEnv* env, const StringImpl& impl)
+{
+    const unsigned len = impl.length();
+    if (impl.is8Bit()) {
+        Vector<jchar, 256> jchars(len);
+        copyJCharsFromLCharSource(jchars.data(), impl.characters8(), len);
+        return env->NewString(jchars.data(), len);
+    }
+    return env->NewString(reinterpret_cast<const jchar*>(impl.characters16()), len);
+}
+
+// Java strings created for atomic strings (tag, attribute and event names
+// mostly), which the DOM bindings convert over and over again. The entries
+// keep their StringImpl alive, so a key can not be reused by another string
+// while it is cached. Only used on the main thread.
+class AtomStringCache {
+public:
+    static const unsigned capacity = 64;
+    static const unsigned maxLength = 128;
+
+    JLString get(JNIEnv* env, StringImpl& impl)
+    {
+        for (unsigned i = 0; i < m_size; i++) {
+            if (m_entries[i].impl == &impl) {
+                Entry entry = m_entries[i];
+                moveDown(i);
+                m_entries[0] = entry;
+                return static_cast<jstring>(env->NewLocalRef(entry.string));
+            }
+        }
+
+        JLString string(createJavaString(env, impl));
+        jstring global = string ? static_cast<jstring>(env->NewGlobalRef(string)) : NULL;
+        if (!global) {
+            return string;
+        }
+        if (m_size == capacity) {
+            Entry& last = m_entries[--m_size];
+            last.impl->deref();
+            env->DeleteGlobalRef(last.string);
+        }
+        moveDown(m_size++);
+        impl.ref();
+        m_entries[0] = { &impl, global };
+        return string;
+    }
+
+private:
+    struct Entry {
+        StringImpl* impl;
+        jstring string;
+    };
+
+    void moveDown(unsigned count)
+    {
+        for (unsigned i = count; i > 0; i--) {
+            m_entries[i] = m_entries[i - 1];
+        }
+    }
+
+    Entry m_entries[capacity];
+    unsigned m_size { 0 };
+};
+
+static AtomStringCache& atomStringCache()
+{
+    static NeverDestroyed<AtomStringCache> cache;
+    return cache;
+}
+
+static jclass getNativeTextClass(JNIEnv* env)
+{
+    static JGClass jNativeTextCls(env->FindClass("com/sun/webkit/NativeText"));
+    ASSERT(jNativeTextCls);
+    return jNativeTextCls;
+}
+
 // String conversions
 String::String(JNIEnv* env, const JLString &s)
 {
@@ -18,13 +119,12 @@ String::String(JNIEnv* env, const JLString &s)
         if (!len) {
             m_impl = StringImpl::empty();
         } else {
-            const jchar* str = env->GetStringCritical(s, NULL);
-            if (str) {
-                m_impl = StringImpl::create((const UChar*)str, len);
-                env->ReleaseStringCritical(s, str);
-            } else {
-                m_impl = StringImpl::create(reinterpret_cast<const UChar*>(L"OME"), 3);
-            }
+            // Copy straight into the new StringImpl rather than through
+            // GetStringCritical(), which has to inflate compact strings
+            // into a temporary buffer anyway.
+            UChar* data;
+            m_impl = StringImpl::createUninitialized(len, data);
+            env->GetStringRegion(s, 0, len, reinterpret_cast<jchar*>(data));
         }
     }
 }
@@ -33,19 +133,67 @@ JLString String::toJavaString(JNIEnv *env) const
 {
     if (isNull()) {
         return NULL;
+    } else if (m_impl->isAtomic() && length() <= AtomStringCache::maxLength && isMainThread()) {
+        return atomStringCache().get(env, *m_impl);
     } else {
-        const unsigned len = length();
-        if (is8Bit()) {
-            // Convert latin1 chars to unicode.
-            Vector<jchar> jchars(len);
-            for (unsigned i = 0; i < len; i++) {
-                jchars[i] = at(i);
-            }
-            return env->NewString(jchars.data(), len);
-        } else {
-            return env->NewString((jchar*)characters16(), len);
-        }
+        return createJavaString(env, *m_impl);
+    }
+}
+
+JLObject String::toJavaNativeText(JNIEnv* env) const
+{
+    if (isNull()) {
+        return NULL;
     }
+
+    static jmethodID mid = env->GetStaticMethodID(
+            getNativeTextClass(env),
+            "fwkCreate",
+            "(Ljava/nio/ByteBuffer;ZJ)Lcom/sun/webkit/NativeText;");
+    ASSERT(mid);
+
+    // The buffer is a view of the characters of the StringImpl, which is
+    // released by NativeText once the buffer is unreachable.
+    StringImpl* impl = m_impl.get();
+    void* data = impl->is8Bit()
+        ? (void*)impl->characters8()
+        : (void*)impl->characters16();
+    jlong capacity = impl->is8Bit()
+        ? impl->length()
+        : impl->length() * sizeof(UChar);
+    JLObject buffer(env->NewDirectByteBuffer(data, capacity));
+    if (CheckAndClearException(env) || !buffer) {
+        return NULL;
+    }
+
+    impl->ref();
+    JLObject text(env->CallStaticObjectMethod(
+            getNativeTextClass(env),
+            mid,
+            (jobject)buffer,
+            bool_to_jbool(impl->is8Bit()),
+            ptr_to_jlong(impl)));
+    // On failure the StringImpl is leaked, as it may already be owned by
+    // the disposer of the buffer.
+    if (CheckAndClearException(env)) {
+        return NULL;
+    }
+    return text;
+}
+
+extern "C" {
+
+/*
+ * Class:     com_sun_webkit_NativeText
+ * Method:    twkRelease
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_webkit_NativeText_twkRelease
+  (JNIEnv*, jclass, jlong pImpl)
+{
+    static_cast<StringImpl*>(jlong_to_ptr(pImpl))->deref();
+}
+
 }
 
 } // namespace WTF
@@ -428,6 +428,8 @@ public:
 #if PLATFORM(JAVA)
     WTF_EXPORT_STRING_API String(JNIEnv*, const JLString &);
     WTF_EXPORT_STRING_API JLString toJavaString(JNIEnv*) const;
+    // Returns a com.sun.webkit.NativeText viewing the characters in place.
+    WTF_EXPORT_STRING_API JLObject toJavaNativeText(JNIEnv*) const;
     WTF_EXPORT_STRING_API static String fromJavaString(JNIEnv *, jstring);
 #endif
 
@@ -98,6 +98,7 @@ list(APPEND WebCore_SOURCES
     platform/java/SoundJava.cpp
     platform/java/StringJava.cpp
     platform/java/TemporaryLinkStubsJava.cpp
+    platform/java/TiledBackingStoreJava.cpp
     platform/java/TouchEventJava.cpp
     platform/java/WebPage.cpp
     platform/java/WheelEventJava.cpp
@@ -112,6 +113,7 @@ list(APPEND WebCore_SOURCES
     platform/graphics/java/FontCascadeJava.cpp
     platform/graphics/java/FontJava.cpp
     platform/graphics/java/FontPlatformDataJava.cpp
+    platform/graphics/java/GlyphCacheJava.cpp
     platform/graphics/java/GlyphPageTreeNodeJava.cpp
     platform/graphics/java/GraphicsContextJava.cpp
     platform/graphics/java/IconJava.cpp
@@ -122,6 +124,7 @@ list(APPEND WebCore_SOURCES
     platform/graphics/java/NativeImageJava.cpp
     html/shadow/MediaControlsApple.cpp
     platform/graphics/java/PathJava.cpp
+    platform/graphics/java/PathRecorderJava.cpp
     platform/graphics/java/RenderingQueue.cpp
     platform/graphics/java/RQRef.cpp
 
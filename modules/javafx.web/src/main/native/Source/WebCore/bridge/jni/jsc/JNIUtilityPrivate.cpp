@@ -253,87 +253,87 @@ jvalue convertValueToJValue(ExecState* exec, RootObject* rootObject, JSValue val
     return result;
 }
 
+// The class and valueOf() method used to box a primitive of the given type.
+struct BoxingMethod {
+    const char* className;
+    const char* valueOfSignature;
+    const char* unboxName;
+    const char* unboxSignature;
+};
+
+static const BoxingMethod* boxingMethodFor(JavaType jtype)
+{
+    static const BoxingMethod boolean = { "java/lang/Boolean", "(Z)Ljava/lang/Boolean;", "booleanValue", "()Z" };
+    static const BoxingMethod character = { "java/lang/Character", "(C)Ljava/lang/Character;", "charValue", "()C" };
+    static const BoxingMethod byte = { "java/lang/Byte", "(B)Ljava/lang/Byte;", "byteValue", "()B" };
+    static const BoxingMethod shortInt = { "java/lang/Short", "(S)Ljava/lang/Short;", "shortValue", "()S" };
+    static const BoxingMethod integer = { "java/lang/Integer", "(I)Ljava/lang/Integer;", "intValue", "()I" };
+    static const BoxingMethod longInt = { "java/lang/Long", "(J)Ljava/lang/Long;", "longValue", "()J" };
+    static const BoxingMethod floatingPoint = { "java/lang/Float", "(F)Ljava/lang/Float;", "floatValue", "()F" };
+    static const BoxingMethod doublePrecision = { "java/lang/Double", "(D)Ljava/lang/Double;", "doubleValue", "()D" };
+
+    switch (jtype) {
+    case JavaTypeBoolean: return &boolean;
+    case JavaTypeChar: return &character;
+    case JavaTypeByte: return &byte;
+    case JavaTypeShort: return &shortInt;
+    case JavaTypeInt: return &integer;
+    case JavaTypeLong: return &longInt;
+    case JavaTypeFloat: return &floatingPoint;
+    case JavaTypeDouble: return &doublePrecision;
+    default: return nullptr;
+    }
+}
+
+// Class and method IDs for boxing and unboxing the primitive types, indexed
+// by JavaType and looked up once.
+struct BoxingIDs {
+    JGClass cls;
+    jmethodID valueOf;
+    jmethodID unbox;
+};
+
+static const BoxingIDs& boxingIDsFor(JNIEnv* env, JavaType jtype)
+{
+    static BoxingIDs ids[JavaTypeDouble + 1];
+    BoxingIDs& entry = ids[jtype];
+    if (!entry.cls) {
+        const BoxingMethod* method = boxingMethodFor(jtype);
+        ASSERT(method);
+        JLClass cls(env->FindClass(method->className));
+        entry.valueOf = env->GetStaticMethodID(cls, "valueOf", method->valueOfSignature);
+        entry.unbox = env->GetMethodID(cls, method->unboxName, method->unboxSignature);
+        entry.cls = cls;
+    }
+    return entry;
+}
+
 jobject jvalueToJObject(jvalue value, JavaType jtype) {
-    JNIEnv* env = getJNIEnv();
-    jmethodID meth;
     switch (jtype) {
     case JavaTypeObject:
     case JavaTypeArray:
         return value.l;
-    case JavaTypeBoolean: {
-      static JGClass clsZ(env->FindClass("java/lang/Boolean"));
-      meth = env->GetStaticMethodID(clsZ, "valueOf", "(Z)Ljava/lang/Boolean;");
-      return env->CallStaticObjectMethod(clsZ, meth, value.z);
-    }
-    case JavaTypeChar: {
-      static JGClass clsC(env->FindClass("java/lang/Character"));
-      meth = env->GetStaticMethodID(clsC, "valueOf",
-                                    "(C)Ljava/lang/Character;");
-      return env->CallStaticObjectMethod(clsC, meth, value.c);
-    }
-    case JavaTypeByte: {
-      static JGClass clsB(env->FindClass("java/lang/Byte"));
-      meth = env->GetStaticMethodID(clsB, "valueOf", "(B)Ljava/lang/Byte;");
-      return env->CallStaticObjectMethod(clsB, meth, value.b);
-    }
-    case JavaTypeShort: {
-      static JGClass clsS(env->FindClass("java/lang/Short"));
-      meth = env->GetStaticMethodID(clsS, "valueOf", "(S)Ljava/lang/Short;");
-      return env->CallStaticObjectMethod(clsS, meth, value.s);
-    }
-    case JavaTypeInt: {
-      static JGClass clsI(env->FindClass("java/lang/Integer"));
-      meth = env->GetStaticMethodID(clsI, "valueOf", "(I)Ljava/lang/Integer;");
-      return env->CallStaticObjectMethod(clsI, meth, value.i);
-    }
-    case JavaTypeLong: {
-      static JGClass clsJ(env->FindClass("java/lang/Long"));
-      meth = env->GetStaticMethodID(clsJ, "valueOf", "(J)Ljava/lang/Long;");
-      return env->CallStaticObjectMethod(clsJ, meth, value.j);
-    }
-    case JavaTypeFloat: {
-      static JGClass clsF(env->FindClass("java/lang/Float"));
-      meth = env->GetStaticMethodID(clsF, "valueOf", "(F)Ljava/lang/Float;");
-      return env->CallStaticObjectMethod(clsF, meth, value.f);
-    }
+    case JavaTypeBoolean:
+    case JavaTypeChar:
+    case JavaTypeByte:
+    case JavaTypeShort:
+    case JavaTypeInt:
+    case JavaTypeLong:
+    case JavaTypeFloat:
     case JavaTypeDouble: {
-      static JGClass clsD(env->FindClass("java/lang/Double"));
-      meth = env->GetStaticMethodID(clsD, "valueOf", "(D)Ljava/lang/Double;");
-      return env->CallStaticObjectMethod(clsD, meth, value.d);
+        JNIEnv* env = getJNIEnv();
+        const BoxingIDs& ids = boxingIDsFor(env, jtype);
+        return env->CallStaticObjectMethodA(ids.cls, ids.valueOf, &value);
     }
     default:
         abort();
     }
 }
 
-jthrowable dispatchJNICall(int count, RootObject*, jobject obj, bool isStatic, JavaType returnType, jmethodID methodId, jobject* args, jvalue& result, jobject accessControlContext) {
-
-    // Since obj is WeakGlobalRef, creating a localref to safeguard instance() from GC
-    JLObject jlinstance(obj, true);
-
-    if (!jlinstance) {
-        LOG_ERROR("Could not get javaInstance for %p in JNIUtilityPrivate::dispatchJNICall", (jobject)jlinstance);
-        return NULL;
-    }
-
-    JNIEnv* env = getJNIEnv();
-    jclass objClass = env->GetObjectClass(obj);
-    jobject rmethod = env->ToReflectedMethod(objClass, methodId, isStatic);
-    jclass utilityCls = env->FindClass("com/sun/webkit/Utilities");
-    jclass objectCls = env->FindClass("java/lang/Object");
-    jobjectArray argsArray = env->NewObjectArray(count, objectCls, NULL);
-    for (int i = 0;  i < count; i++)
-      env->SetObjectArrayElement(argsArray, i, args[i]);
-    jmethodID invokeMethod =
-        env->GetStaticMethodID(utilityCls, "fwkInvokeWithContext",
-                               "(Ljava/lang/reflect/Method;Ljava/lang/Object;[Ljava/lang/Object;Ljava/security/AccessControlContext;)Ljava/lang/Object;");
-    jobject r = env->CallStaticObjectMethod(utilityCls, invokeMethod,
-                                            rmethod, obj, argsArray,
-                                            accessControlContext);
-
-    jthrowable ex = env->ExceptionOccurred();
-    env->ExceptionClear();
-
+// Stores the value returned by Utilities.fwkInvokeWithContext in result,
+// unboxing it according to the return type of the method.
+static void storeResult(JNIEnv* env, jobject r, JavaType returnType, jvalue& result)
+{
     switch (returnType) {
     case JavaTypeVoid:
         {
@@ -348,38 +348,113 @@ jthrowable dispatchJNICall(int count, RootObject*, jobject obj, bool isStatic, J
         break;
 
     case JavaTypeBoolean:
-        result.z = callJNIMethod<jboolean>(r, "booleanValue", "()Z");
+        result.z = r ? env->CallBooleanMethod(r, boxingIDsFor(env, returnType).unbox) : JNI_FALSE;
         break;
 
     case JavaTypeByte:
-        result.b = callJNIMethod<jbyte>(r, "byteValue", "()B");
+        result.b = r ? env->CallByteMethod(r, boxingIDsFor(env, returnType).unbox) : 0;
         break;
 
     case JavaTypeShort:
-        result.s = callJNIMethod<jshort>(r, "shortValue", "()S");
+        result.s = r ? env->CallShortMethod(r, boxingIDsFor(env, returnType).unbox) : 0;
         break;
 
     case JavaTypeInt:
-        result.i = callJNIMethod<jint>(r, "intValue", "()I");
+        result.i = r ? env->CallIntMethod(r, boxingIDsFor(env, returnType).unbox) : 0;
         break;
 
     case JavaTypeLong:
-        result.j = callJNIMethod<jlong>(r, "longValue", "()J");
+        result.j = r ? env->CallLongMethod(r, boxingIDsFor(env, returnType).unbox) : 0;
         break;
 
     case JavaTypeFloat:
-        result.f = callJNIMethod<jfloat>(r, "floatValue", "()F");
+        result.f = r ? env->CallFloatMethod(r, boxingIDsFor(env, returnType).unbox) : 0;
         break;
 
     case JavaTypeDouble:
-        result.d = callJNIMethod<jdouble>(r, "doubleValue", "()D");
+        result.d = r ? env->CallDoubleMethod(r, boxingIDsFor(env, returnType).unbox) : 0;
         break;
 
     case JavaTypeInvalid:
         /* Nothing to do */
         break;
     }
-    return ex;
+    if (r && returnType != JavaTypeArray && returnType != JavaTypeObject && returnType != JavaTypeChar)
+        env->DeleteLocalRef(r);
+}
+
+// Calls Utilities.fwkInvokeWithContext, which invokes the reflected method
+// with the access control context of the page, and returns the exception
+// it threw, if any.
+static jthrowable invokeWithContext(JNIEnv* env, jobject reflectedMethod, jobject obj, jobjectArray argsArray, JavaType returnType, jvalue& result, jobject accessControlContext)
+{
+    static JGClass utilityCls(env->FindClass("com/sun/webkit/Utilities"));
+    static jmethodID invokeMethod =
+        env->GetStaticMethodID(utilityCls, "fwkInvokeWithContext",
+                               "(Ljava/lang/reflect/Method;Ljava/lang/Object;[Ljava/lang/Object;Ljava/security/AccessControlContext;)Ljava/lang/Object;");
+    ASSERT(invokeMethod);
+
+    jobject r = env->CallStaticObjectMethod(utilityCls, invokeMethod,
+                                            reflectedMethod, obj, argsArray,
+                                            accessControlContext);
+
+    jthrowable ex = env->ExceptionOccurred();
+    env->ExceptionClear();
+    if (ex)
+        return ex;
+
+    storeResult(env, r, returnType, result);
+    return nullptr;
+}
+
+static jclass objectClass(JNIEnv* env)
+{
+    static JGClass objectCls(env->FindClass("java/lang/Object"));
+    return objectCls;
+}
+
+jthrowable dispatchJNICall(int count, RootObject*, jobject obj, bool isStatic, JavaType returnType, jmethodID methodId, jobject* args, jvalue& result, jobject accessControlContext) {
+
+    // Since obj is WeakGlobalRef, creating a localref to safeguard instance() from GC
+    JLObject jlinstance(obj, true);
+
+    if (!jlinstance) {
+        LOG_ERROR("Could not get javaInstance for %p in JNIUtilityPrivate::dispatchJNICall", (jobject)jlinstance);
+        return NULL;
+    }
+
+    JNIEnv* env = getJNIEnv();
+    JLClass objClass(env->GetObjectClass(obj));
+    JLObject rmethod(env->ToReflectedMethod(objClass, methodId, isStatic));
+    JLObjectArray argsArray(env->NewObjectArray(count, objectClass(env), NULL));
+    for (int i = 0;  i < count; i++)
+      env->SetObjectArrayElement(argsArray, i, args[i]);
+
+    return invokeWithContext(env, rmethod, obj, argsArray, returnType, result, accessControlContext);
+}
+
+jthrowable dispatchJNICall(RootObject*, jobject obj, jobject reflectedMethod, JavaType returnType, int count, const jvalue* args, const JavaType* argTypes, jvalue& result, jobject accessControlContext)
+{
+    // Since obj is WeakGlobalRef, creating a localref to safeguard instance() from GC
+    JLObject jlinstance(obj, true);
+
+    if (!jlinstance) {
+        LOG_ERROR("Could not get javaInstance for %p in JNIUtilityPrivate::dispatchJNICall", (jobject)jlinstance);
+        return NULL;
+    }
+
+    JNIEnv* env = getJNIEnv();
+    JLObjectArray argsArray(env->NewObjectArray(count, objectClass(env), NULL));
+    for (int i = 0; i < count; i++) {
+        if (argTypes[i] == JavaTypeObject || argTypes[i] == JavaTypeArray) {
+            env->SetObjectArrayElement(argsArray, i, args[i].l);
+        } else {
+            JLObject boxed(jvalueToJObject(args[i], argTypes[i]));
+            env->SetObjectArrayElement(argsArray, i, boxed);
+        }
+    }
+
+    return invokeWithContext(env, reflectedMethod, obj, argsArray, returnType, result, accessControlContext);
 }
 
 } // end of namespace Bindings
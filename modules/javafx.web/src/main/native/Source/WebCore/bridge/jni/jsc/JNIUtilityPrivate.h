@@ -45,6 +45,11 @@ jobject convertUndefinedToJObject();
 
  jthrowable dispatchJNICall(int, RootObject *rootObject, jobject, bool isStatic, JavaType returnType, jmethodID, jobject* args, jvalue& result, jobject accessControlContext);
 
+// Invokes a method obtained with Class.getMethods() on obj. Primitive
+// arguments are passed as jvalues and only boxed for the reflective call,
+// with class and method IDs that are looked up once.
+jthrowable dispatchJNICall(RootObject*, jobject obj, jobject reflectedMethod, JavaType returnType, int count, const jvalue* args, const JavaType* argTypes, jvalue& result, jobject accessControlContext);
+
 jobject jvalueToJObject(jvalue value, JavaType);
 
 } // namespace Bindings
@@ -300,14 +300,11 @@ JSValue JavaInstance::invokeMethod(ExecState* exec, RuntimeMethod* runtimeMethod
         return jsUndefined();
     }
 
-    Vector<jobject> jArgs(count);
+    Vector<jvalue, 8> jArgs(count);
 
     for (int i = 0; i < count; i++) {
-        CString javaClassName = jMethod->parameterAt(i).utf8();
-        JavaType jtype = javaTypeFromClassName(javaClassName.data());
-        jvalue jarg = convertValueToJValue(exec, m_rootObject.get(),
-            exec->argument(i), jtype, javaClassName.data());
-        jArgs[i] = jvalueToJObject(jarg, jtype);
+        jArgs[i] = convertValueToJValue(exec, m_rootObject.get(),
+            exec->argument(i), jMethod->parameterTypeAt(i), jMethod->parameterClassNameAt(i));
         LOG(LiveConnect, "JavaInstance::invokeMethod arg[%d] = %s", i, exec->argument(i).toString(exec)->value(exec).ascii().data());
     }
 
@@ -334,13 +331,10 @@ JSValue JavaInstance::invokeMethod(ExecState* exec, RuntimeMethod* runtimeMethod
         }
 
         // const char *callingURL = 0; // FIXME, need to propagate calling URL to Java
-        jmethodID methodId = getMethodID(obj, jMethod->name().utf8().data(), jMethod->signature());
-
-        jthrowable ex = dispatchJNICall(exec->argumentCount(), rootObject,
-                                        obj, jMethod->isStatic(),
-                                        jMethod->returnType(), methodId,
-                                        jArgs.data(), result,
-                                        accessControlContext());
+        jthrowable ex = dispatchJNICall(rootObject, obj, jMethod->reflectedMethod(),
+                                        jMethod->returnType(), count,
+                                        jArgs.data(), jMethod->parameterTypes(),
+                                        result, accessControlContext());
         if (ex != NULL) {
             JSValue exceptionDescription
               = (JavaInstance::create(ex, rootObject, accessControlContext())
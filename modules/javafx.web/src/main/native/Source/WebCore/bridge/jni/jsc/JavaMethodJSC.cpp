@@ -36,6 +36,7 @@ using namespace JSC;
 using namespace JSC::Bindings;
 
 JavaMethod::JavaMethod(JNIEnv* env, jobject aMethod)
+    : m_method(JobjectWrapper::create(aMethod, true))
 {
     // Get return type name
     jstring returnTypeName = 0;
@@ -66,6 +67,8 @@ JavaMethod::JavaMethod(JNIEnv* env, jobject aMethod)
             if (!parameterName)
                 parameterName = env->NewStringUTF("<Unknown>");
             m_parameters.append(JavaString(env, parameterName).impl());
+            m_parameterClassNames.append(m_parameters.last().utf8());
+            m_parameterTypes.append(javaTypeFromClassName(m_parameterClassNames.last().data()));
             env->DeleteLocalRef(aParameter);
             env->DeleteLocalRef(parameterName);
         }
@@ -111,14 +114,14 @@ const char* JavaMethod::signature() const
         StringBuilder signatureBuilder;
         signatureBuilder.append('(');
         for (unsigned int i = 0; i < m_parameters.size(); i++) {
-            CString javaClassName = parameterAt(i).utf8();
-            JavaType type = javaTypeFromClassName(javaClassName.data());
+            const char* javaClassName = parameterClassNameAt(i);
+            JavaType type = parameterTypeAt(i);
             if (type == JavaTypeArray)
-                appendClassName(signatureBuilder, javaClassName.data());
+                appendClassName(signatureBuilder, javaClassName);
             else {
                 signatureBuilder.append(signatureFromJavaType(type));
                 if (type == JavaTypeObject) {
-                    appendClassName(signatureBuilder, javaClassName.data());
+                    appendClassName(signatureBuilder, javaClassName);
                     signatureBuilder.append(';');
                 }
             }
@@ -30,8 +30,10 @@
 
 #include "Bridge.h"
 #include "JavaType.h"
+#include "JobjectWrapper.h"
 
 #include "JavaStringJSC.h"
+#include <wtf/text/CString.h>
 
 namespace JSC {
 
@@ -47,6 +49,11 @@ public:
     const String name() const { return m_name.impl(); }
     RuntimeType returnTypeClassName() const { return m_returnTypeClassName.utf8(); }
     const String parameterAt(int i) const { return m_parameters[i]; }
+    const char* parameterClassNameAt(int i) const { return m_parameterClassNames[i].data(); }
+    JavaType parameterTypeAt(int i) const { return m_parameterTypes[i]; }
+    const JavaType* parameterTypes() const { return m_parameterTypes.data(); }
+    // The java.lang.reflect.Method this JavaMethod was created from.
+    jobject reflectedMethod() const { return m_method->instance(); }
     const char* signature() const;
     JavaType returnType() const { return m_returnType; }
     bool isStatic() const { return m_isStatic; }
@@ -56,6 +63,10 @@ public:
 
 private:
     Vector<WTF::String> m_parameters;
+    // Computed once from m_parameters, as they are needed on every call.
+    Vector<CString> m_parameterClassNames;
+    Vector<JavaType> m_parameterTypes;
+    RefPtr<JobjectWrapper> m_method;
     JavaString m_name;
     mutable char* m_signature;
     JavaString m_returnTypeClassName;
@@ -51,6 +51,7 @@
 
 #if PLATFORM(JAVA)
 #include <wtf/java/JavaEnv.h>
+#include "GlyphCacheJava.h"
 #include "RQRef.h"
 #endif
 
@@ -185,6 +186,12 @@ public:
 
 #if PLATFORM(JAVA)
     RefPtr<RQRef> nativeFontData() const { return m_jFont; }
+    GlyphCacheJava& glyphCache() const
+    {
+        if (!m_glyphCache)
+            m_glyphCache = GlyphCacheJava::create();
+        return *m_glyphCache;
+    }
 #endif
 
     unsigned hash() const;
@@ -268,6 +275,7 @@ private:
 
 #if PLATFORM(JAVA)
     RefPtr<RQRef> m_jFont;
+    mutable RefPtr<GlyphCacheJava> m_glyphCache;
 #endif
 
     // The values below are common to all ports
@@ -68,6 +68,7 @@ typedef WebCore::PlatformPath PlatformPath;
 #elif PLATFORM(JAVA)
 #include <wtf/RefPtr.h>
 #include "RQRef.h"
+#include "PathRecorderJava.h"
 namespace WebCore {
     class RQRef;
 }
@@ -143,7 +144,12 @@ namespace WebCore {
         float normalAngleAtLength(float length, bool& success) const;
 
         WEBCORE_EXPORT void clear();
+#if PLATFORM(JAVA)
+        // The Java port always has a (possibly empty) native path.
+        bool isNull() const { return false; }
+#else
         bool isNull() const { return !m_path; }
+#endif
         bool isEmpty() const;
         // Gets the current point of the current path, which is conceptually the final point reached by the path so far.
         // Note the Path can be empty (isEmpty() == true) and still have a current point.
@@ -179,6 +185,9 @@ namespace WebCore {
         // meaning Path::platformPath() can return null.
 #if USE(DIRECT2D)
         PlatformPathPtr platformPath() const { return m_path.get(); }
+#elif PLATFORM(JAVA)
+        // Serializes pending changes to the Java WCPath before returning it.
+        PlatformPathPtr platformPath() const;
 #else
         PlatformPathPtr platformPath() const { return m_path; }
 #endif
@@ -219,6 +228,10 @@ namespace WebCore {
         COMPtr<ID2D1GeometryGroup> m_path;
         COMPtr<ID2D1PathGeometry> m_activePathGeometry;
         COMPtr<ID2D1GeometrySink> m_activePath;
+#elif PLATFORM(JAVA)
+        PathRecorder m_recorder;
+        mutable PlatformPathPtr m_path { nullptr };
+        mutable bool m_platformPathValid { false };
 #else
         PlatformPathPtr m_path { nullptr };
 #endif
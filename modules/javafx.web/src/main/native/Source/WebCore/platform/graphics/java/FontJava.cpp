@@ -102,20 +102,11 @@ RefPtr<Font> Font::platformCreateScaledFont(const FontDescription&, float scaleF
 
 float Font::platformWidthForGlyph(Glyph c) const
 {
-    JNIEnv* env = WebCore_GetJavaEnv();
-
     RefPtr<RQRef> jFont = m_platformData.nativeFontData();
     if (!jFont)
         return 0.0f;
 
-    static jmethodID getGlyphWidth_mID = env->GetMethodID(PG_GetFontClass(env),
-        "getGlyphWidth", "(I)D");
-    ASSERT(getGlyphWidth_mID);
-
-    float res = env->CallDoubleMethod(*jFont, getGlyphWidth_mID, (jint)c);
-    CheckAndClearException(env);
-
-    return res;
+    return m_platformData.glyphCache().advanceForGlyph(*jFont, c);
 }
 
 FloatRect Font::platformBoundsForGlyph(Glyph) const
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+#include "config.h"
+
+#include "GlyphCacheJava.h"
+#include "Logging.h"
+
+#include <unicode/utf16.h>
+#include <wtf/Vector.h>
+#include <wtf/java/JavaEnv.h>
+
+namespace WebCore {
+
+static GlyphCacheJava::Statistics& cacheStatistics()
+{
+    static GlyphCacheJava::Statistics statistics = { };
+    return statistics;
+}
+
+/*static*/
+const GlyphCacheJava::Statistics& GlyphCacheJava::statistics()
+{
+    return cacheStatistics();
+}
+
+float* GlyphCacheJava::fillAdvanceBlock(RQRef& jFont, unsigned blockNumber)
+{
+    JNIEnv* env = WebCore_GetJavaEnv();
+
+    static jmethodID mid = env->GetMethodID(PG_GetFontClass(env),
+        "getGlyphWidths", "(II)[F");
+    ASSERT(mid);
+
+    std::unique_ptr<float[]> block(new float[BLOCK_SIZE]());
+    JLocalRef<jfloatArray> jwidths(static_cast<jfloatArray>(env->CallObjectMethod(
+        (jobject)jFont, mid, (jint)(blockNumber * BLOCK_SIZE), (jint)BLOCK_SIZE)));
+    CheckAndClearException(env);
+    if (jwidths) {
+        env->GetFloatArrayRegion(jwidths, 0, BLOCK_SIZE, block.get());
+        CheckAndClearException(env);
+    }
+
+    const Statistics& stat = cacheStatistics();
+    LOG(PerformanceLogging, "GlyphCacheJava %p: filled advance block %u (hits: %u, misses: %u)",
+        this, blockNumber, stat.advanceHits, stat.advanceMisses);
+
+    return m_advances.add(blockNumber, WTFMove(block)).iterator->value.get();
+}
+
+float GlyphCacheJava::advanceForGlyph(RQRef& jFont, Glyph glyph)
+{
+    unsigned blockNumber = static_cast<unsigned>(glyph) / BLOCK_SIZE;
+    float* block;
+    auto it = m_advances.find(blockNumber);
+    if (it != m_advances.end()) {
+        ++cacheStatistics().advanceHits;
+        block = it->value.get();
+    } else {
+        ++cacheStatistics().advanceMisses;
+        block = fillAdvanceBlock(jFont, blockNumber);
+    }
+    return block[static_cast<unsigned>(glyph) % BLOCK_SIZE];
+}
+
+Glyph* GlyphCacheJava::fillGlyphBlock(RQRef& jFont, unsigned blockNumber)
+{
+    JNIEnv* env = WebCore_GetJavaEnv();
+
+    static jmethodID mid = env->GetMethodID(PG_GetFontClass(env),
+        "getGlyphCodes", "([C)[I");
+    ASSERT(mid);
+
+    std::unique_ptr<Glyph[]> block(new Glyph[BLOCK_SIZE]());
+
+    // Supplementary code points are passed as surrogate pairs, so the
+    // glyph for the i-th code point is then at index 2 * i.
+    UChar32 first = blockNumber * BLOCK_SIZE;
+    bool isBMP = U_IS_BMP(first);
+    unsigned length = isBMP ? BLOCK_SIZE : 2 * BLOCK_SIZE;
+    unsigned step = isBMP ? 1 : 2;
+
+    Vector<jchar> chars(length);
+    for (unsigned i = 0; i < BLOCK_SIZE; ++i) {
+        UChar32 c = first + i;
+        if (isBMP) {
+            chars[i] = U16_IS_SURROGATE(c) ? 0 : c;
+        } else {
+            chars[2 * i] = U16_LEAD(c);
+            chars[2 * i + 1] = U16_TRAIL(c);
+        }
+    }
+
+    JLocalRef<jcharArray> jchars(env->NewCharArray(length));
+    CheckAndClearException(env); // OOME
+    if (jchars) {
+        env->SetCharArrayRegion(jchars, 0, length, chars.data());
+        JLocalRef<jintArray> jglyphs(static_cast<jintArray>(env->CallObjectMethod(
+            (jobject)jFont, mid, (jcharArray)jchars)));
+        CheckAndClearException(env);
+        if (jglyphs) {
+            Vector<jint> glyphs(length);
+            env->GetIntArrayRegion(jglyphs, 0, length, glyphs.data());
+            CheckAndClearException(env);
+            for (unsigned i = 0; i < BLOCK_SIZE; ++i) {
+                block[i] = glyphs[i * step];
+            }
+        }
+    }
+
+    const Statistics& stat = cacheStatistics();
+    LOG(PerformanceLogging, "GlyphCacheJava %p: filled glyph block %u (hits: %u, misses: %u)",
+        this, blockNumber, stat.glyphHits, stat.glyphMisses);
+
+    return m_glyphs.add(blockNumber, WTFMove(block)).iterator->value.get();
+}
+
+Glyph GlyphCacheJava::glyphForCodePoint(RQRef& jFont, UChar32 c)
+{
+    unsigned blockNumber = static_cast<unsigned>(c) / BLOCK_SIZE;
+    Glyph* block;
+    auto it = m_glyphs.find(blockNumber);
+    if (it != m_glyphs.end()) {
+        ++cacheStatistics().glyphHits;
+        block = it->value.get();
+    } else {
+        ++cacheStatistics().glyphMisses;
+        block = fillGlyphBlock(jFont, blockNumber);
+    }
+    return block[static_cast<unsigned>(c) % BLOCK_SIZE];
+}
+
+} // namespace WebCore
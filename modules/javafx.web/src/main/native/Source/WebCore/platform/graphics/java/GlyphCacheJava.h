@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#pragma once
+
+#include "Glyph.h"
+#include "RQRef.h"
+
+#include <memory>
+#include <wtf/HashMap.h>
+#include <wtf/RefCounted.h>
+#include <unicode/utypes.h>
+
+namespace WebCore {
+
+/*
+ * Per-FontPlatformData cache of glyph advances and character to glyph
+ * mappings obtained from the Java WCFont.
+ *
+ * Both are stored in dense blocks of BLOCK_SIZE entries and a miss fills
+ * the whole block with one JNI call (WCFont.getGlyphWidths and
+ * WCFont.getGlyphCodes respectively), so laying out text needs at most one
+ * Java call per block instead of one per glyph or per GlyphPage.
+ *
+ * The cache is shared by all the copies of a FontPlatformData and is only
+ * used on the main thread.
+ */
+class GlyphCacheJava : public RefCounted<GlyphCacheJava> {
+public:
+    static const unsigned BLOCK_SIZE = 256;
+
+    struct Statistics {
+        unsigned advanceHits;
+        unsigned advanceMisses;
+        unsigned glyphHits;
+        unsigned glyphMisses;
+    };
+
+    static Ref<GlyphCacheJava> create() {
+        return adoptRef(*new GlyphCacheJava());
+    }
+
+    float advanceForGlyph(RQRef& jFont, Glyph);
+
+    // Returns 0 if the font has no glyph for the code point.
+    Glyph glyphForCodePoint(RQRef& jFont, UChar32);
+
+    static const Statistics& statistics();
+
+private:
+    GlyphCacheJava() = default;
+
+    float* fillAdvanceBlock(RQRef& jFont, unsigned blockNumber);
+    Glyph* fillGlyphBlock(RQRef& jFont, unsigned blockNumber);
+
+    typedef HashMap<unsigned, std::unique_ptr<float[]>, IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned>> AdvanceBlockMap;
+    typedef HashMap<unsigned, std::unique_ptr<Glyph[]>, IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned>> GlyphBlockMap;
+
+    AdvanceBlockMap m_advances;
+    GlyphBlockMap m_glyphs;
+};
+
+} // namespace WebCore
@@ -7,38 +7,19 @@
 #include "GraphicsContextJava.h"
 #include "Font.h"
 
+#include <unicode/utf16.h>
+
 namespace WebCore {
 
 bool GlyphPage::fill(UChar* buffer, unsigned bufferLength)
 {
-    JNIEnv* env = WebCore_GetJavaEnv();
-
     RefPtr<RQRef> jFont = this->font().platformData().nativeFontData();
     if (!jFont)
         return false;
 
-    JLocalRef<jcharArray> jchars(env->NewCharArray(bufferLength));
-    CheckAndClearException(env); // OOME
-    ASSERT(jchars);
-    if (!jchars)
-        return false;
-
-    jchar* chars = (jchar*)env->GetPrimitiveArrayCritical(jchars, NULL);
-    ASSERT(chars);
-    memcpy(chars, buffer, bufferLength * 2);
-    env->ReleasePrimitiveArrayCritical(jchars, chars, 0);
-
-    static jmethodID mid = env->GetMethodID(PG_GetFontClass(env), "getGlyphCodes", "([C)[I");
-    ASSERT(mid);
-    JLocalRef<jintArray> jglyphs(static_cast<jintArray>(env->CallObjectMethod(*jFont, mid, (jcharArray)jchars)));
-    CheckAndClearException(env);
-    ASSERT(jglyphs);
-    if (!jglyphs)
-        return false;
-
-    Glyph* glyphs = (Glyph*)env->GetPrimitiveArrayCritical(jglyphs, NULL);
-    ASSERT(glyphs);
-
+    // One character or surrogate pair per glyph. WebCore replaces some
+    // characters of the page (controls by U+200B, tab and no-break space
+    // by a space, ...), so each of them is looked up.
     unsigned step;  // 1 for BMP, 2 for non-BMP
     if (bufferLength == GlyphPage::size) {
         step = 1;
@@ -46,18 +27,20 @@ bool GlyphPage::fill(UChar* buffer, unsigned bufferLength)
         step = 2;
     } else {
         ASSERT_NOT_REACHED();
+        return false;
     }
 
+    GlyphCacheJava& glyphCache = this->font().platformData().glyphCache();
     bool haveGlyphs = false;
     for (unsigned i = 0; i < GlyphPage::size; i++) {
-        Glyph glyph = glyphs[i * step];
-        if (glyph) {
-            haveGlyphs = true;
-            setGlyphForIndex(i, glyph);
-        } else
-            setGlyphForIndex(i, 0);
+        UChar32 c = buffer[i * step];
+        if (step == 2 && U16_IS_LEAD(c) && U16_IS_TRAIL(buffer[i * step + 1])) {
+            c = U16_GET_SUPPLEMENTARY(c, buffer[i * step + 1]);
+        }
+        Glyph glyph = glyphCache.glyphForCodePoint(*jFont, c);
+        haveGlyphs |= !!glyph;
+        setGlyphForIndex(i, glyph);
     }
-    env->ReleasePrimitiveArrayCritical(jglyphs, glyphs, JNI_ABORT);
 
     return haveGlyphs;
 }
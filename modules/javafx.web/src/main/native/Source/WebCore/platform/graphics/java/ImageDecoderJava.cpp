@@ -96,27 +96,50 @@ void ImageDecoder::setData(SharedBuffer& data, bool allDataReceived)
     ASSERT(m_nativeDecoder);
     JNIEnv* env = WebCore_GetJavaEnv();
 
+    static jmethodID midGetImageDataArray = env->GetMethodID(
+        PG_GetGraphicsImageDecoderClass(env),
+        "getImageDataArray",
+        "(I)[B");
+    ASSERT(midGetImageDataArray);
+
     static jmethodID midAddImageData = env->GetMethodID(
         PG_GetGraphicsImageDecoderClass(env),
         "addImageData",
-        "([B)V");
+        "(I)V");
     ASSERT(midAddImageData);
 
-    const char* segment;
-    while (unsigned length = data.getSomeData(segment, m_receivedDataSize)) {
-        JLByteArray jArray(env->NewByteArray(length));
-        if (jArray && !CheckAndClearException(env)) {
-            // not OOME in Java
-            env->SetByteArrayRegion(jArray, 0, length, (const jbyte*)segment);
-            env->CallVoidMethod(m_nativeDecoder, midAddImageData, (jbyteArray)jArray);
-            CheckAndClearException(env);
+    // All the segments received since the last call are copied in place to
+    // the array of the decoder and delivered at once, so the decoder sees
+    // one portion per call rather than one per segment.
+    unsigned dataSize = data.size();
+    if (dataSize > m_receivedDataSize) {
+        unsigned length = dataSize - m_receivedDataSize;
+        JLByteArray jArray((jbyteArray)env->CallObjectMethod(
+            m_nativeDecoder, midGetImageDataArray, (jint)length));
+        // The array holds the data received so far followed by the room
+        // for the new portion. If it could not be grown, the portion is
+        // delivered again with the next call.
+        if (!CheckAndClearException(env) && jArray
+            && (unsigned)env->GetArrayLength(jArray) >= dataSize) {
+            jbyte* dst = (jbyte*)env->GetPrimitiveArrayCritical((jbyteArray)jArray, 0);
+            if (dst) {
+                unsigned position = m_receivedDataSize;
+                const char* segment;
+                while (unsigned segmentLength = data.getSomeData(segment, position)) {
+                    memcpy(dst + position, segment, segmentLength);
+                    position += segmentLength;
+                }
+                env->ReleasePrimitiveArrayCritical(jArray, dst, 0);
+                m_receivedDataSize = dataSize;
+                env->CallVoidMethod(m_nativeDecoder, midAddImageData, (jint)length);
+                CheckAndClearException(env);
+            }
         }
-        m_receivedDataSize += length;
     }
 
     if (allDataReceived) {
         m_isAllDataReceived = true;
-        env->CallVoidMethod(m_nativeDecoder, midAddImageData, 0);
+        env->CallVoidMethod(m_nativeDecoder, midAddImageData, (jint)-1);
         CheckAndClearException(env);
     }
 }
@@ -11,11 +11,11 @@
 #include "FloatRect.h"
 #include "StrokeStyleApplier.h"
 #include <wtf/java/JavaEnv.h>
-#include "NotImplemented.h"
 #include "GraphicsContextJava.h"
 #include "RQRef.h"
 #include "GraphicsContext.h"
 #include "ImageBuffer.h"
+#include "AffineTransform.h"
 
 #include <wtf/text/WTFString.h>
 
@@ -67,11 +67,10 @@ PassRefPtr<RQRef> copyPath(PassRefPtr<RQRef> p)
 
 
 Path::Path()
-    : m_path(createEmptyPath())
 {}
 
 Path::Path(const Path& p)
-    : m_path(copyPath(p.platformPath()))
+    : m_recorder(p.m_recorder)
 {}
 
 Path::~Path()
@@ -80,26 +79,57 @@ Path::~Path()
 Path &Path::operator=(const Path &p)
 {
     if (this != &p) {
-        m_path = copyPath(p.platformPath());
+        m_recorder = p.m_recorder;
+        m_platformPathValid = false;
     }
     return *this;
 }
 
-bool Path::contains(const FloatPoint& p, WindRule rule) const
+/*
+ * The geometry lives in m_recorder; the Java WCPath is only created and
+ * refreshed (with a single WCPath.setPath call) when the path is about to
+ * be filled, stroked or clipped.
+ */
+PlatformPathPtr Path::platformPath() const
 {
-    ASSERT(m_path);
+    if (!m_path) {
+        m_path = createEmptyPath();
+        m_platformPathValid = false;
+    }
+    if (m_platformPathValid) {
+        return m_path;
+    }
 
     JNIEnv* env = WebCore_GetJavaEnv();
 
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "contains",
-        "(IDD)Z");
+    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "setPath",
+        "([BI[FI)V");
     ASSERT(mid);
 
-    jboolean res = env->CallBooleanMethod(*m_path, mid, (jint)rule,
-        (jdouble)p.x(), (jdouble)p.y());
+    const Vector<jbyte>& verbs = m_recorder.verbs();
+    const Vector<jfloat>& coords = m_recorder.coords();
+
+    JLocalRef<jbyteArray> jverbs(env->NewByteArray(verbs.size()));
+    JLocalRef<jfloatArray> jcoords(env->NewFloatArray(coords.size()));
+    if (!jverbs || !jcoords) {
+        CheckAndClearException(env);
+        return m_path;
+    }
+    env->SetByteArrayRegion(jverbs, 0, verbs.size(), verbs.data());
+    env->SetFloatArrayRegion(jcoords, 0, coords.size(), coords.data());
+
+    env->CallVoidMethod(*m_path, mid,
+        (jbyteArray)jverbs, (jint)verbs.size(),
+        (jfloatArray)jcoords, (jint)coords.size());
     CheckAndClearException(env);
 
-    return jbool_to_bool(res);
+    m_platformPathValid = true;
+    return m_path;
+}
+
+bool Path::contains(const FloatPoint& p, WindRule rule) const
+{
+    return m_recorder.contains(p, rule);
 }
 
 FloatRect Path::boundingRect() const
@@ -109,351 +139,165 @@ FloatRect Path::boundingRect() const
 
 FloatRect Path::strokeBoundingRect(StrokeStyleApplier *applier) const
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "getBounds",
-            "()Lcom/sun/webkit/graphics/WCRectangle;");
-    ASSERT(mid);
-
-    JLObject rect(env->CallObjectMethod(*m_path, mid));
-    CheckAndClearException(env);
-    if (rect) {
-        static jfieldID rectxFID = env->GetFieldID(PG_GetRectangleClass(env), "x", "F");
-        ASSERT(rectxFID);
-        static jfieldID rectyFID = env->GetFieldID(PG_GetRectangleClass(env), "y", "F");
-        ASSERT(rectyFID);
-        static jfieldID rectwFID = env->GetFieldID(PG_GetRectangleClass(env), "w", "F");
-        ASSERT(rectwFID);
-        static jfieldID recthFID = env->GetFieldID(PG_GetRectangleClass(env), "h", "F");
-        ASSERT(recthFID);
-
-        FloatRect bounds(
-            float(env->GetFloatField(rect, rectxFID)),
-            float(env->GetFloatField(rect, rectyFID)),
-            float(env->GetFloatField(rect, rectwFID)),
-            float(env->GetFloatField(rect, recthFID)));
-        CheckAndClearException(env);
-
-        float thickness;
-        if (applier) {
-            GraphicsContext& gc = scratchContext();
-            gc.save();
-            applier->strokeStyle(&gc);
-            thickness = gc.strokeThickness();
-            gc.restore();
-            bounds.inflate(thickness / 2);
-        }
-        return bounds;
-    } else {
+    if (m_recorder.verbs().isEmpty()) {
         return FloatRect();
     }
+
+    FloatRect bounds = m_recorder.boundingRect();
+    if (applier) {
+        GraphicsContext& gc = scratchContext();
+        gc.save();
+        applier->strokeStyle(&gc);
+        float thickness = gc.strokeThickness();
+        gc.restore();
+        bounds.inflate(thickness / 2);
+    }
+    return bounds;
 }
 
 void Path::clear()
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "clear", "()V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid);
-    CheckAndClearException(env);
+    m_recorder.clear();
+    m_platformPathValid = false;
 }
 
 bool Path::isEmpty() const
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-                                            "isEmpty", "()Z");
-    ASSERT(mid);
-
-    jboolean res = env->CallBooleanMethod(*m_path, mid);
-    CheckAndClearException(env);
-
-    return jbool_to_bool(res);
+    return m_recorder.isEmpty();
 }
 
 bool Path::hasCurrentPoint() const
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-                                            "hasCurrentPoint", "()Z");
-    ASSERT(mid);
-
-    jboolean res = env->CallBooleanMethod(*m_path, mid);
-    CheckAndClearException(env);
-
-    return jbool_to_bool(res);
+    return m_recorder.hasCurrentPoint();
 }
 
 FloatPoint Path::currentPoint() const
 {
-    //utatodo: return current point of subpath.
-    float quietNaN = std::numeric_limits<float>::quiet_NaN();
-    return FloatPoint(quietNaN, quietNaN);
+    return m_recorder.currentPoint();
 }
 
 void Path::moveTo(const FloatPoint &p)
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "moveTo",
-        "(DD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid, (jdouble)p.x(), (jdouble)p.y());
-    CheckAndClearException(env);
+    m_recorder.moveTo(p);
+    m_platformPathValid = false;
 }
 
 void Path::addLineTo(const FloatPoint &p)
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addLineTo",
-        "(DD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid, (jdouble)p.x(), (jdouble)p.y());
-    CheckAndClearException(env);
+    m_recorder.lineTo(p);
+    m_platformPathValid = false;
 }
 
 void Path::addQuadCurveTo(const FloatPoint &cp, const FloatPoint &p)
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addQuadCurveTo",
-                                            "(DDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid, (jdouble)cp.x(), (jdouble)cp.y(), (jdouble)p.x(), (jdouble)p.y());
-    CheckAndClearException(env);
+    m_recorder.quadTo(cp, p);
+    m_platformPathValid = false;
 }
 
 void Path::addBezierCurveTo(const FloatPoint & controlPoint1,
                             const FloatPoint & controlPoint2,
                             const FloatPoint & controlPoint3)
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "addBezierCurveTo", "(DDDDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid,
-                        (jdouble)controlPoint1.x(), (jdouble)controlPoint1.y(),
-                        (jdouble)controlPoint2.x(), (jdouble)controlPoint2.y(),
-                        (jdouble)controlPoint3.x(), (jdouble)controlPoint3.y());
-    CheckAndClearException(env);
+    m_recorder.cubicTo(controlPoint1, controlPoint2, controlPoint3);
+    m_platformPathValid = false;
 }
 
 void Path::addArcTo(const FloatPoint & p1, const FloatPoint & p2, float radius)
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addArcTo",
-        "(DDDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid,
-                        (jdouble)p1.x(), (jdouble)p1.y(),
-                        (jdouble)p2.x(), (jdouble)p2.y(), (jdouble)radius);
-    CheckAndClearException(env);
+    m_recorder.arcTo(p1, p2, radius);
+    m_platformPathValid = false;
 }
 
 void Path::closeSubpath()
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "closeSubpath", "()V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid);
-    CheckAndClearException(env);
+    m_recorder.close();
+    m_platformPathValid = false;
 }
 
 void Path::addArc(const FloatPoint & p, float radius, float startAngle,
-                  float endAngle, bool clockwise)
+                  float endAngle, bool anticlockwise)
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addArc",
-        "(DDDDDZ)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid, (jdouble)p.x(), (jdouble)p.y(),
-        (jdouble)radius, (jdouble)startAngle, (jdouble)endAngle,
-        bool_to_jbool(clockwise));
-    CheckAndClearException(env);
+    m_recorder.ellipticalArc(p, radius, radius, 0, startAngle, endAngle, anticlockwise);
+    m_platformPathValid = false;
 }
 
 void Path::addRect(const FloatRect& r)
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addRect",
-        "(DDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid, (jdouble)r.x(), (jdouble)r.y(),
-                              (jdouble)r.width(), (jdouble)r.height());
-    CheckAndClearException(env);
+    m_recorder.rect(r);
+    m_platformPathValid = false;
 }
 
 void Path::addEllipse(FloatPoint point, float radiusX, float radiusY, float rotation, float startAngle, float endAngle, bool anticlockwise)
 {
-    notImplemented();
+    m_recorder.ellipticalArc(point, radiusX, radiusY, rotation, startAngle, endAngle, anticlockwise);
+    m_platformPathValid = false;
 }
 
 void Path::addPath(const Path& path, const AffineTransform& transform)
 {
-    notImplemented();
+    m_recorder.append(path.m_recorder, transform);
+    m_platformPathValid = false;
 }
 
 void Path::addEllipse(const FloatRect& r)
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addEllipse",
-        "(DDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid,
-                        (jdouble)r.x(), (jdouble)r.y(),
-                        (jdouble)r.width(), (jdouble)r.height());
-    CheckAndClearException(env);
+    m_recorder.ellipse(r);
+    m_platformPathValid = false;
 }
 
 void Path::translate(const FloatSize &sz)
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "translate",
-        "(DD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid,
-                        (jdouble)sz.width(), (jdouble)sz.height());
-    CheckAndClearException(env);
+    m_recorder.transform(AffineTransform().translate(sz.width(), sz.height()));
+    m_platformPathValid = false;
 }
 
 void Path::transform(const AffineTransform &at)
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "transform", "(DDDDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid,
-                        (jdouble)at.a(), (jdouble)at.b(),
-                        (jdouble)at.c(), (jdouble)at.d(),
-                        (jdouble)at.e(), (jdouble)at.f());
-    CheckAndClearException(env);
+    m_recorder.transform(at);
+    m_platformPathValid = false;
 }
 
 void Path::apply(const PathApplierFunction& function) const
 {
-    ASSERT(m_path);
-
-    JNIEnv* env = WebCore_GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "getPathIterator", "()Lcom/sun/webkit/graphics/WCPathIterator;");
-    ASSERT(mid);
-
-    JLObject iter(env->CallObjectMethod(*m_path, mid));
-    CheckAndClearException(env);
-
-    if (iter) {
-        static jmethodID midIsDone = env->GetMethodID(PG_GetPathIteratorClass(env),
-            "isDone", "()Z");
-        ASSERT(midIsDone);
-
-        static jmethodID midNext = env->GetMethodID(PG_GetPathIteratorClass(env),
-            "next", "()V");
-        ASSERT(midNext);
-
-        static jmethodID midCurrentSegment = env->GetMethodID(PG_GetPathIteratorClass(env),
-            "currentSegment", "([D)I");
-        ASSERT(midCurrentSegment);
-
-        PathElement pelement;
-        FloatPoint points[3];
-        pelement.points = points;
-
-        JLocalRef<jdoubleArray> coords(env->NewDoubleArray(6));
-        while(JNI_FALSE == env->CallBooleanMethod(iter, midIsDone)) {
-            jint type = env->CallBooleanMethod(
-                iter,
-                midCurrentSegment,
-                (jdoubleArray)coords);
-            jboolean isCopy = JNI_FALSE;
-            jdouble *data = env->GetDoubleArrayElements(coords, &isCopy);
-            switch (type) {
-            case com_sun_webkit_graphics_WCPathIterator_SEG_MOVETO:
-                pelement.type = PathElementMoveToPoint;
-                pelement.points[0] = FloatPoint(data[0],data[1]);
-                function(pelement);
-                break;
-            case com_sun_webkit_graphics_WCPathIterator_SEG_LINETO:
-                pelement.type = PathElementAddLineToPoint;
-                pelement.points[0] = FloatPoint(data[0],data[1]);
-                function(pelement);
-                break;
-            case com_sun_webkit_graphics_WCPathIterator_SEG_QUADTO:
-                pelement.type = PathElementAddQuadCurveToPoint;
-                pelement.points[0] = FloatPoint(data[0],data[1]);
-                pelement.points[1] = FloatPoint(data[2],data[3]);
-                function(pelement);
-                break;
-            case com_sun_webkit_graphics_WCPathIterator_SEG_CUBICTO:
-                pelement.type = PathElementAddCurveToPoint;
-                pelement.points[0] = FloatPoint(data[0],data[1]);
-                pelement.points[1] = FloatPoint(data[2],data[3]);
-                pelement.points[2] = FloatPoint(data[4],data[5]);
-                function(pelement);
-                break;
-            case com_sun_webkit_graphics_WCPathIterator_SEG_CLOSE:
-                pelement.type = PathElementCloseSubpath;
-                function(pelement);
-                break;
-            }
-            env->ReleaseDoubleArrayElements(coords, data, JNI_ABORT);
-            env->CallVoidMethod(iter, midNext);
+    PathElement pelement;
+    FloatPoint points[3];
+    pelement.points = points;
+
+    const jfloat* data = m_recorder.coords().data();
+    for (auto type : m_recorder.verbs()) {
+        switch (type) {
+        case com_sun_webkit_graphics_WCPathIterator_SEG_MOVETO:
+            pelement.type = PathElementMoveToPoint;
+            pelement.points[0] = FloatPoint(data[0],data[1]);
+            data += 2;
+            function(pelement);
+            break;
+        case com_sun_webkit_graphics_WCPathIterator_SEG_LINETO:
+            pelement.type = PathElementAddLineToPoint;
+            pelement.points[0] = FloatPoint(data[0],data[1]);
+            data += 2;
+            function(pelement);
+            break;
+        case com_sun_webkit_graphics_WCPathIterator_SEG_QUADTO:
+            pelement.type = PathElementAddQuadCurveToPoint;
+            pelement.points[0] = FloatPoint(data[0],data[1]);
+            pelement.points[1] = FloatPoint(data[2],data[3]);
+            data += 4;
+            function(pelement);
+            break;
+        case com_sun_webkit_graphics_WCPathIterator_SEG_CUBICTO:
+            pelement.type = PathElementAddCurveToPoint;
+            pelement.points[0] = FloatPoint(data[0],data[1]);
+            pelement.points[1] = FloatPoint(data[2],data[3]);
+            pelement.points[2] = FloatPoint(data[4],data[5]);
+            data += 6;
+            function(pelement);
+            break;
+        case com_sun_webkit_graphics_WCPathIterator_SEG_CLOSE:
+            pelement.type = PathElementCloseSubpath;
+            function(pelement);
+            break;
         }
-        CheckAndClearException(env);
     }
 }
 
@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+#include "config.h"
+
+#include "PathRecorderJava.h"
+
+#include "AffineTransform.h"
+#include <wtf/MathExtras.h>
+
+#include "com_sun_webkit_graphics_WCPathIterator.h"
+
+namespace WebCore {
+
+static const jbyte SEG_MOVETO = com_sun_webkit_graphics_WCPathIterator_SEG_MOVETO;
+static const jbyte SEG_LINETO = com_sun_webkit_graphics_WCPathIterator_SEG_LINETO;
+static const jbyte SEG_QUADTO = com_sun_webkit_graphics_WCPathIterator_SEG_QUADTO;
+static const jbyte SEG_CUBICTO = com_sun_webkit_graphics_WCPathIterator_SEG_CUBICTO;
+static const jbyte SEG_CLOSE = com_sun_webkit_graphics_WCPathIterator_SEG_CLOSE;
+
+// Same recursion limit as com.sun.javafx.geom.Shape.pointCrossingsFor*.
+static const int MAX_CROSSINGS_LEVEL = 52;
+
+void PathRecorder::clear()
+{
+    m_verbs.clear();
+    m_coords.clear();
+    m_moveTo = FloatPoint();
+    m_current = FloatPoint();
+}
+
+bool PathRecorder::isEmpty() const
+{
+    for (auto verb : m_verbs) {
+        if (verb == SEG_LINETO || verb == SEG_QUADTO || verb == SEG_CUBICTO) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PathRecorder::ensureSubpath(const FloatPoint& p)
+{
+    if (!hasCurrentPoint()) {
+        moveTo(p);
+    }
+}
+
+void PathRecorder::connectTo(const FloatPoint& p)
+{
+    if (!hasCurrentPoint()) {
+        moveTo(p);
+    } else if (m_verbs.last() == SEG_CLOSE || m_current != p) {
+        lineTo(p);
+    }
+}
+
+void PathRecorder::moveTo(const FloatPoint& p)
+{
+    if (!m_verbs.isEmpty() && m_verbs.last() == SEG_MOVETO) {
+        // Collapse consecutive moves, as Path2D.moveTo does.
+        m_coords[m_coords.size() - 2] = p.x();
+        m_coords[m_coords.size() - 1] = p.y();
+    } else {
+        m_verbs.append(SEG_MOVETO);
+        m_coords.append(p.x());
+        m_coords.append(p.y());
+    }
+    m_moveTo = m_current = p;
+}
+
+void PathRecorder::lineTo(const FloatPoint& p)
+{
+    if (!hasCurrentPoint()) {
+        moveTo(p);
+        return;
+    }
+    m_verbs.append(SEG_LINETO);
+    m_coords.append(p.x());
+    m_coords.append(p.y());
+    m_current = p;
+}
+
+void PathRecorder::quadTo(const FloatPoint& cp, const FloatPoint& p)
+{
+    ensureSubpath(cp);
+    m_verbs.append(SEG_QUADTO);
+    m_coords.append(cp.x());
+    m_coords.append(cp.y());
+    m_coords.append(p.x());
+    m_coords.append(p.y());
+    m_current = p;
+}
+
+void PathRecorder::cubicTo(const FloatPoint& cp1, const FloatPoint& cp2, const FloatPoint& p)
+{
+    ensureSubpath(cp1);
+    m_verbs.append(SEG_CUBICTO);
+    m_coords.append(cp1.x());
+    m_coords.append(cp1.y());
+    m_coords.append(cp2.x());
+    m_coords.append(cp2.y());
+    m_coords.append(p.x());
+    m_coords.append(p.y());
+    m_current = p;
+}
+
+void PathRecorder::close()
+{
+    if (m_verbs.isEmpty() || m_verbs.last() == SEG_CLOSE) {
+        return;
+    }
+    m_verbs.append(SEG_CLOSE);
+    m_current = m_moveTo;
+}
+
+void PathRecorder::arcSegments(const FloatPoint& center, float radiusX, float radiusY,
+    float rotation, float startAngle, float sweep)
+{
+    AffineTransform unitToArc;
+    unitToArc.translate(center.x(), center.y());
+    unitToArc.rotate(rad2deg(rotation));
+    unitToArc.scaleNonUniform(radiusX, radiusY);
+
+    connectTo(unitToArc.mapPoint(FloatPoint(cosf(startAngle), sinf(startAngle))));
+    if (!sweep) {
+        return;
+    }
+
+    // Every segment spans at most a quarter of the ellipse.
+    int count = std::max(1, static_cast<int>(ceilf(fabsf(sweep) / piOverTwoFloat - 0.0001f)));
+    float step = sweep / count;
+    float kappa = 4.f / 3.f * tanf(step / 4.f);
+    float angle = startAngle;
+    for (int i = 0; i < count; ++i) {
+        float next = angle + step;
+        float cos0 = cosf(angle), sin0 = sinf(angle);
+        float cos1 = cosf(next), sin1 = sinf(next);
+        cubicTo(
+            unitToArc.mapPoint(FloatPoint(cos0 - kappa * sin0, sin0 + kappa * cos0)),
+            unitToArc.mapPoint(FloatPoint(cos1 + kappa * sin1, sin1 - kappa * cos1)),
+            unitToArc.mapPoint(FloatPoint(cos1, sin1)));
+        angle = next;
+    }
+}
+
+void PathRecorder::ellipticalArc(const FloatPoint& center, float radiusX, float radiusY,
+    float rotation, float startAngle, float endAngle, bool anticlockwise)
+{
+    float sweep = endAngle - startAngle;
+    if (!anticlockwise) {
+        if (sweep >= 2 * piFloat) {
+            sweep = 2 * piFloat;
+        } else {
+            sweep = fmodf(sweep, 2 * piFloat);
+            if (sweep < 0) {
+                sweep += 2 * piFloat;
+            }
+        }
+    } else {
+        if (sweep <= -2 * piFloat) {
+            sweep = -2 * piFloat;
+        } else {
+            sweep = fmodf(sweep, 2 * piFloat);
+            if (sweep > 0) {
+                sweep -= 2 * piFloat;
+            }
+        }
+    }
+    arcSegments(center, radiusX, radiusY, rotation, startAngle, sweep);
+}
+
+void PathRecorder::arcTo(const FloatPoint& p1, const FloatPoint& p2, float radius)
+{
+    if (!hasCurrentPoint()) {
+        moveTo(p1);
+    }
+
+    FloatPoint p0 = m_current;
+    FloatSize v1 = p0 - p1;
+    FloatSize v2 = p2 - p1;
+    float length1 = sqrtf(v1.width() * v1.width() + v1.height() * v1.height());
+    float length2 = sqrtf(v2.width() * v2.width() + v2.height() * v2.height());
+    float cross = v1.width() * v2.height() - v1.height() * v2.width();
+
+    // Degenerates into a straight line if any of the points coincide, the
+    // radius is zero or the points are collinear.
+    if (!length1 || !length2 || !radius || fabsf(cross) <= 1e-6f * length1 * length2) {
+        lineTo(p1);
+        return;
+    }
+
+    float cosPhi = (v1.width() * v2.width() + v1.height() * v2.height()) / (length1 * length2);
+    float phi = acosf(std::max(-1.f, std::min(1.f, cosPhi)));
+    float tangent = radius / tanf(phi / 2);
+
+    FloatPoint t1 = p1 + FloatSize(v1.width() * tangent / length1, v1.height() * tangent / length1);
+    FloatPoint t2 = p1 + FloatSize(v2.width() * tangent / length2, v2.height() * tangent / length2);
+
+    FloatSize bisector(v1.width() / length1 + v2.width() / length2, v1.height() / length1 + v2.height() / length2);
+    float bisectorLength = sqrtf(bisector.width() * bisector.width() + bisector.height() * bisector.height());
+    float centerDistance = sqrtf(tangent * tangent + radius * radius);
+    FloatPoint center = p1 + FloatSize(bisector.width() * centerDistance / bisectorLength,
+        bisector.height() * centerDistance / bisectorLength);
+
+    float startAngle = atan2f(t1.y() - center.y(), t1.x() - center.x());
+    float endAngle = atan2f(t2.y() - center.y(), t2.x() - center.x());
+    float sweep = endAngle - startAngle;
+    if (sweep > piFloat) {
+        sweep -= 2 * piFloat;
+    } else if (sweep < -piFloat) {
+        sweep += 2 * piFloat;
+    }
+    arcSegments(center, radius, radius, 0, startAngle, sweep);
+}
+
+void PathRecorder::rect(const FloatRect& r)
+{
+    moveTo(r.location());
+    lineTo(FloatPoint(r.maxX(), r.y()));
+    lineTo(FloatPoint(r.maxX(), r.maxY()));
+    lineTo(FloatPoint(r.x(), r.maxY()));
+    close();
+}
+
+void PathRecorder::ellipse(const FloatRect& r)
+{
+    moveTo(FloatPoint(r.maxX(), r.center().y()));
+    arcSegments(r.center(), r.width() / 2, r.height() / 2, 0, 0, 2 * piFloat);
+    close();
+}
+
+void PathRecorder::append(const PathRecorder& other, const AffineTransform& at)
+{
+    const jfloat* c = other.m_coords.data();
+    for (auto verb : other.m_verbs) {
+        switch (verb) {
+        case SEG_MOVETO:
+            moveTo(at.mapPoint(FloatPoint(c[0], c[1])));
+            c += 2;
+            break;
+        case SEG_LINETO:
+            lineTo(at.mapPoint(FloatPoint(c[0], c[1])));
+            c += 2;
+            break;
+        case SEG_QUADTO:
+            quadTo(at.mapPoint(FloatPoint(c[0], c[1])), at.mapPoint(FloatPoint(c[2], c[3])));
+            c += 4;
+            break;
+        case SEG_CUBICTO:
+            cubicTo(at.mapPoint(FloatPoint(c[0], c[1])), at.mapPoint(FloatPoint(c[2], c[3])),
+                at.mapPoint(FloatPoint(c[4], c[5])));
+            c += 6;
+            break;
+        case SEG_CLOSE:
+            close();
+            break;
+        }
+    }
+}
+
+void PathRecorder::transform(const AffineTransform& at)
+{
+    for (size_t i = 0; i + 1 < m_coords.size(); i += 2) {
+        FloatPoint p = at.mapPoint(FloatPoint(m_coords[i], m_coords[i + 1]));
+        m_coords[i] = p.x();
+        m_coords[i + 1] = p.y();
+    }
+    m_moveTo = at.mapPoint(m_moveTo);
+    m_current = at.mapPoint(m_current);
+}
+
+static int pointCrossingsForLine(double px, double py,
+    double x0, double y0, double x1, double y1)
+{
+    if (py < y0 && py < y1) return 0;
+    if (py >= y0 && py >= y1) return 0;
+    if (px >= x0 && px >= x1) return 0;
+    if (px < x0 && px < x1) return (y0 < y1) ? 1 : -1;
+    double xintercept = x0 + (py - y0) * (x1 - x0) / (y1 - y0);
+    if (px >= xintercept) return 0;
+    return (y0 < y1) ? 1 : -1;
+}
+
+static int pointCrossingsForQuad(double px, double py,
+    double x0, double y0, double xc, double yc, double x1, double y1, int level)
+{
+    if (py < y0 && py < yc && py < y1) return 0;
+    if (py >= y0 && py >= yc && py >= y1) return 0;
+    if (px >= x0 && px >= xc && px >= x1) return 0;
+    if (px < x0 && px < xc && px < x1) {
+        if (py >= y0) {
+            if (py < y1) return 1;
+        } else {
+            if (py >= y1) return -1;
+        }
+        return 0;
+    }
+    if (level > MAX_CROSSINGS_LEVEL) {
+        return pointCrossingsForLine(px, py, x0, y0, x1, y1);
+    }
+    double x0c = (x0 + xc) / 2;
+    double y0c = (y0 + yc) / 2;
+    double xc1 = (xc + x1) / 2;
+    double yc1 = (yc + y1) / 2;
+    xc = (x0c + xc1) / 2;
+    yc = (y0c + yc1) / 2;
+    if (std::isnan(xc) || std::isnan(yc)) {
+        return 0;
+    }
+    return pointCrossingsForQuad(px, py, x0, y0, x0c, y0c, xc, yc, level + 1)
+        + pointCrossingsForQuad(px, py, xc, yc, xc1, yc1, x1, y1, level + 1);
+}
+
+static int pointCrossingsForCubic(double px, double py,
+    double x0, double y0, double xc0, double yc0,
+    double xc1, double yc1, double x1, double y1, int level)
+{
+    if (py < y0 && py < yc0 && py < yc1 && py < y1) return 0;
+    if (py >= y0 && py >= yc0 && py >= yc1 && py >= y1) return 0;
+    if (px >= x0 && px >= xc0 && px >= xc1 && px >= x1) return 0;
+    if (px < x0 && px < xc0 && px < xc1 && px < x1) {
+        if (py >= y0) {
+            if (py < y1) return 1;
+        } else {
+            if (py >= y1) return -1;
+        }
+        return 0;
+    }
+    if (level > MAX_CROSSINGS_LEVEL) {
+        return pointCrossingsForLine(px, py, x0, y0, x1, y1);
+    }
+    double xmid = (xc0 + xc1) / 2;
+    double ymid = (yc0 + yc1) / 2;
+    xc0 = (x0 + xc0) / 2;
+    yc0 = (y0 + yc0) / 2;
+    xc1 = (xc1 + x1) / 2;
+    yc1 = (yc1 + y1) / 2;
+    double xc0m = (xc0 + xmid) / 2;
+    double yc0m = (yc0 + ymid) / 2;
+    double xmc1 = (xmid + xc1) / 2;
+    double ymc1 = (ymid + yc1) / 2;
+    xmid = (xc0m + xmc1) / 2;
+    ymid = (yc0m + ymc1) / 2;
+    if (std::isnan(xmid) || std::isnan(ymid)) {
+        return 0;
+    }
+    return pointCrossingsForCubic(px, py, x0, y0, xc0, yc0, xc0m, yc0m, xmid, ymid, level + 1)
+        + pointCrossingsForCubic(px, py, xmid, ymid, xmc1, ymc1, xc1, yc1, x1, y1, level + 1);
+}
+
+bool PathRecorder::contains(const FloatPoint& p, WindRule rule) const
+{
+    if (m_verbs.size() < 2) {
+        return false;
+    }
+
+    double px = p.x(), py = p.y();
+    double movx = 0, movy = 0, curx = 0, cury = 0;
+    int crossings = 0;
+    const jfloat* c = m_coords.data();
+    for (auto verb : m_verbs) {
+        switch (verb) {
+        case SEG_MOVETO:
+            if (cury != movy) {
+                crossings += pointCrossingsForLine(px, py, curx, cury, movx, movy);
+            }
+            movx = curx = c[0];
+            movy = cury = c[1];
+            c += 2;
+            break;
+        case SEG_LINETO:
+            crossings += pointCrossingsForLine(px, py, curx, cury, c[0], c[1]);
+            curx = c[0];
+            cury = c[1];
+            c += 2;
+            break;
+        case SEG_QUADTO:
+            crossings += pointCrossingsForQuad(px, py, curx, cury, c[0], c[1], c[2], c[3], 0);
+            curx = c[2];
+            cury = c[3];
+            c += 4;
+            break;
+        case SEG_CUBICTO:
+            crossings += pointCrossingsForCubic(px, py, curx, cury,
+                c[0], c[1], c[2], c[3], c[4], c[5], 0);
+            curx = c[4];
+            cury = c[5];
+            c += 6;
+            break;
+        case SEG_CLOSE:
+            if (cury != movy) {
+                crossings += pointCrossingsForLine(px, py, curx, cury, movx, movy);
+            }
+            curx = movx;
+            cury = movy;
+            break;
+        }
+    }
+    if (cury != movy) {
+        crossings += pointCrossingsForLine(px, py, curx, cury, movx, movy);
+    }
+
+    return rule == RULE_EVENODD ? (crossings & 1) : crossings;
+}
+
+FloatRect PathRecorder::boundingRect() const
+{
+    if (m_coords.isEmpty()) {
+        return FloatRect();
+    }
+    // Like Path2D.getBounds(), control points are included.
+    float minX = m_coords[0], maxX = m_coords[0];
+    float minY = m_coords[1], maxY = m_coords[1];
+    for (size_t i = 2; i + 1 < m_coords.size(); i += 2) {
+        minX = std::min(minX, m_coords[i]);
+        maxX = std::max(maxX, m_coords[i]);
+        minY = std::min(minY, m_coords[i + 1]);
+        maxY = std::max(maxY, m_coords[i + 1]);
+    }
+    return FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+} // namespace WebCore
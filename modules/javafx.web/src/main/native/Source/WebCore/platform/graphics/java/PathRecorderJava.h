@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#pragma once
+
+#include "FloatRect.h"
+#include "WindRule.h"
+
+#include <jni.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class AffineTransform;
+
+/*
+ * Native storage of the Java port Path geometry.
+ *
+ * Segments are kept in the same compact form as com.sun.javafx.geom.Path2D:
+ * one verb (a WCPathIterator.SEG_* constant) per segment and a flat array of
+ * float coordinates. Arcs, ellipses and rectangles are converted to cubic
+ * and line segments when they are added, so the recorded data can be handed
+ * to WCPath.setPath() as is, and queries like contains() and boundingRect()
+ * never need to call into Java.
+ */
+class PathRecorder {
+public:
+    PathRecorder() = default;
+
+    void clear();
+
+    bool isEmpty() const;
+    bool hasCurrentPoint() const { return !m_verbs.isEmpty(); }
+    FloatPoint currentPoint() const { return m_current; }
+
+    void moveTo(const FloatPoint&);
+    void lineTo(const FloatPoint&);
+    void quadTo(const FloatPoint& controlPoint, const FloatPoint&);
+    void cubicTo(const FloatPoint& controlPoint1, const FloatPoint& controlPoint2, const FloatPoint&);
+    void close();
+
+    void arcTo(const FloatPoint&, const FloatPoint&, float radius);
+    void ellipticalArc(const FloatPoint& center, float radiusX, float radiusY, float rotation,
+        float startAngle, float endAngle, bool anticlockwise);
+    void rect(const FloatRect&);
+    void ellipse(const FloatRect&);
+
+    void append(const PathRecorder&, const AffineTransform&);
+    void transform(const AffineTransform&);
+
+    bool contains(const FloatPoint&, WindRule) const;
+    FloatRect boundingRect() const;
+
+    const Vector<jbyte>& verbs() const { return m_verbs; }
+    const Vector<jfloat>& coords() const { return m_coords; }
+
+private:
+    // Starts a subpath at the given point if there is no current point.
+    void ensureSubpath(const FloatPoint&);
+    // Connects the start of an appended shape to the current point,
+    // as Path2D.append(shape, true) does.
+    void connectTo(const FloatPoint&);
+    // Appends cubic segments approximating an arc of the given ellipse.
+    void arcSegments(const FloatPoint& center, float radiusX, float radiusY,
+        float rotation, float startAngle, float sweep);
+
+    Vector<jbyte> m_verbs;
+    Vector<jfloat> m_coords;
+    FloatPoint m_moveTo;
+    FloatPoint m_current;
+};
+
+} // namespace WebCore
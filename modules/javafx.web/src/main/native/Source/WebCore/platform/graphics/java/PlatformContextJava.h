@@ -4,6 +4,7 @@
 #ifndef PlatformContextJava_h
 #define PlatformContextJava_h
 
+#include "AffineTransform.h"
 #include "GraphicsContext.h"
 #include "wtf/Noncopyable.h"
 #include "RenderingQueue.h"
@@ -37,15 +38,8 @@ namespace WebCore {
             m_path.clear();
         }
 
-        void addPath(PlatformPathPtr pPath) {
-            JNIEnv* env = WebCore_GetJavaEnv();
-
-            static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-                "addPath", "(Lcom/sun/webkit/graphics/WCPath;)V");
-            ASSERT(mid);
-
-            env->CallVoidMethod((jobject)*m_path.platformPath(), mid, (jobject)*pPath);
-            CheckAndClearException(env);
+        void addPath(const Path& path) {
+            m_path.addPath(path, AffineTransform());
         }
 
         PlatformPathPtr platformPath() {
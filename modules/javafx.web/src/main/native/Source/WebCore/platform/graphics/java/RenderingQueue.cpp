@@ -23,6 +23,77 @@ static Addr2ByteBuffer& getAddr2ByteBuffer()
     return container;
 }
 
+static ByteBufferPool::Statistics& poolStatistics()
+{
+    static ByteBufferPool::Statistics statistics = { };
+    return statistics;
+}
+
+/*static*/
+const ByteBufferPool::Statistics& ByteBufferPool::statistics()
+{
+    return poolStatistics();
+}
+
+char* ByteBufferPool::acquire(int& capacity)
+{
+    ByteBufferPool::Statistics& stat = poolStatistics();
+
+    // Take the smallest pooled block that fits; the queue normally asks
+    // for the same capacity every time, so the first match is exact.
+    size_t best = notFound;
+    for (size_t i = 0; i < m_freeBlocks.size(); ++i) {
+        if (m_freeBlocks[i].capacity >= capacity
+            && (best == notFound || m_freeBlocks[i].capacity < m_freeBlocks[best].capacity)) {
+            best = i;
+        }
+    }
+
+    char* storage;
+    if (best != notFound) {
+        storage = m_freeBlocks[best].storage;
+        capacity = m_freeBlocks[best].capacity;
+        m_freeBlocks.remove(best);
+        stat.pooledBytes -= capacity;
+        ++stat.reused;
+    } else {
+        storage = new char[capacity];
+        ++stat.allocated;
+    }
+
+    stat.liveBytes += capacity;
+    stat.liveBytesHighWater = std::max(stat.liveBytesHighWater, stat.liveBytes);
+    RQ_LOG_POOL_STATISTICS(ByteBufferPool, stat);
+    return storage;
+}
+
+void ByteBufferPool::release(char* storage, int capacity)
+{
+    ByteBufferPool::Statistics& stat = poolStatistics();
+    stat.liveBytes -= capacity;
+
+    if (m_freeBlocks.size() >= m_maxBlockCount
+        || stat.pooledBytes + capacity > MAX_POOLED_BYTES) {
+        delete[] storage;
+        ++stat.discarded;
+        return;
+    }
+
+    m_freeBlocks.append(Block { storage, capacity });
+    stat.pooledBytes += capacity;
+    stat.pooledBytesHighWater = std::max(stat.pooledBytesHighWater, stat.pooledBytes);
+}
+
+ByteBufferPool::~ByteBufferPool()
+{
+    ByteBufferPool::Statistics& stat = poolStatistics();
+    for (auto& block : m_freeBlocks) {
+        stat.pooledBytes -= block.capacity;
+        delete[] block.storage;
+    }
+    RQ_LOG_POOL_STATISTICS(ByteBufferPool, stat);
+}
+
 /*static*/
 RefPtr<RenderingQueue> RenderingQueue::create(
     const JLObject &jRQ,
@@ -43,7 +114,7 @@ RenderingQueue& RenderingQueue::freeSpace(int size) {
         }
     }
     if (!m_buffer) {
-        m_buffer = RefPtr<ByteBuffer>(ByteBuffer::create(std::max(m_capacity, size)));
+        m_buffer = RefPtr<ByteBuffer>(ByteBuffer::create(m_bufferPool, std::max(m_capacity, size)));
     }
     return *this;
 }
@@ -16,11 +16,65 @@ namespace WebCore {
 
 class RQRef;
 
+/*
+ * A free list of ByteBuffer storage blocks owned by a RenderingQueue.
+ * When a flushed ByteBuffer is released by the Java side (see twkRelease)
+ * its storage goes back to the pool of the queue that allocated it and is
+ * handed out again by the next RenderingQueue::freeSpace call instead of
+ * being deleted and reallocated.
+ *
+ * The pool is ref-counted by the queue and by every ByteBuffer created from
+ * it, so buffers still held by Java can outlive their RenderingQueue.
+ * The total amount of pooled storage across all pools is bounded by
+ * MAX_POOLED_BYTES; blocks above the cap are freed as before.
+ *
+ * All the methods are called on the Event thread.
+ */
+class ByteBufferPool : public RefCounted<ByteBufferPool> {
+    RQ_LOG_INSTANCE_COUNT(ByteBufferPool)
+public:
+    static const size_t MAX_POOLED_BYTES = 0x400000;
+
+    struct Statistics {
+        size_t allocated;       // blocks allocated with new[]
+        size_t reused;          // allocations avoided by taking a pooled block
+        size_t discarded;       // released blocks freed because a cap was hit
+        size_t pooledBytes;     // storage currently kept in all free lists
+        size_t pooledBytesHighWater;
+        size_t liveBytes;       // storage currently in use by ByteBuffers
+        size_t liveBytesHighWater;
+    };
+
+    static RefPtr<ByteBufferPool> create(size_t maxBlockCount) {
+        return adoptRef(new ByteBufferPool(maxBlockCount));
+    }
+
+    char* acquire(int& capacity);
+    void release(char* storage, int capacity);
+
+    static const Statistics& statistics();
+
+    ~ByteBufferPool();
+
+private:
+    ByteBufferPool(size_t maxBlockCount) :
+        m_maxBlockCount(maxBlockCount)
+    {}
+
+    struct Block {
+        char* storage;
+        int capacity;
+    };
+
+    size_t m_maxBlockCount;
+    Vector<Block> m_freeBlocks;
+};
+
 class ByteBuffer : public RefCounted<ByteBuffer> {
     RQ_LOG_INSTANCE_COUNT(ByteBuffer)
 public:
-    static RefPtr<ByteBuffer> create(int capacity) {
-        return adoptRef(new ByteBuffer(capacity));
+    static RefPtr<ByteBuffer> create(RefPtr<ByteBufferPool> pool, int capacity) {
+        return adoptRef(new ByteBuffer(pool, capacity));
     }
 
     JLObject createDirectByteBuffer(JNIEnv* env) {
@@ -56,16 +110,19 @@ public:
     bool isEmpty() { return m_position == 0; }
 
     ~ByteBuffer() {
-        delete[] m_buffer;
+        m_pool->release(m_buffer, m_capacity);
     }
 
 private:
-    ByteBuffer(int capacity) :
-        m_buffer(new char[capacity]),
+    ByteBuffer(RefPtr<ByteBufferPool> pool, int capacity) :
+        m_pool(pool),
         m_capacity(capacity),
         m_position(0)
-    {}
+    {
+        m_buffer = m_pool->acquire(m_capacity);
+    }
 
+    RefPtr<ByteBufferPool> m_pool;
     char* m_buffer;
     int m_capacity;
     int m_position;
@@ -136,6 +193,7 @@ private:
         m_rqoRenderingQueue(RQRef::create(jRQ)),
         m_capacity(capacity),
         m_autoFlush(autoFlush),
+        m_bufferPool(ByteBufferPool::create(MAX_BUFFER_COUNT)),
         m_buffer(nullptr)
     {}
 
@@ -148,6 +206,7 @@ private:
 
     int m_capacity;
     bool m_autoFlush;
+    RefPtr<ByteBufferPool> m_bufferPool; // recycled storage for m_buffer
     RefPtr<ByteBuffer> m_buffer; // ref to the current ByteBuffer
 
 };
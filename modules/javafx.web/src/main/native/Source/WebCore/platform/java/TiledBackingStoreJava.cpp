@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ */
+#include "config.h"
+
+#include "TiledBackingStoreJava.h"
+
+#include "FrameView.h"
+#include "GraphicsContext.h"
+#include "Page.h"
+#include "Region.h"
+
+namespace WebCore {
+
+TiledBackingStoreJava::TiledBackingStoreJava(int tileSize, size_t maxBytes)
+    : m_tileSize(tileSize)
+    , m_maxTiles(std::max<size_t>(1, maxBytes / (4 * static_cast<size_t>(tileSize) * tileSize)))
+{
+}
+
+static int tileIndex(int coordinate, int tileSize)
+{
+    // Rounded down, RTL documents have negative contents coordinates
+    return coordinate >= 0 ? coordinate / tileSize : (coordinate + 1) / tileSize - 1;
+}
+
+IntRect TiledBackingStoreJava::tileRect(const IntPoint& index) const
+{
+    return IntRect(index.x() * m_tileSize, index.y() * m_tileSize, m_tileSize, m_tileSize);
+}
+
+bool TiledBackingStoreJava::canPaint(FrameView& view) const
+{
+    // Fixed objects and objects repainted on scroll are drawn relative to
+    // the visible rect, so their tiles would go stale once scrolled away.
+    Page* page = view.frame().page();
+    return page && page->deviceScaleFactor() == 1
+        && view.canBlitOnScroll()
+        && !view.hasViewportConstrainedObjects();
+}
+
+TiledBackingStoreJava::Tile* TiledBackingStoreJava::tileAt(const IntPoint& index)
+{
+    auto it = m_tiles.find(index);
+    if (it != m_tiles.end()) {
+        return it->value.get();
+    }
+
+    std::unique_ptr<ImageBuffer> buffer = ImageBuffer::create(FloatSize(m_tileSize, m_tileSize), Unaccelerated);
+    if (!buffer) {
+        return nullptr;
+    }
+    std::unique_ptr<Tile> tile(new Tile { WTFMove(buffer), tileRect(index), 0 });
+    return m_tiles.add(index, WTFMove(tile)).iterator->value.get();
+}
+
+void TiledBackingStoreJava::renderTile(FrameView& view, Tile& tile, const IntRect& tileRect)
+{
+    if (tile.dirtyRect.isEmpty()) {
+        return;
+    }
+
+    GraphicsContext& context = tile.buffer->context();
+    GraphicsContextStateSaver stateSaver(context);
+    context.translate(-tileRect.x(), -tileRect.y());
+    context.clip(tile.dirtyRect);
+    context.clearRect(tile.dirtyRect);
+    view.paintContents(context, tile.dirtyRect);
+    tile.dirtyRect = IntRect();
+}
+
+bool TiledBackingStoreJava::paint(GraphicsContext& context, FrameView& view, const IntRect& windowRect)
+{
+    if (!canPaint(view)) {
+        clear();
+        return false;
+    }
+    if (view.clipsRepaints()) {
+        // A new view, whose repaints out of view were dropped so far
+        clear();
+        view.setClipsRepaints(false);
+    }
+
+    ++m_paintCount;
+
+    IntRect visibleWindowRect = view.contentsToWindow(view.visibleContentRect());
+    IntRect dirtyWindowRect = intersection(windowRect, visibleWindowRect);
+    if (!dirtyWindowRect.isEmpty()) {
+        IntRect dirtyRect = view.windowToContents(dirtyWindowRect);
+        IntSize offset = dirtyWindowRect.location() - dirtyRect.location();
+
+        GraphicsContextStateSaver stateSaver(context);
+        context.clip(dirtyWindowRect);
+        context.translate(offset.width(), offset.height());
+
+        int lastRow = tileIndex(dirtyRect.maxY() - 1, m_tileSize);
+        int lastColumn = tileIndex(dirtyRect.maxX() - 1, m_tileSize);
+        for (int row = tileIndex(dirtyRect.y(), m_tileSize); row <= lastRow; ++row) {
+            for (int column = tileIndex(dirtyRect.x(), m_tileSize); column <= lastColumn; ++column) {
+                IntPoint index(column, row);
+                IntRect rect = tileRect(index);
+                Tile* tile = tileAt(index);
+                if (!tile) {
+                    // No image for the tile, paint the contents directly
+                    GraphicsContextStateSaver tileStateSaver(context);
+                    rect.intersect(dirtyRect);
+                    context.clip(rect);
+                    view.paintContents(context, rect);
+                    continue;
+                }
+                tile->lastUsed = m_paintCount;
+                renderTile(view, *tile, rect);
+                context.drawImageBuffer(*tile->buffer, rect.location());
+            }
+        }
+    }
+
+    // The scrollbars and the scroll corner are not part of the tiles
+    Region chromeRegion(windowRect);
+    chromeRegion.subtract(visibleWindowRect);
+    for (const auto& rect : chromeRegion.rects()) {
+        view.paint(context, rect);
+    }
+
+    releaseTiles();
+    return true;
+}
+
+void TiledBackingStoreJava::invalidate(FrameView& view, const IntRect& windowRect)
+{
+    if (m_tiles.isEmpty()) {
+        return;
+    }
+
+    IntRect rect = view.windowToContents(windowRect);
+    for (auto& entry : m_tiles) {
+        IntRect dirtyRect = intersection(tileRect(entry.key), rect);
+        if (!dirtyRect.isEmpty()) {
+            entry.value->dirtyRect.unite(dirtyRect);
+        }
+    }
+}
+
+void TiledBackingStoreJava::clear()
+{
+    m_tiles.clear();
+}
+
+void TiledBackingStoreJava::releaseTiles()
+{
+    // Tiles drawn by the current paint are kept, even over the budget
+    while (m_tiles.size() > m_maxTiles) {
+        auto oldest = m_tiles.end();
+        for (auto it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+            if (it->value->lastUsed != m_paintCount
+                    && (oldest == m_tiles.end() || it->value->lastUsed < oldest->value->lastUsed)) {
+                oldest = it;
+            }
+        }
+        if (oldest == m_tiles.end()) {
+            return;
+        }
+        m_tiles.remove(oldest);
+    }
+}
+
+} // namespace WebCore
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ */
+
+#pragma once
+
+#include "ImageBuffer.h"
+#include "IntPointHash.h"
+#include "IntRect.h"
+
+#include <memory>
+#include <wtf/HashMap.h>
+
+namespace WebCore {
+
+class FrameView;
+class GraphicsContext;
+
+/*
+ * Tiles of the main frame contents of a page painted without a root
+ * compositing layer. The tiles are ImageBuffers (render target images on
+ * the Java side) laid out on a grid in contents coordinates, so they stay
+ * valid when the page is scrolled.
+ *
+ * A repaint only marks the parts of the tiles it touches as dirty. Painting
+ * a rect renders the dirty parts of the tiles it covers and then draws the
+ * tiles, so contents scrolled back into view are neither painted nor
+ * serialized to the RenderingQueue again. The repaints of the main frame
+ * view are not clipped to its visible rect while the tiles are used, or
+ * contents changed out of view would be left stale.
+ *
+ * Views with fixed or sticky objects, with objects that are repainted on
+ * scroll, or with a device scale factor other than 1 are painted directly.
+ * When the tiles take more than the memory budget, the least recently
+ * drawn ones are released.
+ *
+ * Only used on the main thread.
+ */
+class TiledBackingStoreJava {
+public:
+    TiledBackingStoreJava(int tileSize, size_t maxBytes);
+
+    // Paints windowRect of the view. Returns false, without painting, if
+    // the view can not be painted from tiles.
+    bool paint(GraphicsContext&, FrameView&, const IntRect& windowRect);
+
+    void invalidate(FrameView&, const IntRect& windowRect);
+    void clear();
+
+private:
+    struct Tile {
+        std::unique_ptr<ImageBuffer> buffer;
+        IntRect dirtyRect; // contents coordinates
+        unsigned lastUsed;
+    };
+
+    bool canPaint(FrameView&) const;
+    IntRect tileRect(const IntPoint& index) const;
+    Tile* tileAt(const IntPoint& index);
+    void renderTile(FrameView&, Tile&, const IntRect& tileRect);
+    void releaseTiles();
+
+    typedef HashMap<IntPoint, std::unique_ptr<Tile>> TileMap;
+
+    const int m_tileSize;
+    const size_t m_maxTiles;
+    TileMap m_tiles;
+    unsigned m_paintCount { 0 };
+};
+
+} // namespace WebCore
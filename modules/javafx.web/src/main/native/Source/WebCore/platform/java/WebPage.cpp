@@ -88,6 +88,7 @@
 #include "Storage/WebDatabaseProvider.h"
 #include "Storage/StorageNamespaceImpl.h"
 #include "StorageNamespaceProvider.h"
+#include "TiledBackingStoreJava.h"
 #include "VisitedLinkStoreJava.h"
 #include "WebKitVersion.h" //generated
 #include "Widget.h"
@@ -134,7 +135,8 @@ WebPage::WebPage(std::unique_ptr<Page> page)
     :
     // m_page(page)
     // ,
-     m_suppressNextKeypressEvent(false)
+     m_repaintTimer(*this, &WebPage::flushJavaRepaint)
+    , m_suppressNextKeypressEvent(false)
     , m_isDebugging(false)
 #if USE(ACCELERATED_COMPOSITING)
     , m_syncLayers(false)
@@ -179,6 +181,11 @@ JLObject WebPage::jobjectFromPage(Page* page)
         : NULL;
 }
 
+void WebPage::enableTiledBackingStore(int tileSize, size_t maxBytes)
+{
+    m_backingStore = std::make_unique<TiledBackingStoreJava>(tileSize, maxBytes);
+}
+
 void WebPage::setSize(const IntSize& size)
 {
     Frame* mainFrame = (Frame*)&m_page->mainFrame();
@@ -188,6 +195,9 @@ void WebPage::setSize(const IntSize& size)
         return;
     }
 
+    if (m_backingStore) {
+        m_backingStore->clear();
+    }
     frameView->resize(size);
     frameView->scheduleRelayout();
 
@@ -237,6 +247,7 @@ void WebPage::prePaint() {
             m_syncLayers = false;
             syncLayers();
         }
+        flushJavaRepaint();
         return;
     }
 #endif
@@ -246,6 +257,8 @@ void WebPage::prePaint() {
         // Updating layout & styles precedes normal painting.
         frameView->updateLayoutAndStyleIfNeededRecursive();
     }
+    // Report the damage of the layout along with whatever was pending
+    flushJavaRepaint();
 }
 
 void WebPage::paint(jobject rq, jint x, jint y, jint w, jint h)
@@ -272,7 +285,9 @@ void WebPage::paint(jobject rq, jint x, jint y, jint w, jint h)
     JSGlobalContextRef globalContext = toGlobalRef(mainFrame->script().globalObject(mainThreadNormalWorld())->globalExec());
     JSC::JSLockHolder sw(toJS(globalContext)); // TODO-java: was JSC::APIEntryShim sw( toJS(globalContext) );
 
-    frameView->paint(gc, IntRect(x, y, w, h));
+    if (!m_backingStore || !m_backingStore->paint(gc, *frameView, IntRect(x, y, w, h))) {
+        frameView->paint(gc, IntRect(x, y, w, h));
+    }
     if (m_page->settings().showDebugBorders()) {
         drawDebugLed(gc, IntRect(x, y, w, h), Color(0, 0, 255, 128));
     }
@@ -351,26 +366,104 @@ void WebPage::repaint(const IntRect& rect)
         m_rootLayer->setNeedsDisplayInRect(rect);
     }
 #endif
+    FrameView* frameView = m_page->mainFrame().view();
+    if (m_backingStore && frameView) {
+        m_backingStore->invalidate(*frameView, rect);
+        // Repaints out of view only concern the tiles
+        requestJavaRepaint(intersection(rect, IntRect(IntPoint(), frameView->size())));
+        return;
+    }
     requestJavaRepaint(rect);
 }
 
+// Beyond this many rects, or when the rects cover most of their bounds,
+// the bounds are repainted instead.
+static const size_t maxRepaintRects = 16;
+// Extra cost of a repaint rect, in pixels, when deciding whether two rects
+// are repainted separately or as their union.
+static const uint64_t repaintRectCost = 64 * 64;
+
+static uint64_t rectArea(const IntRect& rect)
+{
+    return static_cast<uint64_t>(rect.width()) * rect.height();
+}
+
+static Vector<IntRect> coalesceRepaintRects(const Region& region)
+{
+    Vector<IntRect> rects = region.rects();
+    const IntRect& bounds = region.bounds();
+    uint64_t area = 0;
+    for (const auto& rect : rects) {
+        area += rectArea(rect);
+    }
+    if (rects.size() > maxRepaintRects || area * 4 >= rectArea(bounds) * 3) {
+        return { bounds };
+    }
+
+    Vector<IntRect> merged;
+    for (IntRect rect : rects) {
+        for (size_t i = 0; i < merged.size();) {
+            IntRect u = unionRect(merged[i], rect);
+            if (rectArea(u) <= rectArea(merged[i]) + rectArea(rect) + repaintRectCost) {
+                // The union may now reach rects already passed
+                rect = u;
+                merged.remove(i);
+                i = 0;
+            } else {
+                ++i;
+            }
+        }
+        merged.append(rect);
+    }
+    return merged;
+}
+
 void WebPage::requestJavaRepaint(const IntRect& rect)
 {
+    if (rect.isEmpty()) {
+        return;
+    }
+    m_pendingRepaint.unite(Region(rect));
+    if (!m_repaintTimer.isActive()) {
+        m_repaintTimer.startOneShot(0_s);
+    }
+}
+
+void WebPage::flushJavaRepaint()
+{
+    m_repaintTimer.stop();
+    if (m_pendingRepaint.isEmpty()) {
+        return;
+    }
+    Vector<IntRect> rects = coalesceRepaintRects(m_pendingRepaint);
+    m_pendingRepaint = Region();
+
     JNIEnv* env = WebCore_GetJavaEnv();
 
     static jmethodID mid = env->GetMethodID(
             PG_GetWebPageClass(env),
             "fwkRepaint",
-            "(IIII)V");
+            "([I)V");
     ASSERT(mid);
 
+    Vector<jint> coords;
+    coords.reserveInitialCapacity(rects.size() * 4);
+    for (const auto& rect : rects) {
+        coords.uncheckedAppend(rect.x());
+        coords.uncheckedAppend(rect.y());
+        coords.uncheckedAppend(rect.width());
+        coords.uncheckedAppend(rect.height());
+    }
+    JLocalRef<jintArray> jcoords(env->NewIntArray(coords.size()));
+    if (CheckAndClearException(env) || !jcoords) { // OOME
+        return;
+    }
+    env->SetIntArrayRegion(jcoords, 0, coords.size(), coords.data());
+
     env->CallVoidMethod(
             jobjectFromPage(m_page.get()),
             mid,
-            rect.x(),
-            rect.y(),
-            rect.width(),
-            rect.height());
+            (jintArray)jcoords);
     CheckAndClearException(env);
 }
 
@@ -825,8 +918,16 @@ public:
     void setLocalStorageDatabasePath(const String& path) {
         m_localStorageDatabasePath = path;
     }
+
+    // Applied to the local storage namespace when the page first uses it
+    void setLocalStorageSyncPolicy(double syncInterval, unsigned maxItemsToSync) {
+        m_localStorageSyncInterval = syncInterval;
+        m_localStorageMaxItemsToSync = maxItemsToSync;
+    }
 private:
     String m_localStorageDatabasePath;
+    double m_localStorageSyncInterval { -1 };
+    unsigned m_localStorageMaxItemsToSync { 0 };
 
     RefPtr<StorageNamespace> createSessionStorageNamespace(Page&, unsigned quota) override
     {
@@ -835,7 +936,11 @@ private:
 
     RefPtr<StorageNamespace> createLocalStorageNamespace(unsigned quota) override
     {
-        return WebKit::StorageNamespaceImpl::getOrCreateLocalStorageNamespace(m_localStorageDatabasePath, quota);
+        auto storageNamespace = WebKit::StorageNamespaceImpl::getOrCreateLocalStorageNamespace(m_localStorageDatabasePath, quota);
+        if (m_localStorageSyncInterval >= 0) {
+            storageNamespace->setSyncPolicy(m_localStorageSyncInterval, m_localStorageMaxItemsToSync);
+        }
+        return WTFMove(storageNamespace);
     }
 
     RefPtr<StorageNamespace> createTransientLocalStorageNamespace(SecurityOrigin&, unsigned quota) override
@@ -855,6 +960,8 @@ namespace {
 
 bool s_useJIT;
 bool s_useDFGJIT;
+int s_tileSize;
+size_t s_tileCacheBytes;
 
 }  // namespace
 
@@ -863,9 +970,12 @@ extern "C" {
 #endif
 
 JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkInitWebCore
-    (JNIEnv* env, jclass self, jboolean useJIT, jboolean useDFGJIT) {
+    (JNIEnv* env, jclass self, jboolean useJIT, jboolean useDFGJIT,
+     jint tileSize, jint tileCacheMegabytes) {
     s_useJIT = useJIT;
     s_useDFGJIT = useDFGJIT;
+    s_tileSize = tileSize;
+    s_tileCacheBytes = tileCacheMegabytes > 0 ? static_cast<size_t>(tileCacheMegabytes) << 20 : 0;
 }
 
 JNIEXPORT jlong JNICALL Java_com_sun_webkit_WebPage_twkCreatePage
@@ -921,7 +1031,11 @@ JNIEXPORT jlong JNICALL Java_com_sun_webkit_WebPage_twkCreatePage
 
     pc.backForwardClient = BackForwardList::create();
 
-    return ptr_to_jlong(new WebPage(std::unique_ptr<Page>(new Page(WTFMove(pc)))));
+    WebPage* webPage = new WebPage(std::unique_ptr<Page>(new Page(WTFMove(pc))));
+    if (s_tileSize > 0) {
+        webPage->enableTiledBackingStore(s_tileSize, s_tileCacheBytes);
+    }
+    return ptr_to_jlong(webPage);
 }
 
 JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkInit
@@ -1059,22 +1173,20 @@ JNIEXPORT jstring JNICALL Java_com_sun_webkit_WebPage_twkGetURL
     return doc->url().string().toJavaString(env).releaseLocal();
 }
 
-JNIEXPORT jstring JNICALL Java_com_sun_webkit_WebPage_twkGetInnerText
-    (JNIEnv* env, jobject self, jlong pFrame)
+static String frameInnerText(Frame* frame)
 {
-    Frame* frame = static_cast<Frame*>(jlong_to_ptr(pFrame));
     if (!frame) {
-        return 0;
+        return String();
     }
 
     Document* document = frame->document();
     if (!document) {
-        return 0;
+        return String();
     }
 
     Element* documentElement = document->documentElement();
     if (!documentElement) {
-        return 0;
+        return String();
     }
 
     FrameView* frameView = frame->view();
@@ -1082,7 +1194,21 @@ JNIEXPORT jstring JNICALL Java_com_sun_webkit_WebPage_twkGetInnerText
         frameView->layout();
     }
 
-    return documentElement->innerText().toJavaString(env).releaseLocal();
+    return documentElement->innerText();
+}
+
+JNIEXPORT jstring JNICALL Java_com_sun_webkit_WebPage_twkGetInnerText
+    (JNIEnv* env, jobject self, jlong pFrame)
+{
+    Frame* frame = static_cast<Frame*>(jlong_to_ptr(pFrame));
+    return frameInnerText(frame).toJavaString(env).releaseLocal();
+}
+
+JNIEXPORT jobject JNICALL Java_com_sun_webkit_WebPage_twkGetInnerTextBuffer
+    (JNIEnv* env, jobject self, jlong pFrame)
+{
+    Frame* frame = static_cast<Frame*>(jlong_to_ptr(pFrame));
+    return frameInnerText(frame).toJavaNativeText(env).releaseLocal();
 }
 
 JNIEXPORT jstring JNICALL Java_com_sun_webkit_WebPage_twkGetRenderTree
@@ -2190,26 +2316,38 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkSetEditable
     page->setEditable(jbool_to_bool(editable));
 }
 
-JNIEXPORT jstring JNICALL Java_com_sun_webkit_WebPage_twkGetHtml
-    (JNIEnv* env, jobject self, jlong pFrame)
+static String frameHtml(Frame* frame)
 {
-    Frame* frame = static_cast<Frame*>(jlong_to_ptr(pFrame));
     if (!frame) {
-        return 0;
+        return String();
     }
 
     Document* document = frame->document();
     if (!document || !document->isHTMLDocument()) {
-        return 0;
+        return String();
     }
 
     HTMLElement* documentElement =
             static_cast<HTMLElement*>(document->documentElement());
     if (!documentElement) {
-        return 0;
+        return String();
     }
 
-    return documentElement->outerHTML().toJavaString(env).releaseLocal();
+    return documentElement->outerHTML();
+}
+
+JNIEXPORT jstring JNICALL Java_com_sun_webkit_WebPage_twkGetHtml
+    (JNIEnv* env, jobject self, jlong pFrame)
+{
+    Frame* frame = static_cast<Frame*>(jlong_to_ptr(pFrame));
+    return frameHtml(frame).toJavaString(env).releaseLocal();
+}
+
+JNIEXPORT jobject JNICALL Java_com_sun_webkit_WebPage_twkGetHtmlBuffer
+    (JNIEnv* env, jobject self, jlong pFrame)
+{
+    Frame* frame = static_cast<Frame*>(jlong_to_ptr(pFrame));
+    return frameHtml(frame).toJavaNativeText(env).releaseLocal();
 }
 
 JNIEXPORT jboolean JNICALL Java_com_sun_webkit_WebPage_twkGetUsePageCache
@@ -2306,6 +2444,17 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkSetLocalStorageDatabasePat
         ->setLocalStorageDatabasePath(settings.localStorageDatabasePath());
 }
 
+JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkSetLocalStorageSyncPolicy
+  (JNIEnv*, jobject, jlong pPage, jint syncIntervalMillis, jint maxItemsToSync)
+{
+    ASSERT(pPage);
+    Page* page = WebPage::pageFromJLong(pPage);
+    ASSERT(page);
+    static_cast<WebStorageNamespaceProviderJava*>(
+      &page->storageNamespaceProvider())
+        ->setLocalStorageSyncPolicy(syncIntervalMillis / 1000.0, maxItemsToSync);
+}
+
 JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkSetLocalStorageEnabled
   (JNIEnv*, jobject, jlong pPage, jboolean enabled)
 {
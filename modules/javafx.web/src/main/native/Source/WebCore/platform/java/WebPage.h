@@ -10,7 +10,9 @@
 #endif
 #include "IntRect.h"
 #include "PrintContext.h"
+#include "Region.h"
 #include "ScrollTypes.h"
+#include "Timer.h"
 
 #include <jni.h> // todo tav remove when building w/ pch
 #include <wtf/java/JavaRef.h>
@@ -27,6 +29,7 @@ class Node;
 class Page;
 class PlatformKeyboardEvent;
 class TextureMapper;
+class TiledBackingStoreJava;
 
 class WebPage
 #if USE(ACCELERATED_COMPOSITING)
@@ -63,6 +66,7 @@ public:
 
     static JLObject jobjectFromPage(Page* page);
 
+    void enableTiledBackingStore(int tileSize, size_t maxBytes);
     void setSize(const IntSize&);
     void prePaint();
     void paint(jobject, jint, jint, jint, jint);
@@ -87,6 +91,7 @@ public:
 
 private:
     void requestJavaRepaint(const IntRect&);
+    void flushJavaRepaint();
 #if USE(ACCELERATED_COMPOSITING)
     void markForSync();
     void syncLayers();
@@ -118,6 +123,12 @@ private:
 
     std::unique_ptr<Page> m_page;
     std::unique_ptr<PrintContext> m_printContext;
+    std::unique_ptr<TiledBackingStoreJava> m_backingStore;
+
+    // Damage not reported to Java yet, flushed by prePaint() or, at the
+    // latest, when m_repaintTimer fires.
+    Region m_pendingRepaint;
+    Timer m_repaintTimer;
 
 #if USE(ACCELERATED_COMPOSITING)
     std::unique_ptr<GraphicsLayer> m_rootLayer;
@@ -27,6 +27,7 @@
 
 #include <wtf/HashMap.h>
 #include <wtf/RefCounted.h>
+#include <wtf/Vector.h>
 #include <wtf/text/StringHash.h>
 #include <wtf/text/WTFString.h>
 
@@ -57,12 +58,15 @@ public:
 
 private:
     explicit StorageMap(unsigned quota);
-    void invalidateIterator();
-    void setIteratorToIndex(unsigned);
+    void addKey(const String&);
+    void removeKey(const String&);
 
     HashMap<String, String> m_map;
-    HashMap<String, String>::iterator m_iterator;
-    unsigned m_iteratorIndex;
+
+    // The keys of m_map by index, for key(). Removing a key moves the last
+    // one into its place, so the order only changes when a key is removed.
+    Vector<String> m_keys;
+    HashMap<String, unsigned> m_keyIndices;
 
     unsigned m_quotaSize; // Measured in bytes.
     unsigned m_currentLength; // Measured in UChars.
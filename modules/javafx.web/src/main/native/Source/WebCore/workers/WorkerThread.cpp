@@ -156,7 +156,7 @@ void WorkerThread::workerThreadStart(void* thread)
 void WorkerThread::workerThread()
 {
 #if PLATFORM(JAVA)
-    WTF::AutoAttachToJavaThread autoAttach(true);
+    WTF::AutoAttachToJavaThread autoAttach;
 #endif
     // Propagate the mainThread's fenv to workers.
 #if PLATFORM(IOS)
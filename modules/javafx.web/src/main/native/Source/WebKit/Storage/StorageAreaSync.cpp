@@ -40,14 +40,6 @@ using namespace WebCore;
 
 namespace WebKit {
 
-// If the StorageArea undergoes rapid changes, don't sync each change to disk.
-// Instead, queue up a batch of items to sync and actually do the sync at the following interval.
-static const double StorageSyncInterval = 1.0;
-
-// A sane limit on how many items we'll schedule to sync all at once.  This makes it
-// much harder to starve the rest of LocalStorage and the OS's IO subsystem in general.
-static const int MaxiumItemsToSync = 100;
-
 inline StorageAreaSync::StorageAreaSync(RefPtr<StorageSyncManager>&& storageSyncManager, Ref<StorageAreaImpl>&& storageArea, const String& databaseIdentifier)
     : m_syncTimer(*this, &StorageAreaSync::syncTimerFired)
     , m_itemsCleared(false)
@@ -118,7 +110,7 @@ void StorageAreaSync::scheduleItemForSync(const String& key, const String& value
 
     m_changedItems.set(key, value);
     if (!m_syncTimer.isActive()) {
-        m_syncTimer.startOneShot(StorageSyncInterval);
+        m_syncTimer.startOneShot(m_syncManager->syncInterval());
 
         // The following is balanced by the call to enableSuddenTermination in the
         // syncTimerFired function.
@@ -134,7 +126,7 @@ void StorageAreaSync::scheduleClear()
     m_changedItems.clear();
     m_itemsCleared = true;
     if (!m_syncTimer.isActive()) {
-        m_syncTimer.startOneShot(StorageSyncInterval);
+        m_syncTimer.startOneShot(m_syncManager->syncInterval());
 
         // The following is balanced by the call to enableSuddenTermination in the
         // syncTimerFired function.
@@ -153,7 +145,7 @@ void StorageAreaSync::scheduleCloseDatabase()
     m_syncCloseDatabase = true;
 
     if (!m_syncTimer.isActive()) {
-        m_syncTimer.startOneShot(StorageSyncInterval);
+        m_syncTimer.startOneShot(m_syncManager->syncInterval());
 
         // The following is balanced by the call to enableSuddenTermination in the
         // syncTimerFired function.
@@ -173,7 +165,7 @@ void StorageAreaSync::syncTimerFired()
         // previous one. But, if we're shutting down, schedule it anyway.
         if (m_syncInProgress && !m_finalSyncScheduled) {
             ASSERT(!m_syncTimer.isActive());
-            m_syncTimer.startOneShot(StorageSyncInterval);
+            m_syncTimer.startOneShot(m_syncManager->syncInterval());
             return;
         }
 
@@ -183,10 +175,11 @@ void StorageAreaSync::syncTimerFired()
             m_itemsCleared = false;
         }
 
+        unsigned maxItemsToSync = m_syncManager->maxItemsToSync();
         HashMap<String, String>::iterator changed_it = m_changedItems.begin();
         HashMap<String, String>::iterator changed_end = m_changedItems.end();
-        for (int count = 0; changed_it != changed_end; ++count, ++changed_it) {
-            if (count >= MaxiumItemsToSync && !m_finalSyncScheduled) {
+        for (unsigned count = 0; changed_it != changed_end; ++count, ++changed_it) {
+            if (count >= maxItemsToSync && !m_finalSyncScheduled) {
                 partialSync = true;
                 break;
             }
@@ -220,7 +213,7 @@ void StorageAreaSync::syncTimerFired()
     if (partialSync) {
         // If we didn't finish syncing, then we need to finish the job later.
         ASSERT(!m_syncTimer.isActive());
-        m_syncTimer.startOneShot(StorageSyncInterval);
+        m_syncTimer.startOneShot(m_syncManager->syncInterval());
     } else {
         // The following is balanced by the calls to disableSuddenTermination in the
         // scheduleItemForSync, scheduleClear, and scheduleFinalSync functions.
@@ -405,46 +398,54 @@ void StorageAreaSync::sync(bool clearItems, const HashMap<String, String>& items
     // to write new items created after the request to delete the db.
     if (m_syncCloseDatabase) {
         m_syncCloseDatabase = false;
-        m_database.close();
+        closeDatabase();
         return;
     }
 
     SQLiteTransactionInProgressAutoCounter transactionCounter;
 
+    // The statements are prepared once per open database and reused by
+    // every sync.
+    SQLiteStatement* insert = cachedStatement(m_insertStatement, "INSERT INTO ItemTable VALUES (?, ?)");
+    if (!insert) {
+        LOG_ERROR("Failed to prepare insert statement - cannot write to local storage database");
+        return;
+    }
+
+    SQLiteStatement* remove = cachedStatement(m_removeStatement, "DELETE FROM ItemTable WHERE key=?");
+    if (!remove) {
+        LOG_ERROR("Failed to prepare delete statement - cannot write to local storage database");
+        return;
+    }
+
+    // Clearing and writing the items is one transaction, so the database
+    // never holds a cleared area without its new items.
+    SQLiteTransaction transaction(m_database);
+    transaction.begin();
+
     // If the clear flag is set, then we clear all items out before we write any new ones in.
     if (clearItems) {
-        SQLiteStatement clear(m_database, "DELETE FROM ItemTable");
-        if (clear.prepare() != SQLITE_OK) {
+        SQLiteStatement* clear = cachedStatement(m_clearStatement, "DELETE FROM ItemTable");
+        if (!clear) {
             LOG_ERROR("Failed to prepare clear statement - cannot write to local storage database");
+            transaction.rollback();
             return;
         }
 
-        int result = clear.step();
+        int result = clear->step();
+        clear->reset();
         if (result != SQLITE_DONE) {
             LOG_ERROR("Failed to clear all items in the local storage database - %i", result);
+            transaction.rollback();
             return;
         }
     }
 
-    SQLiteStatement insert(m_database, "INSERT INTO ItemTable VALUES (?, ?)");
-    if (insert.prepare() != SQLITE_OK) {
-        LOG_ERROR("Failed to prepare insert statement - cannot write to local storage database");
-        return;
-    }
-
-    SQLiteStatement remove(m_database, "DELETE FROM ItemTable WHERE key=?");
-    if (remove.prepare() != SQLITE_OK) {
-        LOG_ERROR("Failed to prepare delete statement - cannot write to local storage database");
-        return;
-    }
-
     HashMap<String, String>::const_iterator end = items.end();
 
-    SQLiteTransaction transaction(m_database);
-    transaction.begin();
     for (HashMap<String, String>::const_iterator it = items.begin(); it != end; ++it) {
         // Based on the null-ness of the second argument, decide whether this is an insert or a delete.
-        SQLiteStatement& query = it->value.isNull() ? remove : insert;
+        SQLiteStatement& query = it->value.isNull() ? *remove : *insert;
 
         query.bindText(1, it->key);
 
@@ -453,16 +454,40 @@ void StorageAreaSync::sync(bool clearItems, const HashMap<String, String>& items
             query.bindBlob(2, it->value);
 
         int result = query.step();
+        query.reset();
         if (result != SQLITE_DONE) {
             LOG_ERROR("Failed to update item in the local storage database - %i", result);
             break;
         }
-
-        query.reset();
     }
     transaction.commit();
 }
 
+SQLiteStatement* StorageAreaSync::cachedStatement(std::unique_ptr<SQLiteStatement>& statement, const char* query)
+{
+    ASSERT(!isMainThread());
+    ASSERT(m_database.isOpen());
+
+    if (!statement) {
+        auto newStatement = std::make_unique<SQLiteStatement>(m_database, query);
+        if (newStatement->prepare() != SQLITE_OK)
+            return nullptr;
+        statement = WTFMove(newStatement);
+    }
+    return statement.get();
+}
+
+void StorageAreaSync::closeDatabase()
+{
+    ASSERT(!isMainThread());
+
+    // The statements have to be finalized before the database is closed
+    m_insertStatement = nullptr;
+    m_removeStatement = nullptr;
+    m_clearStatement = nullptr;
+    m_database.close();
+}
+
 void StorageAreaSync::performSync()
 {
     ASSERT(!isMainThread());
@@ -515,7 +540,7 @@ void StorageAreaSync::deleteEmptyDatabase()
     int count = query.getColumnInt(0);
     if (!count) {
         query.finalize();
-        m_database.close();
+        closeDatabase();
         if (StorageTracker::tracker().isActive()) {
             callOnMainThread([databaseIdentifier = m_databaseIdentifier.isolatedCopy()] {
                 StorageTracker::tracker().deleteOriginWithIdentifier(databaseIdentifier);
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <WebCore/SQLiteDatabase.h>
+#include <WebCore/SQLiteStatement.h>
 #include <WebCore/Timer.h>
 #include <wtf/Condition.h>
 #include <wtf/HashMap.h>
@@ -67,6 +68,9 @@ private:
 
     // The database handle will only ever be opened and used on the background thread.
     WebCore::SQLiteDatabase m_database;
+    std::unique_ptr<WebCore::SQLiteStatement> m_insertStatement;
+    std::unique_ptr<WebCore::SQLiteStatement> m_removeStatement;
+    std::unique_ptr<WebCore::SQLiteStatement> m_clearStatement;
 
     // The following members are subject to thread synchronization issues.
 public:
@@ -83,6 +87,8 @@ private:
 
     void syncTimerFired();
     void openDatabase(OpenDatabaseParamType openingStrategy);
+    void closeDatabase();
+    WebCore::SQLiteStatement* cachedStatement(std::unique_ptr<WebCore::SQLiteStatement>&, const char* query);
     void sync(bool clearItems, const HashMap<String, String>& items);
 
     const String m_databaseIdentifier;
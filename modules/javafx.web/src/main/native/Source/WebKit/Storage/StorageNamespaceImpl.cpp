@@ -178,4 +178,11 @@ void StorageNamespaceImpl::closeIdleLocalStorageDatabases()
         it->value->closeDatabaseIfIdle();
 }
 
+void StorageNamespaceImpl::setSyncPolicy(double syncInterval, unsigned maxItemsToSync)
+{
+    ASSERT(isMainThread());
+    if (m_syncManager)
+        m_syncManager->setSyncPolicy(syncInterval, maxItemsToSync);
+}
+
 } // namespace WebCore
@@ -54,6 +54,9 @@ public:
     void sync();
     void closeIdleLocalStorageDatabases();
 
+    // See StorageSyncManager::setSyncPolicy()
+    void setSyncPolicy(double syncInterval, unsigned maxItemsToSync);
+
 private:
     StorageNamespaceImpl(WebCore::StorageType, const String& path, unsigned quota);
 
@@ -33,6 +33,14 @@
 
 namespace WebCore {
 
+// If the StorageArea undergoes rapid changes, don't sync each change to disk.
+// Instead, queue up a batch of items to sync and actually do the sync at the following interval.
+static const double defaultStorageSyncInterval = 1.0;
+
+// A sane limit on how many items we'll schedule to sync all at once.  This makes it
+// much harder to starve the rest of LocalStorage and the OS's IO subsystem in general.
+static const unsigned defaultMaxItemsToSync = 100;
+
 Ref<StorageSyncManager> StorageSyncManager::create(const String& path)
 {
     return adoptRef(*new StorageSyncManager(path));
@@ -40,6 +48,8 @@ Ref<StorageSyncManager> StorageSyncManager::create(const String& path)
 
 StorageSyncManager::StorageSyncManager(const String& path)
     : m_thread(std::make_unique<StorageThread>())
+    , m_syncInterval(defaultStorageSyncInterval)
+    , m_maxItemsToSync(defaultMaxItemsToSync)
     , m_path(path.isolatedCopy())
 {
     ASSERT(isMainThread());
@@ -53,6 +63,13 @@ StorageSyncManager::~StorageSyncManager()
     ASSERT(!m_thread);
 }
 
+void StorageSyncManager::setSyncPolicy(double syncInterval, unsigned maxItemsToSync)
+{
+    ASSERT(isMainThread());
+    m_syncInterval = std::max(syncInterval, 0.0);
+    m_maxItemsToSync = std::max(maxItemsToSync, 1u);
+}
+
 // Called on a background thread.
 String StorageSyncManager::fullDatabaseFilename(const String& databaseIdentifier)
 {
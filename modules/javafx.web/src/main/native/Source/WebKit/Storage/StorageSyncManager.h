@@ -46,10 +46,19 @@ public:
     void dispatch(Function<void ()>&&);
     void close();
 
+    // How long the changes of a storage area are batched before they are
+    // written, and how many are written at most per batch. Shared by all the
+    // pages using the same database path; only used on the main thread.
+    void setSyncPolicy(double syncInterval, unsigned maxItemsToSync);
+    double syncInterval() const { return m_syncInterval; }
+    unsigned maxItemsToSync() const { return m_maxItemsToSync; }
+
 private:
     explicit StorageSyncManager(const String& path);
 
     std::unique_ptr<StorageThread> m_thread;
+    double m_syncInterval;
+    unsigned m_maxItemsToSync;
 
 // The following members are subject to thread synchronization issues
 public:
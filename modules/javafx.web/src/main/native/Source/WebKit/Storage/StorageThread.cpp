@@ -73,7 +73,7 @@ void StorageThread::threadEntryPointCallback(void* thread)
 void StorageThread::threadEntryPoint()
 {
 #if PLATFORM(JAVA)
-    WTF::AutoAttachToJavaThread autoAttach(true);
+    WTF::AutoAttachToJavaThread autoAttach;
 #endif
     ASSERT(!isMainThread());
 
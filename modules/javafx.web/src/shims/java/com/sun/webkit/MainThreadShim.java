@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.webkit;
+
+import java.util.TimerTask;
+
+public class MainThreadShim {
+
+    /**
+     * Sets the Java timer of the main RunLoop, as the native RunLoop does
+     * for its earliest timer.
+     */
+    public static void setRunLoopTimer(long delayMillis) {
+        MainThread.fwkSetRunLoopTimer(delayMillis);
+    }
+
+    public static TimerTask getRunLoopTask() {
+        synchronized (MainThread.class) {
+            return MainThread.runLoopTask;
+        }
+    }
+
+    public static int getJavaThreadAttachCount() {
+        return MainThread.twkGetJavaThreadAttachCount();
+    }
+
+    public static int getJavaThreadDetachCount() {
+        return MainThread.twkGetJavaThreadDetachCount();
+    }
+
+    /**
+     * Calls into Java {@code count} times from a new native thread, and
+     * returns after that thread has exited.
+     */
+    public static void scheduleDispatchFunctionsFromNewThread(int count) {
+        MainThread.twkScheduleDispatchFunctionsFromNewThread(count);
+    }
+
+    /**
+     * Must be called on the event thread. Starts {@code count} timers of
+     * the main RunLoop due within {@code delayMillis}, and dispatches
+     * {@code count} functions to it from another thread.
+     */
+    public static void startRunLoopTest(int count, long delayMillis) {
+        MainThread.twkStartRunLoopTest(count, delayMillis);
+    }
+
+    public static int getRunLoopTestTimersFired() {
+        return MainThread.twkGetRunLoopTestTimersFired();
+    }
+
+    public static int getRunLoopTestFunctionsRun() {
+        return MainThread.twkGetRunLoopTestFunctionsRun();
+    }
+}
@@ -26,10 +26,16 @@
 package com.sun.webkit;
 
 import com.sun.webkit.WebPage;
+import com.sun.webkit.graphics.WCRectangle;
+import java.util.List;
 
 public class WebPageShim {
 
     public static int getFramesCount(WebPage page) {
         return page.test_getFramesCount();
     }
+
+    public static List<WCRectangle> getDirtyRects(WebPage page) {
+        return page.test_getDirtyRects();
+    }
 }
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.webkit;
+
+import com.sun.javafx.PlatformUtil;
+import com.sun.webkit.MainThreadShim;
+import java.util.ArrayList;
+import java.util.HashSet;
+import java.util.List;
+import java.util.TimerTask;
+import org.junit.Test;
+import test.javafx.scene.web.TestBase;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assume.assumeTrue;
+
+/**
+ * Checks that the timers of the main WebKit RunLoop and the functions
+ * dispatched to the main thread run on the event thread, and the attachment
+ * of native WebKit threads to the JVM.
+ */
+public class MainThreadTest extends TestBase {
+
+    private static final int TIMEOUT = 10000;
+
+    private void waitForRunLoopTest(int count) throws InterruptedException {
+        long deadline = System.currentTimeMillis() + TIMEOUT;
+        while (System.currentTimeMillis() < deadline) {
+            if (MainThreadShim.getRunLoopTestTimersFired() == count
+                    && MainThreadShim.getRunLoopTestFunctionsRun() == count) {
+                break;
+            }
+            Thread.sleep(10);
+        }
+        assertEquals("timers fired", count, MainThreadShim.getRunLoopTestTimersFired());
+        assertEquals("functions run", count, MainThreadShim.getRunLoopTestFunctionsRun());
+    }
+
+    @Test public void testRunLoopTimersAndDispatch() throws InterruptedException {
+        // Only the generic RunLoop of the Linux build is pumped from Java
+        assumeTrue(PlatformUtil.isLinux());
+        submit(() -> MainThreadShim.startRunLoopTest(1, 0));
+        waitForRunLoopTest(1);
+    }
+
+    @Test public void testManyRunLoopTimers() throws InterruptedException {
+        assumeTrue(PlatformUtil.isLinux());
+        submit(() -> MainThreadShim.startRunLoopTest(500, 200));
+        waitForRunLoopTest(500);
+    }
+
+    @Test public void testPageTimersAndWorkerMessages() throws InterruptedException {
+        // The worker thread posts its messages to the main thread
+        loadContent("<script>"
+                + "var fired = 0;"
+                + "for (var i = 0; i < 10; i++) {"
+                + "  setTimeout(function() { fired++; }, 10 * i);"
+                + "}"
+                + "var messages = 0;"
+                + "var worker = new Worker(URL.createObjectURL(new Blob(["
+                + "'for (var i = 0; i < 10; i++) { postMessage(i); }'])));"
+                + "worker.onmessage = function(e) { messages++; };"
+                + "</script>");
+        long deadline = System.currentTimeMillis() + TIMEOUT;
+        while (System.currentTimeMillis() < deadline
+                && !"10 10".equals(executeScript("fired + ' ' + messages"))) {
+            Thread.sleep(10);
+        }
+        assertEquals("timers fired and messages received",
+                "10 10", executeScript("fired + ' ' + messages"));
+    }
+
+    @Test public void testRunLoopTimerKeepsOneTask() {
+        // Only the generic RunLoop of the Linux build sets the Java timer
+        assumeTrue(PlatformUtil.isLinux());
+        List<TimerTask> tasks = new ArrayList<>();
+        for (int i = 0; i < 100; i++) {
+            MainThreadShim.setRunLoopTimer(60000);
+            tasks.add(MainThreadShim.getRunLoopTask());
+        }
+        // Fires right away, so that the native RunLoop sets its timer again
+        MainThreadShim.setRunLoopTimer(0);
+        assertEquals("tasks", 100, new HashSet<>(tasks).size());
+        for (TimerTask task : tasks) {
+            assertFalse("task still pending", task.cancel());
+        }
+    }
+
+    @Test public void testDispatchingThreadAttachesOnce() {
+        int[] counts = new int[4];
+        submit(() -> {
+            counts[0] = MainThreadShim.getJavaThreadAttachCount();
+            counts[1] = MainThreadShim.getJavaThreadDetachCount();
+            // Each call goes into Java, which used to attach and detach
+            // the native thread every time
+            MainThreadShim.scheduleDispatchFunctionsFromNewThread(100);
+            counts[2] = MainThreadShim.getJavaThreadAttachCount();
+            counts[3] = MainThreadShim.getJavaThreadDetachCount();
+        });
+        assertEquals("attaches", 1, counts[2] - counts[0]);
+        assertEquals("detaches", 1, counts[3] - counts[1]);
+    }
+}
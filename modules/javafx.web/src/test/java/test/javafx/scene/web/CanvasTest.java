@@ -146,4 +146,47 @@ public class CanvasTest extends TestBase {
             }
         });
     }
+
+    @Test public void testCanvasPathGeometry() {
+        final String htmlCanvasContent = "\n"
+            + "<!DOCTYPE html>\n"
+            + "<html>\n"
+            + "<body>\n"
+            + "<canvas id=\"myCanvas\" width=\"200\" height=\"100\">\n"
+            + "</canvas>\n"
+            + "<script>\n"
+            + "var c = document.getElementById(\"myCanvas\");\n"
+            + "var ctx = c.getContext(\"2d\");\n"
+            + "ctx.beginPath();\n"
+            + "ctx.arc(50, 50, 40, 0, 2 * Math.PI, false);\n"
+            + "ctx.moveTo(100, 10);\n"
+            + "ctx.lineTo(190, 10);\n"
+            + "ctx.arcTo(190, 90, 100, 90, 20);\n"
+            + "ctx.closePath();\n"
+            + "window.results = [\n"
+            + "    ctx.isPointInPath(50, 50),\n"
+            + "    ctx.isPointInPath(85, 50),\n"
+            + "    ctx.isPointInPath(12, 12),\n"
+            + "    ctx.isPointInPath(150, 20),\n"
+            + "    ctx.isPointInPath(195, 50)];\n"
+            + "ctx.fillStyle = '#00f';\n"
+            + "ctx.fill();\n"
+            + "window.data = ctx.getImageData(50, 50, 1, 1).data;\n"
+            + "</script>\n"
+            + "</body>\n"
+            + "</html>\n";
+
+        loadContent(htmlCanvasContent);
+
+        final boolean[] expected = {true, true, false, true, false};
+        submit(() -> {
+            final JSObject results = (JSObject) getEngine().executeScript("window.results");
+            for (int i = 0; i < expected.length; i++) {
+                assertEquals("isPointInPath result " + i, expected[i], results.getSlot(i));
+            }
+            final JSObject data = (JSObject) getEngine().executeScript("window.data");
+            assertEquals("Filled arc pixel should be blue", 255, (int) data.getSlot(2));
+            assertEquals("Filled arc pixel should be opaque", 255, (int) data.getSlot(3));
+        });
+    }
 }
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.util.ArrayList;
+import java.util.concurrent.CountDownLatch;
+import java.util.stream.Stream;
+import javafx.scene.web.WebEngine;
+import javafx.scene.web.WebEngineShim;
+import org.junit.After;
+import static org.junit.Assert.assertEquals;
+import org.junit.Test;
+
+/**
+ * Checks the key order of local storage and the batched writes of its
+ * database set with WebPage.setLocalStorageSyncPolicy().
+ */
+public class LocalStorageTest extends TestBase {
+
+    private static final File PAGE = new File("src/test/resources/test/html/ipsum.html");
+    private static final int TIMEOUT = 10000;
+
+    private final ArrayList<WebEngine> createdWebEngines = new ArrayList<>();
+    private final ArrayList<File> createdDirectories = new ArrayList<>();
+
+    @After
+    public void after() throws IOException {
+        submit(() -> {
+            for (WebEngine webEngine : createdWebEngines) {
+                WebEngineShim.dispose(webEngine);
+            }
+        });
+        for (File directory : createdDirectories) {
+            deleteRecursively(directory);
+        }
+    }
+
+    @Test
+    public void testKeyOrderAfterRemovals() throws IOException {
+        WebEngine webEngine = createWebEngine(createDirectory("localStorageKeys"), 1000, 100);
+        String keys = (String) submit(() -> webEngine.executeScript(
+                "localStorage.clear();"
+                + "['a', 'b', 'c', 'd'].forEach(function(k) { localStorage.setItem(k, k); });"
+                // The last key takes the place of a removed one
+                + "localStorage.removeItem('b');"
+                + "localStorage.setItem('e', 'e');"
+                // Setting an existing key keeps its place
+                + "localStorage.setItem('a', 'A');"
+                + "localStorage.removeItem('e');"
+                + "localStorage.removeItem('a');"
+                + "var keys = [];"
+                + "for (var i = 0; i < localStorage.length; i++) keys.push(localStorage.key(i));"
+                + "keys.push(localStorage.key(localStorage.length));"
+                + "keys.join(',')"));
+        assertEquals("c,d,null", keys);
+    }
+
+    @Test
+    public void testBatchLargerThanSyncLimitIsPersisted() throws Exception {
+        File directory = createDirectory("localStorageSync");
+        WebEngine webEngine = createWebEngine(directory, 10, 5);
+        submit(() -> webEngine.executeScript(
+                "for (var i = 0; i < 50; i++) localStorage.setItem('key' + i, 'value' + i);"
+                + "localStorage.removeItem('key7');"));
+
+        // Each copy of the database is read by a new local storage, one
+        // per directory, once the writes had time to be synced
+        long deadline = System.currentTimeMillis() + TIMEOUT;
+        int attempt = 0;
+        Object length;
+        do {
+            Thread.sleep(200);
+            File copy = createDirectory("localStorageSyncCopy" + attempt++);
+            copyRecursively(new File(directory, "localstorage").toPath(),
+                    new File(copy, "localstorage").toPath());
+            WebEngine reader = createWebEngine(copy, 1000, 100);
+            length = submit(() -> reader.executeScript(
+                    "localStorage.length + ':' + localStorage.getItem('key49')"
+                    + " + ':' + localStorage.getItem('key7')"));
+        } while (!"49:value49:null".equals(length) && System.currentTimeMillis() < deadline);
+        assertEquals("49:value49:null", length);
+    }
+
+    private File createDirectory(String name) throws IOException {
+        File directory = new File(name);
+        deleteRecursively(directory);
+        directory.mkdirs();
+        createdDirectories.add(directory);
+        return directory;
+    }
+
+    private WebEngine createWebEngine(File directory, int syncIntervalMillis, int maxItemsToSync) {
+        WebEngine webEngine = submit(() -> new WebEngine());
+        createdWebEngines.add(webEngine);
+        submit(() -> {
+            webEngine.setUserDataDirectory(directory);
+            // Applies when the page first uses local storage
+            WebEngineShim.getPage(webEngine).setLocalStorageSyncPolicy(
+                    syncIntervalMillis, maxItemsToSync);
+        });
+        load(webEngine);
+        return webEngine;
+    }
+
+    private void load(WebEngine webEngine) {
+        final CountDownLatch latch = new CountDownLatch(1);
+        submit(() -> {
+            webEngine.getLoadWorker().runningProperty().addListener((ov, oldValue, newValue) -> {
+                if (!newValue) {
+                    latch.countDown();
+                }
+            });
+            webEngine.load(PAGE.toURI().toASCIIString());
+        });
+        try {
+            latch.await();
+        } catch (InterruptedException ex) {
+            throw new AssertionError(ex);
+        }
+    }
+
+    private static void copyRecursively(Path source, Path target) throws IOException {
+        if (Files.isDirectory(source)) {
+            Files.createDirectories(target);
+            try (Stream<Path> children = Files.list(source)) {
+                for (Path child : (Iterable<Path>) children::iterator) {
+                    copyRecursively(child, target.resolve(child.getFileName()));
+                }
+            }
+        } else if (Files.exists(source)) {
+            Files.copy(source, target, StandardCopyOption.REPLACE_EXISTING);
+        }
+    }
+
+    private static void deleteRecursively(File file) throws IOException {
+        if (file.isDirectory()) {
+            for (File f : file.listFiles()) {
+                deleteRecursively(f);
+            }
+        }
+        if (file.exists() && !file.delete()) {
+            // If WebKit takes time to close the file, better
+            // delete it during VM shutdown.
+            file.deleteOnExit();
+        }
+    }
+}
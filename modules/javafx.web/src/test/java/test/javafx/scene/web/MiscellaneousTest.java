@@ -423,4 +423,28 @@ public class MiscellaneousTest extends TestBase {
             throw new AssertionError(e);
         }
     }
+
+    /**
+     * @test
+     * Check the glyphs of a page of characters that starts with a character
+     * which WebCore replaces before the page is filled (U+00A0 by a space).
+     */
+    @Test public void testGlyphPageWithReplacedCharacters() {
+        loadContent(
+        "<span id='copyright' style='white-space: pre'>\u00a9\u00a9\u00a9\u00a9\u00a9\u00a9</span><br>" +
+        "<span id='paren' style='white-space: pre'>))))))</span><br>" +
+        "<span id='nbsp' style='white-space: pre'>a\u00a0\u00a0b</span><br>" +
+        "<span id='space' style='white-space: pre'>a  b</span>"
+        );
+
+        submit(()->{
+            // U+00A9 is in the same page as U+00A0, and ')' is U+0029
+            assertFalse("U+00A9 drawn with the glyph of ')'",
+                (Boolean) getEngine().executeScript(
+                "document.getElementById('copyright').offsetWidth == document.getElementById('paren').offsetWidth"));
+            assertTrue("U+00A0 not drawn as a space",
+                (Boolean) getEngine().executeScript(
+                "document.getElementById('nbsp').offsetWidth == document.getElementById('space').offsetWidth"));
+        });
+    }
 }
@@ -25,13 +25,20 @@
 
 package test.javafx.scene.web;
 
+import com.sun.webkit.NativeText;
 import com.sun.webkit.WebPage;
 import com.sun.webkit.WebPageShim;
+import com.sun.webkit.graphics.WCRectangle;
+import java.util.ArrayList;
+import java.util.List;
 import java.util.concurrent.Callable;
 import javafx.scene.web.WebEngineShim;
 
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
 import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
 import org.junit.Test;
 
 public class WebPageTest extends TestBase {
@@ -42,6 +49,11 @@ public class WebPageTest extends TestBase {
     final static String PTAG = "<p></p>";
     final static String IFRAME = "<iframe src=''> </iframe>";
 
+    final static int PAGE_WIDTH = 800;
+    final static int PAGE_HEIGHT = 600;
+    final static int BOX_SIZE = 10;
+    final static int REPAINT_TIMEOUT = 10000;
+
     @Test public void testGetHtml() throws Exception {
         WebPage page = WebEngineShim.getPage(getEngine());
 
@@ -63,6 +75,42 @@ public class WebPageTest extends TestBase {
         return submit(() -> page.getHtml(page.getMainFrame()));
     }
 
+    @Test public void testGetHtmlBuffer() throws Exception {
+        WebPage page = WebEngineShim.getPage(getEngine());
+
+        loadContent(HTML);
+        NativeText text = getHtmlBuffer(page);
+        assertTrue("Latin-1 document", text.isLatin1());
+        assertEquals("Latin-1 document length", HTML.length(), text.length());
+        assertEquals("Latin-1 document", HTML, text.toString());
+
+        String unicode = "<html><head></head><body><p>\u0416\u4e2d</p></body></html>";
+        loadContent(unicode);
+        text = getHtmlBuffer(page);
+        assertFalse("UTF-16 document", text.isLatin1());
+        assertEquals("UTF-16 document length", unicode.length(), text.length());
+        assertEquals("UTF-16 document", unicode, text.toString());
+        assertEquals("Same as getHtml()", getHtml(page), text.toString());
+
+        loadContent(XML, "application/xml");
+        assertNull("XML document", getHtmlBuffer(page));
+    }
+
+    @Test public void testGetInnerTextBuffer() throws Exception {
+        WebPage page = WebEngineShim.getPage(getEngine());
+
+        loadContent(HTML);
+        NativeText text = submit(() -> page.getInnerTextBuffer(page.getMainFrame()));
+        assertEquals("Inner text", "Test", text.toString());
+        assertEquals("Same as getInnerText()",
+                submit(() -> page.getInnerText(page.getMainFrame())),
+                text.toString());
+    }
+
+    private NativeText getHtmlBuffer(final WebPage page) throws Exception {
+        return submit(() -> page.getHtmlBuffer(page.getMainFrame()));
+    }
+
     @Test public void testGetHtmlIllegalFrameId() {
         WebPage page = WebEngineShim.getPage(getEngine());
         assertEquals(null, page.getHtml(1));
@@ -83,4 +131,91 @@ public class WebPageTest extends TestBase {
             assertEquals("Expected single frame : ", 1, WebPageShim.getFramesCount(page));
         });
     }
+
+    // Loads a page of count boxes spread over the page, paints it, and
+    // returns the area of the boxes
+    private List<WCRectangle> loadBoxes(WebPage page, int count) {
+        submit(() -> page.setBounds(0, 0, PAGE_WIDTH, PAGE_HEIGHT));
+        StringBuilder html = new StringBuilder("<html><body>");
+        List<WCRectangle> boxes = new ArrayList<>();
+        for (int i = 0; i < count; i++) {
+            int x = (i * 173) % (PAGE_WIDTH - BOX_SIZE);
+            int y = (i * 97) % (PAGE_HEIGHT - BOX_SIZE);
+            html.append("<div style='position: absolute; left: ").append(x)
+                .append("px; top: ").append(y).append("px; width: ").append(BOX_SIZE)
+                .append("px; height: ").append(BOX_SIZE)
+                .append("px; background: red'></div>");
+            boxes.add(new WCRectangle(x, y, BOX_SIZE, BOX_SIZE));
+        }
+        loadContent(html.append("</body></html>").toString());
+        submit(() -> {
+            page.updateContent(new WCRectangle(0, 0, PAGE_WIDTH, PAGE_HEIGHT));
+            assertFalse("Damage left after an update", page.isDirty());
+        });
+        return boxes;
+    }
+
+    private static final String PAINT_BOXES_BLUE =
+            "var boxes = document.getElementsByTagName('div');" +
+            "for (var i = 0; i < boxes.length; i++)" +
+            "    boxes[i].style.background = 'blue';";
+
+    @Test public void testLayoutDamageIsPaintedInSameUpdate() {
+        final WebPage page = WebEngineShim.getPage(getEngine());
+        loadBoxes(page, 6);
+
+        // The style change is only laid out, and its damage only reported,
+        // by the update itself
+        submit(() -> {
+            getEngine().executeScript(PAINT_BOXES_BLUE);
+            page.updateContent(new WCRectangle(0, 0, PAGE_WIDTH, PAGE_HEIGHT));
+            assertFalse("Damage left after an update", page.isDirty());
+        });
+    }
+
+    @Test public void testRepaintRectsCoverDamage() {
+        // A few rects are merged with their neighbours, many are replaced
+        // by their bounds
+        checkRepaintRectsCoverDamage(6);
+        checkRepaintRectsCoverDamage(40);
+    }
+
+    private void checkRepaintRectsCoverDamage(int count) {
+        final WebPage page = WebEngineShim.getPage(getEngine());
+        List<WCRectangle> boxes = loadBoxes(page, count);
+
+        // The layout forced here reports all of the damage at once, at the
+        // end of the current run loop iteration
+        executeScript(PAINT_BOXES_BLUE + "document.body.offsetWidth;");
+        List<WCRectangle> dirtyRects = submit(() -> WebPageShim.getDirtyRects(page));
+        long deadline = System.currentTimeMillis() + REPAINT_TIMEOUT;
+        while (dirtyRects.isEmpty()) {
+            if (System.currentTimeMillis() > deadline) {
+                fail("No damage reported for " + count + " boxes");
+            }
+            try {
+                Thread.sleep(10);
+            } catch (InterruptedException e) {}
+            dirtyRects = submit(() -> WebPageShim.getDirtyRects(page));
+        }
+
+        for (WCRectangle box : boxes) {
+            for (int x = box.getIntX(); x < box.getIntX() + BOX_SIZE; x++) {
+                for (int y = box.getIntY(); y < box.getIntY() + BOX_SIZE; y++) {
+                    assertTrue("Pixel (" + x + ", " + y + ") of " + box
+                            + " not in " + dirtyRects,
+                            covers(dirtyRects, new WCRectangle(x, y, 1, 1)));
+                }
+            }
+        }
+    }
+
+    private static boolean covers(List<WCRectangle> rects, WCRectangle pixel) {
+        for (WCRectangle rect : rects) {
+            if (rect.contains(pixel)) {
+                return true;
+            }
+        }
+        return false;
+    }
 }
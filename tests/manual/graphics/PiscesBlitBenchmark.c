@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Checks that the SSE2 and AVX2 variants of the Pisces software blitters
+ * produce exactly the pixels of the C code, then measures the throughput
+ * of every blitter, in MPix/s, for each kernel the processor supports.
+ * Build it against the blitter sources and the generated JNI headers of
+ * javafx.graphics, for example on Linux:
+ *
+ *   cc -O2 -I $JAVA_HOME/include -I $JAVA_HOME/include/linux \
+ *      -I modules/javafx.graphics/build/gensrc/headers/javafx.graphics \
+ *      -I modules/javafx.graphics/src/main/native-prism-sw \
+ *      tests/manual/graphics/PiscesBlitBenchmark.c \
+ *      modules/javafx.graphics/src/main/native-prism-sw/PiscesBlit.c \
+ *      -lm -o PiscesBlitBenchmark
+ *
+ * Usage: PiscesBlitBenchmark [width height [frames]]
+ * The default is 20 frames of 1920x1080. The exit status is 1 when a
+ * variant differs from the C code.
+ */
+
+#include <PiscesBlit.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#define MAX_AA_ALPHA 64
+#define CHECK_ROWS 2000
+
+typedef enum {
+    SRC_OVER, SRC_OVER_MASK, SRC, SRC_MASK, PT_SRC_OVER, PT_SRC_OVER_MASK, NUM_MODES
+} BlitMode;
+
+static const char *modeNames[] = {
+    "SrcOver", "SrcOver mask", "Src", "Src mask", "SrcOver paint", "SrcOver paint mask"
+};
+static const char *kernelNames[] = { "C", "SSE2", "AVX2" };
+
+static jbyte alphaMap[MAX_AA_ALPHA + 1];
+
+static double now(void)
+{
+#ifdef WIN32
+    LARGE_INTEGER count, frequency;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+    return (double)count.QuadPart / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+static void *allocOrDie(size_t size)
+{
+    void *p = calloc(1, size);
+    if (p == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+/*
+ * Coverage with long runs of 0 and full coverage, as along the edges and
+ * inside of shapes, and random values in between.
+ */
+static void randomCoverage(jint *coverage, jint w, jint max)
+{
+    jint i = 0;
+    while (i < w) {
+        jint run = 1 + rand() % 24;
+        jint kind = rand() % 4;
+        for (; run > 0 && i < w; run--, i++) {
+            coverage[i] = (kind == 0) ? 0 : (kind == 1) ? max : rand() % (max + 1);
+        }
+    }
+}
+
+static jint randomPremultiplied(void)
+{
+    jint a = rand() % 256;
+    jint r = a ? rand() % (a + 1) : 0;
+    jint g = a ? rand() % (a + 1) : 0;
+    jint b = a ? rand() % (a + 1) : 0;
+    if (rand() % 4 == 0) {
+        a = 255;
+    }
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+static jboolean isMaskMode(BlitMode mode)
+{
+    return mode == SRC_OVER_MASK || mode == SRC_MASK || mode == PT_SRC_OVER_MASK;
+}
+
+/*
+ * Sets up rdr to blit a row of w pixels at x in data, from the coverage
+ * of the row. The alpha deltas and mask are written to deltas and mask.
+ */
+static void setupRow(Renderer *rdr, BlitMode mode, jint *data, jint x, jint w,
+                     const jint *coverage, jint *deltas, jbyte *mask)
+{
+    jint i;
+
+    rdr->_data = data;
+    rdr->_currImageOffset = 0;
+    rdr->_imageScanlineStride = x + w;
+    rdr->_imagePixelStride = 1;
+    rdr->_minTouched = x;
+    rdr->_maxTouched = x + w - 1;
+    rdr->_alphaWidth = w;
+    if (isMaskMode(mode)) {
+        for (i = 0; i < w; i++) {
+            mask[i] = (jbyte)alphaMap[coverage[i]];
+        }
+        rdr->_mask_byteData = mask;
+        rdr->_maskOffset = 0;
+    } else {
+        for (i = 0; i < w; i++) {
+            deltas[i] = coverage[i] - (i ? coverage[i - 1] : 0);
+        }
+        deltas[w] = -coverage[w - 1];
+        rdr->_rowAAInt = deltas;
+        rdr->alphaMap = alphaMap;
+    }
+}
+
+static void blit(Renderer *rdr, BlitMode mode)
+{
+    switch (mode) {
+        case SRC_OVER:         blitSrcOver8888_pre(rdr, 1); break;
+        case SRC_OVER_MASK:    blitSrcOverMask8888_pre(rdr, 1); break;
+        case SRC:              blitSrc8888_pre(rdr, 1); break;
+        case SRC_MASK:         blitSrcMask8888_pre(rdr, 1); break;
+        case PT_SRC_OVER:      blitPTSrcOver8888_pre(rdr, 1); break;
+        case PT_SRC_OVER_MASK: blitPTSrcOverMask8888_pre(rdr, 1); break;
+        default: break;
+    }
+}
+
+static void setColor(Renderer *rdr)
+{
+    jint special = rand() % 4;
+    rdr->_calpha = (special == 0) ? 255 : (special == 1) ? 0 : rand() % 256;
+    rdr->_cred = rand() % 256;
+    rdr->_cgreen = rand() % 256;
+    rdr->_cblue = rand() % 256;
+}
+
+static int check(Renderer *rdr, jint maxKernel)
+{
+    jint *coverage = allocOrDie(1100 * sizeof(jint));
+    jint *deltas = allocOrDie(1100 * sizeof(jint));
+    jbyte *mask = allocOrDie(1100);
+    jint *dst = allocOrDie(1100 * sizeof(jint));
+    jint *expected = allocOrDie(1100 * sizeof(jint));
+    jint *actual = allocOrDie(1100 * sizeof(jint));
+    jint *paint = allocOrDie(1100 * sizeof(jint));
+    int failures = 0;
+    jint row, i, kernel;
+    BlitMode mode;
+
+    for (mode = 0; mode < NUM_MODES; mode++) {
+        int modeFailures = 0;
+        srand(mode + 1);
+        for (row = 0; row < CHECK_ROWS; row++) {
+            // Widths up to several coverage chunks, with all of the tails
+            jint w = 1 + rand() % 1000;
+            jint x = rand() % 64;
+
+            randomCoverage(coverage, w, MAX_AA_ALPHA);
+            for (i = 0; i < x + w; i++) {
+                // Arbitrary destinations, premultiplied paints
+                dst[i] = (rand() << 16) ^ rand();
+                paint[i] = randomPremultiplied();
+            }
+            setColor(rdr);
+            rdr->_paint = paint;
+            rdr->_paint_length = w;
+
+            setMaxBlitKernel(BLIT_KERNEL_C);
+            memcpy(expected, dst, (x + w) * sizeof(jint));
+            setupRow(rdr, mode, expected, x, w, coverage, deltas, mask);
+            blit(rdr, mode);
+
+            for (kernel = BLIT_KERNEL_SSE2; kernel <= maxKernel; kernel++) {
+                setMaxBlitKernel(kernel);
+                memcpy(actual, dst, (x + w) * sizeof(jint));
+                setupRow(rdr, mode, actual, x, w, coverage, deltas, mask);
+                blit(rdr, mode);
+                for (i = 0; i < x + w; i++) {
+                    if (actual[i] != expected[i] && modeFailures++ < 5) {
+                        printf("%s %s: pixel %d of %d at %d, 0x%08x instead of 0x%08x\n",
+                               modeNames[mode], kernelNames[kernel], i - x, w, x,
+                               (unsigned)actual[i], (unsigned)expected[i]);
+                    }
+                }
+                if (!isMaskMode(mode)) {
+                    for (i = 0; i <= w; i++) {
+                        if (i < w && deltas[i] != 0 && modeFailures++ < 5) {
+                            printf("%s %s: delta %d not cleared\n",
+                                   modeNames[mode], kernelNames[kernel], i);
+                        }
+                    }
+                }
+            }
+        }
+        printf("%-20s %s\n", modeNames[mode], modeFailures ? "FAILED" : "exact");
+        failures += modeFailures;
+    }
+
+    free(coverage);
+    free(deltas);
+    free(mask);
+    free(dst);
+    free(expected);
+    free(actual);
+    free(paint);
+    return failures;
+}
+
+static void benchmark(Renderer *rdr, jint maxKernel, jint width, jint height, jint frames)
+{
+    jint *coverage = allocOrDie(height * sizeof(jint) * width);
+    jint *deltas = allocOrDie((width + 1) * sizeof(jint));
+    jbyte *mask = allocOrDie(width);
+    jint *data = allocOrDie(width * sizeof(jint));
+    jint *paint = allocOrDie(width * sizeof(jint));
+    jint i, y, f, kernel;
+    BlitMode mode;
+
+    srand(42);
+    for (y = 0; y < height; y++) {
+        randomCoverage(coverage + y * width, width, MAX_AA_ALPHA);
+    }
+    for (i = 0; i < width; i++) {
+        data[i] = randomPremultiplied();
+        paint[i] = randomPremultiplied();
+    }
+    rdr->_paint = paint;
+    rdr->_paint_length = width;
+    rdr->_calpha = 200;
+    rdr->_cred = 10;
+    rdr->_cgreen = 120;
+    rdr->_cblue = 240;
+
+    printf("\n%dx%d, %d frames, MPix/s\n%-20s", width, height, frames, "");
+    for (kernel = BLIT_KERNEL_C; kernel <= maxKernel; kernel++) {
+        printf("%10s", kernelNames[kernel]);
+    }
+    printf("\n");
+    for (mode = 0; mode < NUM_MODES; mode++) {
+        printf("%-20s", modeNames[mode]);
+        for (kernel = BLIT_KERNEL_C; kernel <= maxKernel; kernel++) {
+            double start, time = 0;
+            setMaxBlitKernel(kernel);
+            for (f = 0; f < frames; f++) {
+                for (y = 0; y < height; y++) {
+                    // The rows are set up out of the timed part
+                    setupRow(rdr, mode, data, 0, width, coverage + y * width, deltas, mask);
+                    start = now();
+                    blit(rdr, mode);
+                    time += now() - start;
+                }
+            }
+            printf("%10.1f", (double)width * height * frames / time / 1e6);
+        }
+        printf("\n");
+    }
+
+    free(coverage);
+    free(deltas);
+    free(mask);
+    free(data);
+    free(paint);
+}
+
+int main(int argc, char **argv)
+{
+    jint width = 1920, height = 1080, frames = 20;
+    Renderer *rdr = allocOrDie(sizeof(Renderer));
+    jint maxKernel = setMaxBlitKernel(BLIT_KERNEL_AVX2);
+    jint i;
+    int failures;
+
+    if (argc >= 3) {
+        width = atoi(argv[1]);
+        height = atoi(argv[2]);
+    }
+    if (argc >= 4) {
+        frames = atoi(argv[3]);
+    }
+    if (width <= 0 || height <= 0 || frames <= 0) {
+        fprintf(stderr, "Usage: %s [width height [frames]]\n", argv[0]);
+        return 2;
+    }
+    for (i = 0; i <= MAX_AA_ALPHA; i++) {
+        alphaMap[i] = (jbyte)((i * 255 + MAX_AA_ALPHA / 2) / MAX_AA_ALPHA);
+    }
+
+    printf("Best kernel: %s\n\n", kernelNames[maxKernel]);
+    failures = check(rdr, maxKernel);
+    benchmark(rdr, maxKernel, width, height, frames);
+
+    free(rdr);
+    return failures ? 1 : 0;
+}
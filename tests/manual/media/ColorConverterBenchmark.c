@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Measures the throughput of the jfxmedia color conversions, in MPix/s, for
+ * every kernel the processor supports and several thread counts. Build it
+ * against the converter sources, for example on Linux:
+ *
+ *   cc -O2 -DTARGET_OS_LINUX=1 -msse2 \
+ *      -I modules/javafx.media/src/main/native/jfxmedia/Utils \
+ *      tests/manual/media/ColorConverterBenchmark.c \
+ *      modules/javafx.media/src/main/native/jfxmedia/Utils/ColorConverter.c \
+ *      -lpthread -o ColorConverterBenchmark
+ *
+ * Usage: ColorConverterBenchmark [width height [frames]]
+ * The default is 100 frames of 1920x1080. The YCbCr420p conversions have no
+ * C kernel in SSE2 builds, their C rows measure the SSE2 kernels again.
+ */
+
+#include "ColorConverter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+static const char *kernelNames[] = { "C", "SSE2", "AVX2" };
+static const int threadCounts[] = { 1, 2, 4 };
+
+static double now(void)
+{
+#ifdef WIN32
+    LARGE_INTEGER count, frequency;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+    return (double)count.QuadPart / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+static uint8_t *allocPlane(int32_t size)
+{
+    // The SSE2 kernels store to 16 byte aligned rows
+    uint8_t *p = (uint8_t*)malloc(size + 16);
+    int32_t i;
+
+    if (p == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    p = (uint8_t*)(((uintptr_t)p + 15) & ~(uintptr_t)15);
+    for (i = 0; i < size; i++) {
+        p[i] = (uint8_t)rand();
+    }
+    return p;
+}
+
+int main(int argc, char **argv)
+{
+    int32_t width = (argc > 2) ? atoi(argv[1]) : 1920;
+    int32_t height = (argc > 2) ? atoi(argv[2]) : 1080;
+    int frames = (argc > 3) ? atoi(argv[3]) : 100;
+    int32_t yStride = (width + 15) & ~15;
+    int32_t uvStride = (width / 2 + 15) & ~15;
+    int32_t packedStride = (width * 2 + 15) & ~15;
+    int32_t dstStride = width * 4;
+    uint8_t *y = allocPlane(yStride * height);
+    uint8_t *u = allocPlane(uvStride * height / 2);
+    uint8_t *v = allocPlane(uvStride * height / 2);
+    uint8_t *a = allocPlane(yStride * height);
+    uint8_t *packed = allocPlane(packedStride * height);
+    uint8_t *rgb = allocPlane(dstStride * height);
+    uint8_t *dst = allocPlane(dstStride * height);
+    int kernel, maxKernel, conversion, t, i;
+
+    if (width < 2 || height < 2 || frames < 1) {
+        fprintf(stderr, "usage: %s [width height [frames]]\n", argv[0]);
+        return 1;
+    }
+
+    maxKernel = ColorConvert_SetMaxKernel(COLOR_CONVERT_KERNEL_AVX2);
+    printf("%dx%d, %d frames\n", width, height, frames);
+    printf("%-24s %-6s %8s %10s\n", "conversion", "kernel", "threads", "MPix/s");
+
+    for (conversion = 0; conversion < 7; conversion++) {
+        for (kernel = COLOR_CONVERT_KERNEL_C; kernel <= maxKernel; kernel++) {
+            for (t = 0; t < (int)(sizeof(threadCounts) / sizeof(threadCounts[0])); t++) {
+                const char *name = NULL;
+                double start;
+
+                ColorConvert_SetMaxKernel(kernel);
+                ColorConvert_SetParallelism(threadCounts[t], 0);
+
+                start = now();
+                for (i = 0; i < frames; i++) {
+                    switch (conversion) {
+                        case 0:
+                            name = "YCbCr420p_to_ARGB32";
+                            ColorConvert_YCbCr420p_to_ARGB32(dst, dstStride, width, height,
+                                    y, v, u, a, yStride, uvStride, uvStride, yStride);
+                            break;
+                        case 1:
+                            name = "YCbCr420p_to_ARGB32_no_a";
+                            ColorConvert_YCbCr420p_to_ARGB32_no_alpha(dst, dstStride, width, height,
+                                    y, v, u, yStride, uvStride, uvStride);
+                            break;
+                        case 2:
+                            name = "YCbCr420p_to_BGRA32";
+                            ColorConvert_YCbCr420p_to_BGRA32(dst, dstStride, width, height,
+                                    y, v, u, a, yStride, uvStride, uvStride, yStride);
+                            break;
+                        case 3:
+                            name = "YCbCr420p_to_BGRA32_no_a";
+                            ColorConvert_YCbCr420p_to_BGRA32_no_alpha(dst, dstStride, width, height,
+                                    y, v, u, yStride, uvStride, uvStride);
+                            break;
+                        case 4:
+                            name = "YCbCr422_to_ARGB32";
+                            ColorConvert_YCbCr422p_to_ARGB32_no_alpha(dst, dstStride, width, height,
+                                    packed + 1, packed + 2, packed, packedStride, packedStride);
+                            break;
+                        case 5:
+                            name = "YCbCr422_to_BGRA32";
+                            ColorConvert_YCbCr422p_to_BGRA32_no_alpha(dst, dstStride, width, height,
+                                    packed + 1, packed + 2, packed, packedStride, packedStride);
+                            break;
+                        default:
+                            name = "SwapRGB32";
+                            ColorConvert_SwapRGB32(dst, dstStride, width, height, rgb, dstStride);
+                            break;
+                    }
+                }
+
+                printf("%-24s %-6s %8d %10.1f\n", name, kernelNames[kernel], threadCounts[t],
+                       (double)width * height * frames / (now() - start) / 1e6);
+            }
+        }
+    }
+
+    return 0;
+}
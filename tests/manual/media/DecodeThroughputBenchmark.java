@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import java.io.File;
+import java.util.ArrayDeque;
+import java.util.Deque;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.scene.Group;
+import javafx.scene.Scene;
+import javafx.scene.media.Media;
+import javafx.scene.media.MediaPlayer;
+import javafx.scene.media.MediaView;
+import javafx.stage.Stage;
+
+/**
+ * Measures how fast a local clip is decoded with different numbers of
+ * decoder threads. The clip is played muted at the highest playback rate,
+ * once per thread count, and the media time played per second of wall time
+ * is printed. Run it with an H.264 clip, for example a 4K one:
+ *
+ *     java DecodeThroughputBenchmark clip.mp4 [thread counts]
+ *
+ * The thread counts default to "1,2,4,0", 0 being one thread per CPU core.
+ * They are passed to the decoder through the jfxmedia.decoderThreads
+ * system property. Playback can't go faster than the rate, so a result
+ * close to it means the decoder keeps up.
+ */
+public class DecodeThroughputBenchmark extends Application {
+
+    private static final double RATE = 8.0;
+
+    private static String source;
+    private static final Deque<Integer> threadCounts = new ArrayDeque<>();
+
+    private MediaView view;
+
+    public static void main(String[] args) {
+        if (args.length < 1) {
+            System.err.println("Usage: java DecodeThroughputBenchmark <clip> [thread counts]");
+            System.exit(1);
+        }
+        source = new File(args[0]).toURI().toString();
+        String counts = args.length > 1 ? args[1] : "1,2,4,0";
+        for (String count : counts.split(",")) {
+            threadCounts.add(Integer.parseInt(count.trim()));
+        }
+        launch(args);
+    }
+
+    @Override
+    public void start(Stage stage) {
+        view = new MediaView();
+        view.setFitWidth(640);
+        view.setPreserveRatio(true);
+        stage.setScene(new Scene(new Group(view), 640, 360));
+        stage.show();
+
+        System.out.println("DecodeThroughputBenchmark, " + source + " at rate " + RATE);
+        runNext();
+    }
+
+    private void runNext() {
+        if (threadCounts.isEmpty()) {
+            Platform.exit();
+            return;
+        }
+
+        int threads = threadCounts.poll();
+        System.setProperty("jfxmedia.decoderThreads", Integer.toString(threads));
+
+        MediaPlayer player = new MediaPlayer(new Media(source));
+        player.setMute(true);
+        player.setRate(RATE);
+        view.setMediaPlayer(player);
+
+        long[] start = new long[1];
+        player.setOnReady(() -> {
+            start[0] = System.nanoTime();
+            player.play();
+        });
+        player.setOnEndOfMedia(() -> {
+            double seconds = (System.nanoTime() - start[0]) / 1e9;
+            double mediaSeconds = player.getTotalDuration().toSeconds();
+            System.out.printf("threads %-4s %8.2f s  %6.2fx realtime%n",
+                    threads == 0 ? "auto" : Integer.toString(threads),
+                    seconds, mediaSeconds / seconds);
+            player.dispose();
+            runNext();
+        });
+        player.setOnError(() -> {
+            System.err.println("Error: " + player.getError());
+            Platform.exit();
+        });
+    }
+}
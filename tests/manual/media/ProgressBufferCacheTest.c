@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Checks that the progressbuffer caches read back what was written to them,
+ * in push and pull mode, for every cache mode. Build it against the POSIX
+ * cache, for example on Linux:
+ *
+ *   P=modules/javafx.media/src/main/native/gstreamer/plugins/progressbuffer
+ *   cc -O2 -I $P tests/manual/media/ProgressBufferCacheTest.c \
+ *      $P/posix/filecache.c $(pkg-config --cflags --libs gstreamer-1.0) \
+ *      -o ProgressBufferCacheTest
+ *
+ * Exits with 0 when every check passes, and 1 otherwise.
+ */
+
+#include <cache.h>
+#include <stdio.h>
+#include <string.h>
+
+// Same as in posix/filecache.c
+#define SEGMENT_SIZE (1024 * 1024)
+
+// More than three segments, so that reads cross segment boundaries
+#define CONTENT_SIZE (3 * SEGMENT_SIZE + 12345)
+#define WRITE_SIZE   10000
+
+static const char *modeNames[] = { "file", "mmap", "ram" };
+static int failures = 0;
+
+#define CHECK(mode, condition) check(mode, condition, #condition, __LINE__)
+
+static void check(CacheMode mode, gboolean condition, const char *text, int line)
+{
+    if (!condition)
+    {
+        printf("FAILED (%s, line %d): %s\n", modeNames[mode], line, text);
+        failures++;
+    }
+}
+
+static guint8 content_byte(gint64 position, guint8 seed)
+{
+    return (guint8)(position * 31 + (position >> 12) + seed);
+}
+
+static void write_content(Cache *cache, gint64 start, gint64 size, guint8 seed)
+{
+    gint64 position = start;
+    while (position < start + size)
+    {
+        guint count = (guint)MIN(WRITE_SIZE, start + size - position);
+        guint8 *data = (guint8*)g_malloc(count);
+        GstBuffer *buffer;
+        guint i;
+
+        for (i = 0; i < count; i++)
+            data[i] = content_byte(position + i, seed);
+        buffer = gst_buffer_new_wrapped(data, count);
+        cache_write_buffer(cache, buffer);
+        gst_buffer_unref(buffer);
+        position += count;
+    }
+}
+
+// Returns TRUE if buffer holds the content written at position
+static gboolean check_content(GstBuffer *buffer, gint64 position, guint8 seed)
+{
+    GstMapInfo info;
+    gboolean result = TRUE;
+    gsize i;
+
+    if (!gst_buffer_map(buffer, &info, GST_MAP_READ))
+        return FALSE;
+    for (i = 0; i < info.size && result; i++)
+        result = info.data[i] == content_byte(position + i, seed);
+    gst_buffer_unmap(buffer, &info);
+    return result;
+}
+
+static void test_push_read(CacheMode mode, Cache *cache)
+{
+    gint64 position = 0;
+    GstBuffer *buffer;
+
+    CHECK(mode, cache_set_read_position(cache, 0));
+    while (cache_has_enough_data(cache))
+    {
+        gint64 next = cache_read_buffer(cache, &buffer);
+        CHECK(mode, buffer != NULL);
+        if (buffer == NULL)
+            return;
+
+        CHECK(mode, GST_BUFFER_OFFSET(buffer) == (guint64)position);
+        CHECK(mode, next == position + (gint64)gst_buffer_get_size(buffer));
+        CHECK(mode, check_content(buffer, position, 0));
+        position += gst_buffer_get_size(buffer);
+        gst_buffer_unref(buffer);
+    }
+    CHECK(mode, position == CONTENT_SIZE);
+}
+
+static void test_seek_read(CacheMode mode, Cache *cache)
+{
+    static const gint64 positions[] = {
+        0,
+        SEGMENT_SIZE - 100,       // spans two segments
+        2 * SEGMENT_SIZE + 5,
+        CONTENT_SIZE - 64,
+    };
+    GstBuffer *buffer;
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS(positions); i++)
+    {
+        GstFlowReturn result = cache_read_buffer_from_position(cache, positions[i], 200, &buffer);
+        if (positions[i] + 200 > CONTENT_SIZE)
+        {
+            // Past the written data
+            CHECK(mode, result == GST_FLOW_ERROR);
+            CHECK(mode, buffer == NULL);
+            continue;
+        }
+        CHECK(mode, result == GST_FLOW_OK);
+        CHECK(mode, buffer != NULL);
+        if (buffer == NULL)
+            continue;
+
+        CHECK(mode, gst_buffer_get_size(buffer) == 200);
+        CHECK(mode, GST_BUFFER_OFFSET(buffer) == (guint64)positions[i]);
+        CHECK(mode, check_content(buffer, positions[i], 0));
+        gst_buffer_unref(buffer);
+    }
+
+    // Push mode goes on from the read position that was set
+    CHECK(mode, cache_set_read_position(cache, SEGMENT_SIZE + 7));
+    cache_read_buffer(cache, &buffer);
+    CHECK(mode, buffer != NULL);
+    if (buffer != NULL)
+    {
+        CHECK(mode, GST_BUFFER_OFFSET(buffer) == SEGMENT_SIZE + 7);
+        CHECK(mode, check_content(buffer, SEGMENT_SIZE + 7, 0));
+        gst_buffer_unref(buffer);
+    }
+}
+
+// Rewriting the cache, or destroying it, must not change the buffers that
+// were read from it before.
+static void test_rewrite(CacheMode mode, Cache *cache)
+{
+    GstBuffer *old_buffer;
+    GstBuffer *buffer;
+
+    CHECK(mode, cache_read_buffer_from_position(cache, 1000, 200, &old_buffer) == GST_FLOW_OK);
+
+    CHECK(mode, cache_set_write_position(cache, 100));
+    write_content(cache, 100, SEGMENT_SIZE, 1);
+
+    CHECK(mode, cache_read_buffer_from_position(cache, 0, 100, &buffer) == GST_FLOW_OK);
+    if (buffer != NULL)
+    {
+        CHECK(mode, check_content(buffer, 0, 0));
+        gst_buffer_unref(buffer);
+    }
+    CHECK(mode, cache_read_buffer_from_position(cache, 1000, 200, &buffer) == GST_FLOW_OK);
+    if (buffer != NULL)
+    {
+        CHECK(mode, check_content(buffer, 1000, 1));
+        gst_buffer_unref(buffer);
+    }
+
+    destroy_cache(cache);
+    if (old_buffer != NULL)
+    {
+        CHECK(mode, check_content(old_buffer, 1000, 0));
+        gst_buffer_unref(old_buffer);
+    }
+}
+
+static void test_mode(CacheMode mode)
+{
+    Cache *cache = create_cache_with_mode(mode);
+    CHECK(mode, cache != NULL);
+    if (cache == NULL)
+        return;
+
+    write_content(cache, 0, CONTENT_SIZE, 0);
+    test_push_read(mode, cache);
+    test_seek_read(mode, cache);
+    test_rewrite(mode, cache); // destroys the cache
+}
+
+static void test_ram_cache_limit(void)
+{
+    const gint64 limit = 4 * 1024 * 1024;
+    Cache *cache;
+    GstBuffer *buffer;
+
+    CHECK(CACHE_MODE_RAM, cache_mode_for_size(CACHE_MODE_MMAP, limit, limit) == CACHE_MODE_RAM);
+    CHECK(CACHE_MODE_MMAP, cache_mode_for_size(CACHE_MODE_MMAP, limit + 1, limit) == CACHE_MODE_MMAP);
+    CHECK(CACHE_MODE_FILE, cache_mode_for_size(CACHE_MODE_FILE, 1, 0) == CACHE_MODE_FILE);
+
+    // The memory cache of short content keeps whatever comes past the size
+    // that was announced
+    cache = create_cache_with_mode(cache_mode_for_size(CACHE_MODE_MMAP, 1000, limit));
+    CHECK(CACHE_MODE_RAM, cache != NULL);
+    if (cache == NULL)
+        return;
+
+    write_content(cache, 0, limit + SEGMENT_SIZE, 0);
+    CHECK(CACHE_MODE_RAM, cache_read_buffer_from_position(cache, limit - 100, 200, &buffer) == GST_FLOW_OK);
+    if (buffer != NULL)
+    {
+        CHECK(CACHE_MODE_RAM, check_content(buffer, limit - 100, 0));
+        gst_buffer_unref(buffer);
+    }
+    CHECK(CACHE_MODE_RAM, cache_read_buffer_from_position(cache, limit + SEGMENT_SIZE - 200, 200, &buffer) == GST_FLOW_OK);
+    if (buffer != NULL)
+    {
+        CHECK(CACHE_MODE_RAM, check_content(buffer, limit + SEGMENT_SIZE - 200, 0));
+        gst_buffer_unref(buffer);
+    }
+    destroy_cache(cache);
+}
+
+int main(int argc, char *argv[])
+{
+    gst_init(&argc, &argv);
+    cache_static_init();
+
+    test_mode(CACHE_MODE_FILE);
+    test_mode(CACHE_MODE_MMAP);
+    test_mode(CACHE_MODE_RAM);
+    test_ram_cache_limit();
+
+    printf(failures ? "%d check(s) failed\n" : "All checks passed\n", failures);
+    return failures ? 1 : 0;
+}
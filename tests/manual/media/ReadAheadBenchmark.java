@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import com.sun.media.jfxmedia.locator.ConnectionHolder;
+import com.sun.media.jfxmedia.locator.Locator;
+import java.io.File;
+import java.net.URI;
+import java.nio.ByteBuffer;
+
+/**
+ * Measures the sustained throughput, in MB/s, of the two ways the javasource
+ * element pulls data from a ConnectionHolder: one block at a time through
+ * readNextBlock, which the element then copies out of the holder buffer, and
+ * in large chunks through readAhead into the read-ahead ring.
+ *
+ *     java --add-exports javafx.media/com.sun.media.jfxmedia.locator=ALL-UNNAMED \
+ *          ReadAheadBenchmark <file or URI> [ring sizes in KB] [passes]
+ *
+ * The ring sizes default to "256,1024,4096". Use a jar: URI to measure jar
+ * based media. The native element uses the size set with the
+ * jfxmedia.readAheadSize system property, in bytes.
+ */
+public class ReadAheadBenchmark {
+
+    private static URI uri;
+
+    public static void main(String[] args) throws Exception {
+        if (args.length < 1) {
+            System.err.println("Usage: java ReadAheadBenchmark <file or URI> [ring sizes in KB] [passes]");
+            System.exit(1);
+        }
+        uri = args[0].contains(":") && !new File(args[0]).exists()
+                ? new URI(args[0]) : new File(args[0]).toURI();
+        String sizes = args.length > 1 ? args[1] : "256,1024,4096";
+        int passes = args.length > 2 ? Integer.parseInt(args[2]) : 5;
+
+        // Warm up both paths, so the results don't include compilation
+        readBlocks();
+        readAhead(1024 * 1024);
+
+        report("read-next-block", passes, -1);
+        for (String size : sizes.split(",")) {
+            report("read-ahead " + size.trim() + " KB", passes, Integer.parseInt(size.trim()) * 1024);
+        }
+    }
+
+    private static void report(String name, int passes, int ringSize) throws Exception {
+        long bytes = 0;
+        long start = System.nanoTime();
+        for (int i = 0; i < passes; i++) {
+            bytes += ringSize < 0 ? readBlocks() : readAhead(ringSize);
+        }
+        double seconds = (System.nanoTime() - start) / 1e9;
+        System.out.printf("%-24s %10.1f MB/s%n", name, bytes / seconds / (1024 * 1024));
+    }
+
+    private static ConnectionHolder open() throws Exception {
+        Locator locator = new Locator(uri);
+        locator.init();
+        return locator.createConnectionHolder();
+    }
+
+    // What java_source_loop does without read-ahead: read-next-block, then
+    // copy-block into a newly allocated buffer.
+    private static long readBlocks() throws Exception {
+        ConnectionHolder holder = open();
+        long total = 0;
+        try {
+            int size;
+            while ((size = holder.readNextBlock()) >= 0) {
+                ByteBuffer block = holder.getBuffer().duplicate();
+                block.rewind().limit(size);
+                ByteBuffer.allocateDirect(size).put(block);
+                total += size;
+            }
+        } finally {
+            holder.closeConnection();
+        }
+        return total;
+    }
+
+    // What java_source_loop does with read-ahead: the holder reads chunks of
+    // a quarter of the ring straight into it.
+    private static long readAhead(int ringSize) throws Exception {
+        ConnectionHolder holder = open();
+        ByteBuffer ring = ByteBuffer.allocateDirect(ringSize);
+        int chunk = Math.max(ringSize / 4, 4096);
+        int offset = 0;
+        long total = 0;
+        holder.setReadAheadBuffer(ring);
+        try {
+            int size;
+            while ((size = holder.readAhead(offset, Math.min(chunk, ringSize - offset))) >= 0) {
+                offset += size;
+                if (ringSize - offset < 4096) {
+                    offset = 0;
+                }
+                total += size;
+            }
+        } finally {
+            holder.closeConnection();
+        }
+        return total;
+    }
+}
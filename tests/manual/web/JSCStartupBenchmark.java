@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.concurrent.Worker;
+import javafx.scene.Scene;
+import javafx.scene.web.WebEngine;
+import javafx.scene.web.WebView;
+import javafx.stage.Stage;
+
+/**
+ * Measures the startup parse of a large script, the case the
+ * sourceProviderCachePath option of JavaScriptCore is meant for. The script
+ * defines a few thousand functions, none of which is called, like a library
+ * loaded at startup. The option is set from the environment, since the jsc
+ * shell is not built for this port. Compare a run without the option with
+ * the second of two runs with it (the first one writes the cache file):
+ *
+ *     java JSCStartupBenchmark [functions]
+ *     mkdir -p /tmp/jsccache
+ *     JSC_sourceProviderCachePath=/tmp/jsccache java JSCStartupBenchmark [functions]
+ *     JSC_sourceProviderCachePath=/tmp/jsccache java JSCStartupBenchmark [functions]
+ *
+ * Each run is a new process, since the code cache of the VM skips the parse
+ * of a script run twice by the same process.
+ */
+public class JSCStartupBenchmark extends Application {
+
+    private static int functionCount = 4000;
+
+    public static void main(String[] args) {
+        if (args.length > 0) {
+            functionCount = Integer.parseInt(args[0]);
+        }
+        launch(args);
+    }
+
+    private static String generateLibrary(int count) {
+        StringBuilder source = new StringBuilder();
+        for (int i = 0; i < count; i++) {
+            source.append("function f").append(i).append("(a, b, c) {\n")
+                  .append("    var result = [];\n")
+                  .append("    for (var i = 0; i < a.length; i++) {\n")
+                  .append("        if (a[i] > b)\n")
+                  .append("            result.push({ index: i, value: a[i] * c });\n")
+                  .append("        else\n")
+                  .append("            result.push(function (x) { return x + b; }(a[i]));\n")
+                  .append("    }\n")
+                  .append("    return result.length ? result : null;\n")
+                  .append("}\n");
+        }
+        return source.toString();
+    }
+
+    @Override
+    public void start(Stage stage) {
+        WebView view = new WebView();
+        WebEngine engine = view.getEngine();
+        engine.getLoadWorker().stateProperty().addListener((ov, o, state) -> {
+            if (state == Worker.State.SUCCEEDED) {
+                Platform.runLater(() -> {
+                    run(engine);
+                    Platform.exit();
+                });
+            }
+        });
+        engine.loadContent("<html><body>JSCStartupBenchmark</body></html>");
+        stage.setScene(new Scene(view, 300, 200));
+        stage.show();
+    }
+
+    private void run(WebEngine engine) {
+        String library = generateLibrary(functionCount);
+        long start = System.nanoTime();
+        engine.executeScript(library);
+        long elapsed = System.nanoTime() - start;
+        System.out.printf("Loaded %d functions (%d characters) in %.2f ms%n",
+                functionCount, library.length(), elapsed / 1e6);
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.concurrent.Worker;
+import javafx.scene.Scene;
+import javafx.scene.web.WebEngine;
+import javafx.scene.web.WebView;
+import javafx.stage.Stage;
+import netscape.javascript.JSObject;
+
+/**
+ * Measures the rate of calls from JavaScript to the methods of a Java
+ * object bound with JSObject.setMember(), for a few argument and return
+ * types. Run it against two builds to compare them, for example:
+ *
+ *     java JavaBridgeBenchmark [calls per run]
+ *
+ * Each case is run a few times and the best rate is printed.
+ */
+public class JavaBridgeBenchmark extends Application {
+
+    private static final int RUNS = 5;
+    private static int calls = 200000;
+
+    public static class Callbacks {
+        private int count;
+        private double total;
+
+        public void noArgs() {
+            count++;
+        }
+
+        public int addInt(int a, int b) {
+            return a + b;
+        }
+
+        public double addDouble(double a, double b, double c, double d) {
+            total += a + b + c + d;
+            return total;
+        }
+
+        public boolean flag(boolean value, long id) {
+            return !value && id >= 0;
+        }
+
+        public String string(String s) {
+            return s;
+        }
+
+        public Object object(Object o) {
+            return o;
+        }
+    }
+
+    // JavaScript cases, each calling the bound object 'cb' n times.
+    private static final String[][] CASES = {
+        { "noArgs()",                   "for (var i = 0; i < n; i++) cb.noArgs();" },
+        { "addInt(int, int)",           "var s = 0; for (var i = 0; i < n; i++) s = cb.addInt(s, i);" },
+        { "addDouble(double x 4)",      "for (var i = 0; i < n; i++) cb.addDouble(i, 0.5, 1.5, 2.5);" },
+        { "flag(boolean, long)",        "for (var i = 0; i < n; i++) cb.flag(false, i);" },
+        { "string(String)",             "for (var i = 0; i < n; i++) cb.string('text');" },
+        { "object(Object)",             "var o = {}; for (var i = 0; i < n; i++) cb.object(o);" },
+    };
+
+    public static void main(String[] args) {
+        if (args.length > 0) {
+            calls = Integer.parseInt(args[0]);
+        }
+        launch(args);
+    }
+
+    @Override
+    public void start(Stage stage) {
+        WebView view = new WebView();
+        WebEngine engine = view.getEngine();
+        engine.getLoadWorker().stateProperty().addListener((ov, o, state) -> {
+            if (state == Worker.State.SUCCEEDED) {
+                JSObject window = (JSObject) engine.executeScript("window");
+                window.setMember("cb", new Callbacks());
+                Platform.runLater(() -> {
+                    runCases(engine);
+                    Platform.exit();
+                });
+            }
+        });
+        engine.loadContent("<html><body>JavaBridgeBenchmark</body></html>");
+        stage.setScene(new Scene(view, 300, 200));
+        stage.show();
+    }
+
+    private void runCases(WebEngine engine) {
+        System.out.println("JavaBridgeBenchmark, " + calls + " calls per run");
+        for (String[] c : CASES) {
+            engine.executeScript("function bench(n) { " + c[1] + " }");
+            // Warm up the bridge and the JITs
+            engine.executeScript("bench(" + Math.min(calls, 10000) + ")");
+            long best = Long.MAX_VALUE;
+            for (int run = 0; run < RUNS; run++) {
+                long start = System.nanoTime();
+                engine.executeScript("bench(" + calls + ")");
+                best = Math.min(best, System.nanoTime() - start);
+            }
+            System.out.printf("%-24s %12.0f calls/s%n", c[0], calls * 1e9 / best);
+        }
+    }
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web.sourceprovidercachetest;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.net.Socket;
+import javafx.application.Application;
+import javafx.concurrent.Worker;
+import javafx.scene.Scene;
+import javafx.scene.web.WebEngine;
+import javafx.scene.web.WebView;
+import javafx.stage.Stage;
+
+import static test.javafx.scene.web.sourceprovidercachetest.Constants.*;
+
+/*
+ * Test application launched by SourceProviderCacheTest with the
+ * JSC_sourceProviderCachePath environment variable set.
+ * Test steps:
+ * 1. Run a large generated library with executeScript.
+ * 2. Call some of its functions and arrow functions.
+ * 3. Verify that the result is the one computed here.
+ */
+public class SourceProviderCacheApp extends Application {
+
+    // Socket for communicating with SourceProviderCacheTest
+    private static Socket socket;
+    private static OutputStream out;
+    private static boolean statusWritten = false;
+
+    private static void initSocket(String[] args) throws Exception {
+        int port = Integer.parseInt(args[0]);
+        socket = new Socket((String)null, port);
+        out = socket.getOutputStream();
+        out.write(SOCKET_HANDSHAKE);
+        out.flush();
+    }
+
+    private synchronized static void writeStatus(int status) {
+        if (!statusWritten) {
+            statusWritten = true;
+            try {
+                out.write(status);
+                out.flush();
+            } catch (IOException ex) {
+                ex.printStackTrace(System.err);
+            }
+        }
+    }
+
+    // The same source on every run, so that every run uses the same file
+    static String generateLibrary() {
+        StringBuilder source = new StringBuilder();
+        for (int i = 0; i < FUNCTION_COUNT; i++) {
+            source.append("function f").append(i).append("(a, b) {\n")
+                  .append("    var result = 0;\n")
+                  .append("    for (var i = 0; i < a; i++)\n")
+                  .append("        result += (i % 2) ? b : ").append(i).append(";\n")
+                  .append("    return result;\n")
+                  .append("}\n")
+                  // The cached end of an arrow function is the token after it
+                  .append("var g").append(i).append(" = x => x * ").append(i).append(", h")
+                  .append(i).append(" = 0;\n");
+        }
+        // Only some of the functions are called, the others stay lazily parsed
+        source.append("var sum = 0;\n")
+              .append("for (var i = 0; i < ").append(FUNCTION_COUNT).append("; i += 7)\n")
+              .append("    sum += window['f' + i](3, 1) + window['g' + i](2);\n")
+              .append("sum;\n");
+        return source.toString();
+    }
+
+    static int expectedResult() {
+        int sum = 0;
+        for (int i = 0; i < FUNCTION_COUNT; i += 7) {
+            sum += i + 1 + i + 2 * i;
+        }
+        return sum;
+    }
+
+    @Override
+    public void start(Stage stage) throws Exception {
+        WebView view = new WebView();
+        WebEngine engine = view.getEngine();
+        engine.getLoadWorker().stateProperty().addListener((ov, o, state) -> {
+            if (state == Worker.State.SUCCEEDED) {
+                int status;
+                try {
+                    Object result = engine.executeScript(generateLibrary());
+                    status = (result instanceof Number
+                            && ((Number) result).intValue() == expectedResult())
+                            ? STATUS_OK : STATUS_WRONG_RESULT;
+                } catch (RuntimeException ex) {
+                    ex.printStackTrace(System.err);
+                    status = STATUS_SCRIPT_ERROR;
+                }
+                writeStatus(status);
+                stage.hide();
+                System.exit(ERROR_NONE);
+            }
+        });
+        engine.loadContent("<html><body>SourceProviderCacheApp</body></html>");
+        stage.setScene(new Scene(view, 300, 200));
+        stage.show();
+    }
+
+    public static void main(String[] args) {
+        try {
+            initSocket(args);
+        } catch (Exception ex) {
+            ex.printStackTrace(System.err);
+            System.exit(ERROR_SOCKET);
+        }
+        Application.launch(args);
+    }
+}
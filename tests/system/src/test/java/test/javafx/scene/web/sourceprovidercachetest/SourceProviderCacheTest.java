@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web.sourceprovidercachetest;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.InputStream;
+import java.net.ServerSocket;
+import java.net.Socket;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.attribute.FileTime;
+import java.util.ArrayList;
+import java.util.Arrays;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+import static org.junit.Assert.*;
+import static test.javafx.scene.web.sourceprovidercachetest.Constants.*;
+
+/**
+ * Unit test for the files of JavaScriptCore's sourceProviderCachePath
+ * option. The files written by one run of SourceProviderCacheApp are read
+ * by the next one, and damaged or mismatched files are dropped and written
+ * again, without changing the result of the script.
+ */
+public class SourceProviderCacheTest {
+
+    private static final String className = SourceProviderCacheTest.class.getName();
+    private static final String pkgName = className.substring(0, className.lastIndexOf("."));
+    private final String testAppName = pkgName + "." + "SourceProviderCacheApp";
+
+    // Offsets in the header of a file, see SourceProviderCacheFile.cpp
+    private static final int VERSION_OFFSET = 4;
+    private static final int BUILD_ID_OFFSET = 8;
+    private static final int SOURCE_DIGEST_OFFSET = 28;
+
+    // A time no run of the app writes a file at
+    private static final FileTime OLD_TIME = FileTime.fromMillis(86400000L);
+
+    private Path cacheDir;
+
+    @Before
+    public void createCacheDir() throws IOException {
+        cacheDir = Files.createTempDirectory("jsccache");
+    }
+
+    @After
+    public void deleteCacheDir() throws IOException {
+        for (File file : cacheDir.toFile().listFiles()) {
+            file.delete();
+        }
+        Files.delete(cacheDir);
+    }
+
+    private void runApp() throws Exception {
+        // Initilaize the socket
+        final ServerSocket service = new ServerSocket(0);
+        final int port = service.getLocalPort();
+
+        // Launch the test app
+        final ArrayList<String> cmd
+                = test.util.Util.createApplicationLaunchCommand(testAppName,
+                        null, null);
+        // and add our argument
+        cmd.add(String.valueOf(port));
+        ProcessBuilder builder = new ProcessBuilder(cmd);
+        builder.environment().put("JSC_sourceProviderCachePath", cacheDir.toString());
+        builder.redirectError(ProcessBuilder.Redirect.INHERIT);
+        builder.redirectOutput(ProcessBuilder.Redirect.INHERIT);
+        Process process = builder.start();
+
+        // Accept a connection from the test app
+        final Socket socket = service.accept();
+        final InputStream in = socket.getInputStream();
+
+        // Read the "handshake" token
+        int handshake = in.read();
+        assertEquals("Socket handshake failed,", SOCKET_HANDSHAKE, handshake);
+
+        // Read the status code from the test app
+        int status = in.read();
+        switch (status) {
+            case STATUS_OK:
+                break;
+            case STATUS_WRONG_RESULT:
+                fail(testAppName + ": Wrong result of the library");
+                break;
+            case STATUS_SCRIPT_ERROR:
+                fail(testAppName + ": Exception from the library");
+                break;
+            default:
+                fail(testAppName + ": Unexpected status: " + status);
+        }
+
+        // Make sure that the process exited as expected
+        int retVal = process.waitFor();
+        switch (retVal) {
+            case ERROR_NONE:
+                break;
+
+            case ERROR_SOCKET:
+                fail(testAppName + ": Error connecting to socket");
+                break;
+
+            case 0:
+                fail(testAppName + ": Unexpected exit 0");
+                break;
+
+            case 1:
+                fail(testAppName + ": Unable to launch java application");
+                break;
+
+            default:
+                fail(testAppName + ": Unexpected error exit: " + retVal);
+        }
+        service.close();
+    }
+
+    private Path cacheFile() {
+        File[] files = cacheDir.toFile().listFiles();
+        assertEquals("Files in " + cacheDir + ": " + Arrays.toString(files), 1, files.length);
+        assertTrue(files[0].getName().endsWith(".jsccache"));
+        return files[0].toPath();
+    }
+
+    // Runs the app on a file changed by the test, and checks that the file
+    // is dropped and written again as the first run wrote it. The items are
+    // kept in a hash map, so this relies on two runs parsing the library the
+    // same way.
+    private void runAppWithDamagedFile(byte[] contents) throws Exception {
+        Path file = cacheFile();
+        byte[] original = Files.readAllBytes(file);
+        Files.write(file, contents);
+
+        runApp();
+
+        assertArrayEquals(original, Files.readAllBytes(cacheFile()));
+    }
+
+    private byte[] flipByte(int offset) throws IOException {
+        byte[] contents = Files.readAllBytes(cacheFile());
+        contents[offset] ^= 0x5a;
+        return contents;
+    }
+
+    @Test
+    public void testFileIsReadByNextRun() throws Exception {
+        runApp();
+        Path file = cacheFile();
+        Files.setLastModifiedTime(file, OLD_TIME);
+
+        // Nothing is added to a cache read from the file, so the file is
+        // only written again if it was not read
+        runApp();
+        assertEquals(OLD_TIME, Files.getLastModifiedTime(cacheFile()));
+    }
+
+    @Test
+    public void testTruncatedFile() throws Exception {
+        runApp();
+        byte[] contents = Files.readAllBytes(cacheFile());
+        runAppWithDamagedFile(Arrays.copyOf(contents, contents.length / 2));
+    }
+
+    @Test
+    public void testTruncatedHeader() throws Exception {
+        runApp();
+        byte[] contents = Files.readAllBytes(cacheFile());
+        runAppWithDamagedFile(Arrays.copyOf(contents, BUILD_ID_OFFSET + 3));
+    }
+
+    @Test
+    public void testTrailingData() throws Exception {
+        runApp();
+        byte[] contents = Files.readAllBytes(cacheFile());
+        runAppWithDamagedFile(Arrays.copyOf(contents, contents.length + 4));
+    }
+
+    @Test
+    public void testMismatchedVersion() throws Exception {
+        runApp();
+        runAppWithDamagedFile(flipByte(VERSION_OFFSET));
+    }
+
+    @Test
+    public void testMismatchedBuildID() throws Exception {
+        runApp();
+        runAppWithDamagedFile(flipByte(BUILD_ID_OFFSET));
+    }
+
+    @Test
+    public void testMismatchedSource() throws Exception {
+        runApp();
+        runAppWithDamagedFile(flipByte(SOURCE_DIGEST_OFFSET));
+    }
+
+    @Test
+    public void testDamagedItems() throws Exception {
+        runApp();
+        byte[] contents = Files.readAllBytes(cacheFile());
+        // The last words of the last item, whichever fields they are, are
+        // out of range once all their bits are set
+        for (int i = contents.length - 64; i < contents.length; i++) {
+            contents[i] = (byte) 0xff;
+        }
+        runAppWithDamagedFile(contents);
+    }
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web.tiledbackingstoretest;
+
+import java.io.BufferedOutputStream;
+import java.io.DataOutputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.net.Socket;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Iterator;
+import java.util.List;
+import javafx.animation.PauseTransition;
+import javafx.application.Application;
+import javafx.concurrent.Worker;
+import javafx.scene.Scene;
+import javafx.scene.image.PixelReader;
+import javafx.scene.image.WritableImage;
+import javafx.scene.web.WebEngine;
+import javafx.scene.web.WebView;
+import javafx.stage.Stage;
+import javafx.util.Duration;
+
+import static test.javafx.scene.web.tiledbackingstoretest.Constants.*;
+
+/*
+ * Test application launched by TiledBackingStoreTest, with and without the
+ * tiled backing store enabled.
+ * Test steps:
+ * 1. Load a page much longer than the view and snapshot it.
+ * 2. Scroll down and snapshot it.
+ * 3. Change an element that is out of view, scroll back and snapshot it.
+ * 4. Verify that the element is painted with its new color.
+ * 5. Write the snapshots to the file named by the second argument.
+ */
+public class TiledBackingStoreApp extends Application {
+
+    // Socket for communicating with TiledBackingStoreTest
+    private static Socket socket;
+    private static OutputStream out;
+    private static boolean statusWritten = false;
+    private static String snapshotFile;
+
+    private static final int WIDTH = 400;
+    private static final int HEIGHT = 300;
+
+    // Time for the view to be painted after each step
+    private static final Duration SETTLE_TIME = Duration.millis(500);
+
+    // Boxes without text, so that both ways of painting give the same pixels
+    private static final String HTML;
+    static {
+        StringBuilder html = new StringBuilder(
+                "<html><body style='margin: 0; overflow: hidden'>" +
+                "<div id='top' style='margin: 20px; width: 100px; height: 100px;" +
+                " background: rgb(255, 0, 0)'></div>");
+        for (int i = 0; i < 50; i++) {
+            html.append("<div style='margin-left: ").append(i * 3)
+                .append("px; width: 250px; height: 100px; background: rgb(")
+                .append(i * 5).append(", ").append(255 - i * 5).append(", ")
+                .append((i * 37) % 256).append(")'></div>");
+        }
+        HTML = html.append("</body></html>").toString();
+    }
+
+    private final List<int[]> snapshots = new ArrayList<>();
+
+    private static void initSocket(String[] args) throws Exception {
+        int port = Integer.parseInt(args[0]);
+        socket = new Socket((String)null, port);
+        out = socket.getOutputStream();
+        out.write(SOCKET_HANDSHAKE);
+        out.flush();
+    }
+
+    private synchronized static void writeStatus(int status) {
+        if (!statusWritten) {
+            statusWritten = true;
+            try {
+                out.write(status);
+                out.flush();
+            } catch (IOException ex) {
+                ex.printStackTrace(System.err);
+            }
+        }
+    }
+
+    private int[] snapshot(WebView view) {
+        WritableImage image = view.snapshot(null, null);
+        PixelReader reader = image.getPixelReader();
+        int[] pixels = new int[WIDTH * HEIGHT];
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < WIDTH; x++) {
+                pixels[y * WIDTH + x] = reader.getArgb(x, y);
+            }
+        }
+        snapshots.add(pixels);
+        return pixels;
+    }
+
+    private void writeSnapshots() throws IOException {
+        try (DataOutputStream file = new DataOutputStream(
+                new BufferedOutputStream(new FileOutputStream(snapshotFile)))) {
+            file.writeInt(snapshots.size());
+            for (int[] pixels : snapshots) {
+                file.writeInt(pixels.length);
+                for (int pixel : pixels) {
+                    file.writeInt(pixel);
+                }
+            }
+        }
+    }
+
+    // Runs each step after the view is painted for the previous one
+    private void runSteps(Iterator<Runnable> steps) {
+        PauseTransition pause = new PauseTransition(SETTLE_TIME);
+        pause.setOnFinished(e -> {
+            steps.next().run();
+            if (steps.hasNext()) {
+                runSteps(steps);
+            }
+        });
+        pause.play();
+    }
+
+    private void finish(Stage stage, int status) {
+        if (status == STATUS_OK) {
+            try {
+                writeSnapshots();
+            } catch (IOException ex) {
+                ex.printStackTrace(System.err);
+                status = STATUS_SNAPSHOT_ERROR;
+            }
+        }
+        writeStatus(status);
+        stage.hide();
+        System.exit(ERROR_NONE);
+    }
+
+    @Override
+    public void start(Stage stage) throws Exception {
+        WebView view = new WebView();
+        view.setContextMenuEnabled(false);
+        WebEngine engine = view.getEngine();
+        engine.getLoadWorker().stateProperty().addListener((ov, o, state) -> {
+            if (state != Worker.State.SUCCEEDED) {
+                return;
+            }
+            runSteps(Arrays.<Runnable>asList(
+                () -> snapshot(view),
+                () -> engine.executeScript("window.scrollTo(0, 1200)"),
+                () -> snapshot(view),
+                () -> engine.executeScript("document.getElementById('top')"
+                        + ".style.background = 'rgb(0, 0, 255)'"),
+                () -> engine.executeScript("window.scrollTo(0, 0)"),
+                () -> {
+                    int[] pixels = snapshot(view);
+                    finish(stage, pixels[70 * WIDTH + 70] == 0xff0000ff
+                            ? STATUS_OK : STATUS_STALE_CONTENT);
+                }).iterator());
+        });
+        engine.loadContent(HTML);
+        stage.setScene(new Scene(view, WIDTH, HEIGHT));
+        stage.show();
+    }
+
+    public static void main(String[] args) {
+        try {
+            initSocket(args);
+        } catch (Exception ex) {
+            ex.printStackTrace(System.err);
+            System.exit(ERROR_SOCKET);
+        }
+        snapshotFile = args[1];
+        Application.launch(args);
+    }
+}
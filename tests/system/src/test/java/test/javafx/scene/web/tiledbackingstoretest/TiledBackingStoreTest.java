@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web.tiledbackingstoretest;
+
+import java.io.BufferedInputStream;
+import java.io.DataInputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.net.ServerSocket;
+import java.net.Socket;
+import java.util.ArrayList;
+import java.util.List;
+import org.junit.Test;
+
+import static org.junit.Assert.*;
+import static test.javafx.scene.web.tiledbackingstoretest.Constants.*;
+
+/**
+ * Unit test for the tiled backing store of WebPage. Its system properties
+ * are read once per JVM, so TiledBackingStoreApp is run once with the
+ * store and once without it, and their snapshots are compared.
+ */
+public class TiledBackingStoreTest {
+
+    private static final String className = TiledBackingStoreTest.class.getName();
+    private static final String pkgName = className.substring(0, className.lastIndexOf("."));
+    private final String testAppName = pkgName + "." + "TiledBackingStoreApp";
+
+    private List<int[]> runApp(String... jvmArgs) throws Exception {
+        File snapshotFile = File.createTempFile("tiledbackingstore", ".dat");
+        snapshotFile.deleteOnExit();
+
+        // Initilaize the socket
+        final ServerSocket service = new ServerSocket(0);
+        final int port = service.getLocalPort();
+
+        // Launch the test app
+        final ArrayList<String> cmd
+                = test.util.Util.createApplicationLaunchCommand(testAppName,
+                        null, null, jvmArgs);
+        // and add our arguments
+        cmd.add(String.valueOf(port));
+        cmd.add(snapshotFile.getAbsolutePath());
+        ProcessBuilder builder = new ProcessBuilder(cmd);
+        builder.redirectError(ProcessBuilder.Redirect.INHERIT);
+        builder.redirectOutput(ProcessBuilder.Redirect.INHERIT);
+        Process process = builder.start();
+
+        // Accept a connection from the test app
+        final Socket socket = service.accept();
+        final InputStream in = socket.getInputStream();
+
+        // Read the "handshake" token
+        int handshake = in.read();
+        assertEquals("Socket handshake failed,", SOCKET_HANDSHAKE, handshake);
+
+        // Read the status code from the test app
+        int status = in.read();
+        switch (status) {
+            case STATUS_OK:
+                break;
+            case STATUS_STALE_CONTENT:
+                fail(testAppName
+                    + ": Element changed out of view not repainted");
+                break;
+            case STATUS_SNAPSHOT_ERROR:
+                fail(testAppName + ": Unable to write the snapshots");
+                break;
+            default:
+                fail(testAppName + ": Unexpected status: " + status);
+        }
+
+        // Make sure that the process exited as expected
+        int retVal = process.waitFor();
+        switch (retVal) {
+            case ERROR_NONE:
+                break;
+
+            case ERROR_SOCKET:
+                fail(testAppName + ": Error connecting to socket");
+                break;
+
+            case 0:
+                fail(testAppName + ": Unexpected exit 0");
+                break;
+
+            case 1:
+                fail(testAppName + ": Unable to launch java application");
+                break;
+
+            default:
+                fail(testAppName + ": Unexpected error exit: " + retVal);
+        }
+        service.close();
+
+        return readSnapshots(snapshotFile);
+    }
+
+    private static List<int[]> readSnapshots(File snapshotFile) throws IOException {
+        List<int[]> snapshots = new ArrayList<>();
+        try (DataInputStream file = new DataInputStream(
+                new BufferedInputStream(new FileInputStream(snapshotFile)))) {
+            int count = file.readInt();
+            for (int i = 0; i < count; i++) {
+                int[] pixels = new int[file.readInt()];
+                for (int j = 0; j < pixels.length; j++) {
+                    pixels[j] = file.readInt();
+                }
+                snapshots.add(pixels);
+            }
+        }
+        snapshotFile.delete();
+        return snapshots;
+    }
+
+    @Test
+    public void testTiledSnapshotsMatchDirectPainting() throws Exception {
+        // Tiles are not used with a device scale factor other than 1, and
+        // small tiles make the scrolled views and the change span several
+        List<int[]> direct = runApp("-Dprism.allowhidpi=false",
+                "-Dcom.sun.webkit.tiledBackingStore=false");
+        List<int[]> tiled = runApp("-Dprism.allowhidpi=false",
+                "-Dcom.sun.webkit.tiledBackingStore=true",
+                "-Dcom.sun.webkit.tileSize=64");
+
+        assertEquals("Number of snapshots", direct.size(), tiled.size());
+        String[] names = { "Loaded", "Scrolled", "Changed out of view" };
+        for (int i = 0; i < direct.size(); i++) {
+            assertArrayEquals(names[i], direct.get(i), tiled.get(i));
+        }
+    }
+}